@@ -7,6 +7,17 @@
 #
 #           from psychtoolbox import *
 #
+# Functions which return matrices, e.g., PsychPortAudio('GetAudioData') or
+# PsychHID('GetReport'), accept an optional out= keyword argument with a
+# preallocated NumPy array, or a tuple of arrays or None, one per return
+# argument. If an array matches the type, shape and memory layout of the
+# result, it is filled in place and returned, instead of allocating a new
+# array at each call. Otherwise a new array is returned, e.g., to fetch
+# fixed size blocks of 0.1 seconds of captured sound:
+#
+#           buf = PsychPortAudio('GetAudioData', pahandle, None, 0.1, 0.1)[0]
+#           audio = PsychPortAudio('GetAudioData', pahandle, None, 0.1, 0.1, out=buf)[0]
+#
 # Copyright (c) 2018 Mario Kleiner. Licensed under MIT license.
 #
 
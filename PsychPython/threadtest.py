@@ -0,0 +1,57 @@
+# threadtest.py - Check that blocking module calls let other Python threads run.
+#
+# A worker thread counts in a tight pure Python loop while the main thread
+# blocks in different WaitSecs() variants. As these release the global
+# interpreter lock during the wait, the worker should make roughly as much
+# progress during each wait as during an equally long time.sleep(). Then a
+# few threads call WaitSecs() concurrently, which serializes the calls inside
+# the module, without blocking unrelated Python threads.
+
+import threading
+import time
+from psychtoolbox import *
+
+def run():
+    counter = [0]
+    done = threading.Event()
+
+    def spin():
+        while not done.is_set():
+            counter[0] += 1
+
+    worker = threading.Thread(target=spin, daemon=True)
+    worker.start()
+
+    waits = [('time.sleep()', lambda: time.sleep(0.5)),
+             ("WaitSecs()", lambda: WaitSecs(0.5)),
+             ("WaitSecs('UntilTime')", lambda: WaitSecs('UntilTime', GetSecs() + 0.5)),
+             ("WaitSecs('YieldSecs')", lambda: WaitSecs('YieldSecs', 0.5))]
+
+    # Warm up, so module init does not count:
+    WaitSecs(0.01)
+
+    for name, wait in waits:
+        c0 = counter[0]
+        t0 = GetSecs()
+        wait()
+        t1 = GetSecs()
+        print('%-24s took %f secs, worker counted to %i meanwhile.' % (name, t1 - t0, counter[0] - c0))
+
+    done.set()
+    worker.join()
+
+    # Concurrent waits from multiple threads:
+    def waiter(i):
+        tWake = WaitSecs(0.2)
+        print('Thread %i woke up at %f.' % (i, tWake))
+
+    t0 = GetSecs()
+    threads = [threading.Thread(target=waiter, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    print('4 concurrent WaitSecs(0.2) took %f secs in total.' % (GetSecs() - t0))
+
+if __name__ == '__main__':
+    run()
@@ -5,12 +5,16 @@
  * Features:
  *
  * - Texture mapped renderer.
- * - Fast due to texture object and display list caching for fast glyph recycling.
+ * - Fast due to a packed glyph texture atlas per font and caching of the layout of recently drawn strings,
+ *   so each string is drawn with one texture bind and one draw call.
  * - Good text layouting.
  * - Supports all Freetype-2 supported fonts, e.g., vectorgraphics TrueType fonts.
  * - Anti-Aliased drawing via Alpha-Blending.
  * - Full Unicode support.
  * - Text measuring support, e.g., bounding boxes.
+ * - Signed distance field rendering mode, selected via Screen('Preference', 'TextAntiAliasing', 3): Glyphs are
+ *   generated once per font by a background thread and drawn smoothly at any size and affine transformation,
+ *   without rebuilding the font, optionally as outlines.
  *
  * New style:   Includes our own - slightly modified - version of OGLFT.h/cpp for libglft support, thereby avoiding runtime
  *              dependencies on a properly configured & built libglft (Many binary installs of this library are built without unicode support).
@@ -31,7 +35,7 @@
  *
  * Building for Linux:
  *
- * g++ -g -fPIC -I. -I/usr/include/ -I/usr/include/freetype2/ -L/usr/lib -pie -shared -Wl,-Bsymbolic -Wl,-Bsymbolic-functions -Wl,--version-script=linuxexportlist.txt -o libptbdrawtext_ftgl.so.1 libptbdrawtext_ftgl.cpp qstringqcharemulation.cpp OGLFT.cpp -lGL -lGLU -lfontconfig -lfreetype
+ * g++ -g -fPIC -I. -I/usr/include/ -I/usr/include/freetype2/ -L/usr/lib -pie -shared -Wl,-Bsymbolic -Wl,-Bsymbolic-functions -Wl,--version-script=linuxexportlist.txt -o libptbdrawtext_ftgl.so.1 libptbdrawtext_ftgl.cpp qstringqcharemulation.cpp OGLFT.cpp -lGL -lGLU -lfontconfig -lfreetype -lpthread -ldl
  *
  * libptbdrawtext_ftgl is copyright (c) 2010-2016 by Mario Kleiner.
  * It is licensed to you as follows:
@@ -61,6 +65,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 
 // Include all GLFT and QT stuff:
 #include "OGLFT.h"
@@ -69,6 +74,15 @@
 #include "fontconfig/fontconfig.h"
 #include "fontconfig/fcfreetype.h"
 
+// Threads for background generation of signed distance field glyphs, and lookup of OpenGL functions:
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <dlfcn.h>
+#endif
+#include <deque>
+
 // Maximum number of cacheable font settings, combined over all onscreen windows
 // font family names, sizes, styles and anti-aliasing settings. E.g., a setting of 40 means
 // you could quickly switch between up to 40 different combinations of font name, size,
@@ -88,6 +102,32 @@
 // 10 fullscreen onscreen windows, so guaranteeing for 10 onscreen windows should be good enough.
 #define MIN_GUARANTEED_CONTEXTS 10
 
+// Initial width and maximum height of the glyph texture atlas of each font cache slot. The atlas
+// doubles its height whenever it runs full, up to the maximum, at which point it gets cleared and
+// refilled with the glyphs needed from then on. Its width is increased for very big fonts:
+#define GLYPH_ATLAS_WIDTH 512
+#define GLYPH_ATLAS_MAXHEIGHT 4096
+
+// Maximum number of text strings per font cache slot whose layout is cached for redrawing
+// or measuring them. If more strings are used, the least recently used layouts get replaced:
+#define MAX_LAYOUT_CACHE_SLOTS 512
+
+// Text anti-aliasing mode, as selected via Screen('Preference', 'TextAntiAliasing', 3), for
+// rendering text from a signed distance field (SDF) glyph atlas at any size and transformation:
+#define TEXT_ANTIALIASING_SDF 3
+
+// SDF glyphs are generated once per font face at a pixel size of SDF_BASE_SIZE, from glyph images
+// rendered SDF_OVERSAMPLE times bigger, and encode distances of up to SDF_SPREAD pixels at base size.
+// Glyphs of characters SDF_PREGEN_FIRST to SDF_PREGEN_LAST are generated up front by a background
+// thread, all other glyphs when first used. The width of outlines for Screen('TextStyle') style
+// 8 is SDF_OUTLINE_WIDTH times the font size:
+#define SDF_BASE_SIZE 48
+#define SDF_OVERSAMPLE 4
+#define SDF_SPREAD 6
+#define SDF_PREGEN_FIRST 32
+#define SDF_PREGEN_LAST 255
+#define SDF_OUTLINE_WIDTH 0.0625
+
 unsigned int nowtime = 0;
 unsigned int hitcount = 0;
 unsigned int _verbosity = 2;
@@ -106,6 +146,89 @@ FT_Vector _vector;
 double _xp;
 double _yp;
 
+// Minimal thread, mutex and condition variable support for the SDF glyph generator:
+#if defined(_WIN32)
+typedef HANDLE              sdfThreadType;
+typedef CRITICAL_SECTION    sdfMutexType;
+typedef CONDITION_VARIABLE  sdfCondType;
+#define sdfMutexInit(m)     InitializeCriticalSection(m)
+#define sdfMutexDestroy(m)  DeleteCriticalSection(m)
+#define sdfLock(m)          EnterCriticalSection(m)
+#define sdfUnlock(m)        LeaveCriticalSection(m)
+#define sdfCondInit(c)      InitializeConditionVariable(c)
+#define sdfCondDestroy(c)
+#define sdfCondWait(c, m)   SleepConditionVariableCS(c, m, INFINITE)
+#define sdfCondBroadcast(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_t           sdfThreadType;
+typedef pthread_mutex_t     sdfMutexType;
+typedef pthread_cond_t      sdfCondType;
+#define sdfMutexInit(m)     pthread_mutex_init(m, NULL)
+#define sdfMutexDestroy(m)  pthread_mutex_destroy(m)
+#define sdfLock(m)          pthread_mutex_lock(m)
+#define sdfUnlock(m)        pthread_mutex_unlock(m)
+#define sdfCondInit(c)      pthread_cond_init(c, NULL)
+#define sdfCondDestroy(c)   pthread_cond_destroy(c)
+#define sdfCondWait(c, m)   pthread_cond_wait(c, m)
+#define sdfCondBroadcast(c) pthread_cond_broadcast(c)
+#endif
+
+// SDF image of one glyph, top row first. Distance 0 maps to 128, inside is brighter. left and bottom
+// is the offset of the image from the pen position at base size, with y-axis pointing up:
+typedef struct sdfGlyphImage_t {
+    int w, h;
+    int left, bottom;
+    std::vector<GLubyte> pixels;
+} sdfGlyphImage;
+
+// Background generator of SDF glyph images for one font face. The generator thread uses its own
+// Freetype library instance, as Freetype objects must not be used from multiple threads:
+typedef struct sdfGenerator_t {
+    char fontFileName[FILENAME_MAX];
+    int faceIndex;
+    bool started;               // Generator thread is running and needs to be joined.
+    bool abort;                 // Set to ask generator thread to exit.
+    bool failed;                // Set by generator thread if it can't load the font.
+    sdfThreadType thread;
+    sdfMutexType mutex;         // Protects all of the following:
+    sdfCondType wakeup;         // Signalled to generator thread on new requests or abort.
+    sdfCondType done;           // Signalled by generator thread when a glyph image is finished.
+    std::deque<unsigned int> requests;
+    std::map<unsigned int, sdfGlyphImage> images;
+} sdfGenerator;
+
+// Placement of one glyph in the glyph atlas and its metrics:
+typedef struct glyphInfo_t {
+    bool rasterized;        // Glyph image stored in atlas? Metrics alone are also cached for pure text measurement.
+    int ax, ay, w, h;       // Position and size of glyph image in atlas, in texels. w == 0 if glyph has no image.
+    int left, bottom;       // Offset of glyph image from pen position, y-axis pointing up.
+    OGLFT::BBox bbox;       // Bounding box and advance, as computed by OGLFT's measure().
+} glyphInfo;
+
+// Cached layout of one text string: Interleaved texture coordinates and vertex positions of
+// all glyph quads relative to the start position of the text, and the text bounding box:
+typedef struct textLayout_t {
+    unsigned int timestamp;
+    unsigned int generation;    // Atlas generation at which quads were computed, 0 = no quads yet.
+    std::vector<GLfloat> quads;
+    OGLFT::BBox bbox;
+} textLayout;
+
+// Glyph atlas and text layout cache of one font cache slot:
+typedef struct glyphAtlas_t {
+    GLuint texture;
+    int width, height;
+    int penX, penY, rowHeight;
+    unsigned int generation;    // Incremented whenever texture coordinates of stored glyphs change.
+    unsigned int nowtime;
+    std::vector<GLubyte> pixels;
+    std::map<unsigned int, glyphInfo> glyphs;
+    std::map<std::vector<unsigned int>, textLayout> layouts;
+    GLuint program;             // Shader for drawing signed distance field glyphs, 0 = none yet.
+    GLint outlineLoc;
+    bool programFailed;
+} glyphAtlas;
+
 typedef struct fontCacheItem_t {
     int contextId;
     unsigned int timestamp;
@@ -119,9 +242,706 @@ typedef struct fontCacheItem_t {
     OGLFT::TranslucentTexture    *faceT;
     OGLFT::MonochromeTexture    *faceM;
     FT_Face ft_face;
+    char fontFileName[FILENAME_MAX];
+    int faceIndex;
+    glyphAtlas *atlas;
+    sdfGenerator *sdf;          // Only in signed distance field mode.
 } fontCacheItem;
 fontCacheItem cache[MAX_CACHE_SLOTS];
 
+// OpenGL 2.0 shader functions for drawing SDF glyphs, looked up at runtime, as not all
+// OpenGL libraries export them:
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+
+bool _sdfGLInitialized = false;
+GLuint (APIENTRY *_glCreateShader)(GLenum type) = NULL;
+void (APIENTRY *_glShaderSource)(GLuint shader, GLsizei count, const char** string, const GLint* length) = NULL;
+void (APIENTRY *_glCompileShader)(GLuint shader) = NULL;
+void (APIENTRY *_glGetShaderiv)(GLuint shader, GLenum pname, GLint* params) = NULL;
+void (APIENTRY *_glDeleteShader)(GLuint shader) = NULL;
+GLuint (APIENTRY *_glCreateProgram)(void) = NULL;
+void (APIENTRY *_glAttachShader)(GLuint program, GLuint shader) = NULL;
+void (APIENTRY *_glLinkProgram)(GLuint program) = NULL;
+void (APIENTRY *_glGetProgramiv)(GLuint program, GLenum pname, GLint* params) = NULL;
+void (APIENTRY *_glDeleteProgram)(GLuint program) = NULL;
+void (APIENTRY *_glUseProgram)(GLuint program) = NULL;
+GLint (APIENTRY *_glGetUniformLocation)(GLuint program, const char* name) = NULL;
+void (APIENTRY *_glUniform1i)(GLint location, GLint v0) = NULL;
+void (APIENTRY *_glUniform1f)(GLint location, GLfloat v0) = NULL;
+
+// Fragment shader for SDF glyphs: Anti-aliased edge at distance zero, with a smoothing width of about
+// one pixel at any scale, or only an outline band of the glyph of width 'OutlineWidth' if that is > 0:
+const char* _sdfFragmentShaderSource =
+    "uniform sampler2D Atlas;\n"
+    "uniform float OutlineWidth;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    float d = texture2D(Atlas, gl_TexCoord[0].st).a;\n"
+    "    float w = max(0.5 * fwidth(d), 0.001);\n"
+    "    float a = smoothstep(0.5 - w, 0.5 + w, d);\n"
+    "    if (OutlineWidth > 0.0) a -= smoothstep(0.5 + OutlineWidth - w, 0.5 + OutlineWidth + w, d);\n"
+    "    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * a);\n"
+    "}\n";
+
+static void* getGLProcAddress(const char* name)
+{
+    #if defined(_WIN32)
+        return((void*) wglGetProcAddress(name));
+    #else
+        return(dlsym(RTLD_DEFAULT, name));
+    #endif
+}
+
+// Release glyph atlas and text layout cache of font cache slot 'fi':
+void deleteGlyphAtlas(fontCacheItem* fi)
+{
+    if (!fi->atlas) return;
+
+    if (fi->atlas->texture) glDeleteTextures(1, &fi->atlas->texture);
+    if (fi->atlas->program) _glDeleteProgram(fi->atlas->program);
+    delete(fi->atlas);
+    fi->atlas = NULL;
+}
+
+static int floorDiv(int a, int b)
+{
+    return((a >= 0) ? a / b : -((b - 1 - a) / b));
+}
+
+// Squared euclidean distance transform of the sampled function f of length n into d, as
+// described by Felzenszwalb and Huttenlocher. v and z are scratch arrays of n and n + 1 elements:
+static void sdfDistanceTransform1D(const float* f, float* d, int* v, float* z, int n)
+{
+    int k = 0, q;
+    float s;
+
+    v[0] = 0;
+    z[0] = -1e20f;
+    z[1] = 1e20f;
+    for (q = 1; q < n; q++) {
+        s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * (q - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = 1e20f;
+    }
+
+    for (k = 0, q = 0; q < n; q++) {
+        while (z[k + 1] < q) k++;
+        d[q] = (float) ((q - v[k]) * (q - v[k])) + f[v[k]];
+    }
+}
+
+// In-place squared euclidean distance transform of the w x h grid, columns first, then rows:
+static void sdfDistanceTransform2D(float* grid, int w, int h)
+{
+    int n = (w > h) ? w : h;
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+    int x, y;
+
+    for (x = 0; x < w; x++) {
+        for (y = 0; y < h; y++) f[y] = grid[y * w + x];
+        sdfDistanceTransform1D(&f[0], &d[0], &v[0], &z[0], h);
+        for (y = 0; y < h; y++) grid[y * w + x] = d[y];
+    }
+
+    for (y = 0; y < h; y++) {
+        sdfDistanceTransform1D(&grid[y * w], &d[0], &v[0], &z[0], w);
+        memcpy(&grid[y * w], &d[0], w * sizeof(float));
+    }
+}
+
+// Compute SDF image 'img' of unicode character 'c' from Freetype face 'face', which must be set to
+// a pixel size of SDF_BASE_SIZE * SDF_OVERSAMPLE. The glyph is rendered at that size, then the distance
+// of each pixel to the glyph outline is computed and sampled down to base size:
+static void computeSDFGlyph(FT_Face face, unsigned int c, sdfGlyphImage* img)
+{
+    const int os = SDF_OVERSAMPLE;
+    FT_UInt glyph_index;
+    FT_Bitmap* bitmap;
+    int left, right, bottom, top, gw, gh, ox, oy, x, y, i;
+    float dist, val;
+
+    img->w = img->h = 0;
+    img->left = img->bottom = 0;
+    img->pixels.clear();
+
+    glyph_index = FT_Get_Char_Index(face, c);
+    if ((glyph_index == 0) || FT_Load_Glyph(face, glyph_index, FT_LOAD_NO_HINTING) || FT_Render_Glyph(face->glyph, ft_render_mode_normal)) return;
+
+    bitmap = &(face->glyph->bitmap);
+    if ((bitmap->width == 0) || (bitmap->rows == 0) || (bitmap->pixel_mode != FT_PIXEL_MODE_GRAY)) return;
+
+    // Grid of oversampled pixels, aligned to pixels at base size, with a border of SDF_SPREAD base pixels:
+    left = floorDiv(face->glyph->bitmap_left, os) - SDF_SPREAD;
+    right = -floorDiv(-(face->glyph->bitmap_left + (int) bitmap->width), os) + SDF_SPREAD;
+    bottom = floorDiv(face->glyph->bitmap_top - (int) bitmap->rows, os) - SDF_SPREAD;
+    top = -floorDiv(-face->glyph->bitmap_top, os) + SDF_SPREAD;
+    gw = (right - left) * os;
+    gh = (top - bottom) * os;
+    ox = face->glyph->bitmap_left - left * os;
+    oy = top * os - face->glyph->bitmap_top;
+
+    // Squared distance of each pixel outside the glyph to the glyph, and of each pixel inside to the outside:
+    std::vector<float> outside((size_t) gw * gh, 1e20f), inside((size_t) gw * gh, 0.0f);
+    for (y = 0; y < (int) bitmap->rows; y++) {
+        const unsigned char* src = bitmap->buffer + y * bitmap->pitch;
+        for (x = 0; x < (int) bitmap->width; x++) {
+            if (src[x] >= 128) {
+                i = (y + oy) * gw + x + ox;
+                outside[i] = 0.0f;
+                inside[i] = 1e20f;
+            }
+        }
+    }
+
+    sdfDistanceTransform2D(&outside[0], gw, gh);
+    sdfDistanceTransform2D(&inside[0], gw, gh);
+
+    // Sample signed distance at the center of each base size pixel, mapping [-SDF_SPREAD, SDF_SPREAD] to [1, 0]:
+    img->w = right - left;
+    img->h = top - bottom;
+    img->left = left;
+    img->bottom = bottom;
+    img->pixels.resize((size_t) img->w * img->h);
+
+    for (y = 0; y < img->h; y++) {
+        for (x = 0; x < img->w; x++) {
+            i = (y * os + os / 2) * gw + x * os + os / 2;
+            dist = (outside[i] > 0.0f) ? sqrtf(outside[i]) - 0.5f : 0.5f - sqrtf(inside[i]);
+            val = 0.5f - dist / (2.0f * os * SDF_SPREAD);
+            if (val < 0.0f) val = 0.0f;
+            if (val > 1.0f) val = 1.0f;
+            img->pixels[(size_t) y * img->w + x] = (GLubyte) (val * 255.0f + 0.5f);
+        }
+    }
+}
+
+// Main routine of the SDF generator thread: Computes glyph images on request, and otherwise
+// the glyphs in the range to pregenerate, then sleeps until new requests arrive or exit is requested:
+static void sdfGeneratorMain(sdfGenerator* gen)
+{
+    FT_Library library = NULL;
+    FT_Face face = NULL;
+    sdfGlyphImage img;
+    unsigned int c, next = SDF_PREGEN_FIRST;
+
+    if (FT_Init_FreeType(&library) || FT_New_Face(library, gen->fontFileName, gen->faceIndex, &face) ||
+        FT_Set_Pixel_Sizes(face, 0, SDF_BASE_SIZE * SDF_OVERSAMPLE)) {
+        if (_verbosity > 1) fprintf(stdout, "libptbdrawtext_ftgl: Signed distance field generator failed to load face %i from font file %s.\n", gen->faceIndex, gen->fontFileName);
+        sdfLock(&gen->mutex);
+        gen->failed = true;
+        sdfCondBroadcast(&gen->done);
+        sdfUnlock(&gen->mutex);
+        if (face) FT_Done_Face(face);
+        if (library) FT_Done_FreeType(library);
+        return;
+    }
+
+    sdfLock(&gen->mutex);
+    while (!gen->abort) {
+        if (!gen->requests.empty()) {
+            c = gen->requests.front();
+            gen->requests.pop_front();
+        }
+        else if (next <= SDF_PREGEN_LAST) {
+            c = next++;
+        }
+        else {
+            sdfCondWait(&gen->wakeup, &gen->mutex);
+            continue;
+        }
+
+        if (gen->images.find(c) != gen->images.end()) continue;
+
+        sdfUnlock(&gen->mutex);
+        computeSDFGlyph(face, c, &img);
+        sdfLock(&gen->mutex);
+
+        gen->images[c].pixels.swap(img.pixels);
+        gen->images[c].w = img.w;
+        gen->images[c].h = img.h;
+        gen->images[c].left = img.left;
+        gen->images[c].bottom = img.bottom;
+        sdfCondBroadcast(&gen->done);
+    }
+    sdfUnlock(&gen->mutex);
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI sdfGeneratorThread(LPVOID gen)
+{
+    sdfGeneratorMain((sdfGenerator*) gen);
+    return(0);
+}
+#else
+static void* sdfGeneratorThread(void* gen)
+{
+    sdfGeneratorMain((sdfGenerator*) gen);
+    return(NULL);
+}
+#endif
+
+// Start SDF glyph generator thread for the font face of font cache slot 'fi':
+void createSDFGenerator(fontCacheItem* fi)
+{
+    sdfGenerator* gen = new sdfGenerator();
+
+    strcpy(gen->fontFileName, fi->fontFileName);
+    gen->faceIndex = fi->faceIndex;
+    gen->abort = false;
+    gen->failed = false;
+    sdfMutexInit(&gen->mutex);
+    sdfCondInit(&gen->wakeup);
+    sdfCondInit(&gen->done);
+
+    #if defined(_WIN32)
+        gen->thread = CreateThread(NULL, 0, sdfGeneratorThread, (LPVOID) gen, 0, NULL);
+        gen->started = (gen->thread != NULL);
+    #else
+        gen->started = (pthread_create(&gen->thread, NULL, sdfGeneratorThread, (void*) gen) == 0);
+    #endif
+
+    if (!gen->started) {
+        if (_verbosity > 1) fprintf(stdout, "libptbdrawtext_ftgl: Failed to start signed distance field generator thread.\n");
+        gen->failed = true;
+    }
+
+    fi->sdf = gen;
+}
+
+// Stop SDF glyph generator thread of font cache slot 'fi' and release all its glyph images:
+void deleteSDFGenerator(fontCacheItem* fi)
+{
+    sdfGenerator* gen = fi->sdf;
+    if (!gen) return;
+
+    sdfLock(&gen->mutex);
+    gen->abort = true;
+    sdfCondBroadcast(&gen->wakeup);
+    sdfUnlock(&gen->mutex);
+
+    if (gen->started) {
+        #if defined(_WIN32)
+            WaitForSingleObject(gen->thread, INFINITE);
+            CloseHandle(gen->thread);
+        #else
+            pthread_join(gen->thread, NULL);
+        #endif
+    }
+
+    sdfCondDestroy(&gen->done);
+    sdfCondDestroy(&gen->wakeup);
+    sdfMutexDestroy(&gen->mutex);
+    delete(gen);
+    fi->sdf = NULL;
+}
+
+// Store rendered glyph image 'bitmap' of glyph 'g' in the atlas of 'fi'. Glyphs are packed
+// into rows of the atlas. If the atlas is full, it doubles its height, or gets cleared once it
+// reached its maximum size. Both change the texture coordinates of already stored glyphs:
+void addGlyphToAtlas(fontCacheItem* fi, glyphInfo* g, FT_Bitmap* bitmap)
+{
+    glyphAtlas* atlas = fi->atlas;
+    int r, c, maxval;
+
+    g->w = (int) bitmap->width;
+    g->h = (int) bitmap->rows;
+    if ((g->w == 0) || (g->h == 0)) {
+        g->w = 0;
+        return;
+    }
+
+    if ((g->w + 1 > atlas->width) || (g->h + 1 > GLYPH_ATLAS_MAXHEIGHT)) {
+        if (_verbosity > 1) fprintf(stdout, "libptbdrawtext_ftgl: Glyph of size %i x %i pixels is too big for the glyph atlas. Skipped.\n", g->w, g->h);
+        g->w = 0;
+        return;
+    }
+
+    // Start a new row if glyph doesn't fit into current row:
+    if (atlas->penX + g->w + 1 > atlas->width) {
+        atlas->penX = 0;
+        atlas->penY += atlas->rowHeight + 1;
+        atlas->rowHeight = 0;
+    }
+
+    // Grow or clear atlas until glyph fits below the current row:
+    while (atlas->penY + g->h + 1 > atlas->height) {
+        if (atlas->height * 2 <= GLYPH_ATLAS_MAXHEIGHT) {
+            // Grow: Content stays where it is, only texture coordinates change:
+            atlas->height *= 2;
+            atlas->pixels.resize((size_t) atlas->width * atlas->height, 0);
+        }
+        else {
+            // Clear: All glyphs need to be rasterized again when used next time:
+            if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Glyph atlas full. Clearing it.\n");
+            for (std::map<unsigned int, glyphInfo>::iterator it = atlas->glyphs.begin(); it != atlas->glyphs.end(); ++it) {
+                if (&(it->second) != g) it->second.rasterized = false;
+            }
+
+            atlas->pixels.assign(atlas->pixels.size(), 0);
+            atlas->penX = atlas->penY = atlas->rowHeight = 0;
+        }
+
+        glBindTexture(GL_TEXTURE_2D, atlas->texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, atlas->width, atlas->height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, &atlas->pixels[0]);
+        atlas->generation++;
+    }
+
+    g->ax = atlas->penX;
+    g->ay = atlas->penY;
+    atlas->penX += g->w + 1;
+    if (g->h > atlas->rowHeight) atlas->rowHeight = g->h;
+
+    // Copy into atlas, expanding 1 bpp or fewer gray levels to 8 bit alpha:
+    maxval = (bitmap->num_grays > 1) ? bitmap->num_grays - 1 : 1;
+    for (r = 0; r < g->h; r++) {
+        GLubyte* dst = &atlas->pixels[(size_t) (g->ay + r) * atlas->width + g->ax];
+        const unsigned char* src = bitmap->buffer + r * bitmap->pitch;
+        for (c = 0; c < g->w; c++) dst[c] = (GLubyte) (src[c] * 255 / maxval);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, atlas->texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, atlas->width);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, g->ax, g->ay, g->w, g->h, GL_ALPHA, GL_UNSIGNED_BYTE, &atlas->pixels[(size_t) g->ay * atlas->width + g->ax]);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+// Return glyph info for unicode character 'c' of font cache slot 'fi'. Metrics are computed
+// the same way as OGLFT's measure() does, so cached results match the uncached ones. If
+// 'rasterize' is true, the glyph image is also rendered into the atlas, if not already done,
+// which requires the OpenGL context of the slot to be bound:
+glyphInfo* getGlyph(fontCacheItem* fi, unsigned int c, bool rasterize)
+{
+    glyphAtlas* atlas = fi->atlas;
+    FT_UInt glyph_index;
+    FT_Glyph glyph;
+    FT_BBox ft_bbox;
+    FT_Bitmap bitmap;
+
+    std::map<unsigned int, glyphInfo>::iterator it = atlas->glyphs.find(c);
+    if ((it != atlas->glyphs.end()) && (it->second.rasterized || !rasterize)) return(&it->second);
+
+    bool isNew = (it == atlas->glyphs.end());
+    glyphInfo* g = &(atlas->glyphs[c]);
+
+    glyph_index = FT_Get_Char_Index(fi->ft_face, c);
+    if (glyph_index == 0) {
+        // No such glyph in font: Empty bbox, no advance, nothing to draw:
+        g->rasterized = true;
+        return(g);
+    }
+
+    if (FT_Load_Glyph(fi->ft_face, glyph_index, (fi->sdf) ? FT_LOAD_NO_HINTING : FT_LOAD_DEFAULT)) {
+        g->rasterized = true;
+        return(g);
+    }
+
+    if (isNew && !FT_Get_Glyph(fi->ft_face->glyph, &glyph)) {
+        FT_Glyph_Get_CBox(glyph, ft_glyph_bbox_unscaled, &ft_bbox);
+        FT_Done_Glyph(glyph);
+        g->bbox = ft_bbox;
+        g->bbox.advance_ = fi->ft_face->glyph->advance;
+    }
+
+    if (!rasterize) return(g);
+
+    g->rasterized = true;
+    g->w = 0;
+
+    // Signed distance field mode: Take glyph image from the generator thread, waiting for it if needed:
+    if (fi->sdf) {
+        sdfGenerator* gen = fi->sdf;
+        std::map<unsigned int, sdfGlyphImage>::iterator img;
+
+        sdfLock(&gen->mutex);
+        img = gen->images.find(c);
+        if ((img == gen->images.end()) && !gen->failed) {
+            gen->requests.push_back(c);
+            sdfCondBroadcast(&gen->wakeup);
+            while (((img = gen->images.find(c)) == gen->images.end()) && !gen->failed) sdfCondWait(&gen->done, &gen->mutex);
+        }
+
+        if ((img != gen->images.end()) && (img->second.w > 0)) {
+            memset(&bitmap, 0, sizeof(bitmap));
+            bitmap.width = img->second.w;
+            bitmap.rows = img->second.h;
+            bitmap.pitch = img->second.w;
+            bitmap.buffer = &(img->second.pixels[0]);
+            bitmap.num_grays = 256;
+            bitmap.pixel_mode = FT_PIXEL_MODE_GRAY;
+            g->left = img->second.left;
+            g->bottom = img->second.bottom;
+            addGlyphToAtlas(fi, g, &bitmap);
+        }
+        sdfUnlock(&gen->mutex);
+
+        return(g);
+    }
+
+    // Render glyph with anti-aliasing or as monochrome bitmap:
+    if (FT_Render_Glyph(fi->ft_face->glyph, (fi->faceT) ? ft_render_mode_normal : ft_render_mode_mono)) return(g);
+
+    g->left = fi->ft_face->glyph->bitmap_left;
+    g->bottom = fi->ft_face->glyph->bitmap_top - (int) fi->ft_face->glyph->bitmap.rows;
+
+    if (fi->ft_face->glyph->bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+        // Convert to 8 bpp with 1 Byte alignment:
+        FT_Bitmap_New(&bitmap);
+        if (0 == FT_Bitmap_Convert(OGLFT::Library::instance(), &(fi->ft_face->glyph->bitmap), &bitmap, 1)) addGlyphToAtlas(fi, g, &bitmap);
+        FT_Bitmap_Done(OGLFT::Library::instance(), &bitmap);
+    }
+    else {
+        addGlyphToAtlas(fi, g, &(fi->ft_face->glyph->bitmap));
+    }
+
+    return(g);
+}
+
+// Return the cached layout of the text string 'text' of length 'textLen' for font cache slot 'fi',
+// computing it on first use. If 'withQuads' is true, this also computes the glyph quads for drawing
+// the text, which requires the OpenGL context of the slot to be bound:
+textLayout* getTextLayout(fontCacheItem* fi, int textLen, double* text, bool withQuads)
+{
+    glyphAtlas* atlas;
+    textLayout* layout;
+    glyphInfo* g;
+    int i, pass;
+
+    // Create empty atlas on first use. The texture gets created once we need to store glyph images:
+    if (!fi->atlas) {
+        fi->atlas = new glyphAtlas();
+        fi->atlas->texture = 0;
+        fi->atlas->width = GLYPH_ATLAS_WIDTH;
+        fi->atlas->height = 0;
+        fi->atlas->penX = fi->atlas->penY = fi->atlas->rowHeight = 0;
+        fi->atlas->generation = 1;
+        fi->atlas->nowtime = 0;
+        fi->atlas->program = 0;
+        fi->atlas->programFailed = false;
+
+        // Make sure even the biggest glyphs of this font fit into one atlas row:
+        while ((fi->atlas->width < 4096) && (fi->atlas->width < 2 * (fi->ft_face->size->metrics.height / 64 + fi->ft_face->size->metrics.max_advance / 64)))
+            fi->atlas->width *= 2;
+    }
+
+    atlas = fi->atlas;
+    atlas->nowtime++;
+
+    std::vector<unsigned int> key(textLen);
+    for (i = 0; i < textLen; i++) key[i] = (unsigned int) text[i];
+
+    std::map<std::vector<unsigned int>, textLayout>::iterator it = atlas->layouts.find(key);
+    if (it == atlas->layouts.end()) {
+        // Not cached: Replace least recently used layout if cache is full:
+        if (atlas->layouts.size() >= MAX_LAYOUT_CACHE_SLOTS) {
+            std::map<std::vector<unsigned int>, textLayout>::iterator lru = atlas->layouts.begin();
+            for (it = atlas->layouts.begin(); it != atlas->layouts.end(); ++it) {
+                if (it->second.timestamp < lru->second.timestamp) lru = it;
+            }
+
+            atlas->layouts.erase(lru);
+        }
+
+        layout = &(atlas->layouts[key]);
+        layout->generation = 0;
+
+        // Bounding box, accumulated like OGLFT's measure() does:
+        for (i = 0; i < textLen; i++) {
+            g = getGlyph(fi, key[i], false);
+            if (i == 0) layout->bbox = g->bbox;
+            else layout->bbox += g->bbox;
+        }
+    }
+    else {
+        layout = &(it->second);
+    }
+
+    layout->timestamp = atlas->nowtime;
+    if (!withQuads || (layout->generation == atlas->generation)) return(layout);
+
+    // Need glyph quads: First make sure all glyphs are in the atlas. Repeat if the atlas
+    // had to be cleared meanwhile, so glyphs stored earlier in this pass got removed:
+    if (!atlas->texture) {
+        atlas->height = 256;
+        atlas->pixels.assign((size_t) atlas->width * atlas->height, 0);
+        glGenTextures(1, &atlas->texture);
+        glBindTexture(GL_TEXTURE_2D, atlas->texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        // Distance fields need to be interpolated when scaled, regular glyphs are drawn pixel exact:
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (fi->sdf) ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (fi->sdf) ? GL_LINEAR : GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA8, atlas->width, atlas->height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, &atlas->pixels[0]);
+    }
+
+    for (pass = 0; pass < 2; pass++) {
+        unsigned int generation = atlas->generation;
+        for (i = 0; i < textLen; i++) getGlyph(fi, (unsigned int) text[i], true);
+        if (generation == atlas->generation) break;
+
+        // Only a clear of the atlas requires a second pass, growing it keeps all glyphs:
+        for (i = 0; i < textLen; i++) {
+            if (!getGlyph(fi, (unsigned int) text[i], false)->rasterized) break;
+        }
+        if (i == textLen) break;
+    }
+
+    // Build one textured quad per glyph with an image, advancing the pen like OGLFT does:
+    const GLfloat sw = 1.0f / atlas->width, th = 1.0f / atlas->height;
+    GLfloat px = 0, py = 0;
+
+    layout->quads.clear();
+    for (i = 0; i < textLen; i++) {
+        g = getGlyph(fi, (unsigned int) text[i], false);
+        if (g->rasterized && (g->w > 0)) {
+            const GLfloat x0 = px + g->left, x1 = x0 + g->w;
+            const GLfloat y0 = py + g->bottom, y1 = y0 + g->h;
+            const GLfloat s0 = g->ax * sw, s1 = (g->ax + g->w) * sw;
+            const GLfloat t0 = (g->ay + g->h) * th, t1 = g->ay * th;
+            const GLfloat quad[16] = { s0, t0, x0, y0,  s1, t0, x1, y0,  s1, t1, x1, y1,  s0, t1, x0, y1 };
+            layout->quads.insert(layout->quads.end(), quad, quad + 16);
+        }
+
+        px += g->bbox.advance_.dx_;
+        py += g->bbox.advance_.dy_;
+    }
+
+    layout->generation = atlas->generation;
+
+    return(layout);
+}
+
+// Bind the shader for drawing SDF glyphs from the atlas of font cache slot 'fi', creating it on first
+// use. Returns false if shaders are unsupported, so glyphs can only be drawn with hard edges:
+bool useSDFShader(fontCacheItem* fi)
+{
+    glyphAtlas* atlas = fi->atlas;
+    GLuint shader;
+    GLint status;
+    double outline = 0;
+
+    if (!_sdfGLInitialized) {
+        _sdfGLInitialized = true;
+        _glCreateShader = (GLuint (APIENTRY *)(GLenum)) getGLProcAddress("glCreateShader");
+        _glShaderSource = (void (APIENTRY *)(GLuint, GLsizei, const char**, const GLint*)) getGLProcAddress("glShaderSource");
+        _glCompileShader = (void (APIENTRY *)(GLuint)) getGLProcAddress("glCompileShader");
+        _glGetShaderiv = (void (APIENTRY *)(GLuint, GLenum, GLint*)) getGLProcAddress("glGetShaderiv");
+        _glDeleteShader = (void (APIENTRY *)(GLuint)) getGLProcAddress("glDeleteShader");
+        _glCreateProgram = (GLuint (APIENTRY *)(void)) getGLProcAddress("glCreateProgram");
+        _glAttachShader = (void (APIENTRY *)(GLuint, GLuint)) getGLProcAddress("glAttachShader");
+        _glLinkProgram = (void (APIENTRY *)(GLuint)) getGLProcAddress("glLinkProgram");
+        _glGetProgramiv = (void (APIENTRY *)(GLuint, GLenum, GLint*)) getGLProcAddress("glGetProgramiv");
+        _glDeleteProgram = (void (APIENTRY *)(GLuint)) getGLProcAddress("glDeleteProgram");
+        _glUseProgram = (void (APIENTRY *)(GLuint)) getGLProcAddress("glUseProgram");
+        _glGetUniformLocation = (GLint (APIENTRY *)(GLuint, const char*)) getGLProcAddress("glGetUniformLocation");
+        _glUniform1i = (void (APIENTRY *)(GLint, GLint)) getGLProcAddress("glUniform1i");
+        _glUniform1f = (void (APIENTRY *)(GLint, GLfloat)) getGLProcAddress("glUniform1f");
+    }
+
+    if (!atlas->program && !atlas->programFailed) {
+        atlas->programFailed = true;
+        if (!_glCreateShader || !_glShaderSource || !_glCompileShader || !_glGetShaderiv || !_glDeleteShader || !_glCreateProgram || !_glAttachShader ||
+            !_glLinkProgram || !_glGetProgramiv || !_glDeleteProgram || !_glUseProgram || !_glGetUniformLocation || !_glUniform1i || !_glUniform1f) {
+            if (_verbosity > 1) fprintf(stdout, "libptbdrawtext_ftgl: OpenGL shaders unsupported. Signed distance field text will have hard edges and no outlines.\n");
+            return(false);
+        }
+
+        shader = _glCreateShader(GL_FRAGMENT_SHADER);
+        _glShaderSource(shader, 1, &_sdfFragmentShaderSource, NULL);
+        _glCompileShader(shader);
+        _glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (status) {
+            atlas->program = _glCreateProgram();
+            _glAttachShader(atlas->program, shader);
+            _glLinkProgram(atlas->program);
+            _glGetProgramiv(atlas->program, GL_LINK_STATUS, &status);
+            if (!status) {
+                _glDeleteProgram(atlas->program);
+                atlas->program = 0;
+            }
+        }
+        _glDeleteShader(shader);
+
+        if (!atlas->program) {
+            if (_verbosity > 1) fprintf(stdout, "libptbdrawtext_ftgl: Failed to create shader for signed distance field text. Text will have hard edges and no outlines.\n");
+            return(false);
+        }
+
+        atlas->programFailed = false;
+        _glUseProgram(atlas->program);
+        _glUniform1i(_glGetUniformLocation(atlas->program, "Atlas"), 0);
+        atlas->outlineLoc = _glGetUniformLocation(atlas->program, "OutlineWidth");
+    }
+
+    if (!atlas->program) return(false);
+
+    // Outline text style? Outline width in units of the encoded distance, at least 1 pixel wide:
+    if (_fontStyle & 8) {
+        outline = (SDF_OUTLINE_WIDTH * _fontSize < 1) ? 1 / _fontSize : SDF_OUTLINE_WIDTH;
+        outline = outline * SDF_BASE_SIZE / (2 * SDF_SPREAD);
+        if (outline > 0.45) outline = 0.45;
+    }
+
+    _glUseProgram(atlas->program);
+    _glUniform1f(atlas->outlineLoc, (GLfloat) outline);
+
+    return(true);
+}
+
+// Map point (x, y) of a text layout at SDF base size to the current font size and apply the affine
+// text transformation, just like Freetype transforms regular glyphs. The y-axis points up:
+void sdfTransformPoint(double x, double y, double* tx, double* ty)
+{
+    const double s = _fontSize / SDF_BASE_SIZE;
+
+    *tx = s * (_matrix.xx * x + _matrix.xy * y) / 65536.0 + _vector.x / 64.0;
+    *ty = s * (_matrix.yx * x + _matrix.yy * y) / 65536.0 + _vector.y / 64.0;
+}
+
+// Bounding box and advance of a text layout at SDF base size, mapped like by sdfTransformPoint():
+OGLFT::BBox sdfTransformBBox(const OGLFT::BBox& in)
+{
+    OGLFT::BBox out;
+    double x, y, ox, oy;
+
+    for (int i = 0; i < 4; i++) {
+        sdfTransformPoint((i & 1) ? in.x_max_ : in.x_min_, (i & 2) ? in.y_max_ : in.y_min_, &x, &y);
+        if ((i == 0) || (x < out.x_min_)) out.x_min_ = (float) x;
+        if ((i == 0) || (x > out.x_max_)) out.x_max_ = (float) x;
+        if ((i == 0) || (y < out.y_min_)) out.y_min_ = (float) y;
+        if ((i == 0) || (y > out.y_max_)) out.y_max_ = (float) y;
+    }
+
+    sdfTransformPoint(0, 0, &ox, &oy);
+    sdfTransformPoint(in.advance_.dx_, in.advance_.dy_, &x, &y);
+    out.advance_.dx_ = (float) (x - ox);
+    out.advance_.dy_ = (float) (y - oy);
+
+    return(out);
+}
+
 #ifdef _MSC_VER
 #ifdef OGLFT_BUILD
 #define OGLFT_API __declspec(dllexport)
@@ -146,6 +966,7 @@ OGLFT_API void PsychSetTextBGColor(int context, double* color);
 OGLFT_API void PsychSetTextUseFontmapper(unsigned int useMapper, unsigned int mapperFlags);
 OGLFT_API void PsychSetTextViewPort(int context, double xs, double ys, double w, double h);
 OGLFT_API int PsychDrawText(int context, double xStart, double yStart, int textLen, double* text);
+OGLFT_API int PsychDrawTexts(int context, int numStrings, double* xStart, double* yStart, int* textLens, double** texts, double* colors);
 OGLFT_API int PsychMeasureText(int context, int textLen, double* text, float* xmin, float* ymin, float* xmax, float* ymax, float* xadvance);
 OGLFT_API void PsychSetTextVerbosity(unsigned int verbosity);
 OGLFT_API void PsychSetTextAntiAliasing(int context, int antiAliasing);
@@ -181,10 +1002,15 @@ fontCacheItem* getForContext(int contextId)
             // and the real effective fontRealName that libfontconfig actually gave us. Otherwise, as fontRealName
             // is returned to Screen(), we could get into a funny loop which causes false cache misses if the loaded font
             // doesn't match exactly the required one.
-            if ((fi->antiAliasing == _antiAliasing) && (fi->fontStyle == _fontStyle) && (fi->fontSize == _fontSize) &&
+            // In signed distance field mode, size and transformation are applied at draw time, and the outline
+            // style only selects the shader, so one slot serves them all:
+            if ((fi->antiAliasing == _antiAliasing) &&
                 ((strcmp(fi->fontName, _fontName) == 0) || (strcmp(fi->fontRealName, _fontName) == 0)) &&
-                (fi->matrix.xx == _matrix.xx && fi->matrix.xy == _matrix.xy && fi->matrix.yx == _matrix.yx && fi->matrix.yy == _matrix.yy &&
-                 fi->vector.x == _vector.x && fi->vector.y == _vector.y)) {
+                ((_antiAliasing == TEXT_ANTIALIASING_SDF && _useOwnFontmapper) ? ((fi->fontStyle & ~8) == (_fontStyle & ~8)) : (fi->fontStyle == _fontStyle)) &&
+                ((_antiAliasing == TEXT_ANTIALIASING_SDF) ||
+                 ((fi->fontSize == _fontSize) &&
+                  fi->matrix.xx == _matrix.xx && fi->matrix.xy == _matrix.xy && fi->matrix.yx == _matrix.yx && fi->matrix.yy == _matrix.yy &&
+                  fi->vector.x == _vector.x && fi->vector.y == _vector.y))) {
                 // Match! We have cached OGLFT font objects for this font on this context. Return them:
                 hitcount++;
 
@@ -257,7 +1083,10 @@ int PsychRebuildFont(fontCacheItem* fi)
     int faceIndex = 0;
     char fontFileName[FILENAME_MAX] = { 0 };
 
-    // Destroy old font object, if any:
+    // Destroy old glyph atlas, distance field generator and font object, if any:
+    deleteGlyphAtlas(fi);
+    deleteSDFGenerator(fi);
+
     if (fi->faceT || fi->faceM) {
         // Delete OGLFT face object:
         if (fi->faceT) delete(fi->faceT);
@@ -292,7 +1121,7 @@ int PsychRebuildFont(fontCacheItem* fi)
             target = FcPatternBuild (0, FC_FAMILY, FcTypeString, _fontName, FC_PIXEL_SIZE, FcTypeDouble, _fontSize,
                                      FC_WEIGHT, FcTypeInteger, ((_fontStyle & 1) ? FC_WEIGHT_BOLD : FC_WEIGHT_NORMAL),
                                      FC_SLANT, FcTypeInteger, ((_fontStyle & 2) ?  FC_SLANT_ITALIC : FC_SLANT_ROMAN),
-                                     FC_OUTLINE, FcTypeBool, ((_fontStyle & 8) ? true : false),
+                                     FC_OUTLINE, FcTypeBool, (((_fontStyle & 8) && (_antiAliasing != TEXT_ANTIALIASING_SDF)) ? true : false),
                                      FC_WIDTH, FcTypeInteger, ( (_fontStyle & 32) ?  FC_WIDTH_CONDENSED : ((_fontStyle & 64) ?  FC_WIDTH_EXPANDED : FC_WIDTH_NORMAL) ),
                                      FC_DPI, FcTypeDouble, (double) 72.0,
                                      FC_SCALABLE, FcTypeBool, true,
@@ -387,12 +1216,16 @@ int PsychRebuildFont(fontCacheItem* fi)
         if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Freetype loaded face %p with index %i from font file %s.\n", fi->ft_face, faceIndex, fontFileName);
     }
 
-    // Apply affine transformations, if any:
-    FT_Set_Transform(fi->ft_face, &_matrix, &_vector);
+    strcpy(fi->fontFileName, fontFileName);
+    fi->faceIndex = faceIndex;
 
-    // Create FTGL face from Freetype face with given size and a 72 DPI resolution, aka _fontSize == pixelsize:
+    // Apply affine transformations, if any. In signed distance field mode they are applied at draw time instead:
+    FT_Set_Transform(fi->ft_face, (_antiAliasing == TEXT_ANTIALIASING_SDF) ? NULL : &_matrix, (_antiAliasing == TEXT_ANTIALIASING_SDF) ? NULL : &_vector);
+
+    // Create FTGL face from Freetype face with given size and a 72 DPI resolution, aka _fontSize == pixelsize.
+    // Distance field glyphs always have base size and get scaled to the requested size at draw time:
     if (_antiAliasing != 0) {
-        fi->faceT = new OGLFT::TranslucentTexture(fi->ft_face, _fontSize, 72);
+        fi->faceT = new OGLFT::TranslucentTexture(fi->ft_face, (_antiAliasing == TEXT_ANTIALIASING_SDF) ? SDF_BASE_SIZE : _fontSize, 72);
         // Test the created face to make sure it will work correctly:
         if (!fi->faceT->isValid()) {
             if (_verbosity > 1) fprintf(stdout, "libptbdrawtext_ftgl: Freetype did not recognize %s as a font file.\n", _fontName);
@@ -420,6 +1253,9 @@ int PsychRebuildFont(fontCacheItem* fi)
         fi->faceM->setAdvance(true);
     }
 
+    // Start generating distance field glyphs in the background:
+    if (_antiAliasing == TEXT_ANTIALIASING_SDF) createSDFGenerator(fi);
+
     // Ready!
     return(0);
 }
@@ -517,6 +1353,7 @@ void PsychGetTextCursor(int context, double* xp, double* yp, double* height)
         // constructor execution. We can directly access the scaled font
         // info from the underlying FT_FACE.
         *height = fi->ft_face->size->metrics.height / 64.;
+        if (fi->sdf) *height *= _fontSize / SDF_BASE_SIZE;
     }
     else {
         *height = 0;
@@ -535,10 +1372,10 @@ const char* PsychGetTextFont(int context)
 
 int PsychDrawText(int context, double xStart, double yStart, int textLen, double* text)
 {
-    int i;
     GLuint ti;
-    QChar* myUniChars;
-    GLdouble modelview[4][4];
+    textLayout* layout;
+    OGLFT::BBox bbox;
+    bool sdfShader = false;
 
     // On first invocation after init we need to generate a useless texture object.
     // This is a weird workaround for some weird bug somewhere in FTGL...
@@ -552,20 +1389,15 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     fontCacheItem *fi = getForContext(context);
     if (!fi) return(1);
 
-    // Synthesize Unicode QString from double vector:
-    myUniChars = new QChar[textLen];
-    for(i = 0; i < textLen; i++) {
-        myUniChars[i] = QChar((unsigned int) text[i]);
-    }
-
-    QString uniCodeText = QString(myUniChars, textLen);
-    delete [] myUniChars;
-
     glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
     glPushAttrib(GL_ALL_ATTRIB_BITS);
-    glPixelStorei( GL_UNPACK_ALIGNMENT, 1);
+
+    // Get cached layout of the text, storing glyphs not yet in the glyph atlas:
+    layout = getTextLayout(fi, textLen, text, true);
+    bbox = (fi->sdf) ? sdfTransformBBox(layout->bbox) : layout->bbox;
+
     glEnable( GL_TEXTURE_2D );
-    glTexEnvf( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE );
+    glTexEnvf( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE );
 
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
@@ -578,21 +1410,11 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     glScaled(1., -1., 1.);
     glTranslated(0, -yStart, 0.);
 
-    // Set text color: This will be filtered by OGLFT for redundant settings:
-    if (fi->faceT) {
-        fi->faceT->setForegroundColor( _fgcolor[0], _fgcolor[1], _fgcolor[2], _fgcolor[3]);
-    }
-    else {
-        fi->faceM->setForegroundColor( _fgcolor[0], _fgcolor[1], _fgcolor[2], _fgcolor[3]);
-    }
-
     // Rendering of background quad requested? -- True if background alpha > 0.
     if (_bgcolor[3] > 0) {
-        // Yes. Compute bounding box of "to be drawn" text and render a quad in background color:
-        float xmin, ymin, xmax, ymax, xadvance;
-        PsychMeasureText(context, textLen, text, &xmin, &ymin, &xmax, &ymax, &xadvance);
+        // Yes. Render a quad in background color with the bounding box of "to be drawn" text:
         glColor4fv(&(_bgcolor[0]));
-        glRectf(xmin + xStart, ymin + yStart, xmax + xStart, ymax + yStart);
+        glRectf(bbox.x_min_ + xStart, bbox.y_min_ + yStart, bbox.x_max_ + xStart, bbox.y_max_ + yStart);
     }
 
     // Enable alpha-test against an alpha-value greater zero during draw.
@@ -600,20 +1422,43 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     glEnable(GL_ALPHA_TEST);
     glAlphaFunc(GL_GREATER, 0);
 
-    // Draw the text at selected start location:
-    glPushMatrix();
-    if (fi->faceT) {
-        fi->faceT->draw(xStart, yStart, uniCodeText);
-    }
-    else {
-        fi->faceM->draw(xStart, yStart, uniCodeText);
+    // Draw all glyph quads of the text at selected start location in one go. The atlas
+    // only stores glyph coverage as alpha, the text color is applied by modulation:
+    if (!layout->quads.empty()) {
+        glColor4fv(&(_fgcolor[0]));
+        glBindTexture(GL_TEXTURE_2D, fi->atlas->texture);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &(layout->quads[0]));
+        glVertexPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), &(layout->quads[2]));
+
+        glTranslated(xStart, yStart, 0.);
+
+        if (fi->sdf) {
+            // Scale distance field glyphs from base size to font size and apply the text transformation.
+            // Without shader support, threshold the distance field to get at least hard edged glyphs:
+            GLdouble m[16] = { 1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1 };
+            sdfTransformPoint(0, 0, &m[12], &m[13]);
+            sdfTransformPoint(1, 0, &m[0], &m[1]);
+            sdfTransformPoint(0, 1, &m[4], &m[5]);
+            m[0] -= m[12]; m[1] -= m[13];
+            m[4] -= m[12]; m[5] -= m[13];
+            glMultMatrixd(m);
+
+            sdfShader = useSDFShader(fi);
+            if (!sdfShader) glAlphaFunc(GL_GEQUAL, 0.5);
+        }
+
+        glDrawArrays(GL_QUADS, 0, (GLsizei) (layout->quads.size() / 4));
+        if (sdfShader) _glUseProgram(0);
     }
 
-    // Extract final text cursor position from GL_MODELVIEW matrix:
-    glGetDoublev(GL_MODELVIEW_MATRIX, &(modelview[0][0]));
-    _xp = modelview[3][0];
-    _yp = modelview[3][1];
-    glPopMatrix();
+    // Final text cursor position, as it would result from advancing the
+    // GL_MODELVIEW matrix glyph by glyph in our flipped coordinate system:
+    _xp = xStart + bbox.advance_.dx_;
+    _yp = yStart - bbox.advance_.dy_;
 
     // Disable alpha test after blit:
     glDisable(GL_ALPHA_TEST);
@@ -630,39 +1475,172 @@ int PsychDrawText(int context, double xStart, double yStart, int textLen, double
     return(0);
 }
 
-int PsychMeasureText(int context, int textLen, double* text, float* xmin, float* ymin, float* xmax, float* ymax, float* xadvance)
+int PsychDrawTexts(int context, int numStrings, double* xStart, double* yStart, int* textLens, double** texts, double* colors)
 {
-    int i;
-    QChar* myUniChars;
+    GLuint ti;
+    GLfloat color[4];
+    textLayout* layout;
+    OGLFT::BBox bbox;
+    std::vector<GLfloat> batch, bgRects;
+    unsigned int generation = 0;
+    bool sdfShader = false;
+    double tx, ty;
+    size_t j;
+    int i, pass;
+
+    // On first invocation after init we need to generate a useless texture object.
+    // This is a weird workaround for some weird bug somewhere in FTGL...
+    if (_firstCall) {
+        _firstCall = false;
+        glGenTextures(1, &ti);
+    }
 
     // Check if rebuild of font face needed due to parameter
     // change. Reload/Rebuild font face if so, check for errors:
     fontCacheItem *fi = getForContext(context);
     if (!fi) return(1);
 
-    // Synthesize Unicode QString from double vector:
-    myUniChars = new QChar[textLen];
-    for(i = 0; i < textLen; i++) {
-        myUniChars[i] = QChar((unsigned int) text[i]);
+    if (numStrings < 1) return(0);
+
+    glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+    // Collect the glyph quads of all strings into one vertex array with final window positions and
+    // per-vertex color. Storing glyphs of a later string can grow or clear the glyph atlas, which
+    // invalidates texture coordinates of already collected strings. Collect again if that happened:
+    for (pass = 0; pass < 2; pass++) {
+        batch.clear();
+        bgRects.clear();
+
+        for (i = 0; i < numStrings; i++) {
+            layout = getTextLayout(fi, textLens[i], texts[i], true);
+            if (i == 0) generation = layout->generation;
+
+            for (j = 0; j < 4; j++) color[j] = (colors) ? (GLfloat) colors[i * 4 + j] : _fgcolor[j];
+            bbox = (fi->sdf) ? sdfTransformBBox(layout->bbox) : layout->bbox;
+
+            // Glyph quads are laid out with y-axis pointing up, our window coordinates have top-left origin.
+            // Distance field glyphs get scaled from base size to font size and transformed on the way:
+            for (j = 0; j < layout->quads.size(); j += 4) {
+                tx = layout->quads[j + 2];
+                ty = layout->quads[j + 3];
+                if (fi->sdf) sdfTransformPoint(tx, ty, &tx, &ty);
+
+                const GLfloat v[8] = { layout->quads[j], layout->quads[j + 1],
+                                       (GLfloat) (xStart[i] + tx), (GLfloat) (yStart[i] - ty),
+                                       color[0], color[1], color[2], color[3] };
+                batch.insert(batch.end(), v, v + 8);
+            }
+
+            if (_bgcolor[3] > 0) {
+                const GLfloat r[4] = { (GLfloat) (xStart[i] + bbox.x_min_), (GLfloat) (yStart[i] - bbox.y_max_),
+                                       (GLfloat) (xStart[i] + bbox.x_max_), (GLfloat) (yStart[i] - bbox.y_min_) };
+                bgRects.insert(bgRects.end(), r, r + 4);
+            }
+
+            _xp = xStart[i] + bbox.advance_.dx_;
+            _yp = yStart[i] - bbox.advance_.dy_;
+        }
+
+        if (generation == fi->atlas->generation) break;
     }
 
-    QString uniCodeText = QString(myUniChars, textLen);
-    delete [] myUniChars;
+    // Still not consistent, because all glyphs of the batch don't fit into the atlas at once?
+    // Draw string by string then, each string only needs its own glyphs:
+    if (pass == 2) {
+        if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Glyphs of text batch exceed glyph atlas. Drawing strings one by one.\n");
+
+        glPopAttrib();
+        glPopClientAttrib();
+
+        memcpy(color, _fgcolor, sizeof(color));
+        for (i = 0; i < numStrings; i++) {
+            if (colors) for (j = 0; j < 4; j++) _fgcolor[j] = (GLfloat) colors[i * 4 + j];
+            if (PsychDrawText(context, xStart[i], yStart[i], textLens[i], texts[i])) break;
+        }
+        memcpy(_fgcolor, color, sizeof(color));
+
+        return((i < numStrings) ? 1 : 0);
+    }
 
-    // Compute its bounding box:
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(_vxs, _vxs + _vw, _vys + _vh, _vys);
+    glMatrixMode(GL_MODELVIEW);
     glPushMatrix();
-    OGLFT::BBox box = (fi->faceT) ? fi->faceT->measure(uniCodeText) : fi->faceM->measure(uniCodeText);
+
+    // Rendering of background quads requested? -- True if background alpha > 0.
+    if (_bgcolor[3] > 0) {
+        glColor4fv(&(_bgcolor[0]));
+        for (j = 0; j < bgRects.size(); j += 4) glRectf(bgRects[j], bgRects[j + 1], bgRects[j + 2], bgRects[j + 3]);
+    }
+
+    // Enable alpha-test against an alpha-value greater zero during draw.
+    // This way, non-text pixels (with alpha equal to zero) are discarded.
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0);
+
+    // Draw all glyph quads of all strings in one go:
+    if (!batch.empty()) {
+        glEnable( GL_TEXTURE_2D );
+        glTexEnvf( GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE );
+        glBindTexture(GL_TEXTURE_2D, fi->atlas->texture);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, 8 * sizeof(GLfloat), &batch[0]);
+        glVertexPointer(2, GL_FLOAT, 8 * sizeof(GLfloat), &batch[2]);
+        glColorPointer(4, GL_FLOAT, 8 * sizeof(GLfloat), &batch[4]);
+
+        if (fi->sdf) {
+            sdfShader = useSDFShader(fi);
+            if (!sdfShader) glAlphaFunc(GL_GEQUAL, 0.5);
+        }
+
+        glDrawArrays(GL_QUADS, 0, (GLsizei) (batch.size() / 8));
+        if (sdfShader) _glUseProgram(0);
+        glDisable( GL_TEXTURE_2D );
+    }
+
+    // Disable alpha test after blit:
+    glDisable(GL_ALPHA_TEST);
+
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
     glPopMatrix();
+    glPopAttrib();
+    glPopClientAttrib();
+
+    // Ready!
+    return(0);
+}
+
+int PsychMeasureText(int context, int textLen, double* text, float* xmin, float* ymin, float* xmax, float* ymax, float* xadvance)
+{
+    textLayout* layout;
+    OGLFT::BBox bbox;
 
-    *xmin = box.x_min_;
-    *ymin = box.y_min_;
-    *xmax = box.x_max_;
-    *ymax = box.y_max_;
+    // Check if rebuild of font face needed due to parameter
+    // change. Reload/Rebuild font face if so, check for errors:
+    fontCacheItem *fi = getForContext(context);
+    if (!fi) return(1);
+
+    // Get its bounding box from the layout cache. This doesn't need to render any glyphs:
+    layout = getTextLayout(fi, textLen, text, false);
+    bbox = (fi->sdf) ? sdfTransformBBox(layout->bbox) : layout->bbox;
+
+    *xmin = bbox.x_min_;
+    *ymin = bbox.y_min_;
+    *xmax = bbox.x_max_;
+    *ymax = bbox.y_max_;
 
     // xadvance = How far to horizontally advance the x text
     // drawing cursor position after drawing the text string:
     // newXPos = oldXPos + xadvance
-    *xadvance = box.advance_.dx_;
+    *xadvance = bbox.advance_.dx_;
 
     return(0);
 }
@@ -719,6 +1697,9 @@ int PsychShutdownText(int context)
                     if (fi->ft_face) FT_Done_Face(fi->ft_face);
                     fi->ft_face = NULL;
                 }
+
+                deleteGlyphAtlas(fi);
+                deleteSDFGenerator(fi);
             }
         }
 
@@ -729,6 +1710,9 @@ int PsychShutdownText(int context)
     if (_verbosity > 5) fprintf(stdout, "libptbdrawtext_ftgl: Shutting down. Overall cache hit ratio was %f%%\n", (double) hitcount / (double) nowtime * 100);
     _firstCall = false;
 
+    // Stop all remaining distance field generator threads before we get unloaded:
+    for (int i = 0; i < MAX_CACHE_SLOTS; i++) deleteSDFGenerator(&cache[i]);
+
     // Shutdown fontmapper library:
     // Actually, don't! Some versions of octave also use fontconfig internally, and there is only
     // one shared library instance in the process. Calling FcFini() here will shutdown that instance
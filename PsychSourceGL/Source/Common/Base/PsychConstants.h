@@ -58,10 +58,20 @@
 #endif
 
 #if PSYCH_LANGUAGE == PSYCH_PYTHON
+    // Printing wrappers around PySys_WriteStdout/Stderr, which are safe to use
+    // within blocking sections, see PsychEnterBlockingSection(). Declared as printf-like
+    // functions on gcc and clang, so format string checking still works for printf():
+    #if defined(__GNUC__) || defined(__clang__)
+    void PsychPyWriteStdout(const char* format, ...) __attribute__((format(printf, 1, 2)));
+    void PsychPyWriteStderr(const char* format, ...) __attribute__((format(printf, 1, 2)));
+    #else
+    void PsychPyWriteStdout(const char* format, ...);
+    void PsychPyWriteStderr(const char* format, ...);
+    #endif
     #undef printf
-    #define printf PySys_WriteStdout
+    #define printf PsychPyWriteStdout
     #undef fprintf
-    #define fprintf(fdignore, ...) PySys_WriteStderr(__VA_ARGS__)
+    #define fprintf(fdignore, ...) PsychPyWriteStderr(__VA_ARGS__)
 #endif
 
 //platform dependent macro defines
@@ -75,8 +85,13 @@
     #ifdef _MSC_VER
     #define strdup _strdup
     #endif
+
+    // Storage class for thread local variables:
+    #define PSYCH_THREAD_LOCAL __declspec(thread)
 #elif PSYCH_SYSTEM == PSYCH_OSX
+    #define PSYCH_THREAD_LOCAL __thread
 #elif PSYCH_SYSTEM == PSYCH_LINUX
+    #define PSYCH_THREAD_LOCAL __thread
 #endif
 
 #ifndef FALSE
@@ -42,6 +42,8 @@ PsychError PsychInit(void)
     InitPsychError();
     InitPsychAuthorList();
     PsychInitTimeGlue();
+    PsychInitInstrument();
+    PsychInitThreadPool();
 
     // Registration of the Psychtoolbox exit function is
     // done in PsychScriptingGlueXXX.c because how that is done is
@@ -67,6 +69,8 @@ PsychError PsychExit(void)
     if (projectExit != NULL) (*projectExit)();
 
     // Put whatever cleanup of the Psychtoolbox is required here.
+    PsychExitThreadPool();
+    PsychExitInstrument();
     PsychExitTimeGlue();
 
     // Reset / Clear function and module name registry:
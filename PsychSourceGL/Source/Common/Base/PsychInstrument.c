@@ -11,14 +11,103 @@
   3/18/04  awi		Created. 
  
   
+  DESCRIPTION:
+
+  Instrumentation helpers. Apart from the trivial PsychPushClock/PsychPopClock
+  pair, this implements a low-overhead event tracer:
+
+  Every thread which records a trace event gets its own preallocated ring
+  buffer of events on first use. Only the owning thread ever writes into its
+  buffer, so recording is lock-free and allocation-free after the first event.
+  The shared traceMutex is only taken when a thread registers its buffer and
+  when buffers are enumerated for export or cleared.
+
+  Realtime threads, e.g., audio callbacks, mark themselves via
+  PsychTraceSetThreadRealtime(). They never allocate, but only claim one of the
+  spare buffers which modules preallocate from their main thread via
+  PsychTraceReserveBuffers(), and only via a trylock of traceMutex. If no spare
+  buffer is available, their events are dropped.
+
+  Export is in the Chrome trace event "JSON Array Format", with the closing
+  bracket omitted, as allowed by that format. This way multiple modules, e.g.,
+  Screen, PsychPortAudio and PsychHID, can append their events to the same
+  trace file, and as all timestamps are GetSecs() timestamps, the file shows
+  one consistent timeline across all threads and modules when loaded into
+  chrome://tracing or https://ui.perfetto.dev
+
+  Tracing is disabled by default and costs one flag test per trace point then.
+  It can be controlled via Modulename('TraceControl'), or by the environment
+  variables PSYCH_TRACE (enable at module init), PSYCH_TRACE_FILE (append
+  recorded events to this file at module shutdown) and PSYCH_TRACE_BUFFERSIZE
+  (ring buffer capacity in events per thread, default 65536).
+
 */
 
 
 #include "Psych.h"
 
+#if PSYCH_SYSTEM == PSYCH_LINUX
+#include <sys/syscall.h>
+#endif
+
+#if PSYCH_SYSTEM != PSYCH_WINDOWS
+#include <unistd.h>
+#endif
+
+// Store barrier for publishing new events:
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+#define PsychTraceStoreBarrier() MemoryBarrier()
+#else
+#define PsychTraceStoreBarrier() __sync_synchronize()
+#endif
+
+// Atomic add, returning the previous value, for counting threads inside PsychTraceRecord():
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+#define PsychTraceAtomicAdd(p, v) InterlockedExchangeAdd((volatile LONG*) (p), (v))
+#else
+#define PsychTraceAtomicAdd(p, v) __sync_fetch_and_add((p), (v))
+#endif
+
+#define PSYCH_TRACE_DEFAULT_CAPACITY 65536
+#define PSYCH_TRACE_MAX_THREADNAME 64
+
+typedef struct PsychTraceEvent {
+    double          timestamp;      // GetSecs() time of event, or of begin of a 'X' complete event.
+    double          value;          // Duration for 'X' events, value for 'C' counter events.
+    const char*     name;           // Persistent name string.
+    char            phase;          // Chrome trace event phase: 'B', 'E', 'X', 'i' or 'C'.
+} PsychTraceEvent;
+
+typedef struct PsychTraceBuffer {
+    struct PsychTraceBuffer*    next;
+    PsychTraceEvent*            events;
+    psych_uint64                capacity;
+    volatile psych_uint64       count;      // Total number of events ever written. Only written by owner thread.
+    volatile psych_uint64       start;      // Value of count at last clear. Only written under traceMutex.
+    psych_uint64                tid;
+    char                        threadName[PSYCH_TRACE_MAX_THREADNAME];
+} PsychTraceBuffer;
 
 static double instrumentTime;
 
+static volatile psych_bool traceEnabled = FALSE;
+static volatile long traceWriters = 0;
+static psych_bool traceInitialized = FALSE;
+static int traceGeneration = 0;
+static psych_uint64 traceCapacity = PSYCH_TRACE_DEFAULT_CAPACITY;
+static PsychTraceBuffer* traceBufferList = NULL;
+static PsychTraceBuffer* traceSpareList = NULL;
+static int traceSpareCount = 0;
+static int traceSpareTarget = 0;
+static psych_mutex traceMutex;
+
+static PSYCH_THREAD_LOCAL PsychTraceBuffer* traceBuffer = NULL;
+static PSYCH_THREAD_LOCAL int traceBufferGeneration = 0;
+static PSYCH_THREAD_LOCAL psych_bool traceThreadRealtime = FALSE;
+
+static void PsychTraceAllocSpareBuffers(void);
+static PSYCH_THREAD_LOCAL char traceThreadName[PSYCH_TRACE_MAX_THREADNAME];
+
 void	PsychPushClock(void)
 {
 	PsychGetPrecisionTimerSeconds(&instrumentTime);
@@ -31,7 +120,501 @@ double  PsychPopClock(void)
 	return(instrumentTime);
 }
 
+// Return an OS level numeric id for the calling thread, as used by debuggers and profilers.
+// The id is cached per thread, so this is cheap enough to call for each recorded sample:
+psych_uint64 PsychTraceGetOSThreadId(void)
+{
+    static PSYCH_THREAD_LOCAL psych_uint64 tid = 0;
+
+    if (tid == 0) {
+        #if PSYCH_SYSTEM == PSYCH_LINUX
+            tid = (psych_uint64) syscall(SYS_gettid);
+        #elif PSYCH_SYSTEM == PSYCH_OSX
+            uint64_t ostid = 0;
+            pthread_threadid_np(NULL, &ostid);
+            tid = (psych_uint64) ostid;
+        #else
+            tid = (psych_uint64) GetCurrentThreadId();
+        #endif
+    }
+
+    return(tid);
+}
+
+static psych_uint64 PsychTraceGetProcessId(void)
+{
+    #if PSYCH_SYSTEM == PSYCH_WINDOWS
+        return((psych_uint64) GetCurrentProcessId());
+    #else
+        return((psych_uint64) getpid());
+    #endif
+}
+
+// Stop recording, and wait for threads which are already inside PsychTraceRecord() to finish
+// writing their event, so the ring buffers can be safely exported or released afterwards:
+static void PsychTraceQuiesce(void)
+{
+    traceEnabled = FALSE;
+    PsychTraceStoreBarrier();
+
+    while (PsychTraceAtomicAdd(&traceWriters, 0) > 0)
+        PsychYieldIntervalSeconds(0);
+}
+
+void PsychInitInstrument(void)
+{
+    char* env;
+
+    if (traceInitialized)
+        return;
+
+    PsychInitMutex(&traceMutex);
+    traceBufferList = NULL;
+    traceSpareList = NULL;
+    traceSpareCount = 0;
+    traceSpareTarget = 0;
+    traceGeneration++;
+
+    traceCapacity = PSYCH_TRACE_DEFAULT_CAPACITY;
+    if ((env = getenv("PSYCH_TRACE_BUFFERSIZE")) && (atoi(env) > 0))
+        traceCapacity = (psych_uint64) atoi(env);
+
+    traceEnabled = (getenv("PSYCH_TRACE") && (atoi(getenv("PSYCH_TRACE")) > 0)) ? TRUE : FALSE;
+    traceInitialized = TRUE;
+}
+
+void PsychExitInstrument(void)
+{
+    PsychTraceBuffer *buffer, *next;
+    char* env;
+
+    if (!traceInitialized)
+        return;
+
+    PsychTraceQuiesce();
+
+    // Auto-dump of all recorded events at module shutdown requested?
+    if ((env = getenv("PSYCH_TRACE_FILE")) && (strlen(env) > 0) && (PsychTraceGetNumEvents() > 0))
+        PsychTraceDumpToFile(env);
+
+    // Bump generation, so threads which survive this shutdown notice their
+    // thread local buffer pointer is stale and allocate a new buffer:
+    PsychLockMutex(&traceMutex);
+    traceGeneration++;
+    for (buffer = traceBufferList; buffer; buffer = next) {
+        next = buffer->next;
+        free(buffer->events);
+        free(buffer);
+    }
+    traceBufferList = NULL;
+
+    for (buffer = traceSpareList; buffer; buffer = next) {
+        next = buffer->next;
+        free(buffer->events);
+        free(buffer);
+    }
+    traceSpareList = NULL;
+    traceSpareCount = 0;
+    PsychUnlockMutex(&traceMutex);
+
+    PsychDestroyMutex(&traceMutex);
+    traceInitialized = FALSE;
+}
+
+psych_bool PsychTraceIsEnabled(void)
+{
+    return(traceEnabled);
+}
+
+void PsychTraceSetEnabled(psych_bool enable)
+{
+    if (enable && traceInitialized) {
+        // Spare buffers for realtime threads are only allocated while tracing is enabled:
+        PsychLockMutex(&traceMutex);
+        PsychTraceAllocSpareBuffers();
+        PsychUnlockMutex(&traceMutex);
+        traceEnabled = TRUE;
+    }
+    else if (traceInitialized)
+        PsychTraceQuiesce();
+    else
+        traceEnabled = FALSE;
+}
+
+// Return the current GetSecs() time if tracing is enabled, zero otherwise. Meant
+// for taking the start time of a PsychTraceComplete() span:
+double PsychTraceTimestamp(void)
+{
+    double now;
+
+    if (!traceEnabled)
+        return(0);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&now);
+    return(now);
+}
+
+static PsychTraceBuffer* PsychTraceAllocBuffer(void)
+{
+    PsychTraceBuffer* buffer;
+
+    buffer = (PsychTraceBuffer*) calloc(1, sizeof(PsychTraceBuffer));
+    if (!buffer)
+        return(NULL);
 
+    buffer->events = (PsychTraceEvent*) malloc((size_t) traceCapacity * sizeof(PsychTraceEvent));
+    if (!buffer->events) {
+        free(buffer);
+        return(NULL);
+    }
 
+    buffer->capacity = traceCapacity;
 
+    return(buffer);
+}
+
+// Allocate spare buffers for realtime threads up to traceSpareTarget. Called with traceMutex held:
+static void PsychTraceAllocSpareBuffers(void)
+{
+    PsychTraceBuffer* buffer;
+
+    while ((traceSpareCount < traceSpareTarget) && (buffer = PsychTraceAllocBuffer())) {
+        buffer->next = traceSpareList;
+        traceSpareList = buffer;
+        traceSpareCount++;
+    }
+}
+
+// Make sure at least 'count' spare buffers are available for realtime threads while tracing is
+// enabled, e.g., one per audio stream of PsychPortAudio. Must be called from a non-realtime thread:
+void PsychTraceReserveBuffers(int count)
+{
+    if (!traceInitialized)
+        return;
+
+    PsychLockMutex(&traceMutex);
+    traceSpareTarget = count;
+    if (traceEnabled) PsychTraceAllocSpareBuffers();
+    PsychUnlockMutex(&traceMutex);
+}
+
+// Mark the calling thread as realtime thread, which must never allocate or block for recording events:
+void PsychTraceSetThreadRealtime(void)
+{
+    traceThreadRealtime = TRUE;
+}
+
+// Return the calling threads trace buffer, creating and registering it on first use. Realtime
+// threads only claim a spare buffer, and return NULL if that is not possible without blocking:
+static PsychTraceBuffer* PsychTraceGetBuffer(void)
+{
+    PsychTraceBuffer* buffer = NULL;
+
+    if (traceBuffer && (traceBufferGeneration == traceGeneration))
+        return(traceBuffer);
+
+    if (traceThreadRealtime) {
+        if (PsychTryLockMutex(&traceMutex))
+            return(NULL);
+    }
+    else {
+        PsychLockMutex(&traceMutex);
+    }
+
+    if ((buffer = traceSpareList)) {
+        traceSpareList = buffer->next;
+        traceSpareCount--;
+    }
+    else if (!traceThreadRealtime) {
+        // Allocation is too slow to hold the lock, but a non-realtime thread can afford to block:
+        PsychUnlockMutex(&traceMutex);
+        buffer = PsychTraceAllocBuffer();
+        PsychLockMutex(&traceMutex);
+    }
+
+    if (!buffer) {
+        PsychUnlockMutex(&traceMutex);
+        return(NULL);
+    }
+
+    buffer->tid = PsychTraceGetOSThreadId();
+    snprintf(buffer->threadName, sizeof(buffer->threadName), "%s", traceThreadName);
+    buffer->next = traceBufferList;
+    traceBufferList = buffer;
+    traceBufferGeneration = traceGeneration;
+    PsychUnlockMutex(&traceMutex);
+
+    traceBuffer = buffer;
+
+    return(buffer);
+}
 
+static void PsychTraceRecord(char phase, const char* name, double timestamp, double value)
+{
+    PsychTraceBuffer* buffer;
+    PsychTraceEvent* event;
+    psych_uint64 count;
+
+    if (!traceEnabled)
+        return;
+
+    // Announce ourselves as writer before checking traceEnabled again, so PsychTraceQuiesce()
+    // either sees us and waits, or we see tracing disabled and back off:
+    PsychTraceAtomicAdd(&traceWriters, 1);
+    if (!traceEnabled || !(buffer = PsychTraceGetBuffer())) {
+        PsychTraceAtomicAdd(&traceWriters, -1);
+        return;
+    }
+
+    count = buffer->count;
+    event = &(buffer->events[count % buffer->capacity]);
+    event->timestamp = timestamp;
+    event->value = value;
+    event->name = (name) ? name : "";
+    event->phase = phase;
+
+    // Make sure the event is completely written before it gets published to the exporter:
+    PsychTraceStoreBarrier();
+    buffer->count = count + 1;
+
+    PsychTraceAtomicAdd(&traceWriters, -1);
+}
+
+void PsychTraceBegin(const char* name)
+{
+    if (traceEnabled) PsychTraceRecord('B', name, PsychTraceTimestamp(), 0);
+}
+
+void PsychTraceEnd(const char* name)
+{
+    if (traceEnabled) PsychTraceRecord('E', name, PsychTraceTimestamp(), 0);
+}
+
+// Record a complete span from tStart until now. tStart is usually taken via PsychTraceTimestamp()
+// and is zero if tracing was disabled at that time, in which case nothing is recorded. Complete
+// spans stay well-formed even if the code between start and end error-exits:
+void PsychTraceComplete(const char* name, double tStart)
+{
+    double now;
+
+    if (traceEnabled && (tStart > 0)) {
+        PsychGetAdjustedPrecisionTimerSeconds(&now);
+        PsychTraceRecord('X', name, tStart, now - tStart);
+    }
+}
+
+void PsychTraceInstant(const char* name)
+{
+    if (traceEnabled) PsychTraceRecord('i', name, PsychTraceTimestamp(), 0);
+}
+
+void PsychTraceCounter(const char* name, double value)
+{
+    if (traceEnabled) PsychTraceRecord('C', name, PsychTraceTimestamp(), value);
+}
+
+// Called by PsychSetThreadName(), so exported traces show meaningful thread names:
+void PsychTraceSetThreadName(const char* name)
+{
+    snprintf(traceThreadName, sizeof(traceThreadName), "%s", (name) ? name : "");
+    if (traceBuffer && (traceBufferGeneration == traceGeneration))
+        snprintf(traceBuffer->threadName, sizeof(traceBuffer->threadName), "%s", traceThreadName);
+}
+
+// Index of oldest valid event in a buffer. Older events are either cleared or overwritten by the ring:
+static psych_uint64 PsychTraceFirstEvent(PsychTraceBuffer* buffer, psych_uint64 count)
+{
+    psych_uint64 first = buffer->start;
+
+    if (count - first > buffer->capacity)
+        first = count - buffer->capacity;
+
+    return(first);
+}
+
+psych_int64 PsychTraceGetNumEvents(void)
+{
+    PsychTraceBuffer* buffer;
+    psych_uint64 count;
+    psych_int64 numEvents = 0;
+
+    if (!traceInitialized)
+        return(0);
+
+    PsychLockMutex(&traceMutex);
+    for (buffer = traceBufferList; buffer; buffer = buffer->next) {
+        count = buffer->count;
+        numEvents += (psych_int64) (count - PsychTraceFirstEvent(buffer, count));
+    }
+    PsychUnlockMutex(&traceMutex);
+
+    return(numEvents);
+}
+
+void PsychTraceClear(void)
+{
+    PsychTraceBuffer* buffer;
+
+    if (!traceInitialized)
+        return;
+
+    PsychLockMutex(&traceMutex);
+    for (buffer = traceBufferList; buffer; buffer = buffer->next)
+        buffer->start = buffer->count;
+    PsychUnlockMutex(&traceMutex);
+}
+
+// Copy string 'in' into 'out' of size 'outsize', escaped for use inside a JSON string:
+static void PsychTraceEscapeJSON(char* out, size_t outsize, const char* in)
+{
+    size_t n = 0;
+
+    for (; *in && (n + 7 < outsize); in++) {
+        if ((*in == '"') || (*in == '\\')) {
+            out[n++] = '\\';
+            out[n++] = *in;
+        }
+        else if ((unsigned char) *in < 0x20) {
+            n += snprintf(out + n, outsize - n, "\\u%04x", (unsigned int) (unsigned char) *in);
+        }
+        else {
+            out[n++] = *in;
+        }
+    }
+
+    out[n] = 0;
+}
+
+// Append all recorded events to file 'filename' in Chrome trace event JSON format.
+// Returns the number of exported events, or -1 on failure to open the file:
+psych_int64 PsychTraceDumpToFile(const char* filename)
+{
+    PsychTraceBuffer* buffer;
+    PsychTraceEvent* event;
+    psych_uint64 i, count, pid;
+    psych_int64 numEvents = 0;
+    char category[64], name[256];
+    char line[512];
+    int len;
+    FILE* fd;
+
+    if (!traceInitialized)
+        return(0);
+
+    if (!(fd = fopen(filename, "a")))
+        return(-1);
+
+    // Start of a new trace file? Then open the JSON event array. Note: We format
+    // into a line buffer and fputs() it, as fprintf() is remapped to console
+    // output for some scripting environments:
+    fseek(fd, 0, SEEK_END);
+    if (ftell(fd) == 0)
+        fputs("[\n", fd);
+
+    pid = PsychTraceGetProcessId();
+    PsychTraceEscapeJSON(category, sizeof(category), PsychGetModuleName());
+
+    PsychLockMutex(&traceMutex);
+    for (buffer = traceBufferList; buffer; buffer = buffer->next) {
+        if (buffer->threadName[0]) {
+            PsychTraceEscapeJSON(name, sizeof(name), buffer->threadName);
+            snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%llu,\"tid\":%llu,\"args\":{\"name\":\"%s\"}},\n",
+                     (unsigned long long) pid, (unsigned long long) buffer->tid, name);
+            fputs(line, fd);
+        }
+
+        count = buffer->count;
+        for (i = PsychTraceFirstEvent(buffer, count); i < count; i++) {
+            event = &(buffer->events[i % buffer->capacity]);
+            PsychTraceEscapeJSON(name, sizeof(name), event->name);
+
+            len = snprintf(line, sizeof(line), "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%llu,\"tid\":%llu",
+                           name, category, event->phase, event->timestamp * 1e6, (unsigned long long) pid, (unsigned long long) buffer->tid);
+            if ((len < 0) || (len >= (int) sizeof(line) - 64))
+                continue;
+
+            switch (event->phase) {
+                case 'X':
+                    snprintf(line + len, sizeof(line) - len, ",\"dur\":%.3f},\n", event->value * 1e6);
+                    break;
+
+                case 'C':
+                    snprintf(line + len, sizeof(line) - len, ",\"args\":{\"value\":%.9g}},\n", event->value);
+                    break;
+
+                case 'i':
+                    snprintf(line + len, sizeof(line) - len, ",\"s\":\"t\"},\n");
+                    break;
+
+                default:
+                    snprintf(line + len, sizeof(line) - len, "},\n");
+            }
+
+            fputs(line, fd);
+            numEvents++;
+        }
+    }
+    PsychUnlockMutex(&traceMutex);
+
+    fclose(fd);
+
+    return(numEvents);
+}
+
+PsychError PsychTraceControl(void)
+{
+    static char useString[] = "[numEvents, oldEnable] = Modulename('TraceControl' [, enable][, traceFileName][, clearAfterDump=1]);";
+    static char synopsisString[] = "Control low-overhead event tracing of the module and export the recorded trace.\n"
+                                   "If the module records trace events, e.g., timing of subfunction calls or of internal "
+                                   "processing stages and threads, then these are stored in preallocated per-thread ring buffers "
+                                   "without disturbing timing.\n"
+                                   "'enable' if provided, enables (1) or disables (0) tracing. Tracing is off by default, unless "
+                                   "the environment variable PSYCH_TRACE=1 was set at module load time.\n"
+                                   "'traceFileName' if provided, appends all recorded events to the given file in Chrome trace event "
+                                   "JSON format, viewable with the chrome://tracing tool or the Perfetto trace viewer. Different "
+                                   "modules can append to the same file, to get one combined timeline.\n"
+                                   "'clearAfterDump' if set to 1, the default, will discard all recorded events after export to a file.\n"
+                                   "Returns the number of currently stored events in 'numEvents', or the number of exported events if "
+                                   "'traceFileName' was given, and the previous enable setting in 'oldEnable'.\n"
+                                   "Setting the environment variable PSYCH_TRACE_FILE to a filename will export all recorded events at "
+                                   "module shutdown, PSYCH_TRACE_BUFFERSIZE selects the per-thread event capacity.\n";
+    static char seeAlsoString[] = "";
+
+    int enable, clearAfterDump = 1;
+    char* filename = NULL;
+    psych_bool oldEnable = traceEnabled;
+    psych_int64 numEvents;
+
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    PsychAllocInCharArg(2, kPsychArgOptional, &filename);
+    PsychCopyInIntegerArg(3, kPsychArgOptional, &clearAfterDump);
+
+    if (filename) {
+        // Pause recording during export and wait for pending writers, so the ring buffers don't move under us:
+        PsychTraceQuiesce();
+        numEvents = PsychTraceDumpToFile(filename);
+        traceEnabled = oldEnable;
+
+        if (numEvents < 0)
+            PsychErrorExitMsg(PsychError_user, "Could not open trace file for writing.");
+
+        if (clearAfterDump)
+            PsychTraceClear();
+    }
+    else {
+        numEvents = PsychTraceGetNumEvents();
+    }
+
+    if (PsychCopyInIntegerArg(1, kPsychArgOptional, &enable))
+        PsychTraceSetEnabled((enable > 0) ? TRUE : FALSE);
+
+    PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) numEvents);
+    PsychCopyOutDoubleArg(2, kPsychArgOptional, (double) oldEnable);
+
+    return(PsychError_none);
+}
@@ -22,9 +22,32 @@
 void	PsychPushClock(void);
 double  PsychPopClock(void);
 
-
-
+// Low-overhead event tracing:
+//
+// Each thread records into its own private ring buffer, so recording never
+// takes a lock. Event names must be string literals or otherwise persistent
+// strings, as only the pointer is stored. Recorded events can be exported in
+// the Chrome trace event JSON format, readable by chrome://tracing and the
+// Perfetto UI. All timestamps are in GetSecs() time, so traces from different
+// modules can be appended to the same file and show up on one timeline.
+void        PsychInitInstrument(void);
+void        PsychExitInstrument(void);
+psych_bool  PsychTraceIsEnabled(void);
+void        PsychTraceSetEnabled(psych_bool enable);
+double      PsychTraceTimestamp(void);
+void        PsychTraceBegin(const char* name);
+void        PsychTraceEnd(const char* name);
+void        PsychTraceComplete(const char* name, double tStart);
+void        PsychTraceInstant(const char* name);
+void        PsychTraceCounter(const char* name, double value);
+void        PsychTraceSetThreadName(const char* name);
+void        PsychTraceSetThreadRealtime(void);
+void        PsychTraceReserveBuffers(int count);
+psych_uint64 PsychTraceGetOSThreadId(void);
+psych_int64 PsychTraceGetNumEvents(void);
+void        PsychTraceClear(void);
+psych_int64 PsychTraceDumpToFile(const char* filename);
+PsychError  PsychTraceControl(void);
 
 //end include once
 #endif
-	
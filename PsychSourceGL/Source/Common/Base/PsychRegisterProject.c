@@ -22,6 +22,8 @@ static PsychFunctionPtr baseFunctionREGISTER = NULL;
 static PsychFunctionTableEntry functionTableREGISTER[PSYCH_MAX_FUNCTIONS];
 static char ModuleNameREGISTER[PSYCH_MAX_FUNCTION_NAME_LENGTH+1]; //+1 for term null
 static char *currentFunctionNameREGISTER;
+static psych_bool baseFunctionMayBlockREGISTER = FALSE;
+static psych_bool currentFunctionMayBlockREGISTER = FALSE;
 static int numFunctionsREGISTER = 0;
 static psych_bool nameRegistered = FALSE;
 
@@ -41,6 +43,8 @@ void PsychResetRegistry(void)
     baseFunctionREGISTER = NULL;
     ModuleNameREGISTER[0] = 0;
     currentFunctionNameREGISTER = NULL;
+    baseFunctionMayBlockREGISTER = FALSE;
+    currentFunctionMayBlockREGISTER = FALSE;
     numFunctionsREGISTER = 0;
     nameRegistered = FALSE;
     memset(&functionTableREGISTER[0], 0, sizeof(functionTableREGISTER));
@@ -151,6 +155,30 @@ PsychError PsychRegister(char *name,  PsychFunctionPtr func)
 	return(PsychError_none);
 }
 
+/*
+	Like PsychRegister, but marks the registered subfunction, or the project base function if
+	name is NULL, as potentially blocking for a long time. Such functions may temporarily release
+	the lock of the scripting environment around their waits, e.g., the Python GIL, so other
+	threads of the runtime can make progress. See PsychEnterBlockingSection() for details.
+*/
+PsychError PsychRegisterBlocking(char *name,  PsychFunctionPtr func)
+{
+	PsychError rc;
+
+	if ((name == NULL) && (func == NULL))
+		return(PsychError_internal);
+
+	if ((rc = PsychRegister(name, func)) != PsychError_none)
+		return(rc);
+
+	if (name == NULL)
+		baseFunctionMayBlockREGISTER = TRUE;
+	else
+		functionTableREGISTER[numFunctionsREGISTER - 1].mayBlock = TRUE;
+
+	return(PsychError_none);
+}
+
 //for use by projects
 PsychError PsychRegisterExit(PsychFunctionPtr exitFunc)
 {
@@ -174,6 +202,7 @@ PsychFunctionPtr PsychGetProjectFunction(char *command)
 	//return the project base function
 	if(command==NULL){
 		currentFunctionNameREGISTER = NULL;
+		currentFunctionMayBlockREGISTER = baseFunctionMayBlockREGISTER;
 		return(baseFunctionREGISTER);
 	}
 	// See if help is being requested
@@ -187,6 +216,7 @@ PsychFunctionPtr PsychGetProjectFunction(char *command)
 	for(i=0;i<numFunctionsREGISTER;i++){
 		if(PsychMatch(functionTableREGISTER[i].name, command)){
 			currentFunctionNameREGISTER = functionTableREGISTER[i].name;
+			currentFunctionMayBlockREGISTER = functionTableREGISTER[i].mayBlock;
 			return(functionTableREGISTER[i].function);
 		}
 	}
@@ -207,6 +237,12 @@ char *PsychGetFunctionName(void)
 		return(currentFunctionNameREGISTER);
 }
 
+// Was the currently executing function registered via PsychRegisterBlocking()?
+psych_bool PsychIsCurrentFunctionBlocking(void)
+{
+	return(currentFunctionMayBlockREGISTER);
+}
+
 //for use by projects
 char *PsychGetModuleName(void)
 {
@@ -27,10 +27,13 @@ typedef struct
 {
     char name[PSYCH_MAX_FUNCTION_NAME_LENGTH+1];  // +1 for term null
     PsychFunctionPtr function;
+    psych_bool mayBlock;                          // May release the scripting lock, see PsychRegisterBlocking().
 } PsychFunctionTableEntry;
 
 PsychError PsychDescribeModuleFunctions(void);
 PsychError PsychRegister(char *name,  PsychFunctionPtr func);
+PsychError PsychRegisterBlocking(char *name,  PsychFunctionPtr func);
+psych_bool PsychIsCurrentFunctionBlocking(void);
 PsychError PsychRegisterExit(PsychFunctionPtr exitFunc);
 void PsychResetRegistry(void);
 PsychFunctionPtr PsychGetProjectFunction(char *command);
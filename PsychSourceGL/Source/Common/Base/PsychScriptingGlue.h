@@ -132,6 +132,8 @@ size_t PsychGetArgN(int position);
 size_t PsychGetArgP(int position);
 void PsychErrMsgTxt(char *s);
 void PsychProcessErrorInScripting(PsychError error, const char* message);
+void PsychEnterBlockingSection(void);
+void PsychLeaveBlockingSection(void);
 void PsychEnableSubfunctions(void);
 psych_bool PsychAreSubfunctionsEnabled(void);
 psych_bool PsychCheckInputArgType(int position, PsychArgRequirementType isRequired, PsychArgFormatType argType);
@@ -170,7 +172,7 @@ double mxGetScalar(const PyObject* arrayPtr);
 PyObject* mxGetField(const PyObject* structArray, int index, const char* fieldName);
 PyObject** PsychGetOutArgPyPtr(int position);
 const PyObject *PsychGetInArgPyPtr(int position);
-PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args);
+PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args, PyObject* kwargs);
 const char* PsychGetPyModuleFilename(void);
 #endif
 
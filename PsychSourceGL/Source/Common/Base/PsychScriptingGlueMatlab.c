@@ -102,6 +102,9 @@ void InitializeSynopsis(char *synopsis[],int maxStrings);
 static int recLevel = -1;
 static psych_bool psych_recursion_debug = FALSE;
 
+// Start time of subfunction dispatch at each call recursion level, for tracing:
+static double dispatchStartTime[MAX_RECURSIONLEVEL];
+
 static psych_bool nameFirstGLUE[MAX_RECURSIONLEVEL];
 static psych_bool baseFunctionInvoked[MAX_RECURSIONLEVEL];
 
@@ -137,6 +140,18 @@ void PsychProcessErrorInScripting(PsychError error, const char* message)
     return;
 }
 
+// No-Op implementations: Matlab and Octave don't allow concurrent calls into
+// modules from multiple threads, so there is no interpreter lock to release:
+void PsychEnterBlockingSection(void)
+{
+    return;
+}
+
+void PsychLeaveBlockingSection(void)
+{
+    return;
+}
+
 void PsychExitRecursion(void)
 {
     if (recLevel < 0) {
@@ -146,6 +161,10 @@ void PsychExitRecursion(void)
 
     if (psych_recursion_debug) printf("PTB-DEBUG: Module %s leaving recursive call level %i.\n", PsychGetModuleName(), recLevel);
 
+    // Record execution time of this module invocation, if tracing is enabled:
+    if (dispatchStartTime[recLevel] > 0)
+        PsychTraceComplete((strlen(PsychGetFunctionName()) > 0) ? PsychGetFunctionName() : PsychGetModuleName(), dispatchStartTime[recLevel]);
+
     // Done with this call recursion level:
     recLevel--;
 }
@@ -241,6 +260,12 @@ EXP void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *prhs[])
         // generator script to find out about subfunctions of a module:
         PsychRegister((char*) "DescribeModuleFunctionsHelper",  &PsychDescribeModuleFunctions);
 
+        // Register helper for control and export of event tracing, see PsychInstrument.c:
+        PsychRegister((char*) "TraceControl",  &PsychTraceControl);
+
+        // Register helper for core assignment of module threads, see PsychThreadPool.c:
+        PsychRegister((char*) "ThreadControl",  &PsychThreadControl);
+
         firstTime = FALSE;
     }
 
@@ -256,6 +281,9 @@ EXP void mexFunction(int nlhs, mxArray *plhs[], int nrhs, CONSTmxArray *prhs[])
 
     if (psych_recursion_debug) printf("PTB-DEBUG: Module %s entering recursive call level %i.\n", PsychGetModuleName(), recLevel);
 
+    // Start of subfunction execution, if tracing is enabled:
+    dispatchStartTime[recLevel] = PsychTraceTimestamp();
+
     // Store away call arguments for use by language-neutral accessor functions in ScriptingGlue.c
     nlhsGLUE[recLevel] = nlhs;
     nrhsGLUE[recLevel] = nrhs;
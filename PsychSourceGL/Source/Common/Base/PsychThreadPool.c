@@ -0,0 +1,576 @@
+/*
+  PsychToolbox3/Source/Common/Base/PsychThreadPool.c
+
+  PLATFORMS:  All.
+
+  DESCRIPTION:
+
+  Processor core placement of module threads, and a shared worker thread pool.
+
+  Core placement: Each thread of a module belongs to one of the classes in
+  PsychThreadClass. The scripting environment thread is of class main, the
+  module threads call PsychAssignThreadToCoreSet() at thread startup to declare
+  themselves as realtime threads (flipper, kbqueue, serial port readers, ...)
+  or worker threads. Each class can be restricted to its own set of processor
+  cores, so realtime threads don't have to compete with the script thread or
+  with bulk processing for the same cores. Core sets are given as core lists
+  like "0-3,8", either via the environment variables PSYCH_CPUSET_MAIN,
+  PSYCH_CPUSET_REALTIME and PSYCH_CPUSET_WORKER at module init, or at runtime
+  via Modulename('ThreadControl'). If only a realtime set is given, main and
+  worker threads are kept off those cores by default. Without configuration,
+  threads are not restricted at all, which is the old behaviour. Operating
+  systems without thread affinity control (macOS) only record the setting.
+
+  Worker pool: PsychThreadPoolParallelFor() splits a range of items evenly
+  across the calling thread and a lazily created pool of worker threads. Each
+  participant processes its own range front to back in chunks of 'grainSize'
+  items, and when done steals half of the remaining items from the back of
+  the range of another participant. This balances uneven work without a
+  central queue. The number of worker threads defaults to one less than the
+  number of cores available to worker threads, and can be overridden by the
+  environment variable PSYCH_WORKER_THREADS, with zero disabling the pool.
+
+*/
+
+#include "Psych.h"
+
+#define PSYCH_MAX_REGISTERED_THREADS 64
+#define PSYCH_MAX_POOL_THREADS 31
+
+// Registry of threads with assigned core sets, for reporting:
+typedef struct PsychThreadRecord {
+    char                name[32];
+    psych_uint64        osThreadId;
+    PsychThreadClass    threadClass;
+    psych_uint64        coreMask;
+    psych_bool          coreMaskApplied;
+} PsychThreadRecord;
+
+static psych_mutex          registryMutex;
+static PsychThreadRecord    threadRegistry[PSYCH_MAX_REGISTERED_THREADS];
+static int                  numRegisteredThreads = 0;
+
+// Configured core sets per class, zero = unrestricted:
+static psych_uint64         coreSets[kPsychNumThreadClasses];
+static const char*          coreSetClassNames[kPsychNumThreadClasses] = { "main", "realtime", "worker" };
+
+// Class of calling thread, -1 = not assigned, ie. the scripting thread or a foreign thread:
+static PSYCH_THREAD_LOCAL int currentThreadClass = -1;
+static PSYCH_THREAD_LOCAL psych_bool currentThreadRestricted = FALSE;
+
+// Work stealing range of one participant in a parallel for:
+typedef struct PsychPoolRange {
+    psych_mutex     lock;
+    psych_int64     begin;
+    psych_int64     end;
+} PsychPoolRange;
+
+typedef struct PsychPoolWorker {
+    psych_thread    thread;
+    psych_condition wakeup;
+    int             index;
+    psych_uint64    assignedJob;        // Generation of the last job this worker was asked to help with.
+    psych_uint64    finishedJob;        // Generation of the last job this worker finished.
+} PsychPoolWorker;
+
+static psych_bool           poolInitialized = FALSE;
+static int                  numPoolThreads = -1;
+static PsychPoolWorker      poolWorkers[PSYCH_MAX_POOL_THREADS];
+static PsychPoolRange       poolRanges[PSYCH_MAX_POOL_THREADS + 1];
+static psych_mutex          poolStartMutex;     // Serializes the lazy start of the pool threads.
+static psych_mutex          poolJobMutex;       // Serializes PsychThreadPoolParallelFor() calls.
+static psych_mutex          poolStateMutex;     // Protects the job state below.
+static psych_condition      poolDone;
+static psych_uint64         poolGeneration = 0;
+static int                  poolBusyWorkers = 0;
+static psych_bool           poolShutdown = FALSE;
+static PsychParallelForFunc poolFunc = NULL;
+static void*                poolContext = NULL;
+static psych_int64          poolGrainSize = 1;
+
+// Set for pool threads, and for callers while running a job, so nested calls run serially:
+static PSYCH_THREAD_LOCAL psych_bool inThreadPool = FALSE;
+
+// Parse a core list like "0-3,8" into a bit mask. Returns FALSE on syntax error:
+static psych_bool PsychParseCoreList(const char* coreList, psych_uint64* coreMask)
+{
+    const char* s = coreList;
+    char* end;
+    long first, last;
+
+    *coreMask = 0;
+    while (*s) {
+        first = strtol(s, &end, 10);
+        if ((end == s) || (first < 0) || (first > 63))
+            return(FALSE);
+
+        last = first;
+        s = end;
+        if (*s == '-') {
+            last = strtol(++s, &end, 10);
+            if ((end == s) || (last < first) || (last > 63))
+                return(FALSE);
+            s = end;
+        }
+
+        for (; first <= last; first++)
+            *coreMask |= ((psych_uint64) 1) << first;
+
+        if (*s == ',')
+            s++;
+        else if (*s)
+            return(FALSE);
+    }
+
+    return(TRUE);
+}
+
+// Format a bit mask as core list into coreList:
+static void PsychFormatCoreList(psych_uint64 coreMask, char* coreList, size_t size)
+{
+    int first, last;
+    size_t len = 0;
+
+    coreList[0] = 0;
+    for (first = 0; first < 64; first = last + 1) {
+        last = first;
+        if (!(coreMask & (((psych_uint64) 1) << first)))
+            continue;
+
+        while ((last < 63) && (coreMask & (((psych_uint64) 1) << (last + 1))))
+            last++;
+
+        if (first == last)
+            len += snprintf(coreList + len, (len < size) ? size - len : 0, "%s%i", (len > 0) ? "," : "", first);
+        else
+            len += snprintf(coreList + len, (len < size) ? size - len : 0, "%s%i-%i", (len > 0) ? "," : "", first, last);
+    }
+}
+
+static int PsychCountCores(psych_uint64 coreMask)
+{
+    int n = 0;
+
+    for (; coreMask; coreMask &= coreMask - 1)
+        n++;
+
+    return(n);
+}
+
+static psych_uint64 PsychGetAllCoresMask(void)
+{
+    int numCores = PsychGetNumProcessorCores();
+
+    return((numCores >= 64) ? ~((psych_uint64) 0) : ((((psych_uint64) 1) << numCores) - 1));
+}
+
+// Effective core set for a thread class, applying the isolation defaults:
+static psych_uint64 PsychGetClassCoreSet(int threadClass)
+{
+    psych_uint64 allCores;
+
+    if (threadClass < 0)
+        threadClass = kPsychThreadClassMain;
+
+    if (coreSets[threadClass] || (threadClass == kPsychThreadClassRealtime) || !coreSets[kPsychThreadClassRealtime])
+        return(coreSets[threadClass]);
+
+    // Only realtime cores configured: Keep everybody else off them.
+    allCores = PsychGetAllCoresMask();
+
+    return((allCores & ~coreSets[kPsychThreadClassRealtime]) ? (allCores & ~coreSets[kPsychThreadClassRealtime]) : 0);
+}
+
+// Core set assigned to the calling thread, zero if unrestricted:
+psych_uint64 PsychGetThreadCoreSet(void)
+{
+    return(PsychGetClassCoreSet(currentThreadClass));
+}
+
+// Core set for threads of the given class, zero if unrestricted:
+psych_uint64 PsychGetThreadClassCoreSet(PsychThreadClass threadClass)
+{
+    return(PsychGetClassCoreSet((int) threadClass));
+}
+
+// Record the core assignment of thread 'osThreadId' in the registry, and warn if it failed with
+// error code 'rc'. For threads which can't do this themselves, e.g., realtime audio callbacks
+// which apply PsychGetThreadClassCoreSet() via PsychSetThreadCoreMask() and leave the rest to
+// the main thread:
+void PsychRegisterThreadCoreSet(const char* name, psych_uint64 osThreadId, PsychThreadClass threadClass, psych_uint64 coreMask, int rc)
+{
+    int i;
+
+    PsychLockMutex(&registryMutex);
+
+    for (i = 0; i < numRegisteredThreads; i++)
+        if (threadRegistry[i].osThreadId == osThreadId)
+            break;
+
+    // Registry full? Recycle the oldest entry, most likely a dead thread:
+    if (i == PSYCH_MAX_REGISTERED_THREADS) {
+        memmove(&threadRegistry[0], &threadRegistry[1], sizeof(threadRegistry[0]) * (PSYCH_MAX_REGISTERED_THREADS - 1));
+        i = PSYCH_MAX_REGISTERED_THREADS - 1;
+    }
+    else if (i == numRegisteredThreads) {
+        numRegisteredThreads++;
+    }
+
+    snprintf(threadRegistry[i].name, sizeof(threadRegistry[i].name), "%s", (name) ? name : "");
+    threadRegistry[i].osThreadId = osThreadId;
+    threadRegistry[i].threadClass = threadClass;
+    threadRegistry[i].coreMask = coreMask;
+    threadRegistry[i].coreMaskApplied = (coreMask && (rc == 0)) ? TRUE : FALSE;
+
+    PsychUnlockMutex(&registryMutex);
+
+    if (rc && (threadClass != kPsychThreadClassWorker))
+        printf("PTB-WARNING: Could not assign thread '%s' to its %s core set [rc %i].\n", (name) ? name : "", coreSetClassNames[threadClass], rc);
+}
+
+// Apply the core set for the given class to the calling thread and record it in the registry.
+// 'name' is used for reporting. Returns zero on success or if nothing needs to be done, non-zero
+// if the operating system refused the core assignment:
+int PsychAssignThreadToCoreSet(const char* name, PsychThreadClass threadClass)
+{
+    psych_uint64 coreMask;
+    int rc = 0;
+
+    currentThreadClass = (int) threadClass;
+    coreMask = PsychGetClassCoreSet(threadClass);
+    if (coreMask)
+        rc = PsychSetThreadCoreMask(coreMask, NULL);
+    else if (currentThreadRestricted)
+        rc = PsychSetThreadCoreMask(PsychGetAllCoresMask(), NULL);
+
+    currentThreadRestricted = (coreMask && (rc == 0)) ? TRUE : FALSE;
+
+    PsychRegisterThreadCoreSet(name, PsychTraceGetOSThreadId(), threadClass, coreMask, rc);
+
+    return(rc);
+}
+
+void PsychInitThreadPool(void)
+{
+    int i;
+    char* env;
+
+    numRegisteredThreads = 0;
+    numPoolThreads = -1;
+    poolShutdown = FALSE;
+    PsychInitMutex(&registryMutex);
+    PsychInitMutex(&poolStartMutex);
+
+    for (i = 0; i < kPsychNumThreadClasses; i++) {
+        char envName[32];
+
+        coreSets[i] = 0;
+        snprintf(envName, sizeof(envName), "PSYCH_CPUSET_%s", (i == kPsychThreadClassMain) ? "MAIN" : ((i == kPsychThreadClassRealtime) ? "REALTIME" : "WORKER"));
+        if ((env = getenv(envName)) && !PsychParseCoreList(env, &coreSets[i])) {
+            printf("PTB-WARNING: Ignoring invalid core list '%s' in environment variable %s.\n", env, envName);
+            coreSets[i] = 0;
+        }
+    }
+
+    // Calling thread is the scripting thread, which we also report:
+    PsychAssignThreadToCoreSet("PTB mainthread", kPsychThreadClassMain);
+}
+
+static void PsychThreadPoolRunJob(int self, int numParticipants)
+{
+    psych_int64 begin, end, stolen;
+    int i, victim;
+
+    while (TRUE) {
+        // Take the next chunk from the front of our own range:
+        PsychLockMutex(&poolRanges[self].lock);
+        begin = poolRanges[self].begin;
+        end = (poolRanges[self].end - begin > poolGrainSize) ? begin + poolGrainSize : poolRanges[self].end;
+        poolRanges[self].begin = end;
+        PsychUnlockMutex(&poolRanges[self].lock);
+
+        if (begin < end) {
+            poolFunc(poolContext, begin, end);
+            continue;
+        }
+
+        // Own range is empty: Steal the back half of the remaining range of somebody else:
+        stolen = 0;
+        for (i = 1; (i < numParticipants) && !stolen; i++) {
+            victim = (self + i) % numParticipants;
+            PsychLockMutex(&poolRanges[victim].lock);
+            if (poolRanges[victim].begin < poolRanges[victim].end) {
+                end = poolRanges[victim].end;
+                begin = poolRanges[victim].begin + (end - poolRanges[victim].begin) / 2;
+                poolRanges[victim].end = begin;
+                stolen = end - begin;
+            }
+            PsychUnlockMutex(&poolRanges[victim].lock);
+        }
+
+        if (!stolen)
+            return;
+
+        PsychLockMutex(&poolRanges[self].lock);
+        poolRanges[self].begin = begin;
+        poolRanges[self].end = end;
+        PsychUnlockMutex(&poolRanges[self].lock);
+    }
+}
+
+static void* PsychThreadPoolWorkerMain(void* arg)
+{
+    PsychPoolWorker* worker = (PsychPoolWorker*) arg;
+    char name[16];
+
+    snprintf(name, sizeof(name), "PTBWorker%i", worker->index);
+    PsychSetThreadName(name);
+    PsychAssignThreadToCoreSet(name, kPsychThreadClassWorker);
+    inThreadPool = TRUE;
+
+    PsychLockMutex(&poolStateMutex);
+    while (TRUE) {
+        while (!poolShutdown && (worker->finishedJob == worker->assignedJob))
+            PsychWaitCondition(&worker->wakeup, &poolStateMutex);
+
+        if (poolShutdown)
+            break;
+
+        PsychUnlockMutex(&poolStateMutex);
+
+        PsychThreadPoolRunJob(worker->index + 1, numPoolThreads + 1);
+
+        PsychLockMutex(&poolStateMutex);
+        worker->finishedJob = worker->assignedJob;
+        if (--poolBusyWorkers == 0)
+            PsychSignalCondition(&poolDone);
+    }
+    PsychUnlockMutex(&poolStateMutex);
+
+    return(NULL);
+}
+
+static void PsychThreadPoolStart(void)
+{
+    int i, n;
+    char* env;
+
+    PsychInitMutex(&poolJobMutex);
+    PsychInitMutex(&poolStateMutex);
+    PsychInitCondition(&poolDone, NULL);
+    for (i = 0; i <= PSYCH_MAX_POOL_THREADS; i++)
+        PsychInitMutex(&poolRanges[i].lock);
+
+    poolInitialized = TRUE;
+
+    if ((env = getenv("PSYCH_WORKER_THREADS"))) {
+        n = atoi(env);
+    }
+    else {
+        n = (PsychGetClassCoreSet(kPsychThreadClassWorker)) ? PsychCountCores(PsychGetClassCoreSet(kPsychThreadClassWorker)) : PsychGetNumProcessorCores();
+        n = n - 1;
+    }
+
+    if (n < 0) n = 0;
+    if (n > PSYCH_MAX_POOL_THREADS) n = PSYCH_MAX_POOL_THREADS;
+
+    for (i = 0; i < n; i++) {
+        poolWorkers[i].index = i;
+        poolWorkers[i].assignedJob = 0;
+        poolWorkers[i].finishedJob = 0;
+        PsychInitCondition(&poolWorkers[i].wakeup, NULL);
+        if (PsychCreateThread(&poolWorkers[i].thread, NULL, PsychThreadPoolWorkerMain, (void*) &poolWorkers[i])) {
+            PsychDestroyCondition(&poolWorkers[i].wakeup);
+            printf("PTB-WARNING: Could only create %i of %i worker pool threads.\n", i, n);
+            break;
+        }
+    }
+
+    numPoolThreads = i;
+}
+
+// Number of threads running a PsychThreadPoolParallelFor(), including the calling thread:
+int PsychThreadPoolGetNumThreads(void)
+{
+    int n;
+
+    // Start pool on first use. This can be called from multiple threads at the same
+    // time, e.g., from the recorder threads of multiple cameras, so serialize the start:
+    PsychLockMutex(&poolStartMutex);
+    if (numPoolThreads < 0)
+        PsychThreadPoolStart();
+    n = numPoolThreads;
+    PsychUnlockMutex(&poolStartMutex);
+
+    return(n + 1);
+}
+
+/* PsychThreadPoolParallelFor() - Process 'count' items in parallel.
+ *
+ * Calls func(context, begin, end) for disjoint subranges of [0, count), each at most
+ * 'grainSize' items, on the calling thread and the pool threads, and returns once all
+ * items are processed. 'func' runs concurrently on multiple threads, so it must not call
+ * into the scripting environment, PsychErrorExit() or other non thread-safe functions.
+ * Nested calls from inside 'func' are executed serially on the calling thread.
+ */
+void PsychThreadPoolParallelFor(psych_int64 count, psych_int64 grainSize, PsychParallelForFunc func, void* context)
+{
+    int i, n;
+    psych_int64 start;
+
+    if (count <= 0)
+        return;
+
+    if (grainSize < 1)
+        grainSize = 1;
+
+    n = (inThreadPool || (count <= grainSize)) ? 1 : PsychThreadPoolGetNumThreads();
+    if (n == 1) {
+        func(context, 0, count);
+        return;
+    }
+
+    // Don't wake more threads than there are chunks of work:
+    if ((psych_int64) n > (count + grainSize - 1) / grainSize)
+        n = (int) ((count + grainSize - 1) / grainSize);
+
+    PsychLockMutex(&poolJobMutex);
+
+    // Initial even split. Pool threads which don't get a range of their own just steal:
+    for (i = 0, start = 0; i <= numPoolThreads; i++) {
+        poolRanges[i].begin = start;
+        poolRanges[i].end = (i < n) ? start + (count - start) / (n - i) : start;
+        start = poolRanges[i].end;
+    }
+
+    PsychLockMutex(&poolStateMutex);
+    poolFunc = func;
+    poolContext = context;
+    poolGrainSize = grainSize;
+    poolGeneration++;
+    poolBusyWorkers = n - 1;
+    for (i = 0; i < n - 1; i++) {
+        poolWorkers[i].assignedJob = poolGeneration;
+        PsychSignalCondition(&poolWorkers[i].wakeup);
+    }
+    PsychUnlockMutex(&poolStateMutex);
+
+    inThreadPool = TRUE;
+    PsychThreadPoolRunJob(0, numPoolThreads + 1);
+    inThreadPool = FALSE;
+
+    PsychLockMutex(&poolStateMutex);
+    while (poolBusyWorkers > 0)
+        PsychWaitCondition(&poolDone, &poolStateMutex);
+    PsychUnlockMutex(&poolStateMutex);
+
+    PsychUnlockMutex(&poolJobMutex);
+}
+
+void PsychExitThreadPool(void)
+{
+    int i;
+
+    if (poolInitialized) {
+        PsychLockMutex(&poolStateMutex);
+        poolShutdown = TRUE;
+        for (i = 0; i < numPoolThreads; i++)
+            PsychSignalCondition(&poolWorkers[i].wakeup);
+        PsychUnlockMutex(&poolStateMutex);
+
+        for (i = 0; i < numPoolThreads; i++) {
+            PsychDeleteThread(&poolWorkers[i].thread);
+            PsychDestroyCondition(&poolWorkers[i].wakeup);
+        }
+
+        for (i = 0; i <= PSYCH_MAX_POOL_THREADS; i++)
+            PsychDestroyMutex(&poolRanges[i].lock);
+
+        PsychDestroyCondition(&poolDone);
+        PsychDestroyMutex(&poolStateMutex);
+        PsychDestroyMutex(&poolJobMutex);
+        poolInitialized = FALSE;
+    }
+
+    numPoolThreads = -1;
+    PsychDestroyMutex(&poolStartMutex);
+    PsychDestroyMutex(&registryMutex);
+}
+
+PsychError PsychThreadControl(void)
+{
+    static char useString[] = "[threadInfo, coreSets] = Modulename('ThreadControl' [, mainCores][, realtimeCores][, workerCores]);";
+    static char synopsisString[] = "Control assignment of the threads of this module to processor cores, and report thread statistics.\n"
+                                   "The scripting environment thread is of class 'main', timing critical module threads, e.g., flipper, "
+                                   "audio, keyboard queue and serial port reader threads are of class 'realtime', and threads of the shared "
+                                   "worker pool for bulk processing are of class 'worker'. Each class can be restricted to its own set of "
+                                   "cores, so realtime threads don't compete with the script or bulk processing for the same cores.\n"
+                                   "'mainCores', 'realtimeCores' and 'workerCores' if provided, set the new core set of the respective class "
+                                   "as a core list string like '0-3,8', with an empty string meaning all cores. The defaults are taken "
+                                   "from the environment variables PSYCH_CPUSET_MAIN, PSYCH_CPUSET_REALTIME and PSYCH_CPUSET_WORKER at "
+                                   "module init time. If only realtime cores are set, main and worker threads get all other cores. New "
+                                   "settings apply to the calling thread immediately and to other threads when they are started next.\n"
+                                   "Returns a struct array 'threadInfo' with one entry per thread known to the module, with the thread "
+                                   "'name', operating system 'threadId', thread 'class', assigned 'cores', if these cores were 'applied' "
+                                   "successfully, and the consumed 'cpuTime' in seconds, or -1 if the thread no longer exists.\n"
+                                   "'coreSets' is a struct with the current core sets 'main', 'realtime' and 'worker', and the number of "
+                                   "threads of the worker pool in 'poolThreads', including the calling thread. PSYCH_WORKER_THREADS "
+                                   "overrides the default number of pool threads at module init time.\n"
+                                   "This is not supported on macOS, which doesn't allow assignment of threads to cores.\n";
+    static char seeAlsoString[] = "";
+
+    const char* infoFieldNames[] = { "name", "threadId", "class", "cores", "applied", "cpuTime" };
+    const char* setFieldNames[] = { "main", "realtime", "worker", "poolThreads" };
+    PsychGenericScriptType *info, *sets;
+    PsychThreadRecord registry[PSYCH_MAX_REGISTERED_THREADS];
+    char coreList[256];
+    char* arg;
+    psych_uint64 newCoreSets[kPsychNumThreadClasses];
+    int i, n;
+
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(3));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    // Validate all arguments before changing anything:
+    for (i = 0; i < kPsychNumThreadClasses; i++) {
+        newCoreSets[i] = coreSets[i];
+        if (PsychAllocInCharArg(i + 1, kPsychArgOptional, &arg) && !PsychParseCoreList(arg, &newCoreSets[i]))
+            PsychErrorExitMsg(PsychError_user, "Invalid core list specified. Must be a string like '0-3,8'.");
+    }
+
+    for (i = 0; i < kPsychNumThreadClasses; i++)
+        coreSets[i] = newCoreSets[i];
+
+    // Reapply to the calling thread, in case the main set changed:
+    PsychAssignThreadToCoreSet("PTB mainthread", (currentThreadClass >= 0) ? (PsychThreadClass) currentThreadClass : kPsychThreadClassMain);
+
+    // Work on a snapshot of the registry, as the output functions can error-exit, which must not
+    // happen with registryMutex locked:
+    PsychLockMutex(&registryMutex);
+    n = numRegisteredThreads;
+    memcpy(registry, threadRegistry, n * sizeof(registry[0]));
+    PsychUnlockMutex(&registryMutex);
+
+    PsychAllocOutStructArray(1, kPsychArgOptional, n, 6, infoFieldNames, &info);
+    for (i = 0; i < n; i++) {
+        PsychSetStructArrayStringElement("name", i, registry[i].name, info);
+        PsychSetStructArrayDoubleElement("threadId", i, (double) registry[i].osThreadId, info);
+        PsychSetStructArrayStringElement("class", i, (char*) coreSetClassNames[registry[i].threadClass], info);
+        PsychFormatCoreList(registry[i].coreMask, coreList, sizeof(coreList));
+        PsychSetStructArrayStringElement("cores", i, coreList, info);
+        PsychSetStructArrayDoubleElement("applied", i, (double) registry[i].coreMaskApplied, info);
+        PsychSetStructArrayDoubleElement("cpuTime", i, PsychGetThreadCPUTime(registry[i].osThreadId), info);
+    }
+
+    PsychAllocOutStructArray(2, kPsychArgOptional, -1, 4, setFieldNames, &sets);
+    for (i = 0; i < kPsychNumThreadClasses; i++) {
+        PsychFormatCoreList(PsychGetClassCoreSet(i), coreList, sizeof(coreList));
+        PsychSetStructArrayStringElement(coreSetClassNames[i], 0, coreList, sets);
+    }
+    PsychSetStructArrayDoubleElement("poolThreads", 0, (double) ((numPoolThreads >= 0) ? numPoolThreads + 1 : 0), sets);
+
+    return(PsychError_none);
+}
@@ -0,0 +1,41 @@
+/*
+  PsychToolbox3/Source/Common/Base/PsychThreadPool.h
+
+  PLATFORMS:  All.
+
+  DESCRIPTION:
+
+  Central management of processor core assignment for the threads of a
+  module, and a shared pool of worker threads for bulk cpu work.
+
+*/
+
+//begin include once
+#ifndef PSYCH_IS_INCLUDED_PsychThreadPool
+#define PSYCH_IS_INCLUDED_PsychThreadPool
+
+#include "Psych.h"
+
+// Classes of threads, each class gets assigned to its own configurable set of cores:
+typedef enum {
+    kPsychThreadClassMain = 0,          // The thread of the scripting environment.
+    kPsychThreadClassRealtime = 1,      // Timing critical threads, e.g., flipper, audio, input and i/o threads.
+    kPsychThreadClassWorker = 2,        // Bulk processing threads, e.g., the shared worker pool.
+    kPsychNumThreadClasses = 3
+} PsychThreadClass;
+
+// Work function for PsychThreadPoolParallelFor(): Process items [begin, end).
+typedef void (*PsychParallelForFunc)(void* context, psych_int64 begin, psych_int64 end);
+
+void            PsychInitThreadPool(void);
+void            PsychExitThreadPool(void);
+int             PsychAssignThreadToCoreSet(const char* name, PsychThreadClass threadClass);
+psych_uint64    PsychGetThreadCoreSet(void);
+psych_uint64    PsychGetThreadClassCoreSet(PsychThreadClass threadClass);
+void            PsychRegisterThreadCoreSet(const char* name, psych_uint64 osThreadId, PsychThreadClass threadClass, psych_uint64 coreMask, int rc);
+int             PsychThreadPoolGetNumThreads(void);
+void            PsychThreadPoolParallelFor(psych_int64 count, psych_int64 grainSize, PsychParallelForFunc func, void* context);
+PsychError      PsychThreadControl(void);
+
+//end include once
+#endif
@@ -103,10 +103,14 @@ static int nrhsGLUE[MAX_RECURSIONLEVEL];  // Number of provided call arguments.
 
 static PyObject* plhsGLUE[MAX_RECURSIONLEVEL][MAX_OUTPUT_ARGS];             // An array of pointers to the Python return arguments.
 static PyObject* prhsGLUE[MAX_RECURSIONLEVEL][MAX_INPUT_ARGS];              // An array of pointers to the Python call arguments.
+static PyObject* poutGLUE[MAX_RECURSIONLEVEL][MAX_OUTPUT_ARGS];             // Borrowed refs to caller-supplied "out=" arrays, or NULL.
 static psych_bool prhsNeedsConversion[MAX_RECURSIONLEVEL][MAX_INPUT_ARGS];  // prhsGLUE needs one-time conversion to NumPy array?
 
 static int recLevel = -1;
 static psych_bool psych_recursion_debug = FALSE;
+
+// Start time of subfunction dispatch at each call recursion level, for tracing:
+static double dispatchStartTime[MAX_RECURSIONLEVEL];
 static int psych_refcount_debug = 0;
 
 // Our own module object:
@@ -115,6 +119,16 @@ static PyObject *module = NULL;
 // Full filesystem path/name to the library (DLL/dylib/libso) that defines this module:
 static char modulefilename[FILENAME_MAX];
 
+// Serializes execution of this module across Python threads, as module state is
+// not thread-safe. Calling threads wait for it with the GIL released. Recursive
+// calls from the owning thread are tracked via moduleLockDepth:
+static psych_mutex moduleLock;
+static PSYCH_THREAD_LOCAL int moduleLockDepth = 0;
+
+// Thread state of the calling thread while it is inside a blocking section and
+// does not hold the GIL, NULL otherwise. See PsychEnterBlockingSection():
+static PSYCH_THREAD_LOCAL PyThreadState* blockingThreadState = NULL;
+
 // MODULE INITIALIZATION FOR PYTHON:
 // =================================
 
@@ -123,7 +137,7 @@ static char modulefilename[FILENAME_MAX];
 #define PPYNAME(...) _PPYNAME(__VA_ARGS__)
 
 static PyMethodDef GlobalPythonMethodsTable[] = {
-    {PPYNAME(PTBMODULENAME), PsychScriptingGluePythonDispatch, METH_VARARGS, NULL},
+    {PPYNAME(PTBMODULENAME), (PyCFunction) PsychScriptingGluePythonDispatch, METH_VARARGS | METH_KEYWORDS, NULL},
     {NULL, NULL, 0, NULL}
 };
 
@@ -137,6 +151,7 @@ static PyMethodDef GlobalPythonMethodsTable[] = {
 PPYINIT(PTBMODULENAME)
 {
     modulefilename[0] = 0;
+    PsychInitMutex(&moduleLock);
 
     // Add a help string with module synopsis to 1st function - our main dispatch function:
     GlobalPythonMethodsTable[0].ml_doc = PsychBuildSynopsisString(PPYNAME(PTBMODULENAME));
@@ -191,6 +206,7 @@ static struct PyModuleDef module_definition = {
 PPYINIT(PTBMODULENAME)
 {
     modulefilename[0] = 0;
+    PsychInitMutex(&moduleLock);
 
     // Add a help string with module synopsis to 1st function - our main dispatch function:
     GlobalPythonMethodsTable[0].ml_doc = PsychBuildSynopsisString(PPYNAME(PTBMODULENAME));
@@ -237,6 +253,8 @@ jmp_buf jmpbuffer[MAX_RECURSIONLEVEL];
 // to the cleanup routine at the end of our PsychScriptingGluePythonDispatch()
 // dispatcher.
 void mexErrMsgTxt(const char* s) {
+    PsychLeaveBlockingSection();
+
     if (s && strlen(s) > 0)
         printf("%s:%s: %s\n", PsychGetModuleName(), PsychGetFunctionName(), s);
     else
@@ -246,6 +264,97 @@ void mexErrMsgTxt(const char* s) {
     longjmp(jmpbuffer[recLevel], 1);
 }
 
+/* PsychEnterBlockingSection() - Release the Python GIL around a blocking wait.
+ *
+ * Called by module code right before it waits for something for a potentially
+ * long time, e.g., a timer, a condition variable or i/o, so other Python threads
+ * can run meanwhile. Only has an effect if the currently executing subfunction was
+ * registered via PsychRegisterBlocking(), otherwise it is a no-op. The code between
+ * PsychEnterBlockingSection() and PsychLeaveBlockingSection() must not touch any
+ * Python objects or call into the scripting glue, other than printf() and the
+ * PsychErrorExit() family, which handle this case. Other threads calling into the
+ * same module wait until this call has finished, see moduleLock, but other modules
+ * and pure Python code keep running.
+ */
+void PsychEnterBlockingSection(void)
+{
+    if (!PsychIsCurrentFunctionBlocking() || blockingThreadState)
+        return;
+
+    blockingThreadState = PyEval_SaveThread();
+}
+
+/* PsychLeaveBlockingSection() - Reacquire the Python GIL after a blocking wait.
+ *
+ * Safe to call if no blocking section is active.
+ */
+void PsychLeaveBlockingSection(void)
+{
+    if (blockingThreadState) {
+        PyEval_RestoreThread(blockingThreadState);
+        blockingThreadState = NULL;
+    }
+}
+
+// Common implementation of the printf() and fprintf() replacements:
+static void PsychPyWrite(int toStderr, const char* format, va_list args)
+{
+    // PySys_WriteStdout() truncates at 1000 characters anyway:
+    char msg[1001];
+    PyThreadState *savedState = blockingThreadState;
+
+    vsnprintf(msg, sizeof(msg), format, args);
+
+    // Need to hold the GIL for printing. Only reacquire it if this thread is within
+    // a blocking section. Other threads, e.g., background worker threads, don't have
+    // a Python thread state to begin with and must not wait for the GIL:
+    if (savedState) {
+        blockingThreadState = NULL;
+        PyEval_RestoreThread(savedState);
+    }
+
+    if (toStderr)
+        PySys_WriteStderr("%s", msg);
+    else
+        PySys_WriteStdout("%s", msg);
+
+    if (savedState)
+        blockingThreadState = PyEval_SaveThread();
+}
+
+void PsychPyWriteStdout(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    PsychPyWrite(0, format, args);
+    va_end(args);
+}
+
+void PsychPyWriteStderr(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    PsychPyWrite(1, format, args);
+    va_end(args);
+}
+
+// Acquire moduleLock for the calling thread, unless it already owns it:
+static void PsychPyLockModule(void)
+{
+    if ((moduleLockDepth++ == 0) && PsychTryLockMutex(&moduleLock)) {
+        // Lock held by another thread, blocked in this module. Wait without holding the GIL:
+        Py_BEGIN_ALLOW_THREADS
+        PsychLockMutex(&moduleLock);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+static void PsychPyUnlockModule(void)
+{
+    if (--moduleLockDepth == 0)
+        PsychUnlockMutex(&moduleLock);
+}
+
 // Interface to printf... TODO Used anywhere?
 void mexPrintf(const char* fmt, ...)
 {
@@ -764,6 +873,10 @@ void PsychExitRecursion(void)
 
     if (psych_recursion_debug) printf("PTB-DEBUG: Module %s leaving recursive call level %i.\n", PsychGetModuleName(), recLevel);
 
+    // Record execution time of this module invocation, if tracing is enabled:
+    if (dispatchStartTime[recLevel] > 0)
+        PsychTraceComplete((strlen(PsychGetFunctionName()) > 0) ? PsychGetFunctionName() : PsychGetModuleName(), dispatchStartTime[recLevel]);
+
     // Done with this call recursion level:
     recLevel--;
 }
@@ -834,8 +947,11 @@ psych_bool PsychUseCMemoryLayoutIfOptimal(psych_bool tryEnableCMemoryLayout)
  *
  *        Modules should now register in subfunction mode to support the build-in 'version' command.
  *
+ *        The only accepted keyword argument is out=, which passes preallocated NumPy arrays to
+ *        receive returned matrices in place, see PsychCreateOutNumericArray().
+ *
  */
-PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
+PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args, PyObject* kwargs)
 {
     psych_bool          isArgThere[2], isArgEmptyMat[2], isArgText[2], isArgFunction[2];
     PsychFunctionPtr    fArg[2], baseFunction;
@@ -850,6 +966,9 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         return(NULL);
     }
 
+    // Only one thread at a time may execute inside this module:
+    PsychPyLockModule();
+
     // Initialization
     if (firstTime) {
         // Reset call recursion level to startup default:
@@ -877,6 +996,12 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         // generator script to find out about subfunctions of a module:
         PsychRegister((char*) "DescribeModuleFunctionsHelper",  &PsychDescribeModuleFunctions);
 
+        // Register helper for control and export of event tracing, see PsychInstrument.c:
+        PsychRegister((char*) "TraceControl",  &PsychTraceControl);
+
+        // Register helper for core assignment of module threads, see PsychThreadPool.c:
+        PsychRegister((char*) "ThreadControl",  &PsychThreadControl);
+
         firstTime = FALSE;
     }
 
@@ -887,11 +1012,15 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
         printf("PTB-CRITICAL: Maximum recursion level %i for recursive calls into module '%s' exceeded!\n", recLevel, PsychGetModuleName());
         printf("PTB-CRITICAL: Aborting call sequence. Check code for recursion bugs!\n");
         recLevel--;
+        PsychPyUnlockModule();
         return(NULL);
     }
 
     if (psych_recursion_debug) printf("PTB-DEBUG: Module %s entering recursive call level %i.\n", PsychGetModuleName(), recLevel);
 
+    // Start of subfunction execution, if tracing is enabled:
+    dispatchStartTime[recLevel] = PsychTraceTimestamp();
+
     // Default to not using C memory layout, but classic (backwards compatible) Fortran layout:
     use_C_memory_layout[recLevel] = FALSE;
 
@@ -942,6 +1071,35 @@ PyObject* PsychScriptingGluePythonDispatch(PyObject* self, PyObject* args)
     // NULL-out our pointer array of return value pointers plhsGLUE[recLevel]:
     memset(&plhsGLUE[recLevel][0], 0, sizeof(plhsGLUE[recLevel]));
 
+    // Assign caller-supplied output arrays, if any. out= can be a single array for the
+    // first return argument, or a tuple or list with one array or None per return argument:
+    memset(&poutGLUE[recLevel][0], 0, sizeof(poutGLUE[recLevel]));
+    if (kwargs && (PyDict_Size(kwargs) > 0)) {
+        tmparg = PyDict_GetItemString(kwargs, "out");
+        if ((tmparg == NULL) || (PyDict_Size(kwargs) > 1))
+            PsychErrorExitMsg(PsychError_user, "Invalid keyword argument. The only supported keyword argument is out=");
+
+        if (PyTuple_Check(tmparg) || PyList_Check(tmparg)) {
+            if (PySequence_Size(tmparg) > MAX_OUTPUT_ARGS)
+                PsychErrorExitMsg(PsychError_user, "Too many output arrays provided in out=");
+
+            for (i = 0; i < (int) PySequence_Size(tmparg); i++) {
+                // PySequence_Fast_GET_ITEM returns a borrowed reference for tuples and lists:
+                poutGLUE[recLevel][i] = PySequence_Fast_GET_ITEM(tmparg, i);
+                if (poutGLUE[recLevel][i] == Py_None)
+                    poutGLUE[recLevel][i] = NULL;
+            }
+        }
+        else if (tmparg != Py_None) {
+            poutGLUE[recLevel][0] = tmparg;
+        }
+
+        for (i = 0; i < MAX_OUTPUT_ARGS; i++) {
+            if (poutGLUE[recLevel][i] && !PyArray_Check(poutGLUE[recLevel][i]))
+                PsychErrorExitMsg(PsychError_user, "Invalid out= argument. Must be a NumPy array, None, or a tuple or list of NumPy arrays or None.");
+        }
+    }
+
     baseFunctionInvoked[recLevel] = FALSE;
 
     // If no subfunctions have been registered by the project then just invoke the project base function
@@ -1162,6 +1320,9 @@ PythonFunctionCleanup:
     // The following code is executed both at end of normal execution, and also
     // during an error return. It has to do the common cleanup work:
 
+    // Reacquire the GIL if a blocking section was left open:
+    PsychLeaveBlockingSection();
+
     // Release references to NumPy PyArrays, as the PyObject -> PyArray code always
     // returns a new reference which we should get rid off, now that we don't need
     // it anymore:
@@ -1183,6 +1344,9 @@ PythonFunctionCleanup:
         plhsGLUE[recLevel][i] = NULL;
     }
 
+    // Forget caller-supplied out= arrays, we only held borrowed references:
+    memset(&poutGLUE[recLevel][0], 0, sizeof(poutGLUE[recLevel]));
+
     // Release all memory allocated via PsychMallocTemp():
     PsychFreeAllTempMemory();
 
@@ -1192,6 +1356,9 @@ PythonFunctionCleanup:
     // Done with this call recursion level:
     PsychExitRecursion();
 
+    // Let other threads in:
+    PsychPyUnlockModule();
+
     // Return PyObject tuple with all return arguments:
     return(plhs);
 }
@@ -1502,6 +1669,72 @@ PyObject *mxCreateByteMatrix3D(size_t m, size_t n, size_t p)
 }
 
 
+/*
+ *    PsychCreateOutNumericArray()
+ *
+ *    Create the numeric array for return argument 'position'. If the caller passed a
+ *    preallocated NumPy array for this return argument via the out= keyword argument,
+ *    and that array matches the requested element type, shape and memory layout, and is
+ *    writeable, then return a new reference to it instead of allocating a new array.
+ *    The subfunction then writes its results in place into the callers array. This
+ *    avoids allocation churn and page faults for functions which return large matrices
+ *    at each call, e.g., images or sound data. If no or a non-matching array was
+ *    supplied, we fall back to allocating a new array.
+ */
+static PyObject* PsychCreateOutNumericArray(int position, int numDims, ptbSize dimArray[], PsychArgFormatType arraytype)
+{
+    PyArrayObject* out = NULL;
+    int i;
+
+    if ((position > 0) && (position <= MAX_OUTPUT_ARGS))
+        out = (PyArrayObject*) poutGLUE[recLevel][position - 1];
+
+    if (out && (PyArray_NDIM(out) == numDims) && PyArray_EquivTypenums(PyArray_TYPE(out), PsychGetNumTypeFromArgType(arraytype)) &&
+        PyArray_ISWRITEABLE(out) && PyArray_ISALIGNED(out) && PyArray_ISNOTSWAPPED(out) &&
+        ((use_C_memory_layout[recLevel]) ? PyArray_IS_C_CONTIGUOUS(out) : PyArray_IS_F_CONTIGUOUS(out))) {
+        for (i = 0; i < numDims; i++) {
+            if (PyArray_DIM(out, i) != (npy_intp) dimArray[i])
+                break;
+        }
+
+        if (i == numDims) {
+            // Match: Return new reference to callers array, the dispatcher will return it as return argument:
+            Py_INCREF(out);
+            return((PyObject*) out);
+        }
+    }
+
+    if (out && DEBUG_PTBPYTHONGLUE)
+        printf("PTB-DEBUG:%s:%s: out= array for return argument %i does not match type, shape or memory layout. Allocating new array.\n",
+               PsychGetModuleName(), PsychGetFunctionName(), position);
+
+    return(mxCreateNumericArray(numDims, dimArray, arraytype));
+}
+
+/*
+ *    PsychCreateOutMatrix3D()
+ *
+ *    Like mxCreateDoubleMatrix3D() et al., but for return argument 'position' and for
+ *    any numeric 'arraytype', reusing a matching caller-supplied out= array if possible.
+ */
+static PyObject* PsychCreateOutMatrix3D(int position, psych_int64 m, psych_int64 n, psych_int64 p, PsychArgFormatType arraytype)
+{
+    int numDims;
+    ptbSize dimArray[3];
+
+    if (m <= 0 || n <= 0) {
+        dimArray[0] = 0; dimArray[1] = 0; dimArray[2] = 0;    //this prevents a 0x1 or 1x0 empty matrix, we want 0x0 for empty matrices.
+    } else {
+        PsychCheckSizeLimits(m, n, p);
+        dimArray[0] = (ptbSize) m; dimArray[1] = (ptbSize) n; dimArray[2] = (ptbSize) p;
+    }
+
+    numDims = (p==0 || p==1) ? 2 : 3;
+
+    return(PsychCreateOutNumericArray(position, numDims, (ptbSize*) dimArray, arraytype));
+}
+
+
 static PyObject* PyExc[PsychError_last + 1] = { 0 };
 
 /*
@@ -1512,6 +1745,9 @@ void PsychProcessErrorInScripting(PsychError error, const char* message)
 {
     PyObject *exception;
 
+    // Need the GIL to set exception state:
+    PsychLeaveBlockingSection();
+
     if (PyExc[PsychError_invalidArg_absent] == NULL) {
         PyExc[PsychError_none] =                                 NULL;
 
@@ -1601,6 +1837,8 @@ void PsychErrMsgTxt(char *s)
 {
     PsychGenericScriptType *pcontent = NULL;
 
+    PsychLeaveBlockingSection();
+
     // Is this the Screen() module?
     if (strcmp(PsychGetModuleName(), "Screen") == 0) {
         // Yes. We directly call our close and cleanup routine:
@@ -1937,7 +2175,7 @@ psych_bool PsychAllocOutDoubleMatArg(int position, PsychArgRequirementType isReq
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateDoubleMatrix3D(m, n, p);
+        *mxpp = PsychCreateOutMatrix3D(position, m, n, p, PsychArgType_double);
         *array = (double*) mxGetData(*mxpp);
     } else
         *array = (double*) mxMalloc(sizeof(double) * (size_t) m * (size_t) n * (size_t) maxInt(1,p));
@@ -1971,7 +2209,7 @@ psych_bool PsychAllocOutFloatMatArg(int position, PsychArgRequirementType isRequ
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateFloatMatrix3D((size_t) m, (size_t) n, (size_t) p);
+        *mxpp = PsychCreateOutMatrix3D(position, m, n, p, PsychArgType_single);
         *array = (float*) mxGetData(*mxpp);
     } else
         *array = (float*) mxMalloc(sizeof(float) * (size_t) m * (size_t) n * (size_t) maxInt(1,p));
@@ -2024,7 +2262,7 @@ psych_bool PsychAllocOutBooleanMatArg(int position, PsychArgRequirementType isRe
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateNativeBooleanMatrix3D((size_t) m, (size_t) n, (size_t) p);
+        *mxpp = PsychCreateOutMatrix3D(position, m, n, p, PsychArgType_boolean);
         *array = (PsychNativeBooleanType *) mxGetLogicals(*mxpp);
     } else {
         *array = (PsychNativeBooleanType *) mxMalloc(sizeof(PsychNativeBooleanType) * (size_t) m * (size_t) n * (size_t) maxInt(1,p));
@@ -2051,7 +2289,7 @@ psych_bool PsychAllocOutUnsignedByteMatArg(int position, PsychArgRequirementType
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateByteMatrix3D((size_t) m, (size_t) n, (size_t) p);
+        *mxpp = PsychCreateOutMatrix3D(position, m, n, p, PsychArgType_uint8);
         *array = (psych_uint8 *) mxGetData(*mxpp);
     } else {
         *array = (psych_uint8 *) mxMalloc(sizeof(psych_uint8) * (size_t) m * (size_t) n * (size_t) maxInt(1,p));
@@ -2090,7 +2328,7 @@ psych_bool PsychAllocOutUnsignedInt16MatArg(int position, PsychArgRequirementTyp
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateNumericArray(numDims, (ptbSize*) dimArray, PsychArgType_uint16);
+        *mxpp = PsychCreateOutNumericArray(position, numDims, (ptbSize*) dimArray, PsychArgType_uint16);
         *array = (psych_uint16 *) mxGetData(*mxpp);
     } else {
         *array = (psych_uint16 *) mxMalloc(sizeof(psych_uint16) * (size_t) m * (size_t) n * (size_t) maxInt(1,p));
@@ -2113,7 +2351,7 @@ psych_bool PsychCopyOutDoubleMatArg(int position, PsychArgRequirementType isRequ
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateDoubleMatrix3D(m, n, p);
+        *mxpp = PsychCreateOutMatrix3D(position, m, n, p, PsychArgType_double);
         toArray = mxGetData(*mxpp);
         //copy the input array to the output array now
         memcpy(toArray, fromArray, sizeof(double) * (size_t) m * (size_t) n * (size_t) maxInt(1,p));
@@ -2148,7 +2386,7 @@ psych_bool PsychCopyOutUnsignedInt16MatArg(int position, PsychArgRequirementType
     putOut = PsychAcceptOutputArgumentDecider(isRequired, matchError);
     if (putOut) {
         mxpp = PsychGetOutArgPyPtr(position);
-        *mxpp = mxCreateNumericArray(numDims, (ptbSize*) dimArray, PsychArgType_uint16);
+        *mxpp = PsychCreateOutNumericArray(position, numDims, (ptbSize*) dimArray, PsychArgType_uint16);
         toArray = (psych_uint16*) mxGetData(*mxpp);
 
         //copy the input array to the output array now
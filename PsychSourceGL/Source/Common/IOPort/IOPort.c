@@ -582,8 +582,10 @@ PsychError IOPORTRead(void)
 
     if (amount < 0) PsychErrorExitMsg(PsychError_user, "Invalid (negative) 'amount' of data to read!");
 
-    // Read data:
+    // Read data, allowing other threads of the runtime to proceed if this is a blocking read:
+    if (blocking > 0) PsychEnterBlockingSection();
     nread = PsychReadIOPort(handle, (void**) &readbuffer, amount, blocking, errmsg, &timestamp);
+    PsychLeaveBlockingSection();
 
     // Allocate outbuffer of proper size:
     PsychAllocOutDoubleMatArg(1, kPsychArgOptional, 1, ((nread >=0) ? nread : 0), 1, &outbuffer);
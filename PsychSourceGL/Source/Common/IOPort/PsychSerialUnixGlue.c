@@ -232,6 +232,7 @@ void* PsychSerialUnixGlueReaderThreadMain( void* deviceToCast)
 
     // Assign a name to ourselves, for debugging:
     PsychSetThreadName("IOPortSerialRd");
+    PsychAssignThreadToCoreSet("IOPortSerialRd", kPsychThreadClassRealtime);
 
     // Try to raise our priority: We ask to switch ourselves (NULL) to priority class 2 aka
     // realtime scheduling, with a tweakPriority of +1, ie., raise the relative
@@ -330,6 +331,7 @@ void* PsychSerialUnixGlueReaderThreadMain( void* deviceToCast)
 
             // Increment serial bytes received counter:
             device->asyncReadBytesCount += (naccumread > 0) ? naccumread : 0;
+            PsychTraceCounter("IOPort:BytesReceived", (double) device->asyncReadBytesCount);
         }
         else {
             // Standard non-linebuffered readop:
@@ -394,6 +396,7 @@ void* PsychSerialUnixGlueReaderThreadMain( void* deviceToCast)
 
             // Increment serial bytes received counter:
             device->asyncReadBytesCount += (nread > 0) ? nread : 0;
+            PsychTraceCounter("IOPort:BytesReceived", (double) device->asyncReadBytesCount);
 
             // Filtermode for filtering out CR and LF characters active (e.g., for UBW32-Bitwhacker with StickOS)?
             if ((device->readFilterFlags & kPsychIOPortCRLFFiltering) &&
@@ -66,7 +66,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("Verbosity", &IOPORTVerbosity));
     PsychErrorExit(PsychRegister("Close",  &IOPORTClose));
     PsychErrorExit(PsychRegister("CloseAll", &IOPORTCloseAll));
-    PsychErrorExit(PsychRegister("Read", &IOPORTRead));
+    PsychErrorExit(PsychRegisterBlocking("Read", &IOPORTRead));
     PsychErrorExit(PsychRegister("Write", &IOPORTWrite));
     PsychErrorExit(PsychRegister("BytesAvailable", &IOPORTBytesAvailable));
     PsychErrorExit(PsychRegister("Purge", &IOPORTPurge));
@@ -387,7 +387,9 @@ int PsychHIDReturnEventFromEventBuffer(int deviceIndex, int outArgIndex, double
     // If nothing available and we're asked to wait for something, then wait:
     if ((navail == 0) && (maxWaitTimeSecs > 0)) {
         // Wait for something:
+        PsychEnterBlockingSection();
         PsychTimedWaitCondition(&hidEventBufferCondition[deviceIndex], &hidEventBufferMutex[deviceIndex], maxWaitTimeSecs);
+        PsychLeaveBlockingSection();
 
         // Recompute number of available events:
         navail = hidEventBufferWritePos[deviceIndex] - hidEventBufferReadPos[deviceIndex];
@@ -496,6 +498,9 @@ int PsychHIDAddEventToEventBuffer(int deviceIndex, PsychHIDEventRecord* evt)
         memcpy(&(hidEventBuffer[deviceIndex][hidEventBufferWritePos[deviceIndex] % hidEventBufferCapacity[deviceIndex]]), evt, sizeof(PsychHIDEventRecord));
         hidEventBufferWritePos[deviceIndex]++;
 
+        // Record enqueue and the event latency since hardware timestamping for tracing:
+        if (PsychTraceIsEnabled()) PsychTraceCounter("KbQueue:EventLatencyMsecs", (PsychTraceTimestamp() - evt->timestamp) * 1000.0);
+
         // Announce new event to potential waiters:
         PsychSignalCondition(&hidEventBufferCondition[deviceIndex]);
     }
@@ -49,14 +49,14 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("KbWait",  &PSYCHHIDKbWait));
     #endif
 
-    PsychErrorExit(PsychRegister("KbTriggerWait", &PSYCHHIDKbTriggerWait));
+    PsychErrorExit(PsychRegisterBlocking("KbTriggerWait", &PSYCHHIDKbTriggerWait));
     PsychErrorExit(PsychRegister("KbQueueCreate", &PSYCHHIDKbQueueCreate));
     PsychErrorExit(PsychRegister("KbQueueStart", &PSYCHHIDKbQueueStart));
     PsychErrorExit(PsychRegister("KbQueueStop", &PSYCHHIDKbQueueStop));
     PsychErrorExit(PsychRegister("KbQueueCheck", &PSYCHHIDKbQueueCheck));
     PsychErrorExit(PsychRegister("KbQueueFlush", &PSYCHHIDKbQueueFlush));
     PsychErrorExit(PsychRegister("KbQueueRelease", &PSYCHHIDKbQueueRelease));
-    PsychErrorExit(PsychRegister("KbQueueGetEvent", &PSYCHHIDKbQueueGetEvent));
+    PsychErrorExit(PsychRegisterBlocking("KbQueueGetEvent", &PSYCHHIDKbQueueGetEvent));
 
     PsychErrorExit(PsychRegister("RawState",  &PSYCHHIDGetRawState));
     PsychErrorExit(PsychRegister("KbCheck",  &PSYCHHIDKbCheck));
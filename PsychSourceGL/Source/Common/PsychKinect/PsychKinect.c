@@ -212,6 +212,9 @@ void* PsychKinectThreadMain(volatile void* deviceToCast)
 
 	// Child protection:
 	if ((NULL == kinect) || (NULL == kinect->dev)) return(NULL);
+
+	PsychSetThreadName("PsychKinectCapture");
+	PsychAssignThreadToCoreSet("PsychKinectCapture", kPsychThreadClassRealtime);
 	
 	// Start kinect's iso streaming:
 	freenect_start_depth(kinect->dev);
@@ -2435,6 +2435,7 @@ static void* PresenterThreadMain(void* psychOculusDeviceToCast)
 
     // Assign a name to ourselves, for debugging:
     PsychSetThreadName("PsychOculusVR1PresenterThread");
+    PsychAssignThreadToCoreSet("PsychOculusVR1PresenterThread", kPsychThreadClassRealtime);
 
     // VR compositor timeout prevention loop: Repeats infinitely, well, not infinitely,
     // but until we receive a shutdown request and terminate ourselves...
@@ -300,6 +300,12 @@ typedef struct PsychPADevice {
     // Mixer volume related:
     float*    outChannelVolumes;    // Array of per-outputchannel volume settings on slave devices, NULL and not used on non-slave devices.
     float    masterVolume;          // Master volume setting for all non-slave audio devices, i.e., masters and regular devices. Unused on slaves.
+
+    // Processor core assignment of the callback thread, see paCallback():
+    volatile int    coreSetState;   // 0 = Nothing to do, 1 = Callback shall apply coreSetMask, 2 = Applied, needs registration by main thread.
+    psych_uint64    coreSetMask;    // Realtime core set to apply.
+    volatile int    coreSetRc;      // Error code of core assignment.
+    volatile psych_uint64 coreSetThreadId;  // OS thread id of callback thread.
 } PsychPADevice;
 
 PsychPADevice audiodevices[MAX_PSYCH_AUDIO_DEVS];
@@ -533,7 +539,9 @@ int PsychPADeleteAudioBuffer(int handle, int waitmode)
 
         // In waitmode 1, we retry spin-waiting until buffer available:
         while (buffer->locked) {
+            PsychEnterBlockingSection();
             PsychYieldIntervalSeconds(yieldInterval);
+            PsychLeaveBlockingSection();
             PsychPAUpdateBufferReferences();
         }
     }
@@ -599,11 +607,15 @@ static void PsychPAWaitForChange(PsychPADevice* dev)
     if (uselocking) {
         // Locking and signalling: We have to wait for a signal, and we
         // enter here with the device mutex held. Waiting is operating system dependent:
+        PsychEnterBlockingSection();
         PsychWaitCondition(&(dev->changeSignal), &(dev->mutex));
+        PsychLeaveBlockingSection();
     }
     else {
         // No locking and signalling: Just yield for a bit, then retry...
+        PsychEnterBlockingSection();
         PsychYieldIntervalSeconds(yieldInterval);
+        PsychLeaveBlockingSection();
     }
 }
 
@@ -853,6 +865,9 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
     return(0);
 }
 
+static int paCallback( const void *inputBuffer, void *outputBuffer, unsigned long framesPerBuffer,
+                       const PaStreamCallbackTimeInfo* timeInfo, PaStreamCallbackFlags statusFlags, void *userData );
+
 /* paCallback: PortAudo I/O processing callback.
  *
  * This callback is called by PortAudios playback/capture engine whenever
@@ -866,8 +881,11 @@ int PsychPAProcessSchedule(PsychPADevice* dev, psych_int64 *playposition, float*
  * This callback is part of a realtime/interrupt/system context so don't do
  * things like calling PortAudio functions, allocating memory, file i/o or
  * other unbounded operations!
+ *
+ * The actual work is done in paCallbackProcess(), this wrapper only records
+ * the duration of each invocation for event tracing, if enabled.
  */
-static int paCallback( const void *inputBuffer, void *outputBuffer,
+static int paCallbackProcess( const void *inputBuffer, void *outputBuffer,
                        unsigned long framesPerBuffer,
                        const PaStreamCallbackTimeInfo* timeInfo,
                        PaStreamCallbackFlags statusFlags,
@@ -1677,11 +1695,48 @@ static int paCallback( const void *inputBuffer, void *outputBuffer,
     return(paContinue);
 }
 
+static int paCallback( const void *inputBuffer, void *outputBuffer,
+                       unsigned long framesPerBuffer,
+                       const PaStreamCallbackTimeInfo* timeInfo,
+                       PaStreamCallbackFlags statusFlags,
+                       void *userData )
+{
+    PsychPADevice* dev = (PsychPADevice*) userData;
+    double tTrace = PsychTraceTimestamp();
+    int rc;
+
+    // Never allocate or block on trace buffers in the realtime callback:
+    PsychTraceSetThreadRealtime();
+
+    // Keep the audio thread of the host api on the realtime cores, as requested at 'Start'. Only the
+    // affinity gets set here, registration and error reporting is done by PsychPARegisterCoreSet():
+    if (dev->coreSetState == 1) {
+        dev->coreSetThreadId = PsychTraceGetOSThreadId();
+        dev->coreSetRc = PsychSetThreadCoreMask(dev->coreSetMask, NULL);
+        dev->coreSetState = 2;
+    }
+
+    rc = paCallbackProcess(inputBuffer, outputBuffer, framesPerBuffer, timeInfo, statusFlags, userData);
+    PsychTraceComplete("paCallback", tTrace);
+    return(rc);
+}
+
+// Register the core assignment of the callback thread of device 'dev', once paCallback() applied it:
+static void PsychPARegisterCoreSet(PsychPADevice* dev)
+{
+    if (dev->coreSetState == 2) {
+        PsychRegisterThreadCoreSet("PortAudioCallback", dev->coreSetThreadId, kPsychThreadClassRealtime, dev->coreSetMask, dev->coreSetRc);
+        dev->coreSetState = 0;
+    }
+}
+
 void PsychPACloseStream(int id)
 {
     int pamaster, i;
     PaStream* stream = audiodevices[id].stream;
 
+    PsychPARegisterCoreSet(&audiodevices[id]);
+
     // Valid and active device?
     if (stream) {
         // Need different destruction procedures for normals vs. masters vs. slaves:
@@ -3054,6 +3109,9 @@ PsychError PSYCHPORTAUDIOOpen(void)
     // One more audio device...
     audiodevicecount++;
 
+    // Preallocate trace buffers for the realtime callback threads of all open devices:
+    PsychTraceReserveBuffers(audiodevicecount);
+
     return(PsychError_none);
 }
 
@@ -3734,7 +3792,9 @@ PsychError PSYCHPORTAUDIOFillAudioBuffer(void)
             PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
             // TODO: We could do better here by predicting how long it will take at least until we're ready to refill,
             // but a perfect solution would require quite a bit of effort... ...Something for a really boring afternoon.
+            PsychEnterBlockingSection();
             PsychYieldIntervalSeconds(yieldInterval);
+            PsychLeaveBlockingSection();
             PsychPALockDeviceMutex(&audiodevices[pahandle]);
 
             // Recheck for buffer underrun:
@@ -4074,7 +4134,9 @@ PsychError PSYCHPORTAUDIODeleteBuffer(void)
             }
             else {
                 // Retry until it works:
+                PsychEnterBlockingSection();
                 while (PsychPAUpdateBufferReferences()) PsychYieldIntervalSeconds(yieldInterval);
+                PsychLeaveBlockingSection();
                 rc = 1;
             }
         }
@@ -4395,7 +4457,9 @@ PsychError PSYCHPORTAUDIOGetAudioData(void)
             minSecs = (minSamples - (double) insamples) / ((double) audiodevices[pahandle].inchannels) / ((double) audiodevices[pahandle].streaminfo->sampleRate);
             // Ok, required data will be available earliest in 'minSecs' seconds. Sleep until then with lock dropped:
             PsychPAUnlockDeviceMutex(&audiodevices[pahandle]);
+            PsychEnterBlockingSection();
             PsychWaitIntervalSeconds(minSecs);
+            PsychLeaveBlockingSection();
             PsychPALockDeviceMutex(&audiodevices[pahandle]);
 
             // We've slept at least the estimated amount of required time. Recalculate amount
@@ -4688,7 +4752,9 @@ PsychError PSYCHPORTAUDIORescheduleStart(void)
         // Ok, relevant audio buffer with real sound onset submitted to engine.
         // We now have an estimate of real sound onset in startTime, wait until
         // then:
+        PsychEnterBlockingSection();
         PsychWaitUntilSeconds(audiodevices[pahandle].startTime);
+        PsychLeaveBlockingSection();
 
         // Engine should run now. Return real onset time:
         PsychCopyOutDoubleArg(1, kPsychArgOptional, audiodevices[pahandle].startTime);
@@ -4852,6 +4918,11 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
             // Safeguard: If the stream is not stopped, do it now:
             if (!Pa_IsStreamStopped(audiodevices[pahandle].stream)) Pa_StopStream(audiodevices[pahandle].stream);
 
+            // Ask the callback thread of the started stream to move to the realtime cores, if any:
+            PsychPARegisterCoreSet(&audiodevices[pahandle]);
+            audiodevices[pahandle].coreSetMask = PsychGetThreadClassCoreSet(kPsychThreadClassRealtime);
+            audiodevices[pahandle].coreSetState = (audiodevices[pahandle].coreSetMask) ? 1 : 0;
+
             // Start engine:
             if ((err=Pa_StartStream(audiodevices[pahandle].stream))!=paNoError) {
                 printf("PTB-ERROR: Failed to start audio device %i. PortAudio reports this error: %s \n", pahandle, Pa_GetErrorText(err));
@@ -4897,7 +4968,9 @@ PsychError PSYCHPORTAUDIOStartAudioDevice(void)
         // Ok, relevant audio buffer with real sound onset submit to engine.
         // We now have an estimate of real sound onset in startTime, wait until
         // then:
+        PsychEnterBlockingSection();
         PsychWaitUntilSeconds(audiodevices[pahandle].startTime);
+        PsychLeaveBlockingSection();
 
         // Engine should run now. Return real onset time:
         PsychCopyOutDoubleArg(1, kPsychArgOptional, audiodevices[pahandle].startTime);
@@ -4982,6 +5055,9 @@ PsychError PSYCHPORTAUDIOStopAudioDevice(void)
     PsychCopyInIntegerArg(1, kPsychArgRequired, &pahandle);
     if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
 
+    // Register core assignment of the callback thread, now that it likely happened:
+    PsychPARegisterCoreSet(&audiodevices[pahandle]);
+
     // Get optional wait-flag:
     PsychCopyInIntegerArg(2, kPsychArgOptional, &waitforend);
 
@@ -5227,6 +5303,9 @@ PsychError PSYCHPORTAUDIOGetStatus(void)
     PsychCopyInIntegerArg(1, kPsychArgRequired, &pahandle);
     if (pahandle < 0 || pahandle>=MAX_PSYCH_AUDIO_DEVS || audiodevices[pahandle].stream == NULL) PsychErrorExitMsg(PsychError_user, "Invalid audio device handle provided.");
 
+    // Register core assignment of the callback thread, now that it likely happened:
+    PsychPARegisterCoreSet(&audiodevices[pahandle]);
+
     PsychAllocOutStructArray(1, kPsychArgOptional, -1, 23, FieldNames, &status);
 
     // Ok, in a perfect world we should hold the device mutex while querying all the device state.
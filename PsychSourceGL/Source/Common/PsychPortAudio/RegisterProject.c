@@ -39,15 +39,15 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("Open", &PSYCHPORTAUDIOOpen));
     PsychErrorExit(PsychRegister("OpenSlave", &PSYCHPORTAUDIOOpenSlave));
     PsychErrorExit(PsychRegister("Close", &PSYCHPORTAUDIOClose));
-    PsychErrorExit(PsychRegister("Start", &PSYCHPORTAUDIOStartAudioDevice));
-    PsychErrorExit(PsychRegister("RescheduleStart", &PSYCHPORTAUDIORescheduleStart));
-    PsychErrorExit(PsychRegister("Stop", &PSYCHPORTAUDIOStopAudioDevice));
-    PsychErrorExit(PsychRegister("FillBuffer", &PSYCHPORTAUDIOFillAudioBuffer));
-    PsychErrorExit(PsychRegister("RefillBuffer", &PSYCHPORTAUDIORefillBuffer));
+    PsychErrorExit(PsychRegisterBlocking("Start", &PSYCHPORTAUDIOStartAudioDevice));
+    PsychErrorExit(PsychRegisterBlocking("RescheduleStart", &PSYCHPORTAUDIORescheduleStart));
+    PsychErrorExit(PsychRegisterBlocking("Stop", &PSYCHPORTAUDIOStopAudioDevice));
+    PsychErrorExit(PsychRegisterBlocking("FillBuffer", &PSYCHPORTAUDIOFillAudioBuffer));
+    PsychErrorExit(PsychRegisterBlocking("RefillBuffer", &PSYCHPORTAUDIORefillBuffer));
     PsychErrorExit(PsychRegister("GetDevices", &PSYCHPORTAUDIOGetDevices));
     PsychErrorExit(PsychRegister("GetStatus", &PSYCHPORTAUDIOGetStatus));
     PsychErrorExit(PsychRegister("LatencyBias", &PSYCHPORTAUDIOLatencyBias));
-    PsychErrorExit(PsychRegister("GetAudioData", &PSYCHPORTAUDIOGetAudioData));
+    PsychErrorExit(PsychRegisterBlocking("GetAudioData", &PSYCHPORTAUDIOGetAudioData));
     PsychErrorExit(PsychRegister("RunMode", &PSYCHPORTAUDIORunMode));
     PsychErrorExit(PsychRegister("SetLoop", &PSYCHPORTAUDIOSetLoop));
     PsychErrorExit(PsychRegister("EngineTunables", &PSYCHPORTAUDIOEngineTunables));
@@ -55,7 +55,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("UseSchedule", &PSYCHPORTAUDIOUseSchedule));
     PsychErrorExit(PsychRegister("AddToSchedule", &PSYCHPORTAUDIOAddToSchedule));
     PsychErrorExit(PsychRegister("CreateBuffer", &PSYCHPORTAUDIOCreateBuffer));
-    PsychErrorExit(PsychRegister("DeleteBuffer", &PSYCHPORTAUDIODeleteBuffer));
+    PsychErrorExit(PsychRegisterBlocking("DeleteBuffer", &PSYCHPORTAUDIODeleteBuffer));
     PsychErrorExit(PsychRegister("SetOpMode", &PSYCHPORTAUDIOSetOpMode));
     PsychErrorExit(PsychRegister("DirectInputMonitoring", &PSYCHPORTAUDIODirectInputMonitoring));
     PsychErrorExit(PsychRegister("Volume", &PSYCHPORTAUDIOVolume));
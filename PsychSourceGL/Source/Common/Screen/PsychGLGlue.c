@@ -872,3 +872,211 @@ void PsychDrawDisc(PsychWindowRecordType *windowRecord, float xc, float yc, floa
 
     return;
 }
+
+/* Streaming vertex batches for 2D primitives:
+ *
+ * Batch capable drawing commands like 'FillRect', 'FrameRect' and 'FillOval' don't submit each
+ * primitive separately, but write the triangles of all primitives into a client side staging
+ * buffer. The buffer gets uploaded into a streaming vertex buffer object of the onscreen window
+ * and drawn with one single glDrawArrays() call whenever it is full, or when the drawing command
+ * is done, ie. calls PsychBatchFlush(). Each vertex is a (x,y) position, followed by a (r,g,b,a)
+ * color if the primitives have individual colors, otherwise the current color is used.
+ *
+ * Only used on classic OpenGL. Callers need to use their regular drawing path if PsychBatchBegin()
+ * returns FALSE.
+ */
+#define PSYCH_MAX_BATCH_VERTICES 65536
+static float batch_buffer[PSYCH_MAX_BATCH_VERTICES * 6];
+static int batch_count = 0;
+static int batch_stride = 2;
+static float batch_color[4];
+
+psych_bool PsychBatchBegin(PsychWindowRecordType *windowRecord, psych_bool perVertexColors)
+{
+    if (!PsychIsGLClassic(windowRecord)) return(FALSE);
+
+    batch_count = 0;
+    batch_stride = (perVertexColors) ? 6 : 2;
+
+    return(TRUE);
+}
+
+/* PsychStreamVertexData()
+ *
+ * Upload 'size' bytes of vertex 'data' into the streaming vertex buffer object of the onscreen
+ * window of 'windowRecord' and bind it as GL_ARRAY_BUFFER. Returns the base pointer to use for
+ * the following gl...Pointer() calls, ie. NULL for the VBO, or 'data' itself if VBO's are not
+ * supported. Call PsychStreamVertexDataDone() after the draw calls which use the data.
+ */
+char* PsychStreamVertexData(PsychWindowRecordType *windowRecord, const void* data, size_t size)
+{
+    PsychWindowRecordType *parentRecord;
+
+    if (!GLEW_VERSION_1_5) return((char*) data);
+
+    parentRecord = PsychGetParentWindow(windowRecord);
+    if (parentRecord->primitiveBatchVBO == 0) glGenBuffers(1, &parentRecord->primitiveBatchVBO);
+
+    // Respecifying the whole buffer orphans the storage of the previous batch, so we don't have
+    // to wait for the GPU to finish drawing from it:
+    glBindBuffer(GL_ARRAY_BUFFER, parentRecord->primitiveBatchVBO);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr) size, data, GL_STREAM_DRAW);
+
+    return(NULL);
+}
+
+void PsychStreamVertexDataDone(void)
+{
+    if (GLEW_VERSION_1_5) glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void PsychBatchFlush(PsychWindowRecordType *windowRecord)
+{
+    GLsizei stride = batch_stride * sizeof(float);
+    char *base;
+
+    if (batch_count == 0) return;
+
+    base = PsychStreamVertexData(windowRecord, batch_buffer, (size_t) batch_count * stride);
+
+    glVertexPointer(2, GL_FLOAT, stride, base);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    if (batch_stride == 6) {
+        if (windowRecord->defaultDrawShader) {
+            // Shader based unclamped path: Colors go into the texture coordinates:
+            glTexCoordPointer(4, GL_FLOAT, stride, base + 2 * sizeof(float));
+            glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        }
+        else {
+            glColorPointer(4, GL_FLOAT, stride, base + 2 * sizeof(float));
+            glEnableClientState(GL_COLOR_ARRAY);
+        }
+    }
+
+    glDrawArrays(GL_TRIANGLES, 0, batch_count);
+
+    if (batch_stride == 6) {
+        if (windowRecord->defaultDrawShader) {
+            glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+            glTexCoordPointer(4, GL_FLOAT, 0, NULL);
+        }
+        else {
+            glDisableClientState(GL_COLOR_ARRAY);
+            glColorPointer(4, GL_FLOAT, 0, NULL);
+        }
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, NULL);
+
+    PsychStreamVertexDataDone();
+
+    batch_count = 0;
+}
+
+/* Set color of the following primitives of a batch with per vertex colors from the i'th
+ * element of a color array, as returned by PsychPrepareRenderBatch().
+ */
+void PsychBatchSetColor(int i, int mc, double* colors, unsigned char *bytecolors)
+{
+    if (colors) {
+        colors += i * mc;
+        batch_color[0] = (float) colors[0];
+        batch_color[1] = (float) colors[1];
+        batch_color[2] = (float) colors[2];
+        batch_color[3] = (mc == 4) ? (float) colors[3] : 1.0f;
+    }
+    else {
+        bytecolors += i * mc;
+        batch_color[0] = (float) bytecolors[0] / 255.0f;
+        batch_color[1] = (float) bytecolors[1] / 255.0f;
+        batch_color[2] = (float) bytecolors[2] / 255.0f;
+        batch_color[3] = (mc == 4) ? (float) bytecolors[3] / 255.0f : 1.0f;
+    }
+}
+
+// Reserve space for 'count' vertices in the batch, flushing it first if it is full:
+static float* PsychBatchReserve(PsychWindowRecordType *windowRecord, int count)
+{
+    float *v;
+
+    if (batch_count + count > PSYCH_MAX_BATCH_VERTICES) PsychBatchFlush(windowRecord);
+
+    v = &batch_buffer[batch_count * batch_stride];
+    batch_count += count;
+
+    return(v);
+}
+
+static float* PsychBatchPutVertex(float *v, float x, float y)
+{
+    *(v++) = x;
+    *(v++) = y;
+
+    if (batch_stride == 6) {
+        *(v++) = batch_color[0];
+        *(v++) = batch_color[1];
+        *(v++) = batch_color[2];
+        *(v++) = batch_color[3];
+    }
+
+    return(v);
+}
+
+// Add a rectangle, drawn as two triangles with the same corners as a glRectd():
+void PsychBatchAddRect(PsychWindowRecordType *windowRecord, double x1, double y1, double x2, double y2)
+{
+    float *v = PsychBatchReserve(windowRecord, 6);
+
+    v = PsychBatchPutVertex(v, (float) x1, (float) y1);
+    v = PsychBatchPutVertex(v, (float) x2, (float) y1);
+    v = PsychBatchPutVertex(v, (float) x2, (float) y2);
+    v = PsychBatchPutVertex(v, (float) x1, (float) y1);
+    v = PsychBatchPutVertex(v, (float) x2, (float) y2);
+    v = PsychBatchPutVertex(v, (float) x1, (float) y2);
+}
+
+// Add a filled ellipse with center (xc,yc) and radii xRadius and yRadius, subdivided into 'numSlices' triangles:
+void PsychBatchAddOval(PsychWindowRecordType *windowRecord, double xc, double yc, double xRadius, double yRadius, int numSlices)
+{
+    double c, s, t, cstep, sstep;
+    float *v;
+    float x0, y0;
+    int i, n;
+
+    if (numSlices < 3) numSlices = 3;
+
+    cstep = cos(2 * M_PI / numSlices);
+    sstep = sin(2 * M_PI / numSlices);
+    c = 1;
+    s = 0;
+    x0 = (float) (xc + xRadius);
+    y0 = (float) yc;
+
+    // Add the triangle fan around the center in chunks which fit into the batch buffer:
+    while (numSlices > 0) {
+        n = (numSlices < PSYCH_MAX_BATCH_VERTICES / 3) ? numSlices : PSYCH_MAX_BATCH_VERTICES / 3;
+        numSlices -= n;
+        v = PsychBatchReserve(windowRecord, n * 3);
+
+        for (i = 0; i < n; i++) {
+            // Rotate by one slice. Last vertex of the oval gets closed exactly onto the first one:
+            t = c * cstep - s * sstep;
+            s = s * cstep + c * sstep;
+            c = t;
+
+            v = PsychBatchPutVertex(v, (float) xc, (float) yc);
+            v = PsychBatchPutVertex(v, x0, y0);
+            if ((numSlices == 0) && (i == n - 1)) {
+                x0 = (float) (xc + xRadius);
+                y0 = (float) yc;
+            }
+            else {
+                x0 = (float) (xc + xRadius * c);
+                y0 = (float) (yc + yRadius * s);
+            }
+            v = PsychBatchPutVertex(v, x0, y0);
+        }
+    }
+}
@@ -28,6 +28,7 @@
 */
 
 #include "Screen.h"
+#include <ctype.h>
 
 static char texturePlanar1FragmentShaderSrc[] =
 "\n"
@@ -423,6 +424,7 @@ void PsychInitImagingPipelineDefaultsForWindowRecord(PsychWindowRecordType *wind
     windowRecord->preConversionFBO[0]=-1;
     windowRecord->preConversionFBO[1]=-1;
     windowRecord->preConversionFBO[2]=-1;
+    windowRecord->preConversionFBO[3]=-1;
     windowRecord->finalizedFBO[0]=-1;
     windowRecord->finalizedFBO[1]=-1;
     windowRecord->fboCount = 0;
@@ -2654,22 +2656,132 @@ void PsychDeleteFBO(PsychFBO* fboptr)
     free(fboptr); fboptr = NULL;
 }
 
+/* PsychGetFBOPoolOwner()
+ *
+ * Return the onscreen window which owns the FBO pool for FBO's of 'windowRecord', or NULL if
+ * there isn't any anymore. FBO's are not shared between OpenGL contexts, so each onscreen window
+ * has its own pool. Offscreen windows and textures use the context of their parent onscreen window,
+ * but the chain of parent windows can contain already closed windows, so we search by context.
+ */
+static PsychWindowRecordType* PsychGetFBOPoolOwner(PsychWindowRecordType *windowRecord)
+{
+    PsychWindowRecordType **windowRecordArray, *owner = NULL;
+    int i, numWindows;
+
+    if (PsychIsOnscreenWindow(windowRecord)) return(windowRecord);
+    if (windowRecord->targetSpecific.contextObject == NULL) return(NULL);
+
+    PsychCreateVolatileWindowRecordPointerList(&numWindows, &windowRecordArray);
+    for (i = 0; i < numWindows; i++) {
+        if (PsychIsOnscreenWindow(windowRecordArray[i]) && (windowRecordArray[i]->targetSpecific.contextObject == windowRecord->targetSpecific.contextObject)) {
+            owner = windowRecordArray[i];
+            break;
+        }
+    }
+    PsychDestroyVolatileWindowRecordPointerList(windowRecordArray);
+
+    return(owner);
+}
+
+// Would PsychCreateFBO() with the given parameters create an FBO compatible to fbo?
+static psych_bool PsychIsFBOCompatible(PsychFBO* fbo, GLenum fboInternalFormat, psych_bool needzbuffer, int width, int height, int specialFlags)
+{
+    GLenum texturetarget = ((specialFlags & 0x1) || PsychIsGLES(NULL)) ? GL_TEXTURE_2D : GL_TEXTURE_RECTANGLE_EXT;
+
+    return((fbo->fboid != 0) && (fbo->multisample == 0) && (fbo->format == fboInternalFormat) && (fbo->width == width) && (fbo->height == height) &&
+           (fbo->textarget == texturetarget) && ((fbo->ztexid != 0) == (needzbuffer != FALSE)));
+}
+
+/* PsychCreatePooledFBO()
+ *
+ * Like PsychCreateFBO(), but reuse a compatible idle FBO from the FBO pool of the onscreen window
+ * owning the OpenGL context of 'windowRecord', if possible. This avoids allocation hitches, e.g.,
+ * when opening offscreen windows in a loop. The content of a reused FBO is undefined. Only fully
+ * initialized single-sample FBO's are pooled.
+ */
+psych_bool PsychCreatePooledFBO(PsychWindowRecordType *windowRecord, PsychFBO** fbo, GLenum fboInternalFormat, psych_bool needzbuffer, int width, int height, int multisample, int specialFlags)
+{
+    PsychWindowRecordType *owner;
+    int i;
+
+    if ((multisample <= 0) && (fboInternalFormat > 1) && (owner = PsychGetFBOPoolOwner(windowRecord))) {
+        // Search most recently released first, it is most likely still resident in VRAM:
+        for (i = owner->fboPoolCount - 1; i >= 0; i--) {
+            if (PsychIsFBOCompatible(owner->fboPool[i], fboInternalFormat, needzbuffer, width, height, specialFlags)) {
+                *fbo = owner->fboPool[i];
+                owner->fboPoolCount--;
+                memmove(&(owner->fboPool[i]), &(owner->fboPool[i + 1]), (owner->fboPoolCount - i) * sizeof(PsychFBO*));
+
+                if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: Reusing pooled FBO %i of size %i x %i.\n", (*fbo)->fboid, width, height);
+                return(TRUE);
+            }
+        }
+    }
+
+    return(PsychCreateFBO(fbo, fboInternalFormat, needzbuffer, width, height, multisample, specialFlags));
+}
+
+/* PsychReleasePooledFBO()
+ *
+ * Release an FBO which is no longer needed by 'windowRecord' into the FBO pool of the onscreen window
+ * which owns its OpenGL context. If the pool is full, the least recently released FBO gets deleted.
+ * FBO's which are not suitable for pooling, or without a pool owner, are deleted immediately.
+ */
+void PsychReleasePooledFBO(PsychWindowRecordType *windowRecord, PsychFBO* fbo)
+{
+    PsychWindowRecordType *owner;
+
+    if (fbo == NULL)
+        return;
+
+    owner = PsychGetFBOPoolOwner(windowRecord);
+    if ((owner == NULL) || (fbo->fboid == 0) || (fbo->multisample > 0) || (fbo->format <= 1)) {
+        PsychDeleteFBO(fbo);
+        return;
+    }
+
+    PsychSetGLContext(owner);
+
+    if (owner->fboPoolCount == kPsychFBOPoolSize) {
+        PsychDeleteFBO(owner->fboPool[0]);
+        owner->fboPoolCount--;
+        memmove(&(owner->fboPool[0]), &(owner->fboPool[1]), owner->fboPoolCount * sizeof(PsychFBO*));
+    }
+
+    owner->fboPool[owner->fboPoolCount++] = fbo;
+}
+
+/* PsychReleaseFBOPool()
+ *
+ * Delete all idle FBO's in the FBO pool of onscreen window 'windowRecord'. Called at window close
+ * time with the windows OpenGL context bound.
+ */
+void PsychReleaseFBOPool(PsychWindowRecordType *windowRecord)
+{
+    while (windowRecord->fboPoolCount > 0) PsychDeleteFBO(windowRecord->fboPool[--(windowRecord->fboPoolCount)]);
+}
+
 /* PsychMSAAResolveToTemp()
  *
  * Check if given msaaFBO is multi-sampled. If not, return NULL.
- * If yes, create a matching single-sample PsychFBO, MSAA resolve
+ * If yes, get a matching single-sample PsychFBO, MSAA resolve
  * msaaFBO into it, and return the resolved PsychFBO. Also bind the
- * resolved FBO for immediate use.
+ * resolved FBO for immediate use. Release it after use via
+ * PsychReleaseMSAAResolveTemp().
+ *
+ * The resolve buffer is a dedicated buffer from the FBO pool. The bounce
+ * buffers of the imaging pipeline are never used for this, as the async
+ * flipper thread may be executing the pipeline on them at the same time.
  */
-PsychFBO* PsychMSAAResolveToTemp(PsychFBO* msaaFBO)
+PsychFBO* PsychMSAAResolveToTemp(PsychWindowRecordType *windowRecord, PsychFBO* msaaFBO)
 {
-    PsychFBO* resolvedFBO;
+    PsychFBO* resolvedFBO = NULL;
 
     // Nothing to do on single-sample buffers:
     if (msaaFBO->multisample == 0)
         return(NULL);
 
-    if (!PsychCreateFBO(&resolvedFBO, msaaFBO->format, FALSE, msaaFBO->width, msaaFBO->height, 0, 0)) {
+    if (!PsychCreatePooledFBO(windowRecord, &resolvedFBO, msaaFBO->format, FALSE, msaaFBO->width, msaaFBO->height, 0, 0)) {
         PsychErrorExitMsg(PsychError_system, "Failed to create temporary MSAA resolve buffer from MSAA drawBuffer!");
     }
 
@@ -2682,6 +2794,18 @@ PsychFBO* PsychMSAAResolveToTemp(PsychFBO* msaaFBO)
     return(resolvedFBO);
 }
 
+/* PsychReleaseMSAAResolveTemp()
+ *
+ * Release a resolve buffer returned by PsychMSAAResolveToTemp(), if any.
+ */
+void PsychReleaseMSAAResolveTemp(PsychWindowRecordType *windowRecord, PsychFBO* resolvedFBO)
+{
+    if (resolvedFBO == NULL)
+        return;
+
+    PsychReleasePooledFBO(windowRecord, resolvedFBO);
+}
+
 /* PsychCreateShadowFBOForTexture()
  * Check if provided PTB texture already has a PsychFBO attached. Do nothing if so.
  * If a FBO is missing, create one.
@@ -3018,9 +3142,19 @@ void PsychShutdownImagingPipeline(PsychWindowRecordType *windowRecord, psych_boo
 {
     int i;
     PsychFBO* fboptr;
+    PtrPsychHookFunction hookfunc;
 
     // Do OpenGL specific cleanup:
     if (openglpart) {
+        // Release timer queries of all hook slots:
+        for (i=0; i<MAX_SCREEN_HOOKS; i++) {
+            for (hookfunc = windowRecord->HookChain[i]; hookfunc; hookfunc = hookfunc->next) PsychPipelineReleaseHookSlotTiming(windowRecord, hookfunc);
+            PsychPipelineReleaseFusedShaderPasses(windowRecord, i);
+        }
+
+        // Release idle FBO's in our FBO pool:
+        if (PsychIsOnscreenWindow(windowRecord)) PsychReleaseFBOPool(windowRecord);
+
         // Yes. Mode specific cleanup:
         for (i=0; i<windowRecord->fboCount; i++) {
             // Delete i'th FBO, if any:
@@ -3143,6 +3277,9 @@ PsychHookFunction* PsychAddNewHookFunction(PsychWindowRecordType *windowRecord,
     hookfunc->idString = (idString) ? strdup(idString) : strdup("");
     hookfunc->hookfunctype = hookfunctype;
 
+    // Chain changed, so any fused shader passes are outdated:
+    PsychPipelineReleaseFusedShaderPasses(windowRecord, hookidx);
+
     // Return pointer to new hook slot:
     return(hookfunc);
 }
@@ -3174,11 +3311,13 @@ void PsychPipelineResetHook(PsychWindowRecordType *windowRecord, const char* hoo
     PtrPsychHookFunction hookfunc, hookiter;
     int hookidx=PsychGetHookByName(hookString);
     if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "ResetHook: Unknown (non-existent) hook name provided.");
+    PsychPipelineReleaseFusedShaderPasses(windowRecord, hookidx);
     hookiter = windowRecord->HookChain[hookidx];
     while(hookiter) {
         hookfunc = hookiter;
         hookiter = hookiter->next;
-        // Delete all referenced memory:
+        // Delete all referenced memory and timer queries:
+        PsychPipelineReleaseHookSlotTiming(windowRecord, hookfunc);
         free(hookfunc->idString);
         free(hookfunc->pString1);
         // Delete hookfunc struct itself:
@@ -3307,8 +3446,10 @@ void PsychPipelineDeleteHookSlot(PsychWindowRecordType *windowRecord, const char
 
     // Detach it from hookchain, update predecessors next pointer so it points to successor:
     *prehookfunc = hookfunc->next;
+    PsychPipelineReleaseFusedShaderPasses(windowRecord, hookidx);
 
     // Detached. Delete hookfunc:
+    PsychPipelineReleaseHookSlotTiming(windowRecord, hookfunc);
     free(hookfunc->pString1);
     free(hookfunc->idString);
     free(hookfunc);
@@ -3346,6 +3487,9 @@ int PsychPipelineQueryHookSlot(PsychWindowRecordType *windowRecord, const char*
     int hookidx=PsychGetHookByName(hookString);
     if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "QueryHook: Unknown (non-existent) hook name provided.");
     if (nrassigned != 1) targetidx=-1;
+
+    // Usercode queries slots to get at their shaders and change their uniforms, so resync fused passes:
+    PsychPipelineInvalidateFusedShaderPasses(windowRecord, hookidx);
     idx=0;
 
     // Perform linear search until proper slot reached or proper name reached:
@@ -3407,6 +3551,7 @@ int PsychPipelineQueryHookSlot(PsychWindowRecordType *windowRecord, const char*
 void PsychPipelineDumpHook(PsychWindowRecordType *windowRecord, const char* hookString)
 {
     PtrPsychHookFunction hookfunc;
+    PtrPsychFusedShaderPass pass;
     int i=0;
     int hookidx=PsychGetHookByName(hookString);
     if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "DumpHook: Unknown (non-existent) hook name provided.");
@@ -3441,6 +3586,19 @@ void PsychPipelineDumpHook(PsychWindowRecordType *windowRecord, const char* hook
             break;
         }
 
+        if (hookfunc->cpuCount > 0) {
+            printf("        Executed %u times: CPU avg %f msecs, max %f msecs", hookfunc->cpuCount, hookfunc->cpuTimeAvg * 1000, hookfunc->cpuTimeMax * 1000);
+            if (hookfunc->gpuCount > 0) printf(" : GPU avg %f msecs, max %f msecs", hookfunc->gpuTimeAvg * 1000, hookfunc->gpuTimeMax * 1000);
+            printf("\n");
+        }
+
+        for (pass = windowRecord->HookChainFusion[hookidx]; pass; pass = pass->next) {
+            if (pass->first != hookfunc) continue;
+            printf("        Fused with following %i shader slots into one shader pass.", pass->stages - 1);
+            if (pass->slot.gpuCount > 0) printf(" GPU avg %f msecs, max %f msecs", pass->slot.gpuTimeAvg * 1000, pass->slot.gpuTimeMax * 1000);
+            printf("\n");
+        }
+
         // Next one, if any:
         i++;
         hookfunc = hookfunc->next;
@@ -3479,6 +3637,637 @@ psych_bool PsychIsHookChainOperational(PsychWindowRecordType *windowRecord, int
     return(TRUE);
 }
 
+/* Imaging pipeline shader pass fusion:
+ *
+ * Many hook-chains contain runs of simple per-pixel shader slots, separated by Builtin:FlipFBOs
+ * ping-pongs, e.g., color correction, followed by gamma correction, followed by some output
+ * formatter. Each slot costs a full framebuffer pass with a write and read back of an intermediate
+ * FBO, so we fuse such runs into one GLSL program, generated from the source code of the slot
+ * shaders, which executes all stages per pixel in a single pass.
+ *
+ * Detection is conservative: Only slots without lut texture or blitter options, whose program
+ * consists of one fragment shader which samples the input image exclusively via the canonical
+ * texture2DRect(Image, gl_TexCoord[0].st) and has no other samplers, qualify. Each stage's source
+ * gets all its own identifiers prefixed with a stage specific prefix, the input image fetch replaced
+ * by the output of the previous stage and gl_FragColor replaced by a stage output variable. Values
+ * of uniforms are copied from the original programs to the fused program whenever they may have
+ * changed, i.e., after (re-)fusion, after usercode queried or edited a slot of the chain, which is
+ * how it gets at the shaders of slots, or after Screen('HookFunction', ..., 'ShaderChanged'). The
+ * same events trigger a check if usercode relinked a slot program. This way, no synchronous OpenGL
+ * queries are needed for each execution. If anything fails, the chain is executed unfused.
+ *
+ * Fusion skips the quantization of intermediate results to the precision of the bounce FBOs, so
+ * results can differ slightly, usually towards higher precision. The ConserveVRAM setting
+ * kPsychDontFuseShaderPasses disables fusion.
+ */
+
+// Growable string for generated shader source code:
+typedef struct PsychFusionString {
+    char*   str;
+    size_t  len;
+    size_t  size;
+} PsychFusionString;
+
+static void PsychFusionAppend(PsychFusionString* s, const char* src, size_t n)
+{
+    if (s->len + n + 1 > s->size) {
+        s->size = 2 * (s->len + n + 1);
+        s->str = (char*) realloc(s->str, s->size);
+        if (s->str == NULL) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused imaging pipeline shader.");
+    }
+
+    memcpy(s->str + s->len, src, n);
+    s->len += n;
+    s->str[s->len] = 0;
+}
+
+static void PsychFusionAppendf(PsychFusionString* s, const char* fmt, int stage)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), fmt, stage, stage);
+    PsychFusionAppend(s, buf, strlen(buf));
+}
+
+// GLSL keywords, types and builtin functions, which must not be renamed. Texture sampling
+// functions are missing on purpose, as they disqualify a shader for fusion:
+static const char* PsychFusionGLSLReserved[] = {
+    "attribute", "const", "uniform", "varying", "centroid", "invariant", "flat", "smooth", "noperspective",
+    "break", "continue", "do", "for", "while", "if", "else", "switch", "case", "default", "in", "out", "inout",
+    "return", "true", "false", "void", "bool", "int", "uint", "float", "lowp", "mediump", "highp", "precision",
+    "vec2", "vec3", "vec4", "ivec2", "ivec3", "ivec4", "uvec2", "uvec3", "uvec4", "bvec2", "bvec3", "bvec4",
+    "mat2", "mat3", "mat4", "mat2x2", "mat2x3", "mat2x4", "mat3x2", "mat3x3", "mat3x4", "mat4x2", "mat4x3", "mat4x4",
+    "sampler1D", "sampler2D", "sampler3D", "samplerCube", "sampler2DRect", "sampler1DShadow", "sampler2DShadow", "sampler2DRectShadow",
+    "radians", "degrees", "sin", "cos", "tan", "asin", "acos", "atan", "sinh", "cosh", "tanh", "asinh", "acosh", "atanh",
+    "pow", "exp", "log", "exp2", "log2", "sqrt", "inversesqrt", "abs", "sign", "floor", "ceil", "trunc", "round", "roundEven",
+    "fract", "mod", "modf", "min", "max", "clamp", "mix", "step", "smoothstep", "isnan", "isinf",
+    "floatBitsToInt", "floatBitsToUint", "intBitsToFloat", "uintBitsToFloat",
+    "length", "distance", "dot", "cross", "normalize", "faceforward", "reflect", "refract",
+    "matrixCompMult", "outerProduct", "transpose", "determinant", "inverse",
+    "lessThan", "lessThanEqual", "greaterThan", "greaterThanEqual", "equal", "notEqual", "any", "all", "not",
+    "dFdx", "dFdy", "fwidth", "noise1", "noise2", "noise3", "noise4",
+    NULL
+};
+
+// Identifiers which disqualify a shader for fusion:
+static const char* PsychFusionGLSLForbidden[] = {
+    "discard", "struct", "layout", "attribute", "varying", "gl_FragData", "gl_FragDepth", NULL
+};
+
+static psych_bool PsychFusionIsInList(const char* id, size_t n, const char** list)
+{
+    int i;
+    for (i = 0; list[i]; i++) if ((strlen(list[i]) == n) && !strncmp(list[i], id, n)) return(TRUE);
+    return(FALSE);
+}
+
+// Match the canonical input image fetch "(Image, gl_TexCoord[0].st)", following a texture2DRect
+// identifier at p. Returns pointer behind the closing bracket on success, NULL otherwise:
+static const char* PsychFusionMatchImageFetch(const char* p)
+{
+    static const char* tokens[] = { "(", "Image", ",", "gl_TexCoord", "[", "0", "]", ".", "st", ")", NULL };
+    int i;
+    size_t n;
+
+    for (i = 0; tokens[i]; i++) {
+        while (isspace((unsigned char) *p)) p++;
+        n = strlen(tokens[i]);
+
+        // Accept .xy as synonym for .st:
+        if (!strncmp(tokens[i], "st", 2) && !strncmp(p, "xy", 2)) {
+            p += 2;
+        }
+        else {
+            if (strncmp(p, tokens[i], n)) return(NULL);
+            p += n;
+        }
+
+        if ((isalnum((unsigned char) tokens[i][0]) || tokens[i][0] == '_') && (isalnum((unsigned char) *p) || *p == '_')) return(NULL);
+    }
+
+    return(p);
+}
+
+/* PsychFusionRewriteStage()
+ * Rewrite fragment shader source 'src' for use as stage 'stage' of a fused shader and append the
+ * result to 'out'. #extension directives are collected in 'header', the highest #version in 'version'.
+ * Returns FALSE if the shader doesn't qualify for fusion.
+ */
+static psych_bool PsychFusionRewriteStage(const char* src, int stage, PsychFusionString* out, PsychFusionString* header, int* version)
+{
+    const char *p = src, *q;
+    psych_bool linestart = TRUE;
+    psych_bool writescolor = FALSE;
+    char lastsig = 0;
+    char line[256];
+    int v;
+
+    while (*p) {
+        // Newlines and whitespace:
+        if (isspace((unsigned char) *p)) {
+            if (*p == '\n') linestart = TRUE;
+            PsychFusionAppend(out, p++, 1);
+            continue;
+        }
+
+        // Comments:
+        if (p[0] == '/' && p[1] == '/') {
+            while (*p && *p != '\n') p++;
+            continue;
+        }
+
+        if (p[0] == '/' && p[1] == '*') {
+            if ((q = strstr(p + 2, "*/")) == NULL) return(FALSE);
+            p = q + 2;
+            PsychFusionAppend(out, " ", 1);
+            continue;
+        }
+
+        // Preprocessor directives: Only #version and #extension are allowed:
+        if (*p == '#') {
+            if (!linestart) return(FALSE);
+            for (q = p; *q && *q != '\n'; q++) if (*q == '\\') return(FALSE);
+
+            p++;
+            while (*p == ' ' || *p == '\t') p++;
+            if (!strncmp(p, "version", 7)) {
+                if ((1 != sscanf(p + 7, "%i", &v)) || (v > 130)) return(FALSE);
+                if (v > *version) *version = v;
+            }
+            else if (!strncmp(p, "extension", 9)) {
+                // Collect each distinct directive only once:
+                if (q - p > (int) sizeof(line) - 3) return(FALSE);
+                sprintf(line, "#%.*s\n", (int) (q - p), p);
+                if ((header->str == NULL) || !strstr(header->str, line)) PsychFusionAppend(header, line, strlen(line));
+            }
+            else {
+                return(FALSE);
+            }
+
+            p = q;
+            continue;
+        }
+
+        linestart = FALSE;
+
+        // Numbers, including floating point constants with exponent:
+        if (isdigit((unsigned char) *p) || (*p == '.' && isdigit((unsigned char) p[1]))) {
+            q = p;
+            while (isalnum((unsigned char) *q) || *q == '.' || *q == '_' ||
+                   ((*q == '+' || *q == '-') && (q[-1] == 'e' || q[-1] == 'E'))) q++;
+            PsychFusionAppend(out, p, q - p);
+            lastsig = q[-1];
+            p = q;
+            continue;
+        }
+
+        // Identifiers:
+        if (isalpha((unsigned char) *p) || *p == '_') {
+            for (q = p; isalnum((unsigned char) *q) || *q == '_'; q++);
+
+            if (lastsig == '.') {
+                // Swizzle or member selection: Leave alone.
+                PsychFusionAppend(out, p, q - p);
+            }
+            else if (PsychFusionIsInList(p, q - p, PsychFusionGLSLForbidden)) {
+                return(FALSE);
+            }
+            else if ((q - p == 12) && !strncmp(p, "gl_FragColor", 12)) {
+                PsychFusionAppendf(out, "psf%i_FragColor", stage);
+                writescolor = TRUE;
+            }
+            else if (!strncmp(p, "gl_", 3) || PsychFusionIsInList(p, q - p, PsychFusionGLSLReserved)) {
+                PsychFusionAppend(out, p, q - p);
+            }
+            else if (!strncmp(p, "texture", 7) || !strncmp(p, "shadow", 6) || !strncmp(p, "texelFetch", 10)) {
+                // Texture sampling is only allowed as canonical fetch of the input image:
+                if ((q - p != 13) || strncmp(p, "texture2DRect", 13) || !(q = PsychFusionMatchImageFetch(q))) return(FALSE);
+                PsychFusionAppendf(out, "psf%i_in", stage);
+            }
+            else {
+                // Identifier of the shader itself: Prefix it with stage prefix:
+                PsychFusionAppendf(out, "psf%i_", stage);
+                PsychFusionAppend(out, p, q - p);
+            }
+
+            lastsig = 'a';
+            p = q;
+            continue;
+        }
+
+        // Everything else, ie. operators and punctuation:
+        lastsig = *p;
+        PsychFusionAppend(out, p++, 1);
+    }
+
+    PsychFusionAppend(out, "\n", 1);
+
+    return(writescolor);
+}
+
+// Compute a signature of the shader objects attached to a program, to detect relinking with new shaders:
+static unsigned int PsychFusionProgramSignature(GLuint program)
+{
+    GLuint shaders[4];
+    GLsizei count = 0;
+    GLint value = -1;
+    unsigned int hash = 2166136261U;
+    int i;
+
+    // Program deleted by usercode? Zero is never a valid signature, so this counts as changed:
+    if (!glIsProgram(program)) return(0);
+
+    #define PSYCHFUSIONHASH(x) hash = (hash ^ (unsigned int) (x)) * 16777619U
+    glGetProgramiv(program, GL_LINK_STATUS, &value);
+    PSYCHFUSIONHASH(value);
+    glGetAttachedShaders(program, 4, &count, shaders);
+    PSYCHFUSIONHASH(count);
+    for (i = 0; i < count; i++) {
+        value = -1;
+        PSYCHFUSIONHASH(shaders[i]);
+        glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &value);
+        PSYCHFUSIONHASH(value);
+    }
+    #undef PSYCHFUSIONHASH
+
+    return((hash) ? hash : 1);
+}
+
+// Is hookfunc a shader slot which can be fused? If so and out != NULL, append its rewritten source to out:
+static psych_bool PsychFusionCheckSlot(PtrPsychHookFunction hookfunc, int stage, PsychFusionString* out, PsychFusionString* header, int* version)
+{
+    PsychFusionString dummy = { NULL, 0, 0 };
+    GLuint shader;
+    GLsizei count = 0;
+    GLint value, i, n, size;
+    GLenum type;
+    GLchar name[256];
+    char* src;
+    psych_bool rc;
+
+    if ((hookfunc->hookfunctype != kPsychShaderFunc) || (hookfunc->shaderid == 0) || (hookfunc->luttexid1 != 0) ||
+        (strlen(hookfunc->pString1) > 0 && strcmp(hookfunc->pString1, "Blitter:IdentityBlit")))
+        return(FALSE);
+
+    // Linked program with only a fragment shader attached?
+    glGetProgramiv(hookfunc->shaderid, GL_LINK_STATUS, &value);
+    if (value != GL_TRUE) return(FALSE);
+    glGetAttachedShaders(hookfunc->shaderid, 1, &count, &shader);
+    glGetProgramiv(hookfunc->shaderid, GL_ATTACHED_SHADERS, &value);
+    if ((count != 1) || (value != 1)) return(FALSE);
+    glGetShaderiv(shader, GL_SHADER_TYPE, &value);
+    if (value != GL_FRAGMENT_SHADER) return(FALSE);
+
+    // No samplers other than Image, and only uniform types we can copy?
+    glGetProgramiv(hookfunc->shaderid, GL_ACTIVE_UNIFORMS, &n);
+    for (i = 0; i < n; i++) {
+        glGetActiveUniform(hookfunc->shaderid, i, sizeof(name), NULL, &size, &type, name);
+        if (!strncmp(name, "gl_", 3)) continue;
+
+        switch (type) {
+            case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+            case GL_INT: case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+            case GL_BOOL: case GL_BOOL_VEC2: case GL_BOOL_VEC3: case GL_BOOL_VEC4:
+            case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+                break;
+
+            case GL_SAMPLER_2D_RECT:
+                if (!strcmp(name, "Image")) break;
+                // Fallthrough for any other sampler:
+
+            default:
+                return(FALSE);
+        }
+    }
+
+    // Source code rewritable?
+    glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &value);
+    if ((value <= 1) || ((src = (char*) malloc(value)) == NULL)) return(FALSE);
+    glGetShaderSource(shader, value, NULL, src);
+
+    if (out) {
+        PsychFusionAppendf(out, "vec4 psf%i_in;\nvec4 psf%i_FragColor;\n", stage);
+        rc = PsychFusionRewriteStage(src, stage, out, header, version);
+    }
+    else {
+        rc = PsychFusionRewriteStage(src, stage, &dummy, &dummy, &n);
+        free(dummy.str);
+    }
+
+    free(src);
+
+    return(rc);
+}
+
+// Map all uniforms of stage program 'program' to their counterparts in the fused program of pass:
+static void PsychFusionMapUniforms(PtrPsychFusedShaderPass pass, GLuint program, int stage)
+{
+    GLint i, n, e, size, srcloc, dstloc;
+    GLenum type;
+    GLchar name[256], srcname[300], dstname[320];
+    char* bracket;
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &n);
+    for (i = 0; i < n; i++) {
+        glGetActiveUniform(program, i, sizeof(name), NULL, &size, &type, name);
+        if (!strncmp(name, "gl_", 3) || (type == GL_SAMPLER_2D_RECT)) continue;
+
+        // Arrays are reported as name[0]: Map each element separately:
+        if ((bracket = strchr(name, '['))) *bracket = 0;
+
+        for (e = 0; e < size; e++) {
+            if (size > 1) sprintf(srcname, "%s[%i]", name, (int) e); else sprintf(srcname, "%s", name);
+            sprintf(dstname, "psf%i_%s", stage, srcname);
+
+            srcloc = glGetUniformLocation(program, srcname);
+            dstloc = glGetUniformLocation(pass->slot.shaderid, dstname);
+            if ((srcloc == -1) || (dstloc == -1)) continue;
+
+            pass->uniforms = (PsychFusedUniform*) realloc(pass->uniforms, (pass->uniformCount + 1) * sizeof(PsychFusedUniform));
+            if (pass->uniforms == NULL) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused imaging pipeline shader.");
+            pass->uniforms[pass->uniformCount].srcprogram = program;
+            pass->uniforms[pass->uniformCount].srcloc = srcloc;
+            pass->uniforms[pass->uniformCount].dstloc = dstloc;
+            pass->uniforms[pass->uniformCount].type = type;
+            pass->uniforms[pass->uniformCount].cached = FALSE;
+            pass->uniformCount++;
+        }
+    }
+}
+
+// Build fused shader pass for the run of 'stages' shader slots from first to last. Returns NULL on failure:
+static PtrPsychFusedShaderPass PsychFusionBuildPass(PtrPsychHookFunction first, PtrPsychHookFunction last, int stages)
+{
+    PsychFusionString body = { NULL, 0, 0 }, header = { NULL, 0, 0 }, src = { NULL, 0, 0 };
+    PtrPsychFusedShaderPass pass;
+    PtrPsychHookFunction hookfunc;
+    GLuint glsl, shader;
+    GLint status;
+    int k, version = 110;
+    char vline[32];
+    const char* srcptr;
+
+    pass = (PtrPsychFusedShaderPass) calloc(1, sizeof(PsychFusedShaderPass));
+    if ((pass == NULL) || ((pass->signatures = (unsigned int*) calloc(stages, sizeof(unsigned int))) == NULL))
+        PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while generating fused imaging pipeline shader.");
+
+    pass->first = first;
+    pass->last = last;
+    pass->stages = stages;
+
+    // Generate source of the fused shader:
+    for (k = 0, hookfunc = first; k < stages; k++, hookfunc = hookfunc->next->next) {
+        if (!PsychFusionCheckSlot(hookfunc, k, &body, &header, &version)) goto fusion_failed;
+        pass->signatures[k] = PsychFusionProgramSignature(hookfunc->shaderid);
+    }
+
+    sprintf(vline, "#version %i\n", version);
+    PsychFusionAppend(&src, vline, strlen(vline));
+    if (header.str) PsychFusionAppend(&src, header.str, header.len);
+    PsychFusionAppendf(&src, "uniform sampler2DRect Image;\n\n", 0);
+    PsychFusionAppend(&src, body.str, body.len);
+    PsychFusionAppendf(&src, "\nvoid main()\n{\n    psf%i_in = texture2DRect(Image, gl_TexCoord[0].st);\n", 0);
+    for (k = 0; k < stages; k++) {
+        if (k > 0) {
+            sprintf(vline, "    psf%i_in = ", k);
+            PsychFusionAppend(&src, vline, strlen(vline));
+            PsychFusionAppendf(&src, "psf%i_FragColor;\n", k - 1);
+        }
+        PsychFusionAppendf(&src, "    psf%i_main();\n", k);
+    }
+    PsychFusionAppendf(&src, "    gl_FragColor = psf%i_FragColor;\n}\n", stages - 1);
+
+    if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: Fused imaging pipeline shader, GLSL source code follows:\n\n%s\n\n", src.str);
+
+    // Compile and link it. Failure is not an error, we just don't fuse:
+    while (glGetError());
+    srcptr = src.str;
+    shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(shader, 1, &srcptr, NULL);
+    glCompileShader(shader);
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        glDeleteShader(shader);
+        goto fusion_failed;
+    }
+
+    glsl = glCreateProgram();
+    glAttachShader(glsl, shader);
+    glDeleteShader(shader);
+    glLinkProgram(glsl);
+    glGetProgramiv(glsl, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        glDeleteProgram(glsl);
+        goto fusion_failed;
+    }
+
+    // Setup synthetic slot for execution of the fused program:
+    pass->slot.hookfunctype = kPsychShaderFunc;
+    pass->slot.shaderid = glsl;
+    pass->slot.pString1 = strdup("");
+    pass->slot.idString = strdup("Fused:ShaderPasses");
+
+    // Input image is always on texture unit 0:
+    glUseProgram(glsl);
+    glUniform1i(glGetUniformLocation(glsl, "Image"), 0);
+    glUseProgram(0);
+
+    for (k = 0, hookfunc = first; k < stages; k++, hookfunc = hookfunc->next->next) PsychFusionMapUniforms(pass, hookfunc->shaderid, k);
+
+    while (glGetError());
+    free(body.str);
+    free(header.str);
+    free(src.str);
+
+    return(pass);
+
+fusion_failed:
+    if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Could not fuse shader slots '%s' to '%s' of hook-chain into one pass. Executing them unfused.\n", first->idString, last->idString);
+    while (glGetError());
+    free(body.str);
+    free(header.str);
+    free(src.str);
+    free(pass->signatures);
+    free(pass);
+
+    return(NULL);
+}
+
+// Copy current values of all uniforms of the original slot programs into the fused program. Cheap enough
+// for each execution: Only uniforms whose value changed since the last call get assigned, so usercode
+// which changes uniforms of its slot shaders via glUniform() keeps working without notifying us:
+static void PsychFusionUpdateUniforms(PtrPsychFusedShaderPass pass)
+{
+    PsychFusedUniform* u;
+    GLfloat f[16];
+    GLint iv[4];
+    psych_bool bound = FALSE;
+    int i, n;
+
+    for (i = 0; i < pass->uniformCount; i++) {
+        u = &(pass->uniforms[i]);
+        switch (u->type) {
+            case GL_FLOAT:      n = 1; break;
+            case GL_FLOAT_VEC2: n = 2; break;
+            case GL_FLOAT_VEC3: n = 3; break;
+            case GL_FLOAT_VEC4: n = 4; break;
+            case GL_FLOAT_MAT2: n = 4; break;
+            case GL_FLOAT_MAT3: n = 9; break;
+            case GL_FLOAT_MAT4: n = 16; break;
+            case GL_INT:
+            case GL_BOOL:       n = -1; break;
+            case GL_INT_VEC2:
+            case GL_BOOL_VEC2:  n = -2; break;
+            case GL_INT_VEC3:
+            case GL_BOOL_VEC3:  n = -3; break;
+            case GL_INT_VEC4:
+            case GL_BOOL_VEC4:  n = -4; break;
+            default:            n = 0;
+        }
+
+        // Skip uniforms which didn't change since last sync:
+        if (n > 0) {
+            glGetUniformfv(u->srcprogram, u->srcloc, f);
+            if (u->cached && !memcmp(u->fvalue, f, n * sizeof(GLfloat))) continue;
+            memcpy(u->fvalue, f, n * sizeof(GLfloat));
+        }
+        else if (n < 0) {
+            glGetUniformiv(u->srcprogram, u->srcloc, iv);
+            if (u->cached && !memcmp(u->ivalue, iv, -n * sizeof(GLint))) continue;
+            memcpy(u->ivalue, iv, -n * sizeof(GLint));
+        }
+        else continue;
+
+        u->cached = TRUE;
+
+        if (!bound) {
+            glUseProgram(pass->slot.shaderid);
+            bound = TRUE;
+        }
+
+        switch (u->type) {
+            case GL_FLOAT:      glUniform1fv(u->dstloc, 1, f); break;
+            case GL_FLOAT_VEC2: glUniform2fv(u->dstloc, 1, f); break;
+            case GL_FLOAT_VEC3: glUniform3fv(u->dstloc, 1, f); break;
+            case GL_FLOAT_VEC4: glUniform4fv(u->dstloc, 1, f); break;
+            case GL_FLOAT_MAT2: glUniformMatrix2fv(u->dstloc, 1, GL_FALSE, f); break;
+            case GL_FLOAT_MAT3: glUniformMatrix3fv(u->dstloc, 1, GL_FALSE, f); break;
+            case GL_FLOAT_MAT4: glUniformMatrix4fv(u->dstloc, 1, GL_FALSE, f); break;
+            default:
+                if (n == -1) glUniform1iv(u->dstloc, 1, iv);
+                else if (n == -2) glUniform2iv(u->dstloc, 1, iv);
+                else if (n == -3) glUniform3iv(u->dstloc, 1, iv);
+                else glUniform4iv(u->dstloc, 1, iv);
+        }
+    }
+
+    if (bound) glUseProgram(0);
+}
+
+/* PsychPipelineReleaseFusedShaderPasses()
+ * Release all fused shader passes of hook-chain 'hookidx' and mark them invalid, so they get
+ * rebuilt on next execution of the chain. Must be called whenever the chain is modified.
+ */
+void PsychPipelineReleaseFusedShaderPasses(PsychWindowRecordType *windowRecord, int hookidx)
+{
+    PtrPsychFusedShaderPass pass;
+
+    windowRecord->HookChainFusionValid[hookidx] = FALSE;
+    windowRecord->HookChainFusionDirty[hookidx] = TRUE;
+
+    while ((pass = windowRecord->HookChainFusion[hookidx])) {
+        windowRecord->HookChainFusion[hookidx] = pass->next;
+
+        PsychPipelineReleaseHookSlotTiming(windowRecord, &(pass->slot));
+        PsychSetGLContext(windowRecord);
+        glDeleteProgram(pass->slot.shaderid);
+
+        free(pass->slot.pString1);
+        free(pass->slot.idString);
+        free(pass->uniforms);
+        free(pass->signatures);
+        free(pass);
+    }
+}
+
+/* PsychPipelineInvalidateFusedShaderPasses()
+ * Mark fused shader passes of hook-chain 'hookidx', or of all hook-chains if hookidx is -1, as
+ * possibly out of sync with the shaders of their slots, e.g., because usercode may have relinked
+ * them. The next PsychPipelineGetFusedShaderPasses() revalidates them.
+ */
+void PsychPipelineInvalidateFusedShaderPasses(PsychWindowRecordType *windowRecord, int hookidx)
+{
+    int i;
+
+    for (i = 0; i < MAX_SCREEN_HOOKS; i++) {
+        if ((hookidx == -1) || (hookidx == i)) windowRecord->HookChainFusionDirty[i] = TRUE;
+    }
+}
+
+/* PsychPipelineGetFusedShaderPasses()
+ * Return list of fused shader passes for hook-chain 'hookId', (re-)building it if the chain or
+ * any of the shaders of fused slots changed since the last call, and copying changed uniform
+ * values into the fused programs.
+ */
+static PtrPsychFusedShaderPass PsychPipelineGetFusedShaderPasses(PsychWindowRecordType *windowRecord, int hookId)
+{
+    PtrPsychFusedShaderPass pass, *tail;
+    PtrPsychHookFunction hookfunc, first, last;
+    int k, stages;
+
+    // Nothing changed since last call? Then the fused passes are good to go after a uniform sync:
+    if (windowRecord->HookChainFusionValid[hookId] && !windowRecord->HookChainFusionDirty[hookId]) {
+        for (pass = windowRecord->HookChainFusion[hookId]; pass; pass = pass->next) PsychFusionUpdateUniforms(pass);
+        return(windowRecord->HookChainFusion[hookId]);
+    }
+
+    // Shaders of fused slots relinked by usercode? Then rebuild:
+    for (pass = windowRecord->HookChainFusion[hookId]; pass; pass = pass->next) {
+        for (k = 0, hookfunc = pass->first; k < pass->stages; k++, hookfunc = hookfunc->next->next) {
+            if (PsychFusionProgramSignature(hookfunc->shaderid) != pass->signatures[k]) {
+                PsychPipelineReleaseFusedShaderPasses(windowRecord, hookId);
+                break;
+            }
+        }
+        if (!windowRecord->HookChainFusionValid[hookId]) break;
+    }
+
+    if (windowRecord->HookChainFusionValid[hookId]) {
+        // Still valid, just resync uniforms:
+        for (pass = windowRecord->HookChainFusion[hookId]; pass; pass = pass->next) PsychFusionUpdateUniforms(pass);
+        windowRecord->HookChainFusionDirty[hookId] = FALSE;
+
+        return(windowRecord->HookChainFusion[hookId]);
+    }
+
+    // Find all runs of at least two fusable shader slots, separated by Builtin:FlipFBOs:
+    tail = &(windowRecord->HookChainFusion[hookId]);
+    for (hookfunc = windowRecord->HookChain[hookId]; hookfunc; hookfunc = hookfunc->next) {
+        if (!PsychFusionCheckSlot(hookfunc, 0, NULL, NULL, NULL)) continue;
+
+        first = last = hookfunc;
+        stages = 1;
+        while (last->next && (last->next->hookfunctype == kPsychBuiltinFunc) && !strcmp(last->next->idString, "Builtin:FlipFBOs") &&
+               last->next->next && PsychFusionCheckSlot(last->next->next, 0, NULL, NULL, NULL)) {
+            last = last->next->next;
+            stages++;
+        }
+
+        if ((stages > 1) && (pass = PsychFusionBuildPass(first, last, stages))) {
+            PsychFusionUpdateUniforms(pass);
+            *tail = pass;
+            tail = &(pass->next);
+            if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Hook-chain '%s': Fused %i shader slots '%s' to '%s' into one pass.\n", PsychHookPointNames[hookId], stages, first->idString, last->idString);
+        }
+
+        hookfunc = last;
+    }
+
+    windowRecord->HookChainFusionValid[hookId] = TRUE;
+    windowRecord->HookChainFusionDirty[hookId] = FALSE;
+
+    return(windowRecord->HookChainFusion[hookId]);
+}
+
 /* PsychPipelineExecuteHook()
  * Execute the full hook processing chain for a specific hook and a specific windowRecord.
  * This checks if the chain is enabled. If it isn't enabled, it skips processing.
@@ -3488,6 +4277,7 @@ psych_bool PsychIsHookChainOperational(PsychWindowRecordType *windowRecord, int
 psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hookId, void* hookUserData, void* hookBlitterFunction, psych_bool srcIsReadonly, psych_bool allowFBOSwizzle, PsychFBO** srcfbo1, PsychFBO** srcfbo2, PsychFBO** dstfbo, PsychFBO** bouncefbo)
 {
     PtrPsychHookFunction hookfunc;
+    PtrPsychFusedShaderPass fusedpasses = NULL, pass;
     int i=0;
     int pendingFBOpingpongs = 0;
     PsychFBO *mysrcfbo1, *mysrcfbo2, *mydstfbo, *mynxtfbo;
@@ -3510,6 +4300,18 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
     // Is this an image processing hook?
     gfxprocessing = (dstfbo!=NULL) ? TRUE : FALSE;
 
+    // Can runs of shader slots be fused into single passes? Only if all involved framebuffers have the same
+    // size, so texture coordinates are the same for all passes, the input is a rectangle texture, and the
+    // default blitter is used:
+    if (gfxprocessing && glUseProgram && !(PsychPrefStateGet_ConserveVRAM() & kPsychDontFuseShaderPasses) &&
+        ((hookBlitterFunction == NULL) || (hookBlitterFunction == (void*) &PsychBlitterIdentity)) &&
+        srcfbo1 && *srcfbo1 && ((*srcfbo1)->textarget == GL_TEXTURE_RECTANGLE_EXT) &&
+        ((*dstfbo)->width == (*srcfbo1)->width) && ((*dstfbo)->height == (*srcfbo1)->height) &&
+        (!bouncefbo || !(*bouncefbo) || (((*bouncefbo)->width == (*srcfbo1)->width) && ((*bouncefbo)->height == (*srcfbo1)->height)))) {
+        PsychSetGLContext(windowRecord);
+        fusedpasses = PsychPipelineGetFusedShaderPasses(windowRecord, hookId);
+    }
+
     // Get start of enabled chain:
     hookfunc = windowRecord->HookChain[hookId];
 
@@ -3521,6 +4323,9 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
         hookfunc = hookfunc->next;
     }
 
+    // Ping-pongs inside fused runs of shader slots don't happen:
+    for (pass = fusedpasses; pass; pass = pass->next) pendingFBOpingpongs -= pass->stages - 1;
+
     if (gfxprocessing) {
         // Prepare gfx-processing:
 
@@ -3540,6 +4345,12 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
             bouncefbo2 = dstfbo;
         }
 
+        // Special 2nd bounce buffer of different size? Then we can't fuse:
+        if (fusedpasses && (((*bouncefbo2)->width != (*dstfbo)->width) || ((*bouncefbo2)->height != (*dstfbo)->height))) {
+            for (pass = fusedpasses; pass; pass = pass->next) pendingFBOpingpongs += pass->stages - 1;
+            fusedpasses = NULL;
+        }
+
         // Backup scissoring state:
         scissor_enabled = glIsEnabled(GL_SCISSOR_TEST);
 
@@ -3665,8 +4476,21 @@ psych_bool PsychPipelineExecuteHook(PsychWindowRecordType *windowRecord, int hoo
                 }
             }
             else {
+                // Start of a fused run of shader slots? Then execute the fused pass instead and skip the run:
+                for (pass = fusedpasses; pass && (pass->first != hookfunc); pass = pass->next);
+                if (pass) {
+                    if (!PsychPipelineExecuteHookSlot(windowRecord, hookId, &(pass->slot), hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, &mysrcfbo1, &mysrcfbo2, &mydstfbo, &mynxtfbo)) {
+                        if (PsychPrefStateGet_Verbosity()>0) {
+                            printf("PTB-ERROR: Failed in processing of Hookchain '%s' : Fused slots %i to %i --> Aborting chain processing. Set verbosity to 5 for extended debug output.\n", PsychHookPointNames[hookId], i, i + 2 * (pass->stages - 1));
+                        }
+                            return(FALSE);
+                    }
+
+                    i += 2 * (pass->stages - 1);
+                    hookfunc = pass->last;
+                }
                 // Normal hook function - Process this hook function:
-                if (!PsychPipelineExecuteHookSlot(windowRecord, hookId, hookfunc, hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, &mysrcfbo1, &mysrcfbo2, &mydstfbo, &mynxtfbo)) {
+                else if (!PsychPipelineExecuteHookSlot(windowRecord, hookId, hookfunc, hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, &mysrcfbo1, &mysrcfbo2, &mydstfbo, &mynxtfbo)) {
                     // Failed!
                     if (PsychPrefStateGet_Verbosity()>0) {
                         printf("PTB-ERROR: Failed in processing of Hookchain '%s' : Slot %i: Id='%s'  --> Aborting chain processing. Set verbosity to 5 for extended debug output.\n", PsychHookPointNames[hookId], i, hookfunc->idString);
@@ -3926,10 +4750,115 @@ macros_out:
     return(rc);
 }
 
+/* PsychPipelineReleaseHookSlotTiming()
+ * Delete the timer queries of a hook slot. Must be called with the OpenGL context of the slots window
+ * still alive. Does nothing if the slot never got gpu timed.
+ */
+void PsychPipelineReleaseHookSlotTiming(PsychWindowRecordType *windowRecord, PsychHookFunction* hookfunc)
+{
+    if (hookfunc->timerQuery[0][0] == 0) return;
+
+    PsychSetGLContext(windowRecord);
+    glDeleteQueries(4, &(hookfunc->timerQuery[0][0]));
+    memset(hookfunc->timerQuery, 0, sizeof(hookfunc->timerQuery));
+    hookfunc->timerQueryPending[0] = hookfunc->timerQueryPending[1] = FALSE;
+}
+
+/* PsychPipelineResetHookTiming()
+ * Reset the execution time statistics of all slots of the named hook chain.
+ */
+void PsychPipelineResetHookTiming(PsychWindowRecordType *windowRecord, const char* hookString)
+{
+    PtrPsychHookFunction hookfunc;
+    int hookidx=PsychGetHookByName(hookString);
+    if (hookidx==-1) PsychErrorExitMsg(PsychError_user, "ResetHookTiming: Unknown (non-existent) hook name provided.");
+
+    for (hookfunc = windowRecord->HookChain[hookidx]; hookfunc; hookfunc = hookfunc->next) {
+        hookfunc->cpuCount = hookfunc->gpuCount = 0;
+        hookfunc->cpuTimeLast = hookfunc->cpuTimeAvg = hookfunc->cpuTimeMax = 0;
+        hookfunc->gpuTimeLast = hookfunc->gpuTimeAvg = hookfunc->gpuTimeMax = 0;
+    }
+}
+
+// Add a new sample to a set of timing statistics. The average is an exponential moving average
+// over roughly the last 1 / kPsychHookTimingWeight samples:
+#define kPsychHookTimingWeight 0.05
+static void PsychPipelineAddTimingSample(double t, unsigned int *count, double *last, double *avg, double *max)
+{
+    *avg = (*count == 0) ? t : (*avg + kPsychHookTimingWeight * (t - *avg));
+    *last = t;
+    if (t > *max) *max = t;
+    (*count)++;
+}
+
+// Collect results of finished gpu timer queries of hookfunc, without waiting for unfinished ones:
+static void PsychPipelineCollectHookSlotTiming(PsychHookFunction* hookfunc)
+{
+    GLint available;
+    GLuint64 tstart, tend;
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        if (!hookfunc->timerQueryPending[i]) continue;
+
+        glGetQueryObjectiv(hookfunc->timerQuery[i][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        glGetQueryObjectui64v(hookfunc->timerQuery[i][0], GL_QUERY_RESULT, &tstart);
+        glGetQueryObjectui64v(hookfunc->timerQuery[i][1], GL_QUERY_RESULT, &tend);
+        hookfunc->timerQueryPending[i] = FALSE;
+
+        PsychPipelineAddTimingSample((double) (tend - tstart) / 1e9, &hookfunc->gpuCount, &hookfunc->gpuTimeLast, &hookfunc->gpuTimeAvg, &hookfunc->gpuTimeMax);
+    }
+}
+
+static psych_bool PsychPipelineDispatchHookSlot(PsychWindowRecordType *windowRecord, int hookId, PsychHookFunction* hookfunc, void* hookUserData, void* hookBlitterFunction, psych_bool srcIsReadonly, psych_bool allowFBOSwizzle, PsychFBO** srcfbo1, PsychFBO** srcfbo2, PsychFBO** dstfbo, PsychFBO** bouncefbo);
+
 /* PsychPipelineExecuteHookSlot()
  * Execute a single hookfunction slot in a hook chain for a specific window.
+ *
+ * Measures the cpu wall time of each execution. Image processing slots of onscreen windows executed
+ * on the main thread are also gpu timed via a pair of GL_TIMESTAMP queries. Timestamp queries are used,
+ * as opposed to GL_TIME_ELAPSED queries, because they can't collide with an active GL_TIME_ELAPSED query
+ * for Screen('GetWindowInfo') gpu render time measurement. Each slot has two query pairs which are used
+ * alternately, and results are only collected once available, so we never stall the pipeline. If both
+ * pairs are still pending, the gpu time of that execution is not measured.
  */
 psych_bool PsychPipelineExecuteHookSlot(PsychWindowRecordType *windowRecord, int hookId, PsychHookFunction* hookfunc, void* hookUserData, void* hookBlitterFunction, psych_bool srcIsReadonly, psych_bool allowFBOSwizzle, PsychFBO** srcfbo1, PsychFBO** srcfbo2, PsychFBO** dstfbo, PsychFBO** bouncefbo)
+{
+    psych_bool rc;
+    double tstart, tend;
+    int gpuslot = -1;
+
+    if ((dstfbo != NULL) && PsychIsOnscreenWindow(windowRecord) && PsychIsMasterThread() && glQueryCounter) {
+        if (hookfunc->timerQuery[0][0] == 0) glGenQueries(4, &(hookfunc->timerQuery[0][0]));
+
+        PsychPipelineCollectHookSlotTiming(hookfunc);
+        if (!hookfunc->timerQueryPending[0]) gpuslot = 0;
+        else if (!hookfunc->timerQueryPending[1]) gpuslot = 1;
+
+        if (gpuslot >= 0) glQueryCounter(hookfunc->timerQuery[gpuslot][0], GL_TIMESTAMP);
+    }
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tstart);
+
+    rc = PsychPipelineDispatchHookSlot(windowRecord, hookId, hookfunc, hookUserData, hookBlitterFunction, srcIsReadonly, allowFBOSwizzle, srcfbo1, srcfbo2, dstfbo, bouncefbo);
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tend);
+    PsychPipelineAddTimingSample(tend - tstart, &hookfunc->cpuCount, &hookfunc->cpuTimeLast, &hookfunc->cpuTimeAvg, &hookfunc->cpuTimeMax);
+
+    if (gpuslot >= 0) {
+        glQueryCounter(hookfunc->timerQuery[gpuslot][1], GL_TIMESTAMP);
+        hookfunc->timerQueryPending[gpuslot] = TRUE;
+    }
+
+    return(rc);
+}
+
+/* PsychPipelineDispatchHookSlot()
+ * Dispatch execution of a single hookfunction slot by hook function type.
+ */
+static psych_bool PsychPipelineDispatchHookSlot(PsychWindowRecordType *windowRecord, int hookId, PsychHookFunction* hookfunc, void* hookUserData, void* hookBlitterFunction, psych_bool srcIsReadonly, psych_bool allowFBOSwizzle, PsychFBO** srcfbo1, PsychFBO** srcfbo2, PsychFBO** dstfbo, PsychFBO** bouncefbo)
 {
     psych_bool dispatched = FALSE;
 
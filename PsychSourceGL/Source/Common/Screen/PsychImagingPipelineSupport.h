@@ -64,6 +64,10 @@ void    PsychPipelineDumpHook(PsychWindowRecordType *windowRecord, const char* h
 void    PsychPipelineDisableHook(PsychWindowRecordType *windowRecord, const char* hookString);
 void    PsychPipelineEnableHook(PsychWindowRecordType *windowRecord, const char* hookString);
 void    PsychPipelineResetHook(PsychWindowRecordType *windowRecord, const char* hookString);
+void    PsychPipelineResetHookTiming(PsychWindowRecordType *windowRecord, const char* hookString);
+void    PsychPipelineReleaseHookSlotTiming(PsychWindowRecordType *windowRecord, PsychHookFunction* hookfunc);
+void    PsychPipelineReleaseFusedShaderPasses(PsychWindowRecordType *windowRecord, int hookidx);
+void    PsychPipelineInvalidateFusedShaderPasses(PsychWindowRecordType *windowRecord, int hookidx);
 int     PsychPipelineQueryHookSlot(PsychWindowRecordType *windowRecord, const char* hookString, char** insertString, char** idString, char** blitterString, double* doubleptr, double* shaderid, double* luttexid1);
 void    PsychPipelineDeleteHookSlot(PsychWindowRecordType *windowRecord, const char* hookString, int slotid);
 void    PsychPipelineAddBuiltinFunctionToHook(PsychWindowRecordType *windowRecord, const char* hookString, const char* idString, int where, const char* configString);
@@ -89,8 +93,14 @@ psych_bool PsychCreateFBO(PsychFBO** fbo, GLenum fboInternalFormat, psych_bool n
 // Delete PsychFBO struct with all attached OpenGL resources:
 void PsychDeleteFBO(PsychFBO* fboptr);
 
-// MSAA resolve given PsychFBO into a new single-sampled PsychFBO, if it is multi-sampled:
-PsychFBO* PsychMSAAResolveToTemp(PsychFBO* msaaFBO);
+// MSAA resolve given PsychFBO into a temporary single-sampled PsychFBO, if it is multi-sampled:
+PsychFBO* PsychMSAAResolveToTemp(PsychWindowRecordType *windowRecord, PsychFBO* msaaFBO);
+void PsychReleaseMSAAResolveTemp(PsychWindowRecordType *windowRecord, PsychFBO* resolvedFBO);
+
+// Pool of idle FBOs of an onscreen window, for reuse instead of deletion and recreation:
+psych_bool PsychCreatePooledFBO(PsychWindowRecordType *windowRecord, PsychFBO** fbo, GLenum fboInternalFormat, psych_bool needzbuffer, int width, int height, int multisample, int specialFlags);
+void PsychReleasePooledFBO(PsychWindowRecordType *windowRecord, PsychFBO* fbo);
+void PsychReleaseFBOPool(PsychWindowRecordType *windowRecord);
 
 // Set new OpenGL color renderbuffer attachment backing textures for the PsychFBO's of the finalizedFBO[0/1] output render buffers:
 psych_bool PsychSetPipelineExportTexture(PsychWindowRecordType *windowRecord, int leftglHandle, int rightglHandle, int glTextureTarget, int format,
@@ -262,3 +262,16 @@ double PsychSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool inde
     PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
     return(0.0);
 }
+
+/*
+ *  PsychGetMovieStats()  -- Return struct with performance statistics of movie in output argument 'outPos'.
+ */
+void PsychGetMovieStats(int moviehandle, int outPos)
+{
+    #ifdef PTB_USE_GSTREAMER
+    PsychGSGetMovieStats(moviehandle, outPos);
+    return;
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, Movie playback support not supported on your configuration.");
+}
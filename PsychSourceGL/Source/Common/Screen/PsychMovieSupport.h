@@ -47,6 +47,7 @@ int PsychPlaybackRate(int moviehandle, double playbackrate, int loop, double sou
 void PsychExitMovies(void);
 double PsychGetMovieTimeIndex(int moviehandle);
 double PsychSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
+void PsychGetMovieStats(int moviehandle, int outPos);
 
 //end include once
 #endif
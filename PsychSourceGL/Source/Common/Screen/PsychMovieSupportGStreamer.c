@@ -27,6 +27,7 @@
 #include "Screen.h"
 #include <glib.h>
 #include "PsychMovieSupportGStreamer.h"
+#include "PsychUploadBufferPoolGStreamer.h"
 #include <gst/gst.h>
 
 #if GST_CHECK_VERSION(1,0,0)
@@ -50,6 +51,18 @@ typedef enum {
 
 #define PSYCH_MAX_MOVIES 100
 
+// One decoded video frame in the optional decoded-frame RAM cache of a movie:
+typedef struct {
+    unsigned char       *data;
+    double              pts;
+} PsychMovieCachedFrame;
+
+// One video frame in the optional frame-indexed seek table of a movie:
+typedef struct {
+    double              pts;
+    int                 keyFrame;
+} PsychMovieIndexEntry;
+
 typedef struct {
     psych_mutex         mutex;
     psych_condition     condition;
@@ -81,6 +94,45 @@ typedef struct {
     char                movieLocation[FILENAME_MAX];
     char                movieName[FILENAME_MAX];
     GLuint              cached_texture;
+    // Decoded-frame RAM cache, filled by a background decoder thread, see PsychGSStartFrameCache():
+    GstElement          *cachePipeline;
+    GstElement          *cacheSink;
+    psych_thread        cacheThread;
+    int                 cacheThreadActive;
+    int                 cacheAbort;
+    int                 cacheFull;
+    PsychMovieCachedFrame *cacheFrames;
+    size_t              cacheBytes;
+    size_t              cacheMaxBytes;
+    int                 cacheCount;
+    int                 cacheCursor;
+    int                 cacheSeekPending;
+    int                 cacheHits;
+    int                 cacheMisses;
+    // Shared decode scheduler, see PsychGSScheduleDecoderThreads():
+    GstElement          *videocodec;
+    int                 decodeScheduled;
+    int                 decodeThreads;
+    // Decode timing statistics, updated by PsychVideoBufferProbe():
+    int                 decodedFrames;
+    int                 lateFrames;
+    double              sumDecodeLead;
+    double              minDecodeLead;
+    // Pool of decoder output buffers inside a PBO, for direct upload, see PsychGSCreateUploadPool():
+    PsychGSUploadPool   *uploadPool;
+    int                 uploadPoolTried;
+    // Frame-indexed seek table, see PsychGSStartSeekIndex():
+    GstElement          *indexPipeline;
+    GstElement          *indexSink;
+    psych_thread        indexThread;
+    int                 indexThreadActive;
+    int                 indexAbort;
+    char                *seekIndexFile;
+    PsychMovieIndexEntry *seekIndex;
+    int                 seekIndexCount;
+    int                 seekIndexKeyFrames;
+    int                 seekIndexComplete;
+    int                 stepSeeks;
 } PsychMovieRecordType;
 
 static PsychMovieRecordType movieRecordBANK[PSYCH_MAX_MOVIES];
@@ -388,6 +440,54 @@ static GstFlowReturn PsychNewBufferCallback(GstAppSink *sink, gpointer user_data
     return(GST_FLOW_OK);
 }
 
+/* Called by the streaming thread for each decoded video frame, before it enters the videosink.
+ * Measures the decode lead of the frame during active playback, ie., how much earlier than its
+ * due presentation time on the pipeline clock the frame was decoded. Negative leads are late frames.
+ */
+static GstPadProbeReturn PsychVideoBufferProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    PsychMovieRecordType* movie = (PsychMovieRecordType*) user_data;
+    GstBuffer       *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    GstElement      *sink;
+    GstEvent        *event;
+    const GstSegment *segment;
+    GstClock        *clock;
+    GstClockTime    runningTime = GST_CLOCK_TIME_NONE;
+    GstClockTime    now = GST_CLOCK_TIME_NONE;
+    double          lead;
+
+    // Only meaningful during playback, when the pipeline clock runs:
+    if ((movie->rate == 0) || !buffer || !GST_BUFFER_PTS_IS_VALID(buffer)) return(GST_PAD_PROBE_OK);
+
+    if ((event = gst_pad_get_sticky_event(pad, GST_EVENT_SEGMENT, 0))) {
+        gst_event_parse_segment(event, &segment);
+        runningTime = gst_segment_to_running_time(segment, GST_FORMAT_TIME, GST_BUFFER_PTS(buffer));
+        gst_event_unref(event);
+    }
+
+    sink = gst_pad_get_parent_element(pad);
+    if (sink) {
+        if ((clock = gst_element_get_clock(sink))) {
+            now = gst_clock_get_time(clock) - gst_element_get_base_time(sink);
+            gst_object_unref(clock);
+        }
+        gst_object_unref(sink);
+    }
+
+    if (!GST_CLOCK_TIME_IS_VALID(runningTime) || !GST_CLOCK_TIME_IS_VALID(now)) return(GST_PAD_PROBE_OK);
+
+    lead = ((double) runningTime - (double) now) / (double) 1e9;
+
+    PsychLockMutex(&movie->mutex);
+    if ((movie->decodedFrames == 0) || (lead < movie->minDecodeLead)) movie->minDecodeLead = lead;
+    movie->decodedFrames++;
+    movie->sumDecodeLead += lead;
+    if (lead < 0) movie->lateFrames++;
+    PsychUnlockMutex(&movie->mutex);
+
+    return(GST_PAD_PROBE_OK);
+}
+
 /* Not used by us, but needs to be defined as no-op anyway: */
 /* // There are only 3 function pointers in GstAppSinkCallbacks now
 static GstFlowReturn PsychNewBufferListCallback(GstAppSink *sink, gpointer user_data)
@@ -450,6 +550,8 @@ static void PsychMessageErrorCB(GstBus *bus, GstMessage *msg)
 }
 */
 
+static double PsychGSSeekMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
+
 static GstAppSinkCallbacks videosinkCallbacks = {
     PsychEOSCallback,
     PsychNewPrerollCallback,
@@ -457,6 +559,682 @@ static GstAppSinkCallbacks videosinkCallbacks = {
     {0}
 };
 
+/*
+ *  PsychGSDecodeWeight() -- Relative video decoding load of a movie, for the shared decode scheduler.
+ *
+ *  The load is the number of pixels to decode per second. Movies with late frames during
+ *  their previous playback get a higher weight, in proportion to their fraction of late frames.
+ */
+static double PsychGSDecodeWeight(PsychMovieRecordType* movie)
+{
+    double weight = (double) movie->width * (double) movie->height * movie->fps;
+
+    // Size and framerate are not yet known while the movie gets opened. Assume HD at 30 fps:
+    if (weight <= 0) weight = 1920.0 * 1080.0 * 30.0;
+
+    if (movie->decodedFrames > 0) weight *= 1.0 + (double) movie->lateFrames / (double) movie->decodedFrames;
+
+    return(weight);
+}
+
+/*
+ *  PsychGSAllocateDecoderThreads() -- Shared decode scheduler: Number of video decoder threads for a movie.
+ *
+ *  Movies opened with maxNumberThreads = -2 share a budget of one decoder thread per processor core,
+ *  instead of each movie's decoder using as many threads as there are cores. The budget is split
+ *  between movie 'moviehandle' and all other open scheduled movies, in proportion to their decoding
+ *  load. The share is capped to what the other movies leave of the budget with their current thread
+ *  counts, as those can only change at their next start of playback. Each movie gets at least one
+ *  thread, so the budget is only exceeded if more scheduled movies are open than there are cores.
+ */
+static int PsychGSAllocateDecoderThreads(int moviehandle)
+{
+    double  totalWeight = 0;
+    int     i, threads, cores, used = 0;
+
+    for (i = 0; i < PSYCH_MAX_MOVIES; i++) {
+        if (!movieRecordBANK[i].decodeScheduled || ((i != moviehandle) && (movieRecordBANK[i].theMovie == NULL))) continue;
+        totalWeight += PsychGSDecodeWeight(&(movieRecordBANK[i]));
+        if (i != moviehandle) used += movieRecordBANK[i].decodeThreads;
+    }
+
+    cores = PsychGetNumProcessorCores();
+    threads = (int) ((double) cores * PsychGSDecodeWeight(&(movieRecordBANK[moviehandle])) / totalWeight);
+    if (threads > cores - used) threads = cores - used;
+
+    return((threads < 1) ? 1 : threads);
+}
+
+/*
+ *  PsychGSScheduleDecoderThreads() -- Reassign the share of decoder threads of a movie at start of playback.
+ *
+ *  Called before playback of a scheduled movie starts, so the share can take the current
+ *  load and thread counts of all other open movies into account. The thread count of a
+ *  decoder can only be changed in ready state, so the whole stopped pipeline goes through
+ *  ready state and gets prerolled again at its previous position. Shares of movies which
+ *  are already playing stay as they are until their next start.
+ */
+static void PsychGSScheduleDecoderThreads(int moviehandle)
+{
+    PsychMovieRecordType* movie = &(movieRecordBANK[moviehandle]);
+    double timeindex;
+    int threads;
+
+    if (!movie->decodeScheduled || !movie->videocodec) return;
+
+    threads = PsychGSAllocateDecoderThreads(moviehandle);
+    if (threads == movie->decodeThreads) return;
+
+    // Ready state loses the playback position, so remember it:
+    timeindex = PsychGSGetMovieTimeIndex(moviehandle);
+
+    if (PsychMoviePipelineSetState(movie->theMovie, GST_STATE_READY, 30.0)) {
+        g_object_set(G_OBJECT(movie->videocodec), "max-threads", threads, NULL);
+        movie->decodeThreads = threads;
+        if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Decode scheduler assigns %i decoder threads to movie %i.\n", threads, moviehandle);
+    }
+
+    // Back to paused, prerolled at the old position:
+    PsychMoviePipelineSetState(movie->theMovie, GST_STATE_PAUSED, 30.0);
+    gst_element_seek_simple(movie->theMovie, GST_FORMAT_TIME, GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE, (gint64) (timeindex * (double) 1e9));
+    PsychMoviePipelineSetState(movie->theMovie, GST_STATE_PAUSED, 30.0);
+    PsychGSProcessMovieContext(movie, FALSE);
+}
+
+/*
+ *  PsychGSFrameCacheThreadMain() -- Main routine of the decoded-frame cache thread of a movie.
+ *
+ *  Pulls decoded video frames from the private video-only decode pipeline of the movie as
+ *  fast as possible and stores a copy of each frame in the RAM cache, indexed by frame number.
+ *  Stops at end of movie, if the memory limit of the cache is reached, or on abort request.
+ *  The frames are stored in the pixelFormat of the movie, so YUV planar pixelFormats 6 and 7
+ *  give the most compact cache.
+ */
+static void* PsychGSFrameCacheThreadMain(void* moviePtr)
+{
+    PsychMovieRecordType* movie = (PsychMovieRecordType*) moviePtr;
+    GstSample       *videoSample;
+    GstBuffer       *videoBuffer;
+    unsigned char   *data;
+    double          pts;
+    int             frameIndex;
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+    #pragma warning( disable : 4068 )
+#endif
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+    GstMapInfo      mapinfo = GST_MAP_INFO_INIT;
+    #pragma GCC diagnostic pop
+
+    PsychSetThreadName("ScreenMovieCache");
+    PsychAssignThreadToCoreSet("ScreenMovieCache", kPsychThreadClassWorker);
+
+    // Pull returns NULL at end of movie, or if the pipeline gets shut down on abort:
+    while (!movie->cacheAbort && (videoSample = gst_app_sink_pull_sample(GST_APP_SINK(movie->cacheSink)))) {
+        videoBuffer = gst_sample_get_buffer(videoSample);
+        pts = (double) GST_BUFFER_PTS(videoBuffer) / (double) 1e9;
+        frameIndex = (GST_BUFFER_PTS_IS_VALID(videoBuffer)) ? (int) (pts * movie->fps + 0.5) : -1;
+
+        if ((frameIndex >= 0) && (frameIndex < movie->nrframes) && !movie->cacheFrames[frameIndex].data &&
+            gst_buffer_map(videoBuffer, &mapinfo, GST_MAP_READ)) {
+            // Memory limit reached? Then stop decoding. Uncached frames will be served by the playback pipeline:
+            if (movie->cacheBytes + mapinfo.size > movie->cacheMaxBytes) {
+                gst_buffer_unmap(videoBuffer, &mapinfo);
+                gst_sample_unref(videoSample);
+                movie->cacheFull = 1;
+                break;
+            }
+
+            data = (unsigned char*) malloc(mapinfo.size);
+            if (data) {
+                memcpy(data, mapinfo.data, mapinfo.size);
+
+                PsychLockMutex(&movie->mutex);
+                movie->cacheFrames[frameIndex].pts = pts;
+                movie->cacheFrames[frameIndex].data = data;
+                movie->cacheBytes += mapinfo.size;
+                movie->cacheCount++;
+                PsychUnlockMutex(&movie->mutex);
+            }
+
+            gst_buffer_unmap(videoBuffer, &mapinfo);
+        }
+
+        gst_sample_unref(videoSample);
+    }
+
+    // Done with caching at end of movie or memory limit: Shut down the private decode pipeline right
+    // away to release its decoder threads and buffers, instead of keeping it around until the movie
+    // gets closed. Silent, as we are not on the main thread, and idempotent with PsychGSStopFrameCache():
+    if (!movie->cacheAbort) gst_element_set_state(movie->cachePipeline, GST_STATE_NULL);
+
+    return(NULL);
+}
+
+/*
+ *  PsychGSStopFrameCache() -- Stop the decoded-frame cache thread of a movie and release the cache.
+ */
+static void PsychGSStopFrameCache(PsychMovieRecordType* movie)
+{
+    int i;
+
+    if (movie->cachePipeline) {
+        // Shutting down the pipeline unblocks the cache thread if it waits for a new frame:
+        movie->cacheAbort = 1;
+        PsychMoviePipelineSetState(movie->cachePipeline, GST_STATE_NULL, 20.0);
+
+        if (movie->cacheThreadActive) {
+            PsychDeleteThread(&(movie->cacheThread));
+            movie->cacheThreadActive = 0;
+        }
+
+        // The appsink is owned by the pipeline, so it goes away with it:
+        gst_object_unref(GST_OBJECT(movie->cachePipeline));
+        movie->cachePipeline = NULL;
+        movie->cacheSink = NULL;
+    }
+
+    if (movie->cacheFrames) {
+        for (i = 0; i < movie->nrframes; i++) free(movie->cacheFrames[i].data);
+        free(movie->cacheFrames);
+        movie->cacheFrames = NULL;
+    }
+
+    movie->cacheBytes = 0;
+    movie->cacheCount = 0;
+    movie->cacheFull = 0;
+    movie->cacheSeekPending = 0;
+}
+
+/*
+ *  PsychGSStartFrameCache() -- Start decoding of a movie into a decoded-frame RAM cache of at most cacheMB Megabytes.
+ *
+ *  A private video-only playbin decodes the movie in the background, without sync to the clock,
+ *  so the cache fills as fast as the decoder can go, independent of the playback pipeline. Cached
+ *  frames are served by PsychGSGetTextureFromMovie() and PsychGSSetMovieTimeIndex() in manual fetch
+ *  mode (playback rate zero), without any seek or decode, so random access to any cached frame
+ *  is O(1).
+ */
+static psych_bool PsychGSStartFrameCache(PsychMovieRecordType* movie, int moviehandle, double cacheMB)
+{
+    GstCaps *caps;
+
+    if ((movie->nrVideoTracks == 0) || (movie->nrframes <= 0) || (movie->fps <= 0) || (movie->movieduration == DBL_MAX)) {
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Decoded-frame cache for movie %i disabled, as the number of video frames is unknown.\n", moviehandle);
+        return(FALSE);
+    }
+
+    movie->cachePipeline = gst_element_factory_make("playbin", "ptbmovieframecachepipeline");
+    movie->cacheSink = gst_element_factory_make("appsink", "ptbmovieframecachesink");
+    if (!movie->cachePipeline || !movie->cacheSink) {
+        if (movie->cacheSink) gst_object_unref(GST_OBJECT(movie->cacheSink));
+        if (movie->cachePipeline) gst_object_unref(GST_OBJECT(movie->cachePipeline));
+        movie->cachePipeline = NULL;
+        movie->cacheSink = NULL;
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Failed to create decoder for decoded-frame cache of movie %i. Cache disabled.\n", moviehandle);
+        return(FALSE);
+    }
+
+    // Cache frames in the same format as the playback pipeline delivers them:
+    caps = gst_app_sink_get_caps(GST_APP_SINK(movie->videosink));
+    gst_app_sink_set_caps(GST_APP_SINK(movie->cacheSink), caps);
+    if (caps) gst_caps_unref(caps);
+
+    // Decode as fast as possible, without dropping frames, only video:
+    g_object_set(G_OBJECT(movie->cacheSink), "sync", FALSE, NULL);
+    gst_app_sink_set_drop(GST_APP_SINK(movie->cacheSink), FALSE);
+    gst_app_sink_set_max_buffers(GST_APP_SINK(movie->cacheSink), 4);
+    g_object_set(G_OBJECT(movie->cachePipeline), "uri", movie->movieLocation, "flags", GST_PLAY_FLAG_VIDEO, "video-sink", movie->cacheSink, NULL);
+
+    movie->cacheFrames = (PsychMovieCachedFrame*) calloc(movie->nrframes, sizeof(PsychMovieCachedFrame));
+    movie->cacheMaxBytes = (size_t) (cacheMB * 1024 * 1024);
+    movie->cacheBytes = 0;
+    movie->cacheCount = 0;
+    movie->cacheFull = 0;
+    movie->cacheAbort = 0;
+    movie->cacheCursor = 0;
+    movie->cacheSeekPending = 0;
+    movie->cacheHits = 0;
+    movie->cacheMisses = 0;
+
+    if (!movie->cacheFrames || !PsychMoviePipelineSetState(movie->cachePipeline, GST_STATE_PLAYING, 30.0) ||
+        PsychCreateThread(&(movie->cacheThread), NULL, PsychGSFrameCacheThreadMain, (void*) movie)) {
+        PsychGSStopFrameCache(movie);
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Failed to start decoding for decoded-frame cache of movie %i. Cache disabled.\n", moviehandle);
+        return(FALSE);
+    }
+
+    movie->cacheThreadActive = 1;
+
+    if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Decoding movie %i into decoded-frame cache of up to %.1f MB in the background.\n", moviehandle, cacheMB);
+
+    return(TRUE);
+}
+
+/*
+ *  PsychGSFrameCacheLookup() -- Return frame number of the cached frame for a manual fetch at 'timeindex', or -1 if not cached.
+ *
+ *  A timeindex of -1 refers to the next frame, ie., the frame at the cache cursor if the cursor
+ *  was moved by a cache hit, otherwise the frame at the current position of the playback pipeline.
+ */
+static int PsychGSFrameCacheLookup(PsychMovieRecordType* movie, int moviehandle, double timeindex)
+{
+    int frameIndex;
+
+    if (timeindex >= 0) {
+        // Frame whose display interval contains timeindex, with some tolerance for rounding errors:
+        frameIndex = (int) floor(timeindex * movie->fps + 0.001);
+    }
+    else {
+        frameIndex = (movie->cacheSeekPending) ? movie->cacheCursor : (int) (PsychGSGetMovieTimeIndex(moviehandle) * movie->fps + 0.5);
+    }
+
+    if ((frameIndex < 0) || (frameIndex >= movie->nrframes)) return(-1);
+
+    PsychLockMutex(&movie->mutex);
+    if (!movie->cacheFrames[frameIndex].data) frameIndex = -1;
+    PsychUnlockMutex(&movie->mutex);
+
+    return(frameIndex);
+}
+
+/*
+ *  PsychGSFrameCacheSyncPipeline() -- Move the playback pipeline to the cache cursor after fetches served from the cache.
+ *
+ *  Cache hits don't move the playback pipeline. Before the pipeline is used again for
+ *  a fetch without explicit timeindex, it must seek to the frame following the last
+ *  frame served from the cache.
+ */
+static void PsychGSFrameCacheSyncPipeline(PsychMovieRecordType* movie, int moviehandle)
+{
+    if (!movie->cacheSeekPending) return;
+
+    // The fetch after the last frame of the movie signals end of movie, no seek needed:
+    if (movie->cacheCursor >= movie->nrframes) return;
+
+    PsychGSSeekMovieTimeIndex(moviehandle, (double) movie->cacheCursor, TRUE);
+}
+
+#if GST_CHECK_VERSION(1,10,0)
+/*
+ *  PsychGSSeekIndexCompare() -- qsort() comparison function for sorting seek table entries by presentation timestamp.
+ */
+static int PsychGSSeekIndexCompare(const void *a, const void *b)
+{
+    double ptsA = ((const PsychMovieIndexEntry*) a)->pts;
+    double ptsB = ((const PsychMovieIndexEntry*) b)->pts;
+
+    return((ptsA < ptsB) ? -1 : ((ptsA > ptsB) ? 1 : 0));
+}
+
+/*
+ *  PsychGSLoadSeekIndex() -- Load the seek table of a movie from its sidecar file, if it exists and matches the movie.
+ */
+static psych_bool PsychGSLoadSeekIndex(PsychMovieRecordType* movie)
+{
+    PsychMovieIndexEntry *entries;
+    FILE    *fd;
+    double  duration;
+    int     version, count, i, keyFrames = 0;
+
+    if (!movie->seekIndexFile || !(fd = fopen(movie->seekIndexFile, "r")))
+        return(FALSE);
+
+    // Reject files of other versions, or which don't match the duration of the movie:
+    if ((3 != fscanf(fd, "PTBMovieSeekIndex %i %i %lf\n", &version, &count, &duration)) || (version != 1) || (count <= 0) ||
+        ((movie->movieduration != DBL_MAX) && (fabs(duration - movie->movieduration) > 0.01))) {
+        fclose(fd);
+        return(FALSE);
+    }
+
+    entries = (PsychMovieIndexEntry*) malloc(count * sizeof(PsychMovieIndexEntry));
+    for (i = 0; entries && (i < count); i++) {
+        if (2 != fscanf(fd, "%lf %i\n", &entries[i].pts, &entries[i].keyFrame)) break;
+        keyFrames += entries[i].keyFrame;
+    }
+    fclose(fd);
+
+    if (!entries || (i < count)) {
+        free(entries);
+        return(FALSE);
+    }
+
+    PsychLockMutex(&movie->mutex);
+    movie->seekIndex = entries;
+    movie->seekIndexCount = count;
+    movie->seekIndexKeyFrames = keyFrames;
+    movie->seekIndexComplete = 1;
+    PsychUnlockMutex(&movie->mutex);
+
+    return(TRUE);
+}
+
+/*
+ *  PsychGSSaveSeekIndex() -- Save the completed seek table of a movie to its sidecar file.
+ */
+static void PsychGSSaveSeekIndex(PsychMovieRecordType* movie)
+{
+    FILE    *fd;
+    int     i;
+
+    if (!movie->seekIndexFile || !(fd = fopen(movie->seekIndexFile, "w"))) {
+        if (movie->seekIndexFile && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Could not write movie seek table to file %s.\n", movie->seekIndexFile);
+        return;
+    }
+
+    fprintf(fd, "PTBMovieSeekIndex 1 %i %f\n", movie->seekIndexCount, movie->movieduration);
+    for (i = 0; i < movie->seekIndexCount; i++) fprintf(fd, "%.9f %i\n", movie->seekIndex[i].pts, movie->seekIndex[i].keyFrame);
+    fclose(fd);
+}
+
+/*
+ *  PsychGSSeekIndexPadAdded() -- Link dynamic pads of the seek table pipeline.
+ *
+ *  Links the source to the parser, and the first video stream of the parser to the appsink.
+ *  Other streams stay unlinked, so they are discarded.
+ */
+static void PsychGSSeekIndexPadAdded(GstElement *element, GstPad *pad, gpointer targetPtr)
+{
+    GstElement  *target = (GstElement*) targetPtr;
+    GstPad      *sinkpad = gst_element_get_static_pad(target, "sink");
+    GstCaps     *caps;
+
+    (void) element;
+
+    if (!gst_pad_is_linked(sinkpad)) {
+        caps = gst_pad_query_caps(pad, NULL);
+        if (!GST_IS_APP_SINK(target) || (caps && !gst_caps_is_empty(caps) && g_str_has_prefix(gst_structure_get_name(gst_caps_get_structure(caps, 0)), "video/")))
+            gst_pad_link(pad, sinkpad);
+        if (caps) gst_caps_unref(caps);
+    }
+
+    gst_object_unref(sinkpad);
+}
+
+/*
+ *  PsychGSBuildSeekIndex() -- Build the seek table of a movie from its parsed, but not decoded, video stream.
+ *
+ *  Parsing without decoding runs at the speed of disk i/o. Each compressed frame provides its
+ *  presentation timestamp and a flag if it is a keyframe. Frames arrive in decoding order, so
+ *  the table is sorted by presentation timestamp at the end, to get the frames in display order.
+ */
+static void PsychGSBuildSeekIndex(PsychMovieRecordType* movie)
+{
+    PsychMovieIndexEntry *entries = NULL, *newEntries;
+    GstSample       *videoSample;
+    GstBuffer       *videoBuffer;
+    const GstSegment *segment;
+    GstMessage      *msg;
+    GstBus          *bus;
+    GstClockTime    ts;
+    int             count = 0, capacity = 0, keyFrames = 0, failed = 0;
+
+    bus = gst_element_get_bus(movie->indexPipeline);
+
+    while (!movie->indexAbort) {
+        videoSample = gst_app_sink_try_pull_sample(GST_APP_SINK(movie->indexSink), (GstClockTime) (0.1 * 1e9));
+        if (!videoSample) {
+            // End of movie, or error? Otherwise we just timed out and retry:
+            if (gst_app_sink_is_eos(GST_APP_SINK(movie->indexSink))) break;
+            if ((msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR))) {
+                gst_message_unref(msg);
+                failed = 1;
+                break;
+            }
+            continue;
+        }
+
+        videoBuffer = gst_sample_get_buffer(videoSample);
+        ts = (GST_BUFFER_PTS_IS_VALID(videoBuffer)) ? GST_BUFFER_PTS(videoBuffer) : GST_BUFFER_DTS(videoBuffer);
+
+        // Convert timestamp into stream time, the time base of movie positions and seeks:
+        segment = gst_sample_get_segment(videoSample);
+        if (GST_CLOCK_TIME_IS_VALID(ts) && segment && (segment->format == GST_FORMAT_TIME))
+            ts = gst_segment_to_stream_time(segment, GST_FORMAT_TIME, ts);
+
+        if (GST_CLOCK_TIME_IS_VALID(ts)) {
+            if (count == capacity) {
+                capacity = (capacity > 0) ? capacity * 2 : 4096;
+                newEntries = (PsychMovieIndexEntry*) realloc(entries, capacity * sizeof(PsychMovieIndexEntry));
+                if (!newEntries) {
+                    gst_sample_unref(videoSample);
+                    failed = 1;
+                    break;
+                }
+                entries = newEntries;
+            }
+
+            entries[count].pts = (double) ts / (double) 1e9;
+            entries[count].keyFrame = (GST_BUFFER_FLAG_IS_SET(videoBuffer, GST_BUFFER_FLAG_DELTA_UNIT)) ? 0 : 1;
+            keyFrames += entries[count].keyFrame;
+            count++;
+        }
+
+        gst_sample_unref(videoSample);
+    }
+
+    gst_object_unref(bus);
+
+    if (movie->indexAbort || failed || (count == 0) || (keyFrames == 0)) {
+        if (!movie->indexAbort && (PsychPrefStateGet_Verbosity() > 1))
+            printf("PTB-WARNING: Could not build seek table for movie %s. Using regular seeking.\n", movie->movieName);
+        free(entries);
+        return;
+    }
+
+    qsort(entries, count, sizeof(PsychMovieIndexEntry), PsychGSSeekIndexCompare);
+
+    PsychLockMutex(&movie->mutex);
+    movie->seekIndex = entries;
+    movie->seekIndexCount = count;
+    movie->seekIndexKeyFrames = keyFrames;
+    movie->seekIndexComplete = 1;
+    PsychUnlockMutex(&movie->mutex);
+
+    PsychGSSaveSeekIndex(movie);
+
+    if (PsychPrefStateGet_Verbosity() > 3)
+        printf("PTB-INFO: Seek table of movie %s complete: %i frames, %i keyframes.\n", movie->movieName, count, keyFrames);
+
+    return;
+}
+
+/*
+ *  PsychGSSeekIndexThreadMain() -- Main routine of the thread which builds the seek table of a movie in the background.
+ */
+static void* PsychGSSeekIndexThreadMain(void* moviePtr)
+{
+    PsychSetThreadName("ScreenMovieIndex");
+    PsychAssignThreadToCoreSet("ScreenMovieIndex", kPsychThreadClassWorker);
+
+    PsychGSBuildSeekIndex((PsychMovieRecordType*) moviePtr);
+
+    return(NULL);
+}
+#endif
+
+/*
+ *  PsychGSStopSeekIndexPipeline() -- Stop building the seek table of a movie and release the parser pipeline.
+ */
+static void PsychGSStopSeekIndexPipeline(PsychMovieRecordType* movie)
+{
+    if (!movie->indexPipeline) return;
+
+    movie->indexAbort = 1;
+
+    if (movie->indexThreadActive) {
+        PsychDeleteThread(&(movie->indexThread));
+        movie->indexThreadActive = 0;
+    }
+
+    // The appsink is owned by the pipeline, so it goes away with it:
+    PsychMoviePipelineSetState(movie->indexPipeline, GST_STATE_NULL, 20.0);
+    gst_object_unref(GST_OBJECT(movie->indexPipeline));
+    movie->indexPipeline = NULL;
+    movie->indexSink = NULL;
+}
+
+/*
+ *  PsychGSStopSeekIndex() -- Stop building the seek table of a movie and release the table.
+ */
+static void PsychGSStopSeekIndex(PsychMovieRecordType* movie)
+{
+    PsychGSStopSeekIndexPipeline(movie);
+
+    free(movie->seekIndex);
+    movie->seekIndex = NULL;
+    movie->seekIndexCount = 0;
+    movie->seekIndexKeyFrames = 0;
+    movie->seekIndexComplete = 0;
+    movie->stepSeeks = 0;
+
+    free(movie->seekIndexFile);
+    movie->seekIndexFile = NULL;
+}
+
+/*
+ *  PsychGSStartSeekIndex() -- Build a frame-indexed seek table of a movie.
+ *
+ *  The table stores presentation timestamp and keyframe flag of each video frame. Once it is
+ *  complete, frame based seeks are exact, and seeks in manual fetch mode step forward instead of
+ *  seeking if that means less decoding work, see PsychGSSeekMovieTimeIndex(). 'mode' 1 builds the
+ *  table in the background, 'mode' 2 builds it immediately and blocks until it is complete.
+ *  If 'indexFile' is given, the table is loaded from that sidecar file if it matches the movie,
+ *  otherwise it is built and saved to that file.
+ */
+static psych_bool PsychGSStartSeekIndex(PsychMovieRecordType* movie, int moviehandle, int mode, const char* indexFile)
+{
+#if GST_CHECK_VERSION(1,10,0)
+    GstElement *source, *parser;
+
+    if (indexFile) movie->seekIndexFile = strdup(indexFile);
+    movie->indexAbort = 0;
+    movie->stepSeeks = 0;
+
+    if (PsychGSLoadSeekIndex(movie)) {
+        if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Loaded seek table of movie %i from file %s.\n", moviehandle, indexFile);
+        return(TRUE);
+    }
+
+    if (movie->nrVideoTracks == 0) {
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Seek table for movie %i disabled, as the movie has no video track.\n", moviehandle);
+        return(FALSE);
+    }
+
+    movie->indexPipeline = gst_pipeline_new("ptbmovieseekindexpipeline");
+    source = gst_element_factory_make("urisourcebin", NULL);
+    parser = gst_element_factory_make("parsebin", NULL);
+    movie->indexSink = gst_element_factory_make("appsink", NULL);
+    if (!movie->indexPipeline || !source || !parser || !movie->indexSink) {
+        if (source) gst_object_unref(GST_OBJECT(source));
+        if (parser) gst_object_unref(GST_OBJECT(parser));
+        if (movie->indexSink) gst_object_unref(GST_OBJECT(movie->indexSink));
+        if (movie->indexPipeline) gst_object_unref(GST_OBJECT(movie->indexPipeline));
+        movie->indexPipeline = NULL;
+        movie->indexSink = NULL;
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Failed to create parser for seek table of movie %i. Using regular seeking.\n", moviehandle);
+        return(FALSE);
+    }
+
+    gst_bin_add_many(GST_BIN(movie->indexPipeline), source, parser, movie->indexSink, NULL);
+    g_object_set(G_OBJECT(source), "uri", movie->movieLocation, NULL);
+    g_signal_connect(G_OBJECT(source), "pad-added", G_CALLBACK(PsychGSSeekIndexPadAdded), parser);
+    g_signal_connect(G_OBJECT(parser), "pad-added", G_CALLBACK(PsychGSSeekIndexPadAdded), movie->indexSink);
+
+    // Parse as fast as possible, without waiting for preroll, as audio-only streams would never preroll:
+    g_object_set(G_OBJECT(movie->indexSink), "sync", FALSE, "async", FALSE, NULL);
+    gst_app_sink_set_drop(GST_APP_SINK(movie->indexSink), FALSE);
+    gst_app_sink_set_max_buffers(GST_APP_SINK(movie->indexSink), 64);
+
+    if (!PsychMoviePipelineSetState(movie->indexPipeline, GST_STATE_PLAYING, 30.0)) {
+        PsychGSStopSeekIndexPipeline(movie);
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Failed to start parsing for seek table of movie %i. Using regular seeking.\n", moviehandle);
+        return(FALSE);
+    }
+
+    if (mode > 1) {
+        // Build it now:
+        PsychGSBuildSeekIndex(movie);
+        PsychGSStopSeekIndexPipeline(movie);
+        return((psych_bool) movie->seekIndexComplete);
+    }
+
+    if (PsychCreateThread(&(movie->indexThread), NULL, PsychGSSeekIndexThreadMain, (void*) movie)) {
+        PsychGSStopSeekIndexPipeline(movie);
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Failed to start thread for building seek table of movie %i. Using regular seeking.\n", moviehandle);
+        return(FALSE);
+    }
+
+    movie->indexThreadActive = 1;
+
+    if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Building seek table of movie %i in the background.\n", moviehandle);
+
+    return(TRUE);
+#else
+    (void) movie;
+    (void) mode;
+    (void) indexFile;
+    if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Seek table for movie %i not supported, as it requires GStreamer 1.10 or later.\n", moviehandle);
+    return(FALSE);
+#endif
+}
+
+/*
+ *  PsychGSSeekIndexFind() -- Return number of the frame whose display interval contains 'timeindex', according to the seek table.
+ */
+static int PsychGSSeekIndexFind(PsychMovieRecordType* movie, double timeindex)
+{
+    int lo = 0, hi = movie->seekIndexCount - 1, mid;
+
+    // Last frame whose pts is not later than timeindex, with some tolerance for rounding errors:
+    while (lo < hi) {
+        mid = (lo + hi + 1) / 2;
+        if (movie->seekIndex[mid].pts <= timeindex + 0.0001)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return(lo);
+}
+
+/*
+ *  PsychGSSeekIndexStep() -- Try to move to frame 'targetFrame' in manual fetch mode by stepping forward instead of seeking.
+ *
+ *  A seek flushes the decoder and decodes all frames from the keyframe preceding the target. If the
+ *  current frame is not before that keyframe and not after the target, stepping forward to the target
+ *  needs less decoding, and no flush. Returns TRUE if the target was reached this way.
+ */
+static psych_bool PsychGSSeekIndexStep(int moviehandle, int targetFrame)
+{
+    PsychMovieRecordType *movie = &(movieRecordBANK[moviehandle]);
+    GstEvent    *event;
+    int         currentFrame, keyFrame;
+
+    if ((movie->rate != 0) || movie->endOfFetch) return(FALSE);
+
+    for (keyFrame = targetFrame; (keyFrame > 0) && !movie->seekIndex[keyFrame].keyFrame; keyFrame--);
+    currentFrame = PsychGSSeekIndexFind(movie, PsychGSGetMovieTimeIndex(moviehandle));
+
+    if ((currentFrame < keyFrame) || (currentFrame > targetFrame)) return(FALSE);
+
+    if (currentFrame < targetFrame) {
+        // Send the step event only to the videosink, as done for regular frame advance in manual fetch mode:
+        event = gst_event_new_step(GST_FORMAT_BUFFERS, (guint64) (targetFrame - currentFrame), 1.0, TRUE, FALSE);
+        if (!gst_element_send_event(movie->videosink, event)) return(FALSE);
+
+        // Block until step completed, failed, or timeout of 10 seconds reached:
+        if (GST_STATE_CHANGE_SUCCESS != gst_element_get_state(movie->theMovie, NULL, NULL, (GstClockTime) (10 * 1e9))) return(FALSE);
+    }
+
+    movie->stepSeeks++;
+
+    if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-INFO: Stepped from frame %i to frame %i in movie %i without seek.\n", currentFrame, targetFrame, moviehandle);
+
+    return(TRUE);
+}
+
 /*
  *      PsychGSCreateMovie() -- Create a movie object.
  *
@@ -496,6 +1274,8 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
     psych_bool      done;
     GstPlayFlags    playflags = 0;
     psych_bool      needCodecSetup = FALSE;
+    double          cacheMB = 0;
+    int             seekIndexMode = 0;
 
     // Suppress output of error-messages if moviehandle == 1000. That means we
     // run in our own Posix-Thread, not in the Matlab-Thread. Printing via Matlabs
@@ -924,6 +1704,9 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
     // Get the pad from the final sink for probing width x height of movie frames and nominal framerate of movie:
     pad = gst_element_get_static_pad(videosink, "sink");
 
+    // Measure decode timing of each video frame during playback:
+    gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, PsychVideoBufferProbe, &(movieRecordBANK[slotid]), NULL);
+
     PsychGSProcessMovieContext(&(movieRecordBANK[slotid]), FALSE);
 
     // Attach custom made audio sink?
@@ -1007,7 +1790,7 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
     // This happens if usercode provides some supported non-default override parameter for the codec,
     // or if the codec is multi-threaded and usercode wants us to configure its multi-threading behaviour:
     needCodecSetup = FALSE;
-    if (videocodec &&  ((g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "max-threads") && (maxNumberThreads > -1)) ||
+    if (videocodec &&  ((g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "max-threads") && (maxNumberThreads > -1 || maxNumberThreads == -2)) ||
                        (g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "lowres") && (specialFlags1 & (0))) || /* MK: 'lowres' disabled for now. */
                        (g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "debug-mv") && (specialFlags1 & 4)) ||
                        (g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "skip-frame") && (specialFlags1 & 8))
@@ -1042,13 +1825,21 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
 
     // Multi-threaded codec and usercode requests setup? If so, set its multi-threading behaviour:
     // By default many codecs would only use one single thread on any system, even if they are multi-threading capable.
-    if (needCodecSetup && (g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "max-threads")) && (maxNumberThreads > -1)) {
+    if (needCodecSetup && (g_object_class_find_property(G_OBJECT_GET_CLASS(videocodec), "max-threads")) && (maxNumberThreads > -1 || maxNumberThreads == -2)) {
         max_video_threads = 1;
         g_object_get(G_OBJECT(videocodec), "max-threads", &max_video_threads, NULL);
         if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-INFO: Movie playback for movie %i uses video decoder with a default maximum number of %i processing threads.\n", slotid, max_video_threads);
 
-        // Specific number of threads requested, or zero for auto-select?
-        if (maxNumberThreads > 0) {
+        // Specific number of threads requested, shared decode scheduler, or zero for auto-select?
+        if (maxNumberThreads == -2) {
+            // Shared decode scheduler assigns a share of the decoder thread budget of all movies,
+            // and reassigns it whenever playback starts. Keep a reference to the codec for that:
+            movieRecordBANK[slotid].decodeScheduled = 1;
+            movieRecordBANK[slotid].videocodec = gst_object_ref(videocodec);
+            max_video_threads = PsychGSAllocateDecoderThreads(slotid);
+            movieRecordBANK[slotid].decodeThreads = max_video_threads;
+            if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Setting video decoder to use %i processing threads, assigned by shared decode scheduler.\n", max_video_threads);
+        } else if (maxNumberThreads > 0) {
             // Specific value provided: Use it.
             max_video_threads = maxNumberThreads;
             if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Setting video decoder to use a maximum of %i processing threads.\n", max_video_threads);
@@ -1261,6 +2052,23 @@ void PsychGSCreateMovie(PsychWindowRecordType *win, const char* moviename, doubl
         GST_DEBUG_BIN_TO_DOT_FILE_WITH_TS(GST_BIN(movieRecordBANK[slotid].theMovie), GST_DEBUG_GRAPH_SHOW_ALL, "PsychMoviePlaybackGraph");
     }
 
+    // Decoded-frame RAM cache for random access requested?
+    if ((pstring = strstr(movieOptions, "FrameCacheMB=")) && (1 == sscanf(pstring, "FrameCacheMB=%lf", &cacheMB)) && (cacheMB > 0)) {
+        PsychGSStartFrameCache(&(movieRecordBANK[slotid]), slotid, cacheMB);
+    }
+
+    // Frame-indexed seek table requested? Optionally loaded from or saved to a sidecar file:
+    if ((pstring = strstr(movieOptions, "SeekIndex=")) && (1 == sscanf(pstring, "SeekIndex=%i", &seekIndexMode)) && (seekIndexMode > 0)) {
+        if ((pstring = strstr(movieOptions, "SeekIndexFile="))) {
+            pstring = strdup(pstring + strlen("SeekIndexFile="));
+            if (strstr(pstring, ":::") != NULL) *(strstr(pstring, ":::")) = 0;
+        }
+
+        PsychGSStartSeekIndex(&(movieRecordBANK[slotid]), slotid, seekIndexMode, pstring);
+        free(pstring);
+        pstring = NULL;
+    }
+
     // Ready to rock!
     return;
 }
@@ -1286,7 +2094,10 @@ void PsychGSGetMovieInfos(int moviehandle, int* width, int* height, int* frameco
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
-    if (framecount) *framecount = movieRecordBANK[moviehandle].nrframes;
+    // Exact framecount from the seek table, if it is complete:
+    PsychLockMutex(&movieRecordBANK[moviehandle].mutex);
+    if (framecount) *framecount = (movieRecordBANK[moviehandle].seekIndexComplete) ? movieRecordBANK[moviehandle].seekIndexCount : movieRecordBANK[moviehandle].nrframes;
+    PsychUnlockMutex(&movieRecordBANK[moviehandle].mutex);
     if (durationsecs) *durationsecs = movieRecordBANK[moviehandle].movieduration;
     if (framerate) *framerate = movieRecordBANK[moviehandle].fps;
     if (nrdroppedframes) *nrdroppedframes = movieRecordBANK[moviehandle].nr_droppedframes;
@@ -1297,6 +2108,49 @@ void PsychGSGetMovieInfos(int moviehandle, int* width, int* height, int* frameco
     return;
 }
 
+/*
+ *  PsychGSGetMovieStats() - Return struct with performance statistics of a movie in output argument 'outPos'.
+ */
+void PsychGSGetMovieStats(int moviehandle, int outPos)
+{
+    PsychMovieRecordType *movie;
+    PsychGenericScriptType *stats;
+    const char *FieldNames[] = { "FrameCacheMB", "CachedFrames", "CachedMB", "CacheFull", "CacheHits", "CacheMisses", "DroppedFrames",
+                                 "DecoderThreads", "DecodedFrames", "LateFrames", "MeanDecodeLead", "MinDecodeLead", "SeekIndexFrames",
+                                 "SeekIndexKeyFrames", "StepSeeks" };
+
+    if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
+    }
+
+    movie = &(movieRecordBANK[moviehandle]);
+    if (movie->theMovie == NULL) {
+        PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
+    }
+
+    PsychAllocOutStructArray(outPos, FALSE, 1, 15, FieldNames, &stats);
+
+    PsychLockMutex(&movie->mutex);
+    PsychSetStructArrayDoubleElement("FrameCacheMB", 0, (movie->cacheFrames) ? (double) movie->cacheMaxBytes / 1024 / 1024 : 0, stats);
+    PsychSetStructArrayDoubleElement("CachedFrames", 0, movie->cacheCount, stats);
+    PsychSetStructArrayDoubleElement("CachedMB", 0, (double) movie->cacheBytes / 1024 / 1024, stats);
+    PsychSetStructArrayDoubleElement("CacheFull", 0, movie->cacheFull, stats);
+    PsychSetStructArrayDoubleElement("DecodedFrames", 0, movie->decodedFrames, stats);
+    PsychSetStructArrayDoubleElement("LateFrames", 0, movie->lateFrames, stats);
+    PsychSetStructArrayDoubleElement("MeanDecodeLead", 0, (movie->decodedFrames > 0) ? movie->sumDecodeLead / movie->decodedFrames : 0, stats);
+    PsychSetStructArrayDoubleElement("MinDecodeLead", 0, movie->minDecodeLead, stats);
+    PsychSetStructArrayDoubleElement("SeekIndexFrames", 0, (movie->seekIndexComplete) ? movie->seekIndexCount : 0, stats);
+    PsychSetStructArrayDoubleElement("SeekIndexKeyFrames", 0, (movie->seekIndexComplete) ? movie->seekIndexKeyFrames : 0, stats);
+    PsychUnlockMutex(&movie->mutex);
+    PsychSetStructArrayDoubleElement("CacheHits", 0, movie->cacheHits, stats);
+    PsychSetStructArrayDoubleElement("CacheMisses", 0, movie->cacheMisses, stats);
+    PsychSetStructArrayDoubleElement("DroppedFrames", 0, movie->nr_droppedframes, stats);
+    PsychSetStructArrayDoubleElement("DecoderThreads", 0, (movie->decodeScheduled) ? movie->decodeThreads : -1, stats);
+    PsychSetStructArrayDoubleElement("StepSeeks", 0, movie->stepSeeks, stats);
+
+    return;
+}
+
 /*
  *  PsychGSDeleteMovie() -- Delete a movie object and release all associated ressources.
  */
@@ -1313,9 +2167,29 @@ void PsychGSDeleteMovie(int moviehandle)
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    // Stop background decoding into the decoded-frame cache, release the cache:
+    if (movieRecordBANK[moviehandle].cacheFrames && (PsychPrefStateGet_Verbosity() > 3)) {
+        printf("PTB-INFO: Decoded-frame cache of movie %i: %i of %i frames cached in %.1f MB%s. %i cache hits, %i cache misses.\n",
+               moviehandle, movieRecordBANK[moviehandle].cacheCount, movieRecordBANK[moviehandle].nrframes,
+               (double) movieRecordBANK[moviehandle].cacheBytes / 1024 / 1024, (movieRecordBANK[moviehandle].cacheFull) ? ", memory limit reached" : "",
+               movieRecordBANK[moviehandle].cacheHits, movieRecordBANK[moviehandle].cacheMisses);
+    }
+    PsychGSStopFrameCache(&(movieRecordBANK[moviehandle]));
+    PsychGSStopSeekIndex(&(movieRecordBANK[moviehandle]));
+
     // Stop movie playback immediately:
     PsychMoviePipelineSetState(movieRecordBANK[moviehandle].theMovie, GST_STATE_NULL, 20.0);
 
+    // Release the PBO buffer pool, now that no decoder uses it anymore:
+    PsychGSDeleteUploadPool(movieRecordBANK[moviehandle].uploadPool);
+    movieRecordBANK[moviehandle].uploadPool = NULL;
+    movieRecordBANK[moviehandle].uploadPoolTried = 0;
+
+    // Release our reference to the video decoder of the shared decode scheduler:
+    if (movieRecordBANK[moviehandle].videocodec) gst_object_unref(GST_OBJECT(movieRecordBANK[moviehandle].videocodec));
+    movieRecordBANK[moviehandle].videocodec = NULL;
+    movieRecordBANK[moviehandle].decodeScheduled = 0;
+
     // Delete movieobject for this handle:
     gst_object_unref(GST_OBJECT(movieRecordBANK[moviehandle].theMovie));
     movieRecordBANK[moviehandle].theMovie=NULL;
@@ -1396,6 +2270,8 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     double          tNow;
     double          preT, postT;
     unsigned char*  releaseMemPtr = NULL;
+    int             cacheIndex = -1;
+    psych_bool      usedUploadPool = FALSE;
 #if PSYCH_SYSTEM == PSYCH_WINDOWS
     #pragma warning( disable : 4068 )
 #endif
@@ -1450,6 +2326,37 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     // Get current playback rate:
     rate = movieRecordBANK[moviehandle].rate;
 
+    // Decoded-frame cache active in manual fetch mode? Then cached frames are served without seek or decode:
+    if ((0 == rate) && movieRecordBANK[moviehandle].cacheFrames) {
+        cacheIndex = PsychGSFrameCacheLookup(&(movieRecordBANK[moviehandle]), moviehandle, timeindex);
+        if (cacheIndex >= 0) {
+            // Cache hit: The frame is available immediately.
+            if (checkForImage) return(TRUE);
+
+            movieRecordBANK[moviehandle].cacheHits++;
+            movieRecordBANK[moviehandle].pts = movieRecordBANK[moviehandle].cacheFrames[cacheIndex].pts;
+            if (out_texture) out_texture->textureMemory = (GLuint*) movieRecordBANK[moviehandle].cacheFrames[cacheIndex].data;
+
+            // Advance cache cursor to the next frame:
+            movieRecordBANK[moviehandle].cacheCursor = cacheIndex + 1;
+            movieRecordBANK[moviehandle].cacheSeekPending = 1;
+            movieRecordBANK[moviehandle].endOfFetch = 0;
+
+            goto cachedframe;
+        }
+
+        // Cache miss. Last frame of movie already served from the cache?
+        if ((timeindex < 0) && movieRecordBANK[moviehandle].cacheSeekPending &&
+            (movieRecordBANK[moviehandle].cacheCursor >= movieRecordBANK[moviehandle].nrframes)) {
+            return((checkForImage) ? -1 : FALSE);
+        }
+
+        if (!checkForImage) movieRecordBANK[moviehandle].cacheMisses++;
+
+        // Fetch from the playback pipeline, which needs to move to the cache cursor first if no timeindex is given:
+        if (timeindex < 0) PsychGSFrameCacheSyncPipeline(&(movieRecordBANK[moviehandle]), moviehandle);
+    }
+
     // Is movie actively playing (automatic async playback, possibly with synced sound)?
     // If so, then we ignore the 'timeindex' parameter, because the automatic playback
     // process determines which frames should be delivered to PTB when. This function will
@@ -1466,7 +2373,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
             if (timeindex >= 0) {
                 // Yes. We try to retrieve the next possible image for requested timeindex.
                 // Seek to target timeindex:
-                PsychGSSetMovieTimeIndex(moviehandle, timeindex, FALSE);
+                PsychGSSeekMovieTimeIndex(moviehandle, timeindex, FALSE);
             }
             // Check for frame availability happens down there in the shared check code...
         }
@@ -1649,6 +2556,7 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
     }
     if (PsychPrefStateGet_Verbosity() > 5) printf("PTB-DEBUG: ...done.\n");
 
+cachedframe:
     PsychGetAdjustedPrecisionTimerSeconds(&tNow);
     if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-DEBUG: Start of frame query to decode completion: %f msecs.\n", (tNow - tStart) * 1000.0);
     tStart = tNow;
@@ -1689,8 +2597,10 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
 
                 // Return failure if Debayering did not work:
                 if (out_texture->textureMemory == NULL) {
-                    gst_buffer_unmap(videoBuffer, &mapinfo);
-                    gst_sample_unref(videoSample);
+                    if (videoSample) {
+                        gst_buffer_unmap(videoBuffer, &mapinfo);
+                        gst_sample_unref(videoSample);
+                    }
                     videoBuffer = NULL;
                     return(FALSE);
                 }
@@ -1703,6 +2613,18 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
                 return(FALSE);
             #endif
         }
+        else if (videoSample) {
+            // Create pool of decoder output buffers inside a PBO at first fetch, once the format is negotiated.
+            // Only possible with a bounded appsink queue, as the pool has a fixed number of buffers:
+            if (!movieRecordBANK[moviehandle].uploadPoolTried) {
+                movieRecordBANK[moviehandle].uploadPoolTried = 1;
+                movieRecordBANK[moviehandle].uploadPool = PsychGSCreateUploadPool(win, movieRecordBANK[moviehandle].videosink,
+                                                                                  (int) gst_app_sink_get_max_buffers(GST_APP_SINK(movieRecordBANK[moviehandle].videosink)));
+            }
+
+            // Frame decoded into the pool? Then upload asynchronously from the PBO, without a copy:
+            usedUploadPool = PsychGSUploadPoolSetupTexture(movieRecordBANK[moviehandle].uploadPool, win, out_texture);
+        }
 
         // Assign default depth according to number of channels:
         out_texture->depth = out_texture->nrchannels * movieRecordBANK[moviehandle].bitdepth;
@@ -1961,13 +2883,19 @@ int PsychGSGetTextureFromMovie(PsychWindowRecordType *win, int moviehandle, int
         movieRecordBANK[moviehandle].last_pts = *presentation_timestamp;
     }
 
-    // Unlock.
-    gst_buffer_unmap(videoBuffer, &mapinfo);
-    gst_sample_unref(videoSample);
+    // Unlock, unless the frame came from the decoded-frame cache. Frames in the PBO pool
+    // are only released once their asynchronous texture upload is complete:
+    if (videoSample) {
+        gst_buffer_unmap(videoBuffer, &mapinfo);
+        if (usedUploadPool)
+            PsychGSUploadPoolRetireSample(movieRecordBANK[moviehandle].uploadPool, videoSample);
+        else
+            gst_sample_unref(videoSample);
+    }
     videoBuffer = NULL;
 
-    // Manually advance movie time, if in fetch mode:
-    if (0 == rate) {
+    // Manually advance movie time, if in fetch mode and the frame came from the playback pipeline:
+    if ((0 == rate) && (cacheIndex < 0)) {
         // We are in manual fetch mode: Need to manually advance movie to next
         // media sample:
         movieRecordBANK[moviehandle].endOfFetch = 0;
@@ -2073,6 +3001,9 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
     if (playbackrate != 0) {
         // Start playback of movie:
 
+        // Assign share of decoder threads at start from stopped state, if shared decode scheduler is used:
+        if (movieRecordBANK[moviehandle].rate == 0) PsychGSScheduleDecoderThreads(moviehandle);
+
         // Set volume and mute state for audio:
         g_object_set(G_OBJECT(theMovie), "mute", (soundvolume <= 0) ? TRUE : FALSE, NULL);
         g_object_set(G_OBJECT(theMovie), "volume", soundvolume, NULL);
@@ -2118,6 +3049,9 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
 
         movieRecordBANK[moviehandle].loopflag = loop;
         movieRecordBANK[moviehandle].last_pts = -1.0;
+
+        // Above seek moved the pipeline to the cache cursor, if any frames were served from the decoded-frame cache:
+        movieRecordBANK[moviehandle].cacheSeekPending = 0;
         movieRecordBANK[moviehandle].nr_droppedframes = 0;
         movieRecordBANK[moviehandle].rate = playbackrate;
         movieRecordBANK[moviehandle].frameAvail = 0;
@@ -2230,6 +3164,12 @@ double PsychGSGetMovieTimeIndex(int moviehandle)
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    // Frames served from the decoded-frame cache in manual fetch mode don't move the pipeline,
+    // so report the position of the cache cursor instead:
+    if ((movieRecordBANK[moviehandle].rate == 0) && movieRecordBANK[moviehandle].cacheSeekPending) {
+        return((double) movieRecordBANK[moviehandle].cacheCursor / movieRecordBANK[moviehandle].fps);
+    }
+
     if (!gst_element_query_position(theMovie, GST_FORMAT_TIME, &pos_nsecs)) {
         if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Could not query position in movie %i in seconds. Returning zero.\n", moviehandle);
         pos_nsecs = 0;
@@ -2241,27 +3181,82 @@ double PsychGSGetMovieTimeIndex(int moviehandle)
 
 /*
  *  PsychGSSetMovieTimeIndex()  -- Set current playback time of movie, perform active seek if needed.
+ *
+ *  In manual fetch mode, a target frame which is already in the decoded-frame cache
+ *  only moves the cache cursor, without any seek of the playback pipeline.
  */
 double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames)
 {
-    GstElement      *theMovie;
+    PsychMovieRecordType *movie;
     double          oldtime;
-    gint64          targetIndex;
-    GstSeekFlags    flags;
+    int             frameIndex;
 
     if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIES) {
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided!");
     }
 
-    // Fetch references to objects we need:
-    theMovie = movieRecordBANK[moviehandle].theMovie;
-    if (theMovie == NULL) {
+    movie = &(movieRecordBANK[moviehandle]);
+    if (movie->theMovie == NULL) {
         PsychErrorExitMsg(PsychError_user, "Invalid moviehandle provided. No movie associated with this handle !!!");
     }
 
+    if ((movie->rate == 0) && movie->cacheFrames && (timeindex >= 0)) {
+        frameIndex = PsychGSFrameCacheLookup(movie, moviehandle, (indexIsFrames) ? ((double) ((int) (timeindex + 0.5)) / movie->fps) : timeindex);
+        if (frameIndex >= 0) {
+            oldtime = PsychGSGetMovieTimeIndex(moviehandle);
+            movie->cacheCursor = frameIndex;
+            movie->cacheSeekPending = 1;
+            movie->endOfFetch = 0;
+
+            if (PsychPrefStateGet_Verbosity() > 4) printf("PTB-INFO: Moved to cached frame %i in movie %i without seek.\n", frameIndex, moviehandle);
+
+            return(oldtime);
+        }
+    }
+
+    return(PsychGSSeekMovieTimeIndex(moviehandle, timeindex, indexIsFrames));
+}
+
+/*
+ *  PsychGSSeekMovieTimeIndex()  -- Perform active seek of the playback pipeline of a movie.
+ */
+static double PsychGSSeekMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames)
+{
+    PsychMovieRecordType *movie = &(movieRecordBANK[moviehandle]);
+    GstElement      *theMovie;
+    double          oldtime;
+    gint64          targetIndex;
+    GstSeekFlags    flags;
+    int             indexComplete, targetFrame;
+
+    // Fetch references to objects we need:
+    theMovie = movieRecordBANK[moviehandle].theMovie;
+
     // Retrieve current timeindex:
     oldtime = PsychGSGetMovieTimeIndex(moviehandle);
 
+    // The pipeline will be at the new position, no longer at the cache cursor:
+    movieRecordBANK[moviehandle].cacheSeekPending = 0;
+
+    // Seek table complete? Then resolve the target frame exactly, and step to it if that is cheaper than a
+    // seek, otherwise seek to its exact presentation timestamp:
+    PsychLockMutex(&movie->mutex);
+    indexComplete = movie->seekIndexComplete;
+    PsychUnlockMutex(&movie->mutex);
+
+    if (indexComplete) {
+        targetFrame = (indexIsFrames) ? (int) (timeindex + 0.5) : PsychGSSeekIndexFind(movie, timeindex);
+        if ((targetFrame >= 0) && (targetFrame < movie->seekIndexCount)) {
+            if (PsychGSSeekIndexStep(moviehandle, targetFrame)) {
+                movie->endOfFetch = 0;
+                return(oldtime);
+            }
+
+            timeindex = movie->seekIndex[targetFrame].pts;
+            indexIsFrames = FALSE;
+        }
+    }
+
     // NOTE: We could use GST_SEEK_FLAG_SKIP to allow framedropping on fast forward/reverse playback...
     flags = GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE;
 
@@ -36,6 +36,7 @@ int PsychGSPlaybackRate(int moviehandle, double playbackrate, int loop, double s
 void PsychGSExitMovies(void);
 double PsychGSGetMovieTimeIndex(int moviehandle);
 double PsychGSSetMovieTimeIndex(int moviehandle, double timeindex, psych_bool indexIsFrames);
+void PsychGSGetMovieStats(int moviehandle, int outPos);
 
 //end include once
 #endif
@@ -38,6 +38,7 @@
 // Record which defines all state for a capture device:
 typedef struct {
     volatile psych_bool                             eos;
+    volatile psych_bool                             encoderFailed;      // Set once the pipeline reported a GST_MESSAGE_ERROR.
     GMainLoop*                                      Context;
     GstElement*                                     Movie;
     GstElement*                                     ptbvideoappsrc;
@@ -57,6 +58,12 @@ typedef struct {
     double                                          frameTime;
     double                                          frameTimeDelta;
     GstClockTime                                    audioTime;
+    GstBufferPool*                                  pool;               // Pool of recycled video frame buffers.
+    unsigned int                                    maxQueuedFrames;    // Max. number of pool buffers in flight to the encoder, 0 = unlimited.
+    psych_uint64                                    framesAdded;        // Backpressure statistics: Number of added video frames,
+    psych_uint64                                    stallCount;         // number of waits for the encoder to release a buffer,
+    double                                          stallTime;          // total duration of these waits,
+    guint64                                         peakQueuedBytes;    // and peak amount of video data queued in appsrc.
 } PsychMovieWriterRecordType;
 
 static PsychMovieWriterRecordType moviewriterRecordBANK[PSYCH_MAX_MOVIEWRITERDEVICES];
@@ -122,7 +129,11 @@ void PsychDeleteAllMovieWriters(void)
     int i;
 
     for (i = 0; i < PSYCH_MAX_MOVIEWRITERDEVICES; i++) {
-        if (moviewriterRecordBANK[i].Movie) PsychFinalizeNewMovieFile(i);
+        if (moviewriterRecordBANK[i].Movie) {
+            // Add all pending asynchronously read back video frames first, like 'FinalizeMovie' does:
+            PsychFinishAsyncReadbacks(NULL, i);
+            PsychFinalizeNewMovieFile(i);
+        }
     }
 }
 
@@ -135,6 +146,12 @@ void PsychExitMovieWriting(void)
     return;
 }
 
+// Is 'moviehandle' the handle of an open movie writer? Unlike PsychGetMovieWriter() this never error-exits:
+psych_bool PsychIsMovieWriterOpen(int moviehandle)
+{
+    return(((moviehandle >= 0) && (moviehandle < PSYCH_MAX_MOVIEWRITERDEVICES) && moviewriterRecordBANK[moviehandle].Movie) ? TRUE : FALSE);
+}
+
 PsychMovieWriterRecordType* PsychGetMovieWriter(int moviehandle, psych_bool unsafe)
 {
     if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIEWRITERDEVICES) PsychErrorExitMsg(PsychError_user, "Invalid handle for moviewriter provided!");
@@ -197,11 +214,57 @@ unsigned char* PsychGetVideoFrameForMoviePtr(int moviehandle, unsigned int* twid
 {
     PsychMovieWriterRecordType* pwriterRec = PsychGetMovieWriter(moviehandle, FALSE);
     size_t size = pwriterRec->width * pwriterRec->height * pwriterRec->numChannels * (pwriterRec->bitdepth / 8);
+    GstBufferPoolAcquireParams params;
+    GstBus *bus;
+    GstMessage *msg;
+    double tstart, tend;
 
     // Buffer already created?
     if (NULL == pwriterRec->PixMap) {
-        // No. Let's create a suitable one:
-        pwriterRec->PixMap = gst_buffer_new_allocate(NULL, size, NULL);
+        // No. Get one from our pool of recycled buffers, or create a suitable one:
+        if (pwriterRec->pool) {
+            memset(&params, 0, sizeof(params));
+            params.flags = GST_BUFFER_POOL_ACQUIRE_FLAG_DONTWAIT;
+
+            if (gst_buffer_pool_acquire_buffer(pwriterRec->pool, &(pwriterRec->PixMap), &params) != GST_FLOW_OK) {
+                // All buffers are queued for encoding: The encoder can't keep up, so wait for it to release one.
+                // Never block indefinitely though: A failed encoder will never release its buffers, so poll
+                // the pool, check the bus for error messages in between, and give up after 5 seconds. Only
+                // error messages are popped from the bus, as we may run on a video recorder thread here:
+                PsychGetAdjustedPrecisionTimerSeconds(&tstart);
+                tend = tstart;
+                pwriterRec->PixMap = NULL;
+                bus = gst_pipeline_get_bus(GST_PIPELINE(pwriterRec->Movie));
+                while (!pwriterRec->encoderFailed && !pwriterRec->eos && (tend - tstart < 5.0)) {
+                    msg = gst_bus_pop_filtered(bus, GST_MESSAGE_ERROR);
+                    if (msg) {
+                        PsychMovieBusCallback(bus, msg, pwriterRec);
+                        gst_message_unref(msg);
+                        break;
+                    }
+
+                    if (gst_buffer_pool_acquire_buffer(pwriterRec->pool, &(pwriterRec->PixMap), &params) == GST_FLOW_OK) break;
+                    pwriterRec->PixMap = NULL;
+
+                    PsychYieldIntervalSeconds(0.001);
+                    PsychGetAdjustedPrecisionTimerSeconds(&tend);
+                }
+                gst_object_unref(bus);
+                PsychGetAdjustedPrecisionTimerSeconds(&tend);
+
+                if (NULL == pwriterRec->PixMap) {
+                    printf("PTB-ERROR: Movie writer %i: %s No free video frame buffer available.\n", moviehandle,
+                           (pwriterRec->encoderFailed) ? "Encoder failed with error above." :
+                           ((pwriterRec->eos) ? "Encoder already at end of stream." : "Encoder stalled for more than 5 seconds."));
+                }
+
+                pwriterRec->stallCount++;
+                pwriterRec->stallTime += tend - tstart;
+            }
+        }
+        else {
+            pwriterRec->PixMap = gst_buffer_new_allocate(NULL, size, NULL);
+        }
 
         // Out of memory condition!
         if (NULL == pwriterRec->PixMap) return(NULL);
@@ -230,6 +293,17 @@ unsigned char* PsychGetVideoFrameForMoviePtr(int moviehandle, unsigned int* twid
     return((unsigned char*) pwriterRec->mapinfo.data);
 }
 
+// Query size and format of the video frames of movie 'moviehandle':
+void PsychGetMovieFrameFormat(int moviehandle, unsigned int* twidth, unsigned int* theight, unsigned int* numChannels, unsigned int* bitdepth)
+{
+    PsychMovieWriterRecordType* pwriterRec = PsychGetMovieWriter(moviehandle, FALSE);
+
+    *twidth  = pwriterRec->width;
+    *theight = pwriterRec->height;
+    *numChannels = pwriterRec->numChannels;
+    *bitdepth = pwriterRec->bitdepth;
+}
+
 int PsychAddVideoFrameToMovie(int moviehandle, int frameDurationUnits, psych_bool isUpsideDown, double frameTimestamp)
 {
     PsychMovieWriterRecordType* pwriterRec = PsychGetMovieWriter(moviehandle, FALSE);
@@ -312,6 +386,7 @@ int PsychAddVideoFrameToMovie(int moviehandle, int frameDurationUnits, psych_boo
 
     // Add encoded buffer to movie: The function takes our reference, so we *must not unref the buffer*
     ret = gst_app_src_push_buffer(GST_APP_SRC(pwriterRec->ptbvideoappsrc), pwriterRec->PixMap);
+    pwriterRec->framesAdded++;
 
     // Drop our handle to it, so we can allocate a new one on demand:
     pwriterRec->PixMap = NULL;
@@ -341,6 +416,7 @@ int PsychAddVideoFrameToMovie(int moviehandle, int frameDurationUnits, psych_boo
             // The function takes our reference, so we *must not unref the buffer*
             ret = gst_app_src_push_buffer(GST_APP_SRC(pwriterRec->ptbvideoappsrc), curBuffer);
             curBuffer = NULL;
+            pwriterRec->framesAdded++;
 
             // One less...
             frameDurationUnits--;
@@ -350,6 +426,12 @@ int PsychAddVideoFrameToMovie(int moviehandle, int frameDurationUnits, psych_boo
     if (refBuffer) gst_buffer_unref(refBuffer);
     refBuffer = NULL;
 
+#if GST_CHECK_VERSION(1,2,0)
+    // Keep track of how far the encoder lags behind:
+    if (gst_app_src_get_current_level_bytes(GST_APP_SRC(pwriterRec->ptbvideoappsrc)) > pwriterRec->peakQueuedBytes)
+        pwriterRec->peakQueuedBytes = gst_app_src_get_current_level_bytes(GST_APP_SRC(pwriterRec->ptbvideoappsrc));
+#endif
+
     if (ret != GST_FLOW_OK) {
         // Oopsie! Error encountered - Abort.
         if (PsychPrefStateGet_Verbosity() > 0) printf("PTB-ERROR:In AddFrameToMovie: Adding current frame to moviehandle %i failed [push-buffer returned error code %i]!\n", moviehandle, (int) ret);
@@ -531,6 +613,7 @@ static gboolean PsychMovieBusCallback(GstBus *bus, GstMessage *msg, gpointer dat
       GError *error;
 
       gst_message_parse_error(msg, &error, &debug);
+      if (dev) dev->encoderFailed = TRUE;
       if (PsychPrefStateGet_Verbosity() > 0) { 
             printf("PTB-ERROR: GStreamer movie writing engine reports this error:\n"
                    "           Error from element %s: %s\n", GST_OBJECT_NAME(msg->src), error->message);
@@ -566,6 +649,7 @@ int PsychCreateNewMovieFile(char* moviefile, int width, int height, double frame
     PsychMovieWriterRecordType*             pwriterRec = NULL;
     int                                     moviehandle = 0;
     GError                                  *myErr = NULL;
+    GstStructure                            *poolConfig;
     char*                                   poption;
     char                                    codecString[1000];
     char                                    capsString[1000];
@@ -605,10 +689,16 @@ int PsychCreateNewMovieFile(char* moviefile, int width, int height, double frame
     pwriterRec->numChannels = (unsigned int) numChannels;
     pwriterRec->bitdepth = (unsigned int) bitdepth;
     pwriterRec->eos = FALSE;
+    pwriterRec->encoderFailed = FALSE;
     pwriterRec->useVariableFramerate = FALSE;
     pwriterRec->frameTime = 0.0;
     pwriterRec->frameTimeDelta = (framerate > 0.0) ? (1.0 / framerate) : 0.0;
     pwriterRec->audioTime = 0;
+    pwriterRec->maxQueuedFrames = 0;
+    pwriterRec->framesAdded = 0;
+    pwriterRec->stallCount = 0;
+    pwriterRec->stallTime = 0.0;
+    pwriterRec->peakQueuedBytes = 0;
 
     // If no movieoptions specified, create default string for default
     // codec selection and configuration:
@@ -699,6 +789,14 @@ int PsychCreateNewMovieFile(char* moviefile, int width, int height, double frame
         pwriterRec->useVariableFramerate = FALSE;
     }
 
+    // Limit on number of video frames queued for encoding requested? Otherwise the queue is unbounded:
+    if ((poption = strstr(movieoptions, "MaxQueuedFrames="))) {
+        if ((sscanf(poption, "MaxQueuedFrames=%i", &dummyInt) == 1) && (dummyInt >= 0)) {
+            pwriterRec->maxQueuedFrames = (unsigned int) dummyInt;
+        }
+        else PsychErrorExitMsg(PsychError_user, "Invalid MaxQueuedFrames= parameter provided in movieoptions parameter. Parse error or negative value!");
+    }
+
     // Full GStreamer launch line a la gst-launch command provided?
     if (strstr(movieoptions, "gst-launch")) {
         // Yes: We use movieoptions directly as launch line:
@@ -976,6 +1074,20 @@ int PsychCreateNewMovieFile(char* moviefile, int width, int height, double frame
 
     PsychGSProcessMovieContext(pwriterRec, FALSE);
 
+    // Create pool of video frame buffers which get recycled after encoding, instead of allocating
+    // new buffers for each frame. If a limit on queued frames is set, then the pool only has that
+    // many buffers, plus one for filling and one for encoding, so AddFrameToMovie waits for the
+    // encoder instead of queuing up ever more frames:
+    pwriterRec->pool = gst_buffer_pool_new();
+    poolConfig = gst_buffer_pool_get_config(pwriterRec->pool);
+    gst_buffer_pool_config_set_params(poolConfig, NULL, (guint) (width * height * numChannels * (bitdepth / 8)), 2,
+                                      (pwriterRec->maxQueuedFrames > 0) ? pwriterRec->maxQueuedFrames + 2 : 0);
+    if (!gst_buffer_pool_set_config(pwriterRec->pool, poolConfig) || !gst_buffer_pool_set_active(pwriterRec->pool, TRUE)) {
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: In CreateMovie: Could not create pool of video buffers for moviehandle %i. Performance may suffer.\n", moviehandle);
+        gst_object_unref(GST_OBJECT(pwriterRec->pool));
+        pwriterRec->pool = NULL;
+    }
+
     // Increment count of open movie writers:
     moviewritercount++;
 
@@ -1047,6 +1159,14 @@ int PsychFinalizeNewMovieFile(int movieHandle)
     PsychYieldIntervalSeconds(0.010);
     PsychGSProcessMovieContext(pwriterRec, FALSE);
 
+    // Report backpressure statistics, always if AddFrameToMovie had to wait for the encoder:
+    if ((PsychPrefStateGet_Verbosity() > 3) || ((pwriterRec->stallCount > 0) && (PsychPrefStateGet_Verbosity() > 2))) {
+        printf("PTB-INFO: Moviehandle %i: %i video frames added, peak encoder queue %i frames. Waited %i times for %f msecs total for encoder to catch up.\n",
+               movieHandle, (int) pwriterRec->framesAdded,
+               (int) (pwriterRec->peakQueuedBytes / (guint64) (pwriterRec->width * pwriterRec->height * pwriterRec->numChannels * (pwriterRec->bitdepth / 8))),
+               (int) pwriterRec->stallCount, pwriterRec->stallTime * 1000.0);
+    }
+
     // Pause the encoding pipeline:
     if (!PsychMoviePipelineSetState(pwriterRec->Movie, GST_STATE_PAUSED, 10)) {
         myErr |= 4;
@@ -1091,6 +1211,13 @@ int PsychFinalizeNewMovieFile(int movieHandle)
     if (pwriterRec->ptbvideoappsink) gst_object_unref(GST_OBJECT(pwriterRec->ptbvideoappsink));
     pwriterRec->ptbvideoappsink = NULL;
 
+    // Release pool of video buffers. Buffers still in use get freed when they are returned:
+    if (pwriterRec->pool) {
+        gst_buffer_pool_set_active(pwriterRec->pool, FALSE);
+        gst_object_unref(GST_OBJECT(pwriterRec->pool));
+    }
+    pwriterRec->pool = NULL;
+
     // Delete video context:
     if (pwriterRec->Context) g_main_loop_unref(pwriterRec->Context);
     pwriterRec->Context = NULL;
@@ -1118,6 +1245,7 @@ int PsychFinalizeNewMovieFile(int movieHandle)
 void PsychMovieWritingInit(void) { return; }
 void PsychExitMovieWriting(void) { return; }
 void PsychDeleteAllMovieWriters(void) { return; }
+psych_bool PsychIsMovieWriterOpen(int moviehandle) { return(FALSE); }
 int PsychCreateNewMovieFile(char* moviefile, int width, int height, double framerate, int numChannels, int bitdepth, char* movieoptions, char* feedbackString)
 {
     PsychErrorExitMsg(PsychError_unimplemented, "Sorry, movie writing not supported on this operating system");
@@ -1147,6 +1275,11 @@ unsigned char* PsychGetVideoFrameForMoviePtr(int moviehandle, unsigned int* twid
     return(NULL);
 }
 
+void PsychGetMovieFrameFormat(int moviehandle, unsigned int* twidth, unsigned int* theight, unsigned int* numChannels, unsigned int* bitdepth)
+{
+    PsychErrorExitMsg(PsychError_unimplemented, "Sorry, movie writing not supported on this operating system");
+}
+
 psych_bool PsychAddAudioBufferToMovie(int moviehandle, unsigned int nrChannels, unsigned int nrSamples, double* buffer)
 {
     PsychErrorExitMsg(PsychError_unimplemented, "Sorry, movie writing not supported on this operating system");
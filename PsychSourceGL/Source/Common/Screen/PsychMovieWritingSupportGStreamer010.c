@@ -148,7 +148,11 @@ void PsychDeleteAllMovieWriters(void)
     int i;
 
     for (i = 0; i < PSYCH_MAX_MOVIEWRITERDEVICES; i++) {
-        if (moviewriterRecordBANK[i].Movie) PsychFinalizeNewMovieFile(i);
+        if (moviewriterRecordBANK[i].Movie) {
+            // Add all pending asynchronously read back video frames first, like 'FinalizeMovie' does:
+            PsychFinishAsyncReadbacks(NULL, i);
+            PsychFinalizeNewMovieFile(i);
+        }
     }
 }
 
@@ -161,6 +165,12 @@ void PsychExitMovieWriting(void)
     return;
 }
 
+// Is 'moviehandle' the handle of an open movie writer? Unlike PsychGetMovieWriter() this never error-exits:
+psych_bool PsychIsMovieWriterOpen(int moviehandle)
+{
+    return(((moviehandle >= 0) && (moviehandle < PSYCH_MAX_MOVIEWRITERDEVICES) && moviewriterRecordBANK[moviehandle].Movie) ? TRUE : FALSE);
+}
+
 PsychMovieWriterRecordType* PsychGetMovieWriter(int moviehandle, psych_bool unsafe)
 {
     if (moviehandle < 0 || moviehandle >= PSYCH_MAX_MOVIEWRITERDEVICES) PsychErrorExitMsg(PsychError_user, "Invalid handle for moviewriter provided!");
@@ -237,6 +247,17 @@ unsigned char* PsychGetVideoFrameForMoviePtr(int moviehandle, unsigned int* twid
     return((unsigned char*) GST_BUFFER_DATA(pwriterRec->PixMap));
 }
 
+// Query size and format of the video frames of movie 'moviehandle':
+void PsychGetMovieFrameFormat(int moviehandle, unsigned int* twidth, unsigned int* theight, unsigned int* numChannels, unsigned int* bitdepth)
+{
+    PsychMovieWriterRecordType* pwriterRec = PsychGetMovieWriter(moviehandle, FALSE);
+
+    *twidth  = pwriterRec->width;
+    *theight = pwriterRec->height;
+    *numChannels = pwriterRec->numChannels;
+    *bitdepth = pwriterRec->bitdepth;
+}
+
 int PsychAddVideoFrameToMovie(int moviehandle, int frameDurationUnits, psych_bool isUpsideDown, double frameTimestamp)
 {
     PsychMovieWriterRecordType* pwriterRec = PsychGetMovieWriter(moviehandle, FALSE);
@@ -37,6 +37,16 @@
 
 #include "Screen.h"
 
+// SSE2 is part of the baseline instruction set of all 64-bit x86 processors, so
+// it is available without any special compiler flags or runtime cpu detection:
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PSYCH_TEXCONV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Images with more than this many pixels get converted by the shared worker thread pool:
+#define PSYCH_TEXCONV_GRAINSIZE 65536
+
 // If set to true, then the apple client storage extensions are used: I doubt that they have any
 // advantage for the current way PTB is used, but it can be useful to conserve VRAM on very
 // low-mem gfx cards if Screen('Preference', 'ConserveVRAM') is set appropriately.
@@ -132,6 +142,12 @@ void PsychInitWindowRecordTextureFields(PsychWindowRecordType *win)
     // setting will be used for the GL_UNPACK_ALIGNMENT setting in PsychCreateTexture() and friends
     // to optimize texture upload:
     win->textureByteAligned=0;
+
+    // Upload from textureMemory by default, no asynchronous upload pending:
+    win->textureUploadPBO=0;
+    win->textureUploadSlot=0;
+    win->textureUploadOffset=0;
+    win->textureUploadFence=NULL;
 }
 
 void PsychCreateTexture(PsychWindowRecordType *win)
@@ -146,7 +162,7 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     GLint gl_rbits=0, gl_gbits=0, gl_bbits=0, gl_abits=0, gl_lbits=0;
     int twidth, theight, pass, texcount;
     void* texmemptr;
-    psych_bool recycle = FALSE, avoidCPUGPUSync;
+    psych_bool recycle = FALSE, avoidCPUGPUSync, usePBO;
     GLenum glerr;
     int verbosity;
 
@@ -262,6 +278,10 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     // Desktop-GL only:
     if (!PsychIsGLES(win)) glPixelStorei(GL_UNPACK_ROW_LENGTH, (int) sourceWidth);
 
+    // Asynchronous upload from a pixel buffer object? Then the texture is created
+    // empty and filled via glTexSubImage2D from the PBO in stage 2:
+    usePBO = (win->textureUploadPBO) ? TRUE : FALSE;
+
     // We used to have different cases for Luminance, Luminance+Alpha, RGB, RGBA.
     // This way we saved texture memory for the source->textureMemory -- Arrays, as well as copy-time
     // in MakeTexture - In theory...
@@ -285,7 +305,7 @@ void PsychCreateTexture(PsychWindowRecordType *win)
         // Hardware supports rectangular textures: Use texture as-is:
         twidth  = (int) sourceWidth;
         theight = (int) sourceHeight;
-        texmemptr=win->textureMemory;
+        texmemptr = (usePBO) ? NULL : win->textureMemory;
     }
 
     // We only execute this pass for really new textures, not for recycled ones:
@@ -535,7 +555,10 @@ void PsychCreateTexture(PsychWindowRecordType *win)
     }  // End of new texture creation.
 
     // Stage 2: If it is a 2D texture or a recycled texture, fill it with content via glTexSubImage2D:
-    if (texturetarget == GL_TEXTURE_2D || recycle) {
+    if (texturetarget == GL_TEXTURE_2D || recycle || usePBO) {
+        // Source the data from the upload PBO, if any. Then texmemptr is an offset into the PBO:
+        texmemptr = (usePBO) ? PsychBindTextureUploadBuffer(win) : win->textureMemory;
+
         // Special setup code for pot2 textures: Fill the empty power of two texture object with content:
         // We only fill a subrectangle (of sourceWidth x sourceHeight size) with our images content. The
         // unused border contains all zero == black.
@@ -544,39 +567,42 @@ void PsychCreateTexture(PsychWindowRecordType *win)
             // Standard path: Derive texture format and such from requested pixeldepth:
             switch(win->depth) {
                 case 8:
-                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE, GL_UNSIGNED_BYTE, win->textureMemory);
+                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE, GL_UNSIGNED_BYTE, texmemptr);
                     break;
 
                 case 16:
-                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, win->textureMemory);
+                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, texmemptr);
                     break;
 
                 case 24:
-                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGB, GL_UNSIGNED_BYTE, win->textureMemory);
+                    glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGB, GL_UNSIGNED_BYTE, texmemptr);
                     break;
 
                 case 32:
                     if (PsychIsGLES(win)) {
                         // GLES is much more restricted:
                         if (strstr((const char*) glGetString(GL_EXTENSIONS), "GL_EXT_texture_format_BGRA8888")) {
-                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA_EXT, GL_UNSIGNED_BYTE, win->textureMemory);
+                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA_EXT, GL_UNSIGNED_BYTE, texmemptr);
                         }
                         else {
-                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGBA, GL_UNSIGNED_BYTE, win->textureMemory);
+                            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_RGBA, GL_UNSIGNED_BYTE, texmemptr);
                         }
                     }
                     else {
                         // Classic path:
-                        glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA, ((win->gfxcaps & kPsychGfxCapNeedsUnsignedByteRGBATextureUpload) ? GL_UNSIGNED_BYTE : GL_UNSIGNED_INT_8_8_8_8_REV), win->textureMemory);
+                        glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, GL_BGRA, ((win->gfxcaps & kPsychGfxCapNeedsUnsignedByteRGBATextureUpload) ? GL_UNSIGNED_BYTE : GL_UNSIGNED_INT_8_8_8_8_REV), texmemptr);
                     }
                     break;
             }
         }
         else {
             // Requested internal format and external data representation are explicitely requested: Use it.
-            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, win->textureexternalformat, win->textureexternaltype, win->textureMemory);
+            glTexSubImage2D(texturetarget, 0, 0, 0, (GLsizei)sourceWidth, (GLsizei)sourceHeight, win->textureexternalformat, win->textureexternaltype, texmemptr);
             glinternalFormat = win->textureinternalformat;
         }
+
+        // Unbind PBO and fence the now pending asynchronous upload:
+        if (usePBO) PsychFinishTextureUpload(win);
     }
 
     if (!PsychIsGLES(win)) {
@@ -649,9 +675,25 @@ void PsychFreeTextureForWindowRecord(PsychWindowRecordType *win)
         // work for some strange reason :(
         if ((win->textureMemory) && (win->textureNumber > 0)) glFinish(); // FinishObjectAPPLE(GL_TEXTURE_2D, win->textureNumber);
 
+        // Discard fence of a pending asynchronous upload:
+        if (win->textureUploadFence) {
+            glDeleteSync(win->textureUploadFence);
+            win->textureUploadFence = NULL;
+        }
+
         // Perform standard OpenGL texture cleanup if needed:
         if (win->textureNumber != 0) {
-            glDeleteTextures(1, &win->textureNumber);
+            if ((win->fboCount == 1) && win->fboTable[0] && (win->fboTable[0]->coltexid == win->textureNumber) &&
+                (win->fboTable[0]->format > 1) && (win->fboTable[0]->multisample == 0)) {
+                // Colorbuffer of a FBO backed Offscreen window: Return the whole FBO to the FBO pool of our
+                // onscreen window for reuse by future Offscreen windows, instead of deleting it:
+                PsychReleasePooledFBO(win, win->fboTable[0]);
+                win->fboTable[0] = NULL;
+                win->fboCount = 0;
+            }
+            else {
+                glDeleteTextures(1, &win->textureNumber);
+            }
 
             // Accounting... ...this is only a rough guesstimate:
             texmemguesstimate-= win->surfaceSizeBytes;
@@ -1326,8 +1368,22 @@ static float transX, transY;
 static float crt, srt;
 static unsigned int useXForm = 0;
 
-static inline void glVertexXform(GLfloat x, GLfloat y)
+// Staging buffer for the quads of PsychBatchBlitTexturesToDisplay(). Each vertex consists of a
+// (x,y) position, (s,t) texture coordinates and a (r,g,b,a) color, optionally followed by the
+// values of the generic vertex attributes of a user supplied texture shader. The vertices get
+// uploaded and drawn with one glDrawArrays() call at the end of a batch, or whenever the buffer
+// is full:
+#define PSYCH_MAX_TEXBATCH_FLOATS (256 * 1024)
+static float texbatch_buffer[PSYCH_MAX_TEXBATCH_FLOATS];
+static float texbatch_quad[4 + 11 * 4];
+static int texbatch_stride = 8;
+static int texbatch_count = 0;
+static int texbatch_attriboffset[11];   // Offset of each streamed shader attribute in a vertex, or 0 if not streamed.
+
+// Add a vertex of the current quad, with the per quad values from texbatch_quad[]:
+static inline void PsychTexBatchVertex(GLfloat tx, GLfloat ty, GLfloat x, GLfloat y)
 {
+    float *v = &texbatch_buffer[texbatch_count++ * texbatch_stride];
     GLfloat xo, yo;
 
     if (useXForm == 1) {
@@ -1337,44 +1393,92 @@ static inline void glVertexXform(GLfloat x, GLfloat y)
         xo = crt * x - srt * y;
         yo = srt * x + crt * y;
 
-        xo = xo + transX;
-        yo = yo + transY;
+        x = xo + transX;
+        y = yo + transY;
     }
-    else {
-        xo = x;
-        yo = y;
+    else if (useXForm == 2) {
+        tx = tx - transX;
+        ty = ty - transY;
+
+        xo = crt * tx - srt * ty;
+        yo = srt * tx + crt * ty;
+
+        tx = xo + transX;
+        ty = yo + transY;
     }
 
-    glVertex2f(xo, yo);
+    v[0] = x;
+    v[1] = y;
+    v[2] = tx;
+    v[3] = ty;
+    memcpy(&v[4], texbatch_quad, (texbatch_stride - 4) * sizeof(float));
 }
 
-static inline void glTexCoordXform(GLfloat x, GLfloat y)
+// Set per quad value of the i'th shader attribute, or of the color for i == -1:
+static inline void PsychTexBatchAttrib(int i, double a, double b, double c, double d)
 {
-    GLfloat xo, yo;
+    float *v = (i < 0) ? &texbatch_quad[0] : &texbatch_quad[texbatch_attriboffset[i] - 4];
 
-    if (useXForm == 2) {
-        x = x - transX;
-        y = y - transY;
+    v[0] = (float) a;
+    v[1] = (float) b;
+    v[2] = (float) c;
+    v[3] = (float) d;
+}
 
-        xo = crt * x - srt * y;
-        yo = srt * x + crt * y;
+// Draw all quads in the staging buffer, with the given 'modulateColor' and other shader attribute locations:
+static void PsychTexBatchFlush(PsychWindowRecordType *target, GLint mattrib, GLint *attribs)
+{
+    GLsizei stride = texbatch_stride * sizeof(float);
+    char *base;
+    int i;
+
+    if (texbatch_count == 0) return;
+
+    base = PsychStreamVertexData(target, texbatch_buffer, (size_t) texbatch_count * stride);
 
-        xo = xo + transX;
-        yo = yo + transY;
+    glVertexPointer(2, GL_FLOAT, stride, base);
+    glTexCoordPointer(2, GL_FLOAT, stride, base + 2 * sizeof(float));
+    glColorPointer(4, GL_FLOAT, stride, base + 4 * sizeof(float));
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    // The 'modulateColor' attribute of a shader receives the same values as the color:
+    if (mattrib >= 0) {
+        glVertexAttribPointerARB(mattrib, 4, GL_FLOAT, GL_FALSE, stride, base + 4 * sizeof(float));
+        glEnableVertexAttribArrayARB(mattrib);
     }
-    else {
-        xo = x;
-        yo = y;
+
+    for (i = 0; i < 11; i++) {
+        if (texbatch_attriboffset[i] > 0) {
+            glVertexAttribPointerARB(attribs[i], 4, GL_FLOAT, GL_FALSE, stride, base + texbatch_attriboffset[i] * sizeof(float));
+            glEnableVertexAttribArrayARB(attribs[i]);
+        }
+    }
+
+    glDrawArrays(GL_QUADS, 0, texbatch_count);
+
+    if (mattrib >= 0) glDisableVertexAttribArrayARB(mattrib);
+    for (i = 0; i < 11; i++) {
+        if (texbatch_attriboffset[i] > 0) glDisableVertexAttribArrayARB(attribs[i]);
     }
 
-    glTexCoord2f(xo, yo);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, NULL);
+    glTexCoordPointer(2, GL_FLOAT, 0, NULL);
+    glColorPointer(4, GL_FLOAT, 0, NULL);
+
+    PsychStreamVertexDataDone();
+
+    texbatch_count = 0;
 }
 
 void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, PsychWindowRecordType *source, PsychWindowRecordType *target, double *sourceRect, double *targetRect,
                                      double rotationAngle, int filterMode, double globalAlpha)
 {
     static unsigned int index = 0;
-    static float *vertices, *colors, *texcoords;
 
     static GLint attribs[11];
     static GLenum texturetarget;
@@ -1385,18 +1489,16 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
     static double oldRotationAngle;
     static GLdouble sourceWidth, sourceHeight;
     GLdouble sourceX, sourceY, sourceXEnd, sourceYEnd;
+    double *auxParams;
+    int i;
 
     (void) count;
 
     if (opMode == 0) {
         // Start new batch:
-        if (vertices || colors || texcoords)
-            PsychErrorExitMsg(PsychError_internal, "Non-NULL arrays at start of batch for opMode 0!\n");
-
+        // Discard leftovers of a batch which was aborted by an error:
+        texbatch_count = 0;
         index = 0;
-        //vertices = malloc(count * 2 *sizeof(float));
-        //colors = malloc(count * 4 * sizeof(float));
-        //texcoords = malloc(count * 2 * sizeof(float));
 
         // Enable targets framebuffer as current drawingtarget, except if this is a
         // blit operation from a window into itself and the imaging pipe is on:
@@ -1420,15 +1522,14 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
         // Finalize this batch:
 
         // DRAW DRAW DRAW DRAW!
-
-        glEnd();
+        PsychTexBatchFlush(target, mattrib, attribs);
 
         // Disable Transform:
         useXForm = 0;
         oldRotationAngle = 0;
 
         // Only disable texture mapping if we actually enabled it.
-        if (textureNumber > 0) {
+        if ((index > 0) && (textureNumber > 0)) {
             // Reset filters to nearest: This is important in case this texture
             // is used as color buffer attachment of a FBO, because using the
             // FBO would fail in puzzling ways if filtermode!=GL_NEAREST.
@@ -1446,13 +1547,6 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
             glDisable(texturetarget);
         }
 
-        //free(vertices);
-        vertices = NULL;
-        //free(colors);
-        colors = NULL;
-        //free(texcoords);
-        texcoords = NULL;
-
         return;
     }
 
@@ -1723,7 +1817,16 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
 
         textureNumber = source->textureNumber;
 
-        glBegin(GL_QUADS);
+        // Vertex layout in the staging buffer: Append all attributes used by a user supplied shader:
+        texbatch_stride = 8;
+        for (i = 0; i < 11; i++) {
+            texbatch_attriboffset[i] = 0;
+            if ((source->textureFilterShader < 0) && (attribs[i] >= 0) &&
+                ((i < 3) || (target->auxShaderParams && (target->auxShaderParamsCount >= (i - 2) * 4)))) {
+                texbatch_attriboffset[i] = texbatch_stride;
+                texbatch_stride += 4;
+            }
+        }
 
         // End of prep for first texture quad.
     }
@@ -1778,24 +1881,14 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
         sourceYEnd=sourceYEnd / (double) tHeight;
     }
 
-    // Any automatic shader assigned yet?
-    if (shader > 0 && mattrib >= 0) {
-        if (globalAlpha == DBL_MAX) {
-            // globalAlpha disabled: Pass the 'modulateColor' vector:
-            glVertexAttrib4dvARB(mattrib, target->currentColor);
-        }
-        else {
-            // modulateColor disabled: Pass (1,1,1) as RGB color and globalAlpha as alpha:
-            glVertexAttrib4fARB(mattrib, 1.0, 1.0, 1.0, (GLfloat) globalAlpha);
-        }
-    }
-
-    // Fixed function pipeline color assignment:
+    // Color assignment, which is also passed as 'modulateColor' attribute to an automatic shader:
     if (globalAlpha == DBL_MAX) {
-        glColor4dv(target->currentColor);
+        // globalAlpha disabled: Pass the 'modulateColor' vector:
+        PsychTexBatchAttrib(-1, target->currentColor[0], target->currentColor[1], target->currentColor[2], target->currentColor[3]);
     }
     else {
-        glColor4f(1, 1, 1, (GLfloat) globalAlpha);
+        // modulateColor disabled: Pass (1,1,1) as RGB color and globalAlpha as alpha:
+        PsychTexBatchAttrib(-1, 1.0, 1.0, 1.0, globalAlpha);
     }
 
     if ((rotationAngle != 0) && !(source->specialflags & kPsychDontDoRotation)) {
@@ -1847,71 +1940,64 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
         // info gets potentially transformed by the texture matrix, also each vertex
         // only sees one corner of the srcRect: Therefore we encode srcrect = [left top right bottom]
         // on demand:
-        if (attribs[0] >= 0) glVertexAttrib4fARB(attribs[0], (GLfloat) sourceRect[kPsychLeft], (GLfloat) sourceRect[kPsychTop], (GLfloat) sourceRect[kPsychRight], (GLfloat) sourceRect[kPsychBottom]);
+        if (texbatch_attriboffset[0]) PsychTexBatchAttrib(0, sourceRect[kPsychLeft], sourceRect[kPsychTop], sourceRect[kPsychRight], sourceRect[kPsychBottom]);
 
         // 'dstRect' parameter: The glVertex() calls below encode target pixel coordinates
         // - and thereby the corners of 'dstRect' - into each vertex, however this
         // info gets potentially transformed by the modelview/proj. matrix, also each vertex
         // only sees one corner of the dstRect: Therefore we encode dstrect = [left top right bottom]
         // on demand:
-        if (attribs[1] >= 0) glVertexAttrib4fARB(attribs[1], (GLfloat) targetRect[kPsychLeft], (GLfloat) targetRect[kPsychTop], (GLfloat) targetRect[kPsychRight], (GLfloat) targetRect[kPsychBottom]);
+        if (texbatch_attriboffset[1]) PsychTexBatchAttrib(1, targetRect[kPsychLeft], targetRect[kPsychTop], targetRect[kPsychRight], targetRect[kPsychBottom]);
 
         // 'sizeAngleFilterMode' - if requested - encodes texture width in .x component, height in .y
         // requested rotationAngle in .z and the 'filterMode' flags in .w:
-        if (attribs[2] >= 0) glVertexAttrib4fARB(attribs[2], (GLfloat) sourceWidth, (GLfloat) sourceHeight, (GLfloat) rotationAngle, (GLfloat) filterMode);
+        if (texbatch_attriboffset[2]) PsychTexBatchAttrib(2, sourceWidth, sourceHeight, rotationAngle, filterMode);
 
         // 'auxParameters0' is the first for components (rows) of the 'auxParameters' argument
         // of Screen('DrawTexture(s)') - if such an argument was spec'd:
         if (target->auxShaderParams) {
-            if ((target->auxShaderParamsCount >=4) && (attribs[3] >= 0)) glVertexAttrib4dvARB(attribs[3], target->auxShaderParams);
-            if ((target->auxShaderParamsCount >=8) && (attribs[4] >= 0)) glVertexAttrib4dvARB(attribs[4], &(target->auxShaderParams[4]));
-            if ((target->auxShaderParamsCount >=12) && (attribs[5] >= 0)) glVertexAttrib4dvARB(attribs[5], &(target->auxShaderParams[8]));
-            if ((target->auxShaderParamsCount >=16) && (attribs[6] >= 0)) glVertexAttrib4dvARB(attribs[6], &(target->auxShaderParams[12]));
-            if ((target->auxShaderParamsCount >=20) && (attribs[7] >= 0)) glVertexAttrib4dvARB(attribs[7], &(target->auxShaderParams[16]));
-            if ((target->auxShaderParamsCount >=24) && (attribs[8] >= 0)) glVertexAttrib4dvARB(attribs[8], &(target->auxShaderParams[20]));
-            if ((target->auxShaderParamsCount >=28) && (attribs[9] >= 0)) glVertexAttrib4dvARB(attribs[9], &(target->auxShaderParams[24]));
-            if ((target->auxShaderParamsCount >=32) && (attribs[10] >= 0)) glVertexAttrib4dvARB(attribs[10], &(target->auxShaderParams[28]));
+            for (i = 3; i < 11; i++) {
+                if (texbatch_attriboffset[i]) {
+                    auxParams = &(target->auxShaderParams[(i - 3) * 4]);
+                    PsychTexBatchAttrib(i, auxParams[0], auxParams[1], auxParams[2], auxParams[3]);
+                }
+            }
         }
     }
 
+    // Make room for this quad if the staging buffer is full:
+    if ((texbatch_count + 4) * texbatch_stride > PSYCH_MAX_TEXBATCH_FLOATS) PsychTexBatchFlush(target, mattrib, attribs);
+
     // Coordinate assignments depend on internal texture orientation...
     if (source->textureOrientation == 2 ||
         source->textureOrientation == 3 || source->textureOrientation == 4) {
         // Use "normal" coordinate assignments, so that the rotation == 0 deg. case
         // is the fastest case --> Most common orientation has highest performance.
         //lower left
-        glTexCoordXform((GLfloat)sourceX, (GLfloat)sourceYEnd);
-        glVertexXform((GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychTop]));        //upper left vertex in window
+        PsychTexBatchVertex((GLfloat)sourceX, (GLfloat)sourceYEnd, (GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychTop])); //upper left vertex in window
 
         //upper left
-        glTexCoordXform((GLfloat)sourceX, (GLfloat)sourceY);
-        glVertexXform((GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychBottom]));     //lower left vertex in window
+        PsychTexBatchVertex((GLfloat)sourceX, (GLfloat)sourceY, (GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychBottom])); //lower left vertex in window
 
         //upper right
-        glTexCoordXform((GLfloat)sourceXEnd, (GLfloat)sourceY);
-        glVertexXform((GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychBottom]) );   //lower right  vertex in window
+        PsychTexBatchVertex((GLfloat)sourceXEnd, (GLfloat)sourceY, (GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychBottom])); //lower right  vertex in window
 
         //lower right
-        glTexCoordXform((GLfloat)sourceXEnd, (GLfloat)sourceYEnd);
-        glVertexXform((GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychTop]));       //upper right in window
+        PsychTexBatchVertex((GLfloat)sourceXEnd, (GLfloat)sourceYEnd, (GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychTop])); //upper right in window
     }
     else {
         // Use swapped texture coordinates....
         //lower left
-        glTexCoordXform((GLfloat)sourceX, (GLfloat)sourceY);                                       //lower left vertex in  window
-        glVertexXform((GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychTop]));        //upper left vertex in window
+        PsychTexBatchVertex((GLfloat)sourceX, (GLfloat)sourceY, (GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychTop])); //upper left vertex in window
 
         //upper left
-        glTexCoordXform((GLfloat)sourceXEnd, (GLfloat)sourceY);                                    //upper left vertex in texture
-        glVertexXform((GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychBottom]));     //lower left vertex in window
+        PsychTexBatchVertex((GLfloat)sourceXEnd, (GLfloat)sourceY, (GLfloat)(targetRect[kPsychLeft]), (GLfloat)(targetRect[kPsychBottom])); //lower left vertex in window
 
         //upper right
-        glTexCoordXform((GLfloat)sourceXEnd, (GLfloat)sourceYEnd);                                 //upper right vertex in texture
-        glVertexXform((GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychBottom]) );   //lower right  vertex in window
+        PsychTexBatchVertex((GLfloat)sourceXEnd, (GLfloat)sourceYEnd, (GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychBottom])); //lower right  vertex in window
 
         //lower right
-        glTexCoordXform((GLfloat)sourceX, (GLfloat)sourceYEnd);                                    //lower right in texture
-        glVertexXform((GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychTop]));       //upper right in window
+        PsychTexBatchVertex((GLfloat)sourceX, (GLfloat)sourceYEnd, (GLfloat)(targetRect[kPsychRight]), (GLfloat)(targetRect[kPsychTop])); //upper right in window
     }
 
     index++;
@@ -1919,3 +2005,491 @@ void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, Ps
     // Finished!
     return;
 }
+
+// Parameters of a pixel format conversion job for PsychConvertPlanarToInterleavedTexture():
+typedef struct PsychTexConvJob {
+    const void*     inPlanes[4];    // Input planes, already in the channel order of the output.
+    void*           outBuffer;      // Interleaved output buffer.
+    int             numPlanes;      // Number of planes / channels per output pixel.
+    psych_bool      inIsDouble;     // Input are double values, otherwise uint8.
+    psych_bool      outIsFloat;     // Output are GLfloat's, otherwise GLubyte's.
+    double          offset;         // Output = (GLubyte) (offset + scale * input) for double -> uint8 conversion.
+    double          scale;
+} PsychTexConvJob;
+
+#ifdef PSYCH_TEXCONV_SSE2
+// Convert 16 doubles to 16 uint8 with the same truncation and wraparound semantics as
+// the scalar (GLubyte) (offset + scale * value) cast, ie. 32 bit integer truncation:
+static __m128i PsychTexConvDoublesToBytes(const double* in, __m128d offset, __m128d scale)
+{
+    __m128i q[4];
+    __m128i lo, hi;
+    const __m128i mask = _mm_set1_epi32(0xff);
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        lo = _mm_cvttpd_epi32(_mm_add_pd(offset, _mm_mul_pd(scale, _mm_loadu_pd(in + 4 * i))));
+        hi = _mm_cvttpd_epi32(_mm_add_pd(offset, _mm_mul_pd(scale, _mm_loadu_pd(in + 4 * i + 2))));
+        q[i] = _mm_and_si128(_mm_unpacklo_epi64(lo, hi), mask);
+    }
+
+    // All values are in range 0 - 255 now, so saturating packs are exact:
+    return(_mm_packus_epi16(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3])));
+}
+
+// Convert 4 doubles to 4 floats:
+static __m128 PsychTexConvDoublesToFloats(const double* in)
+{
+    return(_mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(in)), _mm_cvtpd_ps(_mm_loadu_pd(in + 2))));
+}
+#endif
+
+// Convert pixels [begin, end) of a conversion job:
+static void PsychTexConvWorker(void* context, psych_int64 begin, psych_int64 end)
+{
+    PsychTexConvJob* job = (PsychTexConvJob*) context;
+    const int n = job->numPlanes;
+    const double offset = job->offset;
+    const double scale = job->scale;
+    size_t ix = (size_t) begin;
+    int p;
+
+    if (job->outIsFloat) {
+        const double** in = (const double**) job->inPlanes;
+        GLfloat* out = (GLfloat*) job->outBuffer;
+
+        #ifdef PSYCH_TEXCONV_SSE2
+        __m128 v[4];
+
+        // 4 pixels per iteration, interleaving by unpacking or a 4x4 transpose:
+        if (n != 3) {
+            for (; ix + 4 <= (size_t) end; ix += 4) {
+                for (p = 0; p < n; p++)
+                    v[p] = PsychTexConvDoublesToFloats(in[p] + ix);
+
+                switch (n) {
+                    case 1:
+                        _mm_storeu_ps(out + ix, v[0]);
+                        break;
+
+                    case 2:
+                        _mm_storeu_ps(out + 2 * ix, _mm_unpacklo_ps(v[0], v[1]));
+                        _mm_storeu_ps(out + 2 * ix + 4, _mm_unpackhi_ps(v[0], v[1]));
+                        break;
+
+                    case 4:
+                        _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+                        for (p = 0; p < 4; p++)
+                            _mm_storeu_ps(out + 4 * ix + 4 * p, v[p]);
+                        break;
+                }
+            }
+        }
+        #endif
+
+        for (; ix < (size_t) end; ix++)
+            for (p = 0; p < n; p++)
+                out[n * ix + p] = (GLfloat) in[p][ix];
+    }
+    else {
+        GLubyte* out = (GLubyte*) job->outBuffer;
+
+        #ifdef PSYCH_TEXCONV_SSE2
+        __m128i v[4], t[4];
+        const __m128d offsetv = _mm_set1_pd(offset);
+        const __m128d scalev = _mm_set1_pd(scale);
+        GLubyte tmp[4][16];
+        int i;
+
+        // 16 pixels per iteration, interleaving by byte and word unpacking:
+        for (; ix + 16 <= (size_t) end; ix += 16) {
+            for (p = 0; p < n; p++) {
+                if (job->inIsDouble)
+                    v[p] = PsychTexConvDoublesToBytes(((const double*) job->inPlanes[p]) + ix, offsetv, scalev);
+                else
+                    v[p] = _mm_loadu_si128((const __m128i*) (((const GLubyte*) job->inPlanes[p]) + ix));
+            }
+
+            switch (n) {
+                case 1:
+                    _mm_storeu_si128((__m128i*) (out + ix), v[0]);
+                    break;
+
+                case 2:
+                    _mm_storeu_si128((__m128i*) (out + 2 * ix), _mm_unpacklo_epi8(v[0], v[1]));
+                    _mm_storeu_si128((__m128i*) (out + 2 * ix + 16), _mm_unpackhi_epi8(v[0], v[1]));
+                    break;
+
+                case 3:
+                    // No byte shuffles in SSE2, so interleave 3 channels via scalar stores:
+                    for (p = 0; p < 3; p++)
+                        _mm_storeu_si128((__m128i*) tmp[p], v[p]);
+                    for (i = 0; i < 16; i++) {
+                        out[3 * (ix + i)] = tmp[0][i];
+                        out[3 * (ix + i) + 1] = tmp[1][i];
+                        out[3 * (ix + i) + 2] = tmp[2][i];
+                    }
+                    break;
+
+                case 4:
+                    t[0] = _mm_unpacklo_epi8(v[0], v[1]);
+                    t[1] = _mm_unpackhi_epi8(v[0], v[1]);
+                    t[2] = _mm_unpacklo_epi8(v[2], v[3]);
+                    t[3] = _mm_unpackhi_epi8(v[2], v[3]);
+                    _mm_storeu_si128((__m128i*) (out + 4 * ix), _mm_unpacklo_epi16(t[0], t[2]));
+                    _mm_storeu_si128((__m128i*) (out + 4 * ix + 16), _mm_unpackhi_epi16(t[0], t[2]));
+                    _mm_storeu_si128((__m128i*) (out + 4 * ix + 32), _mm_unpacklo_epi16(t[1], t[3]));
+                    _mm_storeu_si128((__m128i*) (out + 4 * ix + 48), _mm_unpackhi_epi16(t[1], t[3]));
+                    break;
+            }
+        }
+        #endif
+
+        if (job->inIsDouble) {
+            for (; ix < (size_t) end; ix++)
+                for (p = 0; p < n; p++)
+                    out[n * ix + p] = (GLubyte) (offset + scale * ((const double*) job->inPlanes[p])[ix]);
+        }
+        else {
+            for (; ix < (size_t) end; ix++)
+                for (p = 0; p < n; p++)
+                    out[n * ix + p] = ((const GLubyte*) job->inPlanes[p])[ix];
+        }
+    }
+}
+
+/* PsychConvertPlanarToInterleavedTexture()
+ *
+ * Convert a planar image matrix of 'numPixels' pixels per plane with 'numPlanes' planes
+ * into an interleaved pixel buffer 'outBuffer', as used by Screen('MakeTexture') et al.
+ *
+ * 'inMatrix' is either a double matrix if 'inIsDouble', or a uint8 matrix. Output is GLfloat
+ * if 'outIsFloat', otherwise GLubyte. double -> GLubyte conversion is done as
+ * (GLubyte) (offset + scale * value), double -> GLfloat is a plain cast. uint8 input
+ * can only be converted to GLubyte output.
+ *
+ * 'planeOrder' defines for each output channel which input plane to use, e.g., { 2, 1, 0, 3 }
+ * for BGRA output from RGBA input, or NULL for identity order.
+ *
+ * Large images are split into chunks which are converted in parallel by the shared worker
+ * thread pool. On x86 processors, SSE2 is used for the conversion and interleaving.
+ */
+void PsychConvertPlanarToInterleavedTexture(void* outBuffer, const void* inMatrix, psych_bool inIsDouble, psych_bool outIsFloat,
+                                            int numPlanes, size_t numPixels, double offset, double scale, const int* planeOrder)
+{
+    PsychTexConvJob job;
+    size_t planeSize = numPixels * ((inIsDouble) ? sizeof(double) : sizeof(GLubyte));
+    int p;
+
+    if ((numPlanes < 1) || (numPlanes > 4) || (outIsFloat && !inIsDouble))
+        PsychErrorExitMsg(PsychError_internal, "Invalid texture conversion requested.");
+
+    job.outBuffer = outBuffer;
+    job.numPlanes = numPlanes;
+    job.inIsDouble = inIsDouble;
+    job.outIsFloat = outIsFloat;
+    job.offset = offset;
+    job.scale = scale;
+    for (p = 0; p < numPlanes; p++)
+        job.inPlanes[p] = (const void*) (((const char*) inMatrix) + planeSize * (size_t) ((planeOrder) ? planeOrder[p] : p));
+
+    PsychThreadPoolParallelFor((psych_int64) numPixels, PSYCH_TEXCONV_GRAINSIZE, PsychTexConvWorker, &job);
+}
+
+// Range check and clamping of float texture buffers:
+typedef struct PsychTexFloatJob {
+    GLfloat*            buffer;
+    volatile int        outOfRange;
+} PsychTexFloatJob;
+
+static void PsychTexFloatRangeWorker(void* context, psych_int64 begin, psych_int64 end)
+{
+    PsychTexFloatJob* job = (PsychTexFloatJob*) context;
+    const GLfloat* in = job->buffer;
+    size_t ix = (size_t) begin;
+    int outOfRange = 0;
+
+    #ifdef PSYCH_TEXCONV_SSE2
+    const __m128 absmask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 bad = _mm_setzero_ps();
+
+    for (; ix + 4 <= (size_t) end; ix += 4)
+        bad = _mm_or_ps(bad, _mm_cmpgt_ps(_mm_and_ps(_mm_loadu_ps(in + ix), absmask), one));
+
+    if (_mm_movemask_ps(bad))
+        outOfRange = 1;
+    #endif
+
+    for (; ix < (size_t) end; ix++)
+        if (fabs((double) in[ix]) > 1.0)
+            outOfRange = 1;
+
+    if (outOfRange)
+        job->outOfRange = 1;
+}
+
+static void PsychTexFloatFlushWorker(void* context, psych_int64 begin, psych_int64 end)
+{
+    PsychTexFloatJob* job = (PsychTexFloatJob*) context;
+    GLfloat* buf = job->buffer;
+    size_t ix = (size_t) begin;
+
+    #ifdef PSYCH_TEXCONV_SSE2
+    const __m128 absmask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128d tiny = _mm_set1_pd(1e-9);
+    __m128 v, a, m;
+
+    // Compare in double precision, like the scalar code, to get the exact same threshold:
+    for (; ix + 4 <= (size_t) end; ix += 4) {
+        v = _mm_loadu_ps(buf + ix);
+        a = _mm_and_ps(v, absmask);
+        m = _mm_shuffle_ps(_mm_castpd_ps(_mm_cmplt_pd(_mm_cvtps_pd(a), tiny)),
+                           _mm_castpd_ps(_mm_cmplt_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), tiny)), _MM_SHUFFLE(2, 0, 2, 0));
+        _mm_storeu_ps(buf + ix, _mm_andnot_ps(m, v));
+    }
+    #endif
+
+    for (; ix < (size_t) end; ix++)
+        if (fabs((double) buf[ix]) < 1e-9)
+            buf[ix] = 0.0;
+}
+
+/* PsychCheckFloatTextureRange()
+ *
+ * Return TRUE if all 'count' values in float texture buffer 'buffer' are within [-1 ; 1].
+ */
+psych_bool PsychCheckFloatTextureRange(GLfloat* buffer, size_t count)
+{
+    PsychTexFloatJob job;
+
+    job.buffer = buffer;
+    job.outOfRange = 0;
+    PsychThreadPoolParallelFor((psych_int64) count, 4 * PSYCH_TEXCONV_GRAINSIZE, PsychTexFloatRangeWorker, &job);
+
+    return((job.outOfRange) ? FALSE : TRUE);
+}
+
+/* PsychFlushTinyFloatTextureValues()
+ *
+ * Set all values of magnitude smaller than 1e-9 in float texture buffer 'buffer' to zero.
+ */
+void PsychFlushTinyFloatTextureValues(GLfloat* buffer, size_t count)
+{
+    PsychTexFloatJob job;
+
+    job.buffer = buffer;
+    job.outOfRange = 0;
+    PsychThreadPoolParallelFor((psych_int64) count, 4 * PSYCH_TEXCONV_GRAINSIZE, PsychTexFloatFlushWorker, &job);
+}
+
+/* PsychMapTextureUploadBuffer()
+ *
+ * Map a pixel buffer object of at least 'size' bytes from the ring of upload buffers of the
+ * parent onscreen window of 'win', and assign it as source of the next PsychCreateTexture()
+ * upload of 'texture'. Returns a pointer to the mapped memory into which the caller should
+ * write the texture image, or NULL if asynchronous upload is unsupported, in which case the
+ * caller must use a regular textureMemory buffer for synchronous upload.
+ *
+ * The PBO is persistently mapped if the GL supports it, otherwise it is orphaned and mapped
+ * for each upload. The ring has kPsychTextureUploadRingSize slots, so up to that many uploads
+ * can be in flight, before we have to wait for completion of the oldest one.
+ */
+void* PsychMapTextureUploadBuffer(PsychWindowRecordType *win, PsychWindowRecordType *texture, size_t size)
+{
+    PsychWindowRecordType *parent = PsychGetParentWindow(win);
+    PsychTextureUploadSlot *slot;
+    int i;
+
+    if ((size == 0) || PsychIsGLES(parent) || !GLEW_ARB_pixel_buffer_object || !GLEW_ARB_map_buffer_range)
+        return(NULL);
+
+    PsychSetGLContext(parent);
+
+    i = parent->textureUploadRingNext;
+    parent->textureUploadRingNext = (i + 1) % kPsychTextureUploadRingSize;
+    slot = &(parent->textureUploadRing[i]);
+
+    // Wait for completion of the last upload from this slot, so we can't overwrite its data:
+    if (slot->fence) {
+        while (glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(slot->fence);
+        slot->fence = NULL;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->pbo);
+
+    // Unmap a stale mapping of an upload which was aborted due to some error:
+    if (slot->mapped && !slot->persistent) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        slot->mapped = NULL;
+    }
+
+    // (Re-)Create PBO if it is too small. Round up to 1 MB to avoid frequent resizing:
+    if (slot->size < size) {
+        if (slot->pbo) {
+            if (slot->mapped) glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteBuffers(1, &slot->pbo);
+        }
+
+        slot->pbo = 0;
+        slot->mapped = NULL;
+        slot->size = (size + 0xfffff) & ~((size_t) 0xfffff);
+
+        // Persistent mapping needs fences to protect data in flight:
+        slot->persistent = (GLEW_ARB_buffer_storage && GLEW_ARB_sync) ? TRUE : FALSE;
+
+        glGenBuffers(1, &slot->pbo);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->pbo);
+
+        if (slot->persistent) {
+            glBufferStorage(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) slot->size, NULL, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+            slot->mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) slot->size, GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+        }
+        else {
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) slot->size, NULL, GL_STREAM_DRAW);
+        }
+    }
+
+    // Non-persistent PBO's get mapped for each upload. Invalidation lets the driver orphan a still busy buffer:
+    if (!slot->persistent)
+        slot->mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!slot->mapped) {
+        // Mapping failed. Release the PBO and let the caller fall back to synchronous upload:
+        while (glGetError());
+        glDeleteBuffers(1, &slot->pbo);
+        slot->pbo = 0;
+        slot->size = 0;
+
+        if (PsychPrefStateGet_Verbosity() > 4)
+            printf("PTB-INFO: Failed to map pixel buffer object for asynchronous texture upload. Using synchronous upload.\n");
+
+        return(NULL);
+    }
+
+    texture->textureUploadPBO = slot->pbo;
+    texture->textureUploadSlot = i;
+
+    return(slot->mapped);
+}
+
+/* PsychBindTextureUploadBuffer()
+ *
+ * Called by PsychCreateTexture() to bind the upload PBO of 'texture' as source for the following
+ * glTexSubImage2D() call, unmapping it if it isn't persistently mapped. Returns the offset of the
+ * image data in the PBO, for use as data pointer of that call.
+ *
+ * A textureUploadSlot of -1 denotes a persistently mapped PBO which isn't part of the ring, e.g.,
+ * one of the pixel buffer pools of movie playback and video capture. Its owner is responsible for
+ * protecting the data in flight.
+ */
+void* PsychBindTextureUploadBuffer(PsychWindowRecordType *texture)
+{
+    PsychTextureUploadSlot *slot;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, texture->textureUploadPBO);
+
+    if (texture->textureUploadSlot < 0)
+        return((void*) texture->textureUploadOffset);
+
+    slot = &(PsychGetParentWindow(texture)->textureUploadRing[texture->textureUploadSlot]);
+
+    if (!slot->persistent && slot->mapped) {
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        slot->mapped = NULL;
+    }
+
+    return(NULL);
+}
+
+/* PsychFinishTextureUpload()
+ *
+ * Called by PsychCreateTexture() after submission of the upload from the PBO. Unbinds the PBO and
+ * inserts fences which signal completion of the upload, one for the PBO's ring slot, so the PBO
+ * doesn't get overwritten while the upload is in flight, and one for the texture itself, for use
+ * by PsychQueryTextureUploadComplete().
+ */
+void PsychFinishTextureUpload(PsychWindowRecordType *texture)
+{
+    PsychTextureUploadSlot *slot = (texture->textureUploadSlot >= 0) ? &(PsychGetParentWindow(texture)->textureUploadRing[texture->textureUploadSlot]) : NULL;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (GLEW_ARB_sync) {
+        if (slot) {
+            if (slot->fence) glDeleteSync(slot->fence);
+            slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        if (texture->textureUploadFence) glDeleteSync(texture->textureUploadFence);
+        texture->textureUploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        // Kick off the upload now, instead of at the next flush:
+        glFlush();
+    }
+
+    texture->textureUploadPBO = 0;
+}
+
+/* PsychQueryTextureUploadComplete()
+ *
+ * Check if a pending asynchronous upload of texture 'win' is complete. If 'wait' is TRUE then wait
+ * for completion. Returns TRUE if no upload is pending anymore. Note that drawing a texture with a
+ * pending upload does not need to wait, as the GPU executes the drawing after the upload anyway.
+ */
+psych_bool PsychQueryTextureUploadComplete(PsychWindowRecordType *win, psych_bool wait)
+{
+    GLenum rc;
+
+    if (!win->textureUploadFence)
+        return(TRUE);
+
+    PsychSetGLContext(win);
+
+    rc = glClientWaitSync(win->textureUploadFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while (wait && (rc == GL_TIMEOUT_EXPIRED))
+        rc = glClientWaitSync(win->textureUploadFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+
+    if (rc == GL_TIMEOUT_EXPIRED)
+        return(FALSE);
+
+    glDeleteSync(win->textureUploadFence);
+    win->textureUploadFence = NULL;
+
+    return(TRUE);
+}
+
+/* PsychReleaseTextureUploadBuffers()
+ *
+ * Release the ring of asynchronous texture upload PBO's of onscreen window 'win'. Called at window
+ * close time with the windows OpenGL context bound.
+ */
+void PsychReleaseTextureUploadBuffers(PsychWindowRecordType *win)
+{
+    PsychTextureUploadSlot *slot;
+    int i;
+
+    for (i = 0; i < kPsychTextureUploadRingSize; i++) {
+        slot = &(win->textureUploadRing[i]);
+
+        if (slot->fence) glDeleteSync(slot->fence);
+
+        if (slot->pbo) {
+            if (slot->mapped) {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->pbo);
+                glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+
+            glDeleteBuffers(1, &slot->pbo);
+        }
+
+        memset(slot, 0, sizeof(PsychTextureUploadSlot));
+    }
+
+    win->textureUploadRingNext = 0;
+}
@@ -31,5 +31,14 @@ void PsychMapTexCoord(PsychWindowRecordType *tex, double* tx, double* ty);
 void PsychDetectTextureTarget(PsychWindowRecordType *win);
 void PsychBatchBlitTexturesToDisplay(unsigned int opMode, unsigned int count, PsychWindowRecordType *source, PsychWindowRecordType *target, double *sourceRect, double *targetRect,
                                      double rotationAngle, int filterMode, double globalAlpha);
+void PsychConvertPlanarToInterleavedTexture(void* outBuffer, const void* inMatrix, psych_bool inIsDouble, psych_bool outIsFloat,
+                                            int numPlanes, size_t numPixels, double offset, double scale, const int* planeOrder);
+psych_bool PsychCheckFloatTextureRange(GLfloat* buffer, size_t count);
+void PsychFlushTinyFloatTextureValues(GLfloat* buffer, size_t count);
+void* PsychMapTextureUploadBuffer(PsychWindowRecordType *win, PsychWindowRecordType *texture, size_t size);
+void* PsychBindTextureUploadBuffer(PsychWindowRecordType *texture);
+void PsychFinishTextureUpload(PsychWindowRecordType *texture);
+psych_bool PsychQueryTextureUploadComplete(PsychWindowRecordType *win, psych_bool wait);
+void PsychReleaseTextureUploadBuffers(PsychWindowRecordType *win);
 //end include once
 #endif
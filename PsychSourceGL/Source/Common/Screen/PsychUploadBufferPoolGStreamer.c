@@ -0,0 +1,598 @@
+/*
+    PsychSourceGL/Source/Common/Screen/PsychUploadBufferPoolGStreamer.c
+
+    PLATFORMS:  All with PTB_USE_GSTREAMER defined.
+
+    DESCRIPTION:
+
+    GStreamer buffer pool whose buffers live inside a persistently mapped OpenGL
+    pixel buffer object. The pool gets offered to the elements upstream of the appsink
+    of a movie or video capture pipeline in response to their allocation query. Decoders
+    or converters which accept it write their video frames directly into the PBO, so
+    PsychCreateTexture() can source the texture upload from the PBO via DMA, without
+    the extra copy of the frame into driver memory done by a regular glTexSubImage2D().
+
+    The PBO is split into fixed size slots, one per pool buffer. As the GPU reads a frame
+    asynchronously after PsychCreateTexture() returns, the GstSample of the frame is not
+    released immediately, but retained until a fence signals completion of the upload,
+    so its slot can't be recycled and overwritten while the upload is in flight.
+
+    Elements which don't accept the pool, e.g., because they need more buffers than we
+    can provide or a special memory layout, simply use their own pool, and textures
+    then get uploaded the regular way.
+
+    The PBO lives in the OpenGL context of the onscreen window, so PsychCloseWindow()
+    calls PsychReleaseUploadPools() to switch upstream elements back to regular buffers
+    and delete the PBOs of all pools of that window, while the pipelines may live on.
+    As open movies and capture devices hold pool buffers in their appsink queue and as
+    decoder reference frames, their pipelines get cycled through ready state, which
+    returns all buffers, before the PBO is deleted.
+
+*/
+
+#ifdef PTB_USE_GSTREAMER
+
+#include "Screen.h"
+#include "PsychUploadBufferPoolGStreamer.h"
+#include <gst/gst.h>
+
+#if GST_CHECK_VERSION(1,0,0)
+#include <gst/video/video.h>
+
+// Maximum number of samples retained while their uploads are pending:
+#define kPsychUploadPoolRetained 2
+
+// Upper limit for the size of the PBO, as it gets pinned into system memory:
+#define kPsychUploadPoolMaxBytes (512 * 1024 * 1024)
+
+struct PsychGSUploadPool {
+    PsychGSUploadPool       *next;          // Next pool in list of all pools.
+    PsychWindowRecordType   *win;           // Onscreen window in whose OpenGL context the PBO lives, NULL after window close.
+    GstPad                  *pad;           // Sink pad of the appsink with our allocation query probe.
+    gulong                  probeId;        // Id of the query probe.
+    GstBufferPool           *bufferPool;    // Our PsychGSPBOBufferPool.
+    GLuint                  pbo;            // The PBO.
+    unsigned char           *mapped;        // Persistent mapping of the PBO.
+    size_t                  slotSize;       // Size of one slot, aka the maximum size of a frame.
+    int                     numSlots;       // Number of slots, aka maximum number of pool buffers.
+    int                     numReserved;    // Number of buffers queued in the appsink, or held by us.
+    int                     *slotUsed;      // Slot in use by a pool buffer?
+    GstBuffer               **slotBuffer;   // Pool buffer which uses the slot, if any.
+    psych_bool              fallback;       // Allocate pool buffers in system memory instead of PBO slots?
+    GstSample               *retained[kPsychUploadPoolRetained];    // Samples with pending uploads.
+    GLsync                  fences[kPsychUploadPoolRetained];       // Fences of the pending uploads.
+    int                     nextRetained;                           // Next entry to use in retained[], the oldest one.
+};
+
+// The GstBufferPool subclass:
+typedef struct {
+    GstBufferPool       parent;
+    PsychGSUploadPool   *owner;
+} PsychGSPBOBufferPool;
+
+typedef struct {
+    GstBufferPoolClass  parent_class;
+} PsychGSPBOBufferPoolClass;
+
+G_DEFINE_TYPE(PsychGSPBOBufferPool, psych_gs_pbo_buffer_pool, GST_TYPE_BUFFER_POOL);
+
+// Protects owner and slot allocation against concurrent access from streaming threads:
+G_LOCK_DEFINE_STATIC(psych_pbo_pool);
+
+// Quark for attaching the slot index + 1 to a pool buffer:
+static GQuark psych_pbo_slot_quark = 0;
+
+// List of all pools, for release of the pools of a closing window. Only accessed from the main thread:
+static PsychGSUploadPool *uploadPools = NULL;
+
+static gboolean PsychGSPBOPoolSetConfig(GstBufferPool *pool, GstStructure *config)
+{
+    PsychGSUploadPool *owner = ((PsychGSPBOBufferPool*) pool)->owner;
+    GstCaps *caps;
+    guint size, minBuffers, maxBuffers;
+
+    if (!owner || !gst_buffer_pool_config_get_params(config, &caps, &size, &minBuffers, &maxBuffers))
+        return(FALSE);
+
+    // Reject requests which we can't satisfy from our fixed set of slots. The element will use its own pool then:
+    if ((size > owner->slotSize) || ((int) minBuffers > owner->numSlots - owner->numReserved)) {
+        if (PsychPrefStateGet_Verbosity() > 4)
+            printf("PTB-DEBUG: PBO upload buffer pool rejected config for %i buffers of %i bytes. Using regular texture upload.\n", (int) minBuffers, (int) size);
+        return(FALSE);
+    }
+
+    gst_buffer_pool_config_set_params(config, caps, size, minBuffers, owner->numSlots);
+
+    return(GST_BUFFER_POOL_CLASS(psych_gs_pbo_buffer_pool_parent_class)->set_config(pool, config));
+}
+
+static GstFlowReturn PsychGSPBOPoolAllocBuffer(GstBufferPool *pool, GstBuffer **buffer, GstBufferPoolAcquireParams *params)
+{
+    PsychGSUploadPool *owner;
+    GstStructure *config;
+    guint size;
+    int i = -1;
+
+    config = gst_buffer_pool_get_config(pool);
+    gst_buffer_pool_config_get_params(config, NULL, &size, NULL, NULL);
+    gst_structure_free(config);
+
+    G_LOCK(psych_pbo_pool);
+    owner = ((PsychGSPBOBufferPool*) pool)->owner;
+    if (owner && owner->fallback) {
+        // PBO about to go away: Hand out regular system memory buffers until upstream renegotiates:
+        G_UNLOCK(psych_pbo_pool);
+        *buffer = gst_buffer_new_allocate(NULL, size, NULL);
+        return((*buffer) ? GST_FLOW_OK : GST_FLOW_ERROR);
+    }
+
+    if (owner) {
+        for (i = 0; (i < owner->numSlots) && owner->slotUsed[i]; i++);
+        if (i < owner->numSlots) {
+            // Wrap the slot, without a destroy notify, as the PBO is owned by us:
+            owner->slotUsed[i] = 1;
+            *buffer = gst_buffer_new_wrapped_full(0, owner->mapped + (size_t) i * owner->slotSize, owner->slotSize, 0, size, NULL, NULL);
+            gst_mini_object_set_qdata(GST_MINI_OBJECT(*buffer), psych_pbo_slot_quark, GINT_TO_POINTER(i + 1), NULL);
+            owner->slotBuffer[i] = *buffer;
+        }
+    }
+    G_UNLOCK(psych_pbo_pool);
+
+    if (!owner || (i >= owner->numSlots))
+        return(GST_FLOW_ERROR);
+
+    return(GST_FLOW_OK);
+}
+
+static void PsychGSPBOPoolReleaseBuffer(GstBufferPool *pool, GstBuffer *buffer)
+{
+    PsychGSUploadPool *owner;
+
+    // In fallback mode, PBO buffers must not get recycled. Tagged memory makes the base class free them instead:
+    G_LOCK(psych_pbo_pool);
+    owner = ((PsychGSPBOBufferPool*) pool)->owner;
+    if (owner && owner->fallback && gst_mini_object_get_qdata(GST_MINI_OBJECT(buffer), psych_pbo_slot_quark))
+        GST_BUFFER_FLAG_SET(buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+    G_UNLOCK(psych_pbo_pool);
+
+    GST_BUFFER_POOL_CLASS(psych_gs_pbo_buffer_pool_parent_class)->release_buffer(pool, buffer);
+}
+
+static void PsychGSPBOPoolFreeBuffer(GstBufferPool *pool, GstBuffer *buffer)
+{
+    PsychGSUploadPool *owner;
+    int i = GPOINTER_TO_INT(gst_mini_object_get_qdata(GST_MINI_OBJECT(buffer), psych_pbo_slot_quark)) - 1;
+
+    G_LOCK(psych_pbo_pool);
+    owner = ((PsychGSPBOBufferPool*) pool)->owner;
+    if (owner && (i >= 0)) {
+        owner->slotUsed[i] = 0;
+        owner->slotBuffer[i] = NULL;
+    }
+    G_UNLOCK(psych_pbo_pool);
+
+    GST_BUFFER_POOL_CLASS(psych_gs_pbo_buffer_pool_parent_class)->free_buffer(pool, buffer);
+}
+
+static void psych_gs_pbo_buffer_pool_class_init(PsychGSPBOBufferPoolClass *klass)
+{
+    GstBufferPoolClass *poolClass = GST_BUFFER_POOL_CLASS(klass);
+
+    poolClass->set_config = PsychGSPBOPoolSetConfig;
+    poolClass->alloc_buffer = PsychGSPBOPoolAllocBuffer;
+    poolClass->free_buffer = PsychGSPBOPoolFreeBuffer;
+    poolClass->release_buffer = PsychGSPBOPoolReleaseBuffer;
+
+    psych_pbo_slot_quark = g_quark_from_static_string("PsychPBOSlot");
+}
+
+static void psych_gs_pbo_buffer_pool_init(PsychGSPBOBufferPool *pool)
+{
+    pool->owner = NULL;
+}
+
+#if GST_CHECK_VERSION(1,6,0)
+// Answer allocation queries of upstream elements with our pool:
+static GstPadProbeReturn PsychGSUploadPoolQueryProbe(GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+    PsychGSUploadPool *upool = (PsychGSUploadPool*) user_data;
+    GstQuery *query = GST_PAD_PROBE_INFO_QUERY(info);
+    GstCaps *caps = NULL;
+    gboolean needPool;
+    GstVideoInfo vinfo;
+
+    if (GST_QUERY_TYPE(query) != GST_QUERY_ALLOCATION)
+        return(GST_PAD_PROBE_OK);
+
+    gst_query_parse_allocation(query, &caps, &needPool);
+    if (!caps || !gst_video_info_from_caps(&vinfo, caps) || (GST_VIDEO_INFO_SIZE(&vinfo) > upool->slotSize))
+        return(GST_PAD_PROBE_OK);
+
+    // Offer only our pool, and no GstVideoMeta, so frames get tightly packed into the slots
+    // in the default layout expected by PsychCreateTexture():
+    if (gst_query_get_n_allocation_pools(query) > 0)
+        gst_query_set_nth_allocation_pool(query, 0, upool->bufferPool, (guint) GST_VIDEO_INFO_SIZE(&vinfo), 0, (guint) upool->numSlots);
+    else
+        gst_query_add_allocation_pool(query, upool->bufferPool, (guint) GST_VIDEO_INFO_SIZE(&vinfo), 0, (guint) upool->numSlots);
+
+    return(GST_PAD_PROBE_HANDLED);
+}
+#endif
+
+/* PsychGSCreateUploadPool()
+ *
+ * Create a PBO backed buffer pool for the video frames received by 'appsink', for upload into
+ * textures for onscreen window 'win'. 'numBuffers' is the maximum number of buffers queued in
+ * the appsink. Must be called with the OpenGL context of 'win' bound, after the appsink has
+ * negotiated its caps. Triggers renegotiation of the allocation of upstream elements, so the
+ * pool will be used from one of the next frames on.
+ *
+ * Returns NULL if the pool isn't supported by the system or the video format.
+ */
+PsychGSUploadPool* PsychGSCreateUploadPool(PsychWindowRecordType *win, GstElement *appsink, int numBuffers)
+{
+#if GST_CHECK_VERSION(1,6,0)
+    PsychGSUploadPool *upool;
+    GstPad *pad;
+    GstCaps *caps;
+    GstVideoInfo vinfo;
+    size_t slotSize;
+    int numSlots;
+    const GLbitfield flags = GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    win = PsychGetParentWindow(win);
+    if ((numBuffers < 1) || PsychIsGLES(win) || !GLEW_ARB_buffer_storage || !GLEW_ARB_sync)
+        return(NULL);
+
+    // Slots must fit the negotiated video frame size:
+    pad = gst_element_get_static_pad(appsink, "sink");
+    caps = gst_pad_get_current_caps(pad);
+    if (!caps || !gst_video_info_from_caps(&vinfo, caps)) {
+        if (caps) gst_caps_unref(caps);
+        gst_object_unref(pad);
+        return(NULL);
+    }
+    gst_caps_unref(caps);
+
+    slotSize = ((size_t) GST_VIDEO_INFO_SIZE(&vinfo) + 4095) & ~((size_t) 4095);
+    numSlots = numBuffers + kPsychUploadPoolExtraBuffers;
+    if (slotSize * numSlots > kPsychUploadPoolMaxBytes) {
+        if (PsychPrefStateGet_Verbosity() > 4)
+            printf("PTB-DEBUG: Video frames too big for PBO upload buffer pool. Using regular texture upload.\n");
+        gst_object_unref(pad);
+        return(NULL);
+    }
+
+    upool = (PsychGSUploadPool*) calloc(1, sizeof(PsychGSUploadPool));
+    upool->slotUsed = (int*) calloc(numSlots, sizeof(int));
+    upool->slotBuffer = (GstBuffer**) calloc(numSlots, sizeof(GstBuffer*));
+    upool->win = win;
+    upool->pad = pad;
+    upool->slotSize = slotSize;
+    upool->numSlots = numSlots;
+    upool->numReserved = numBuffers + 1 + kPsychUploadPoolRetained;
+
+    // Create the PBO in system memory, persistently mapped, so streaming threads can write into it:
+    PsychSetGLContext(win);
+    glGenBuffers(1, &upool->pbo);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upool->pbo);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) (slotSize * numSlots), NULL, flags | GL_CLIENT_STORAGE_BIT);
+    upool->mapped = (unsigned char*) glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr) (slotSize * numSlots), flags);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!upool->mapped) {
+        while (glGetError());
+        glDeleteBuffers(1, &upool->pbo);
+        gst_object_unref(pad);
+        free(upool->slotUsed);
+        free(upool->slotBuffer);
+        free(upool);
+
+        if (PsychPrefStateGet_Verbosity() > 4)
+            printf("PTB-DEBUG: Failed to map pixel buffer object for PBO upload buffer pool. Using regular texture upload.\n");
+
+        return(NULL);
+    }
+
+    upool->bufferPool = (GstBufferPool*) g_object_new(psych_gs_pbo_buffer_pool_get_type(), NULL);
+    if (g_object_is_floating(upool->bufferPool)) gst_object_ref_sink(upool->bufferPool);
+    ((PsychGSPBOBufferPool*) upool->bufferPool)->owner = upool;
+
+    // Hook into allocation queries, then ask upstream to renegotiate its allocation:
+    upool->probeId = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM | GST_PAD_PROBE_TYPE_PUSH, PsychGSUploadPoolQueryProbe, upool, NULL);
+    gst_pad_push_event(pad, gst_event_new_reconfigure());
+
+    upool->next = uploadPools;
+    uploadPools = upool;
+
+    if (PsychPrefStateGet_Verbosity() > 4)
+        printf("PTB-DEBUG: Created PBO upload buffer pool with %i slots of %i bytes.\n", numSlots, (int) slotSize);
+
+    return(upool);
+#else
+    return(NULL);
+#endif
+}
+
+/* PsychGSUploadPoolSetupTexture()
+ *
+ * Check if the textureMemory of 'out_texture' points into a buffer of pool 'upool'. If so, setup
+ * the texture for asynchronous upload from the PBO by the following PsychCreateTexture() for
+ * window 'win', and return TRUE. The caller must then hand the GstSample of the buffer over to
+ * PsychGSUploadPoolRetireSample() after PsychCreateTexture(), instead of releasing it.
+ */
+psych_bool PsychGSUploadPoolSetupTexture(PsychGSUploadPool *upool, PsychWindowRecordType *win, PsychWindowRecordType *out_texture)
+{
+    unsigned char *data = (unsigned char*) out_texture->textureMemory;
+
+    if (!upool || (PsychGetParentWindow(win) != upool->win) || (data < upool->mapped) ||
+        (data >= upool->mapped + upool->slotSize * upool->numSlots))
+        return(FALSE);
+
+    out_texture->textureUploadPBO = upool->pbo;
+    out_texture->textureUploadSlot = -1;
+    out_texture->textureUploadOffset = (size_t) (data - upool->mapped);
+
+    return(TRUE);
+}
+
+static void PsychGSUploadPoolReleaseRetained(PsychGSUploadPool *upool, int i, psych_bool wait)
+{
+    if (wait) while (glClientWaitSync(upool->fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+    glDeleteSync(upool->fences[i]);
+    gst_sample_unref(upool->retained[i]);
+    upool->fences[i] = NULL;
+    upool->retained[i] = NULL;
+}
+
+/* PsychGSUploadPoolRetireSample()
+ *
+ * Take ownership of 'sample', whose buffer was just used as source of a texture upload from
+ * the PBO of 'upool', and release it once the upload is complete. The buffer must be unmapped.
+ * Must be called with the OpenGL context of the upload bound.
+ */
+void PsychGSUploadPoolRetireSample(PsychGSUploadPool *upool, GstSample *sample)
+{
+    int i;
+
+    // Release samples whose uploads have completed:
+    for (i = 0; i < kPsychUploadPoolRetained; i++) {
+        if (upool->retained[i] && (glClientWaitSync(upool->fences[i], 0, 0) != GL_TIMEOUT_EXPIRED))
+            PsychGSUploadPoolReleaseRetained(upool, i, FALSE);
+    }
+
+    // Entries are used round-robin. If the next one is still pending, it is the oldest
+    // upload: Wait for its completion, so we don't starve the pool of free buffers:
+    i = upool->nextRetained;
+    upool->nextRetained = (i + 1) % kPsychUploadPoolRetained;
+    if (upool->retained[i]) PsychGSUploadPoolReleaseRetained(upool, i, TRUE);
+
+    upool->retained[i] = sample;
+    upool->fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+// Number of slots of 'upool' in use by pool buffers, after waiting up to 'timeoutSecs' for it to drop to zero:
+static int PsychGSUploadPoolWaitForBuffers(PsychGSUploadPool *upool, double timeoutSecs)
+{
+    double tnow, tdeadline;
+    int i, numUsed;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&tnow);
+    tdeadline = tnow + timeoutSecs;
+    while (TRUE) {
+        numUsed = 0;
+        G_LOCK(psych_pbo_pool);
+        for (i = 0; i < upool->numSlots; i++) numUsed += upool->slotUsed[i];
+        G_UNLOCK(psych_pbo_pool);
+
+        if ((numUsed == 0) || (tnow >= tdeadline)) break;
+
+        PsychYieldIntervalSeconds(0.001);
+        PsychGetAdjustedPrecisionTimerSeconds(&tnow);
+    }
+
+    return(numUsed);
+}
+
+// Cycle the pipeline which contains the appsink of 'upool' through ready state, so all elements
+// return their pool buffers, then bring it back into its previous state and playback position.
+// If that doesn't get all buffers back, shut the pipeline down. Returns number of slots still in use:
+static int PsychGSUploadPoolCyclePipeline(PsychGSUploadPool *upool)
+{
+    GstElement *pipeline, *parent;
+    GstState state = GST_STATE_NULL;
+    GstStateChangeReturn rc;
+    gint64 pos = 0;
+    psych_bool havePos;
+    int numUsed;
+
+    // Find the top-level pipeline:
+    pipeline = GST_ELEMENT(gst_pad_get_parent_element(upool->pad));
+    while (pipeline && (parent = GST_ELEMENT(gst_element_get_parent(pipeline)))) {
+        gst_object_unref(pipeline);
+        pipeline = parent;
+    }
+
+    if (!pipeline)
+        return(PsychGSUploadPoolWaitForBuffers(upool, 0.0));
+
+    gst_element_get_state(pipeline, &state, NULL, (GstClockTime) (5 * GST_SECOND));
+    havePos = gst_element_query_position(pipeline, GST_FORMAT_TIME, &pos);
+
+    gst_element_set_state(pipeline, GST_STATE_READY);
+    gst_element_get_state(pipeline, NULL, NULL, (GstClockTime) (5 * GST_SECOND));
+    numUsed = PsychGSUploadPoolWaitForBuffers(upool, 1.0);
+
+    if (numUsed > 0) {
+        gst_element_set_state(pipeline, GST_STATE_NULL);
+        numUsed = PsychGSUploadPoolWaitForBuffers(upool, 1.0);
+
+        if (PsychPrefStateGet_Verbosity() > 1)
+            printf("PTB-WARNING: Had to stop a movie or video capture pipeline to release its PBO upload buffers at window close.\n");
+    }
+    else if (state >= GST_STATE_PAUSED) {
+        // Preroll again, at the old position if the pipeline isn't a live source, then resume:
+        rc = gst_element_set_state(pipeline, GST_STATE_PAUSED);
+        gst_element_get_state(pipeline, NULL, NULL, (GstClockTime) (5 * GST_SECOND));
+        if (havePos && (rc != GST_STATE_CHANGE_NO_PREROLL)) {
+            gst_element_seek_simple(pipeline, GST_FORMAT_TIME, GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_ACCURATE, pos);
+            gst_element_get_state(pipeline, NULL, NULL, (GstClockTime) (5 * GST_SECOND));
+        }
+
+        if (state == GST_STATE_PLAYING) gst_element_set_state(pipeline, GST_STATE_PLAYING);
+    }
+
+    gst_object_unref(pipeline);
+
+    return(numUsed);
+}
+
+// Replace the PBO memory of all pool buffers of 'upool' which are still in use by a system memory copy,
+// as far as possible. Returns number of buffers which could not be copied, as they are not writable:
+static int PsychGSUploadPoolCopyOutBuffers(PsychGSUploadPool *upool)
+{
+    GstBuffer *buffer;
+    GstMemory *mem;
+    int i, numUsed = 0;
+
+    G_LOCK(psych_pbo_pool);
+    for (i = 0; i < upool->numSlots; i++) {
+        if (!upool->slotUsed[i] || !(buffer = upool->slotBuffer[i])) continue;
+
+        if (!gst_buffer_is_writable(buffer)) {
+            numUsed++;
+            continue;
+        }
+
+        mem = gst_buffer_get_all_memory(buffer);
+        gst_buffer_replace_all_memory(buffer, gst_memory_copy(mem, 0, -1));
+        gst_memory_unref(mem);
+
+        // Not a PBO buffer anymore:
+        gst_mini_object_set_qdata(GST_MINI_OBJECT(buffer), psych_pbo_slot_quark, NULL, NULL);
+        upool->slotUsed[i] = 0;
+        upool->slotBuffer[i] = NULL;
+    }
+    G_UNLOCK(psych_pbo_pool);
+
+    return(numUsed);
+}
+
+/* PsychGSUploadPoolReleaseGL()
+ *
+ * Stop the use of the PBO of 'upool' by upstream elements and delete it, with the OpenGL context
+ * of upool->win bound. The pool switches to system memory buffers, and upstream elements get asked
+ * to renegotiate their allocation, so they switch back to their own regular buffers. If the pipeline
+ * is still alive, i.e., 'cyclePipeline' is TRUE, it gets cycled through ready state to make all
+ * elements return the pool buffers they hold, as the PBO can't be deleted while they use it.
+ */
+static void PsychGSUploadPoolReleaseGL(PsychGSUploadPool *upool, psych_bool cyclePipeline)
+{
+    int i, numUsed;
+
+    // No more allocation queries answered with our pool, and renegotiation of allocation upstream:
+    gst_pad_remove_probe(upool->pad, upool->probeId);
+    upool->probeId = 0;
+
+    // Switch to system memory buffers. Reactivation frees all PBO buffers which are back in the pool:
+    G_LOCK(psych_pbo_pool);
+    upool->fallback = TRUE;
+    G_UNLOCK(psych_pbo_pool);
+    if (gst_buffer_pool_is_active(upool->bufferPool)) {
+        gst_buffer_pool_set_active(upool->bufferPool, FALSE);
+        gst_buffer_pool_set_active(upool->bufferPool, TRUE);
+    }
+
+    gst_pad_push_event(upool->pad, gst_event_new_reconfigure());
+
+    PsychSetGLContext(upool->win);
+
+    for (i = 0; i < kPsychUploadPoolRetained; i++) {
+        if (upool->retained[i]) PsychGSUploadPoolReleaseRetained(upool, i, TRUE);
+    }
+
+    numUsed = PsychGSUploadPoolWaitForBuffers(upool, 0.0);
+    if ((numUsed > 0) && cyclePipeline) numUsed = PsychGSUploadPoolCyclePipeline(upool);
+    if (numUsed > 0) numUsed = PsychGSUploadPoolCopyOutBuffers(upool);
+
+    // Done with the pool:
+    gst_buffer_pool_set_active(upool->bufferPool, FALSE);
+
+    // Buffers still referenced by somebody else? Then we must leak the PBO, as they still point into its mapping:
+    if (numUsed > 0) {
+        if (PsychPrefStateGet_Verbosity() > 0)
+            printf("PTB-ERROR: %i buffers of PBO upload buffer pool still in use at pool destruction! Leaking the PBO.\n", numUsed);
+    }
+    else {
+        PsychSetGLContext(upool->win);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upool->pbo);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &upool->pbo);
+    }
+
+    upool->pbo = 0;
+    upool->mapped = NULL;
+    upool->win = NULL;
+}
+
+/* PsychReleaseUploadPools()
+ *
+ * Release the PBOs of all upload pools which live in the OpenGL context of onscreen window
+ * 'windowRecord'. Called by PsychCloseWindow() before the context gets destroyed. The pools
+ * themselves stay attached to their pipelines, but unused, until PsychGSDeleteUploadPool().
+ */
+void PsychReleaseUploadPools(PsychWindowRecordType *windowRecord)
+{
+    PsychGSUploadPool *upool;
+
+    for (upool = uploadPools; upool; upool = upool->next) {
+        if (upool->win == windowRecord) PsychGSUploadPoolReleaseGL(upool, TRUE);
+    }
+}
+
+/* PsychGSDeleteUploadPool()
+ *
+ * Destroy 'upool' and release its PBO, unless that already happened at close of its window.
+ * Must be called after the pipeline has been put into NULL state, so no element uses the pool anymore.
+ */
+void PsychGSDeleteUploadPool(PsychGSUploadPool *upool)
+{
+    PsychGSUploadPool **link;
+
+    if (!upool)
+        return;
+
+    for (link = &uploadPools; *link; link = &((*link)->next)) {
+        if (*link == upool) {
+            *link = upool->next;
+            break;
+        }
+    }
+
+    if (upool->win) PsychGSUploadPoolReleaseGL(upool, FALSE);
+
+    // Detach the pool from us, so late buffer frees don't touch freed memory:
+    G_LOCK(psych_pbo_pool);
+    ((PsychGSPBOBufferPool*) upool->bufferPool)->owner = NULL;
+    G_UNLOCK(psych_pbo_pool);
+
+    gst_object_unref(upool->bufferPool);
+    gst_object_unref(upool->pad);
+
+    free(upool->slotUsed);
+    free(upool->slotBuffer);
+    free(upool);
+
+    return;
+}
+
+#else
+
+void PsychReleaseUploadPools(PsychWindowRecordType *windowRecord)
+{
+    (void) windowRecord;
+}
+
+#endif
+#endif
@@ -0,0 +1,38 @@
+/*
+    PsychSourceGL/Source/Common/Screen/PsychUploadBufferPoolGStreamer.h
+
+    PLATFORMS:  All with PTB_USE_GSTREAMER defined.
+
+    DESCRIPTION:
+
+    GStreamer buffer pool whose buffers live inside a persistently mapped OpenGL
+    pixel buffer object, so decoders and capture sources can write video frames
+    directly into memory from which textures get uploaded asynchronously by DMA.
+    Shared by movie playback and video capture.
+
+*/
+
+#ifdef PTB_USE_GSTREAMER
+
+//include once
+#ifndef PSYCH_IS_INCLUDED_PsychUploadBufferPoolGStreamer
+#define PSYCH_IS_INCLUDED_PsychUploadBufferPoolGStreamer
+
+#include "Screen.h"
+#include <gst/gst.h>
+
+// Number of pool buffers on top of the appsink queue length: Headroom for decoder
+// reference frames, the preroll buffer and samples retained during pending uploads:
+#define kPsychUploadPoolExtraBuffers 16
+
+typedef struct PsychGSUploadPool PsychGSUploadPool;
+
+PsychGSUploadPool*  PsychGSCreateUploadPool(PsychWindowRecordType *win, GstElement *appsink, int numBuffers);
+psych_bool          PsychGSUploadPoolSetupTexture(PsychGSUploadPool *upool, PsychWindowRecordType *win, PsychWindowRecordType *out_texture);
+void                PsychGSUploadPoolRetireSample(PsychGSUploadPool *upool, GstSample *sample);
+void                PsychGSDeleteUploadPool(PsychGSUploadPool *upool);
+
+//end include once
+#endif
+
+#endif
@@ -324,6 +324,80 @@ double PsychVideoCaptureSetParameter(int capturehandle, const char* pname, doubl
     return(0);
 }
 
+/*
+ *  PsychGetCapturedFrames() - Bulk retrieval of the most recent frames from the capture ring.
+ *
+ *  capturehandle = Grabber to fetch from.
+ *  maxFrames = Maximum number of frames to return.
+ *  onlyNew = If TRUE, only return frames which weren't returned by a previous fetch.
+ *  outrawbuffer = If outrawbuffer->data is NULL, only query geometry of the frames and the number
+ *                 of frames which would be returned, and remember them for the following fetch.
+ *                 Otherwise copy exactly maxFrames frames, oldest first, into outrawbuffer->data.
+ *  timestamps, framecounters, intensities = Optional ptrs to arrays of maxFrames elements to fill with
+ *                 per-frame capture timestamps, frame counters and average intensities.
+ *  origins = Optional ptr to a maxFrames x 2 array to fill with the left and top corner of the ROI of each frame.
+ *
+ *  Returns number of frames available (query) or copied (fetch).
+ */
+int PsychGetCapturedFrames(int capturehandle, int maxFrames, psych_bool onlyNew, rawcapimgdata* outrawbuffer, double* timestamps, double* framecounters, double* intensities, double* origins)
+{
+    if (capturehandle < 0 || capturehandle >= PSYCH_MAX_CAPTUREDEVICES || mastervidcapRecordBANK[capturehandle].engineId == -1) {
+        PsychErrorExitMsg(PsychError_user, "Invalid capturehandle provided!");
+    }
+
+    // Call engine specific method:
+    #ifdef PTB_USE_GSTREAMER
+    if (mastervidcapRecordBANK[capturehandle].engineId == 3) return(PsychGSGetCapturedFrames(capturehandle, maxFrames, onlyNew, outrawbuffer, timestamps, framecounters, intensities, origins));
+    #endif
+
+    PsychErrorExitMsg(PsychError_unimplemented, "Bulk retrieval of captured frames is only supported by the GStreamer video capture engine.");
+    return(0);
+}
+
+/*
+ *  PsychSumCapturedPixels() - Compute sum of all 'count' 8 bit or 16 bit pixel component values in 'data'.
+ *
+ *  Used for the average intensity statistics of captured images. Vectorized with SSE2 if available.
+ */
+psych_uint64 PsychSumCapturedPixels(const void* data, size_t count, int bitdepth)
+{
+    psych_uint64 sum = 0;
+    size_t i = 0;
+
+    if (bitdepth <= 8) {
+        const psych_uint8* pixptr = (const psych_uint8*) data;
+        #ifdef PSYCH_VIDCAP_SSE2
+        // Sum of absolute differences against zero yields two 64 bit partial sums per 16 pixels:
+        __m128i acc = _mm_setzero_si128();
+        const __m128i zero = _mm_setzero_si128();
+        psych_uint64 lanes[2];
+        for (; i + 16 <= count; i += 16) acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) &pixptr[i]), zero));
+        _mm_storeu_si128((__m128i*) lanes, acc);
+        sum = lanes[0] + lanes[1];
+        #endif
+        for (; i < count; i++) sum += (psych_uint64) pixptr[i];
+    }
+    else {
+        const psych_uint16* pixptrs = (const psych_uint16*) data;
+        #ifdef PSYCH_VIDCAP_SSE2
+        // Widen to 32 bit lanes and accumulate into 64 bit lanes, so no overflow for any image size:
+        __m128i acc = _mm_setzero_si128();
+        const __m128i zero = _mm_setzero_si128();
+        psych_uint64 lanes[2];
+        for (; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i*) &pixptrs[i]);
+            __m128i v32 = _mm_add_epi32(_mm_unpacklo_epi16(v, zero), _mm_unpackhi_epi16(v, zero));
+            acc = _mm_add_epi64(acc, _mm_add_epi64(_mm_unpacklo_epi32(v32, zero), _mm_unpackhi_epi32(v32, zero)));
+        }
+        _mm_storeu_si128((__m128i*) lanes, acc);
+        sum = lanes[0] + lanes[1];
+        #endif
+        for (; i < count; i++) sum += (psych_uint64) pixptrs[i];
+    }
+
+    return(sum);
+}
+
 /*
  *  void PsychExitVideoCapture() - Shutdown handler.
  *
@@ -28,6 +28,13 @@
 
 #include "Screen.h"
 
+// SSE2 is part of the baseline instruction set of all 64-bit x86 processors, so capture engines
+// can use it for image processing without any special compiler flags or runtime cpu detection:
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PSYCH_VIDCAP_SSE2 1
+#include <emmintrin.h>
+#endif
+
 typedef struct rawcapimgdata {
     int w;
     int h;
@@ -45,6 +52,8 @@ void PsychCloseVideoCaptureDevice(int capturehandle);
 int PsychGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle, int checkForImage, double timeindex, PsychWindowRecordType *out_texture, double *presentation_timestamp, double* summed_intensity, rawcapimgdata* outrawbuffer);
 int PsychVideoCaptureRate(int capturehandle, double capturerate, int dropframes, double* startattime);
 double PsychVideoCaptureSetParameter(int capturehandle, const char* pname, double value);
+int PsychGetCapturedFrames(int capturehandle, int maxFrames, psych_bool onlyNew, rawcapimgdata* outrawbuffer, double* timestamps, double* framecounters, double* intensities, double* origins);
+psych_uint64 PsychSumCapturedPixels(const void* data, size_t count, int bitdepth);
 void PsychEnumerateVideoSources(int engineId, int outPos);
 void PsychExitVideoCapture(void);
 
@@ -90,6 +99,7 @@ void PsychGSCloseVideoCaptureDevice(int capturehandle);
 int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle, int checkForImage, double timeindex, PsychWindowRecordType *out_texture, double *presentation_timestamp, double* summed_intensity, rawcapimgdata* outrawbuffer);
 int PsychGSVideoCaptureRate(int capturehandle, double capturerate, int dropframes, double* startattime);
 double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, double value);
+int PsychGSGetCapturedFrames(int capturehandle, int maxFrames, psych_bool onlyNew, rawcapimgdata* outrawbuffer, double* timestamps, double* framecounters, double* intensities, double* origins);
 PsychVideosourceRecordType* PsychGSEnumerateVideoSources(int outPos, int deviceIndex, GstElement **videocaptureplugin);
 void PsychGSExitVideoCapture(void);
 
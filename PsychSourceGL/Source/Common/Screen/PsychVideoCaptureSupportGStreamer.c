@@ -62,6 +62,7 @@
 #include <float.h>
 #include <locale.h>
 #include "PsychVideoCaptureSupport.h"
+#include "PsychUploadBufferPoolGStreamer.h"
 
 // Include for dynamic loading of external plugin, for now only on Unix:
 #if PSYCH_SYSTEM != PSYCH_WINDOWS
@@ -136,6 +137,29 @@ typedef struct {
     char* cameraFriendlyName;         // Camera friendly device name.
     char videosourcename[100];        // Plugin name of the videosource plugin.
     void* markerTrackerPlugin;        // Opaque pointer to instance handle of a markerTrackerPlugin.
+    PsychGSUploadPool* uploadPool;    // Pool of capture buffers inside a PBO for direct texture upload, if any.
+    int uploadPoolTried;              // Creation of uploadPool already attempted?
+    gulong dataProbeId;               // Id of the PsychHaveVideoDataCallback() pad probe, zero if not yet installed.
+    psych_mutex ringMutex;            // Protects the capture ring against concurrent access from the streaming thread.
+    unsigned char* ringBuffer;        // Preallocated ring of raw captured frames, filled on the streaming thread.
+    double* ringTimestamps;           // Capture timestamp of each frame in the ring.
+    double* ringFrameCounters;        // Frame counter of each frame in the ring.
+    double* ringIntensities;          // Average intensity of each frame in the ring.
+    int ringCapacity;                 // Number of frames in the ring. Zero == Capture ring disabled.
+    double* ringOrigins;              // Left and top corner of the ROI of each frame in the ring.
+    rawcapimgdata ringFormat;         // Width, height, depth and bitdepth of frames in the ring.
+    size_t ringFrameSize;             // Size of one frame in the ring in bytes.
+    size_t ringSlotSize;              // Size of one slot in the ring in bytes: Big enough for a full unbinned frame.
+    size_t ringSrcSize;               // Minimum size of a captured frame in bytes for processing into the ring.
+    int ringSrcStride;                // Number of components per pixel of captured frames.
+    int ringSrcRGB[3];                // Offsets of red, green and blue component in a captured pixel. All identical for luminance sources.
+    int ringRoi[4];                   // ROI of frames in the ring in captured frame pixels: left, top, right, bottom. Empty == Full frame.
+    int ringBinning;                  // Binning factor 1, 2 or 4 for frames in the ring.
+    int ringGrayscale;                // Convert frames in the ring to grayscale?
+    psych_uint32* ringAccum;          // Row accumulator for binning.
+    psych_int64 ringWriteCount;       // Total number of frames written into the ring.
+    psych_int64 ringReadCount;        // Number of first frame not yet returned by a bulk fetch.
+    psych_int64 ringQueryStart;       // Number of first frame selected by the last bulk query.
 } PsychVidcapRecordType;
 
 static PsychVidcapRecordType vidcapRecordBANK[PSYCH_MAX_CAPTUREDEVICES];
@@ -154,7 +178,9 @@ static bool (*TrackerPlugin_shutdown)(void* handle);
 static bool (*TrackerPlugin_processFrame)(void* handle, unsigned long* source_ptr, int imgwidth, int imgheight, int xmin, int ymin, unsigned int timeidx, double capturetimestamp, unsigned int absolute_frameindex);
 static bool (*TrackerPlugin_processPluginDataBuffer)(void* handle, unsigned long* buffer, int size);
 
-// Forward declaration of internal helper function:
+// Forward declaration of internal helper functions:
+static void PsychGSSetupCaptureRing(PsychVidcapRecordType *capdev, int numFrames);
+static void PsychGSCaptureRingConvert(PsychVidcapRecordType *capdev, const unsigned char* src, unsigned char* dst);
 void PsychGSDeleteAllCaptureDevices(void);
 int PsychGSDrainBufferQueue(PsychVidcapRecordType* capdev, int numFramesToDrain, unsigned int flags);
 
@@ -732,6 +758,13 @@ void PsychGSCloseVideoCaptureDevice(int capturehandle)
         // Stop video capture immediately:
         PsychVideoPipelineSetState(capdev->camera, GST_STATE_NULL, 20.0);
 
+        // Release the PBO buffer pool, now that no element uses it anymore:
+        PsychGSDeleteUploadPool(capdev->uploadPool);
+        capdev->uploadPool = NULL;
+
+        // Release the capture ring, now that the streaming thread is gone:
+        PsychGSSetupCaptureRing(capdev, 0);
+
         // Delete camera for this handle:
         gst_object_unref(GST_OBJECT(capdev->camera));
         capdev->camera=NULL;
@@ -742,6 +775,7 @@ void PsychGSCloseVideoCaptureDevice(int capturehandle)
     capdev->VideoContext = NULL;
 
     PsychDestroyMutex(&capdev->mutex);
+    PsychDestroyMutex(&capdev->ringMutex);
     PsychDestroyCondition(&capdev->condition);
 
     if (capdev->videosink) {
@@ -2868,8 +2902,28 @@ psych_bool PsychGetCodecLaunchLineFromString(char* codecSpec, char* launchString
     return(PsychSetupRecordingPipeFromString(&dummydev, codecSpec, launchString, TRUE, FALSE, FALSE));
 }
 
+/* PsychGSGetCaptureTimestamp: Convert the pts of a captured video buffer into a capture timestamp in seconds,
+ * either in pipeline running time, or in absolute system time, depending on recordingflags 64.
+ */
+static double PsychGSGetCaptureTimestamp(PsychVidcapRecordType *capdev, GstBuffer *videoBuffer)
+{
+    GstClockTime baseTime;
+
+    // Retrieve raw buffer timestamp - pipeline running time?
+    if (capdev->recordingflags & 64) return((double) GST_BUFFER_PTS(videoBuffer) / (double) 1e9);
+
+    // Add base time to convert running time buffer timestamp into absolute time:
+    baseTime = gst_element_get_base_time(capdev->camera);
+    if (baseTime == 0) baseTime = capdev->lastSavedBaseTime;
+
+    // Apply corrective offset for GStreamer clock base zero point:
+    return((double) (GST_BUFFER_PTS(videoBuffer) + baseTime) / (double) 1e9 + gs_startupTime);
+}
+
 /* PsychHaveVideoDataCallback: This is used if an external C plugin, e.g., video LoadMarkerTrackingPlugin
- * is loaded to execute that plugin on the most recently arrived video input buffer. The callback is attached
+ * is loaded to execute that plugin on the most recently arrived video input buffer, and to store a copy of
+ * each frame and its timestamp, frame counter and intensity statistics in the capture ring if that is enabled.
+ * The callback is attached
  * to the sink-pad of our videosink appsink, so the callback gets executed for each incoming buffer on the
  * relevant streaming thread. This makes sure it automatically works even if we are not actively fetching
  * video data, e.g, our appsink just drops all frames, as we piggyback our custom processing on one of the
@@ -2890,6 +2944,45 @@ static GstPadProbeReturn PsychHaveVideoDataCallback(GstPad *pad, GstPadProbeInfo
 
     (void) pad;
 
+    // Capture ring enabled? Copy frame into the next slot of the ring, overwriting the oldest frame:
+    PsychLockMutex(&capdev->ringMutex);
+    if (capdev->ringCapacity > 0) {
+        int slot = (int) (capdev->ringWriteCount % capdev->ringCapacity);
+        size_t count;
+        unsigned char* ringframe = capdev->ringBuffer + (size_t) slot * capdev->ringSlotSize;
+
+        if (gst_buffer_map(videoBuffer, &mapinfo, GST_MAP_READ)) {
+            if (mapinfo.size < capdev->ringSrcSize) {
+                // Not what we negotiated. Can't process this frame:
+                gst_buffer_unmap(videoBuffer, &mapinfo);
+                PsychUnlockMutex(&capdev->ringMutex);
+                if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: Captured video frame of device %i too small for capture ring. Skipping this frame.\n", capdev->capturehandle);
+                return(GST_PAD_PROBE_OK);
+            }
+
+            // Crop, bin and convert frame into the ring:
+            PsychGSCaptureRingConvert(capdev, (const unsigned char*) mapinfo.data, ringframe);
+            gst_buffer_unmap(videoBuffer, &mapinfo);
+
+            capdev->ringOrigins[2 * slot] = capdev->ringRoi[kPsychLeft];
+            capdev->ringOrigins[2 * slot + 1] = capdev->ringRoi[kPsychTop];
+
+            // Average intensity over the ROI, computed on the freshly written and therefore cache-hot frame:
+            count = capdev->ringFrameSize / (capdev->ringFormat.bitdepth / 8);
+            capdev->ringIntensities[slot] = (count == 0) ? 0 : (double) PsychSumCapturedPixels(ringframe, count, capdev->ringFormat.bitdepth) / count /
+                                            ((capdev->bitdepth > 8) ? ((1 << (capdev->bitdepth)) - 1) : 255);
+            capdev->ringTimestamps[slot] = PsychGSGetCaptureTimestamp(capdev, videoBuffer);
+
+            // Use the frame counter of the video source if it provides one, our own running count otherwise:
+            capdev->ringFrameCounters[slot] = (double) ((GST_BUFFER_OFFSET_IS_VALID(videoBuffer)) ? GST_BUFFER_OFFSET(videoBuffer) : (guint64) capdev->ringWriteCount);
+            capdev->ringWriteCount++;
+        }
+        else if (PsychPrefStateGet_Verbosity() > 1) {
+            printf("PTB-WARNING: Failed to map video data of captured video frame for capture ring of device %i. Skipping this frame.\n", capdev->capturehandle);
+        }
+    }
+    PsychUnlockMutex(&capdev->ringMutex);
+
     // Is a special markertracker plugin loaded for this camera? If so, execute it on this frame:
     if (capdev->markerTrackerPlugin) {
         // Map the buffers memory for read+write. Tracking only needs read-access, but if visualization
@@ -2918,6 +3011,230 @@ static GstPadProbeReturn PsychHaveVideoDataCallback(GstPad *pad, GstPadProbeInfo
     return(GST_PAD_PROBE_OK);
 }
 
+/* PsychGSCaptureRingComponent: Return component i of a captured 8 bpc or 16 bpc image row.
+ */
+static psych_uint32 PsychGSCaptureRingComponent(const unsigned char* row, size_t i, int is16)
+{
+    return((is16) ? (psych_uint32) ((const psych_uint16*) row)[i] : (psych_uint32) row[i]);
+}
+
+/* PsychGSCaptureRingConvert: Crop the ROI out of the captured frame src, apply binning and optional
+ * grayscale conversion, and write the result into ring slot dst. Called on the streaming thread with
+ * the ringMutex held, so ROI and format can't change while we process.
+ */
+static void PsychGSCaptureRingConvert(PsychVidcapRecordType *capdev, const unsigned char* src, unsigned char* dst)
+{
+    const int is16 = (capdev->ringFormat.bitdepth > 8) ? 1 : 0;
+    const size_t bpc = (is16) ? 2 : 1;
+    const int ps = capdev->ringSrcStride;
+    const int* rgb = capdev->ringSrcRGB;
+    const int lum = (rgb[0] == rgb[1]) && (rgb[1] == rgb[2]);
+    const int bin = capdev->ringBinning;
+    const int w = capdev->ringFormat.w;
+    const int h = capdev->ringFormat.h;
+    const int outC = capdev->ringFormat.depth;
+    const size_t srcRowBytes = (size_t) capdev->frame_width * (size_t) ps * bpc;
+    const size_t dstRowBytes = (size_t) w * (size_t) outC * bpc;
+    const unsigned char* roi = src + (size_t) capdev->ringRoi[kPsychTop] * srcRowBytes + (size_t) capdev->ringRoi[kPsychLeft] * (size_t) ps * bpc;
+    const psych_uint32 n = (psych_uint32) (bin * bin);
+    psych_uint32* acc = capdev->ringAccum;
+    psych_uint32 v;
+    const unsigned char* row;
+    int ox, oy, x, kx, ky, c;
+    size_t i;
+
+    for (oy = 0; oy < h; oy++, dst += dstRowBytes) {
+        // Plain crop? Copy whole rows:
+        if ((bin == 1) && ((outC == ps) || (lum && ps == 1))) {
+            memcpy(dst, roi + (size_t) oy * srcRowBytes, dstRowBytes);
+            continue;
+        }
+
+        ox = 0;
+
+        #ifdef PSYCH_VIDCAP_SSE2
+        // 2x2 binning of 8 bpc luminance, the typical eye tracking case: Sum vertical pairs in 16 bit lanes,
+        // then horizontal pairs within 32 bit lanes, round and pack 16 input pixels into 8 output pixels:
+        if ((bin == 2) && !is16 && (ps == 1)) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i mask = _mm_set1_epi32(0xFFFF);
+            const __m128i two = _mm_set1_epi16(2);
+            const unsigned char* r0 = roi + (size_t) (2 * oy) * srcRowBytes;
+            const unsigned char* r1 = r0 + srcRowBytes;
+
+            for (; ox + 8 <= w; ox += 8) {
+                __m128i a = _mm_loadu_si128((const __m128i*) &r0[2 * ox]);
+                __m128i b = _mm_loadu_si128((const __m128i*) &r1[2 * ox]);
+                __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                lo = _mm_and_si128(_mm_add_epi32(lo, _mm_srli_epi32(lo, 16)), mask);
+                hi = _mm_and_si128(_mm_add_epi32(hi, _mm_srli_epi32(hi, 16)), mask);
+                lo = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(lo, hi), two), 2);
+                _mm_storel_epi64((__m128i*) &dst[ox], _mm_packus_epi16(lo, zero));
+            }
+
+            if (ox == w) continue;
+        }
+        #endif
+
+        // Generic path: Accumulate bin x bin blocks of remaining pixels, converting to luminance if needed:
+        memset(acc, 0, (size_t) w * (size_t) outC * sizeof(psych_uint32));
+        for (ky = 0; ky < bin; ky++) {
+            row = roi + (size_t) (oy * bin + ky) * srcRowBytes;
+            for (x = ox, i = (size_t) ox * bin * ps; x < w; x++) {
+                for (kx = 0; kx < bin; kx++, i += ps) {
+                    if (outC > 1) {
+                        for (c = 0; c < outC; c++) acc[x * outC + c] += PsychGSCaptureRingComponent(row, i + c, is16);
+                    }
+                    else if (lum) {
+                        acc[x] += PsychGSCaptureRingComponent(row, i + rgb[0], is16);
+                    }
+                    else {
+                        acc[x] += (77 * PsychGSCaptureRingComponent(row, i + rgb[0], is16) + 150 * PsychGSCaptureRingComponent(row, i + rgb[1], is16) +
+                                   29 * PsychGSCaptureRingComponent(row, i + rgb[2], is16) + 128) >> 8;
+                    }
+                }
+            }
+        }
+
+        // Normalize with rounding and store:
+        for (x = ox * outC; x < w * outC; x++) {
+            v = (acc[x] + n / 2) / n;
+            if (is16) ((psych_uint16*) dst)[x] = (psych_uint16) v; else dst[x] = (unsigned char) v;
+        }
+    }
+}
+
+/* PsychGSUpdateCaptureRingFormat: Validate ROI, binning and grayscale settings of the capture ring and
+ * derive the format of the frames in the ring from them. Discards all frames in the ring. Called with
+ * the ringMutex held.
+ */
+static void PsychGSUpdateCaptureRingFormat(PsychVidcapRecordType *capdev)
+{
+    int* roi = capdev->ringRoi;
+    const int lum = (capdev->ringSrcRGB[0] == capdev->ringSrcRGB[1]) && (capdev->ringSrcRGB[1] == capdev->ringSrcRGB[2]);
+
+    // Empty ROI selects the full frame, anything else gets clipped to the frame:
+    if ((roi[kPsychRight] <= roi[kPsychLeft]) || (roi[kPsychBottom] <= roi[kPsychTop])) {
+        roi[kPsychLeft] = 0;
+        roi[kPsychTop] = 0;
+        roi[kPsychRight] = capdev->frame_width;
+        roi[kPsychBottom] = capdev->frame_height;
+    }
+
+    if (roi[kPsychLeft] < 0) roi[kPsychLeft] = 0;
+    if (roi[kPsychTop] < 0) roi[kPsychTop] = 0;
+    if (roi[kPsychRight] > capdev->frame_width) roi[kPsychRight] = capdev->frame_width;
+    if (roi[kPsychBottom] > capdev->frame_height) roi[kPsychBottom] = capdev->frame_height;
+    if (roi[kPsychRight] < roi[kPsychLeft]) roi[kPsychRight] = roi[kPsychLeft];
+    if (roi[kPsychBottom] < roi[kPsychTop]) roi[kPsychBottom] = roi[kPsychTop];
+
+    if ((capdev->ringBinning != 2) && (capdev->ringBinning != 4)) capdev->ringBinning = 1;
+
+    capdev->ringFormat.w = (roi[kPsychRight] - roi[kPsychLeft]) / capdev->ringBinning;
+    capdev->ringFormat.h = (roi[kPsychBottom] - roi[kPsychTop]) / capdev->ringBinning;
+    capdev->ringFormat.depth = (capdev->ringGrayscale || lum) ? 1 : capdev->ringSrcStride;
+    capdev->ringFormat.bitdepth = (capdev->bitdepth > 8) ? 16 : 8;
+    capdev->ringFormat.data = NULL;
+    capdev->ringFrameSize = (size_t) capdev->ringFormat.w * (size_t) capdev->ringFormat.h * (size_t) capdev->ringFormat.depth * (size_t) (capdev->ringFormat.bitdepth / 8);
+
+    capdev->ringWriteCount = 0;
+    capdev->ringReadCount = 0;
+    capdev->ringQueryStart = 0;
+}
+
+/* PsychGSAddVideoDataProbe: Attach PsychHaveVideoDataCallback() to the sink pad of our videosink, unless already done.
+ */
+static void PsychGSAddVideoDataProbe(PsychVidcapRecordType *capdev)
+{
+    GstPad *pad;
+
+    if (capdev->dataProbeId) return;
+
+    // Get the sink pad from the videosink, where our to-be-processed video frames arrive on the streaming thread:
+    pad = gst_element_get_static_pad(capdev->videosink, "sink");
+
+    // Add a pad probe callback PsychHaveVideoDataCallback(). This gets called on each received buffer
+    // from the streaming thread:
+    capdev->dataProbeId = gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, PsychHaveVideoDataCallback, capdev, NULL);
+    gst_object_unref(pad);
+}
+
+/* PsychGSSetupCaptureRing: (Re-)Allocate the capture ring for numFrames frames of the current
+ * capture format, or release it if numFrames is zero. All previously captured ring content is discarded.
+ */
+static void PsychGSSetupCaptureRing(PsychVidcapRecordType *capdev, int numFrames)
+{
+    unsigned char* ringBuffer = NULL;
+    double* ringMeta = NULL;
+    psych_uint32* ringAccum = NULL;
+    size_t slotSize;
+    size_t bpc = (capdev->bitdepth > 8) ? 2 : 1;
+    int stride, r, g, b;
+
+    // Layout of captured pixels: Luminance only is extracted from YUV formats, ie. the Y
+    // component of UYVY packed pixels, or the leading Y plane of I420 planar frames:
+    if ((capdev->reqpixeldepth == 2) && (capdev->bitdepth <= 8) && (capdev->pixeldepth == 16)) {
+        stride = 2; r = g = b = 1;
+    }
+    else if (capdev->reqpixeldepth <= 2) {
+        stride = 1; r = g = b = 0;
+    }
+    else if (capdev->reqpixeldepth == 3) {
+        stride = 3; r = 0; g = 1; b = 2;
+    }
+    else if (capdev->bitdepth > 8) {
+        // ARGB64:
+        stride = 4; r = 1; g = 2; b = 3;
+    }
+    else {
+        // BGRA8:
+        stride = 4; r = 2; g = 1; b = 0;
+    }
+
+    slotSize = (size_t) capdev->frame_width * (size_t) capdev->frame_height * (size_t) ((r == g && g == b) ? 1 : stride) * bpc;
+
+    // Preallocate all memory up front, so the streaming thread never needs to allocate anything:
+    if (numFrames > 0) {
+        ringBuffer = (unsigned char*) malloc(slotSize * (size_t) numFrames);
+        ringMeta = (double*) calloc(5 * (size_t) numFrames, sizeof(double));
+        ringAccum = (psych_uint32*) malloc((size_t) capdev->frame_width * (size_t) stride * sizeof(psych_uint32));
+        if (!ringBuffer || !ringMeta || !ringAccum) {
+            free(ringBuffer);
+            free(ringMeta);
+            free(ringAccum);
+            PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while trying to allocate the capture ring! Try a smaller number of frames.");
+        }
+    }
+
+    PsychLockMutex(&capdev->ringMutex);
+
+    // ringTimestamps holds the start of the shared allocation for all per-frame meta data:
+    free(capdev->ringBuffer);
+    free(capdev->ringTimestamps);
+    free(capdev->ringAccum);
+
+    capdev->ringBuffer = ringBuffer;
+    capdev->ringTimestamps = ringMeta;
+    capdev->ringFrameCounters = (ringMeta) ? ringMeta + numFrames : NULL;
+    capdev->ringIntensities = (ringMeta) ? ringMeta + 2 * numFrames : NULL;
+    capdev->ringOrigins = (ringMeta) ? ringMeta + 3 * numFrames : NULL;
+    capdev->ringAccum = ringAccum;
+    capdev->ringCapacity = numFrames;
+    capdev->ringSlotSize = slotSize;
+    capdev->ringSrcSize = (size_t) capdev->frame_width * (size_t) capdev->frame_height * (size_t) stride * bpc;
+    capdev->ringSrcStride = stride;
+    capdev->ringSrcRGB[0] = r;
+    capdev->ringSrcRGB[1] = g;
+    capdev->ringSrcRGB[2] = b;
+    PsychGSUpdateCaptureRingFormat(capdev);
+
+    PsychUnlockMutex(&capdev->ringMutex);
+
+    // The capture ring gets filled from the streaming thread by our pad probe:
+    if (numFrames > 0) PsychGSAddVideoDataProbe(capdev);
+}
+
 /*
  *      PsychGSOpenVideoCaptureDevice() -- Create a video capture object.
  *
@@ -3087,6 +3404,7 @@ psych_bool PsychGSOpenVideoCaptureDevice(int slotid, PsychWindowRecordType *win,
     capdev->num_dmabuffers = num_dmabuffers;
 
     PsychInitMutex(&vidcapRecordBANK[slotid].mutex);
+    PsychInitMutex(&vidcapRecordBANK[slotid].ringMutex);
     PsychInitCondition(&vidcapRecordBANK[slotid].condition, NULL);
 
     // Try to open and initialize camera according to given settings:
@@ -4566,17 +4884,14 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     GstBuffer *videoBuffer = NULL;
     GstSample *videoSample = NULL;
     double deltaT = 0;
-    GstClockTime baseTime;
 
     int waitforframe;
     int w, h;
-    psych_uint64 intensity = 0;
-    unsigned int count, i;
-    unsigned char* pixptr;
-    psych_uint16* pixptrs;
+    unsigned int count;
     double tstart, tend;
     int nrdropped = 0;
     unsigned char* input_image = NULL;
+    psych_bool usedUploadPool = FALSE;
 
     // Disable warning about missing field initializer in calls
     // like GstMapInfo mapinfo = = GST_MAP_INFO_INIT;
@@ -4774,19 +5089,7 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         input_image = (unsigned char*) (GLuint*) mapinfo.data;
 
         // Assign pts presentation timestamp in pipeline stream time and convert to seconds:
-        if (capdev->recordingflags & 64) {
-            // Retrieve raw buffer timestamp - pipeline running time.
-            capdev->current_pts = (double) GST_BUFFER_PTS(videoBuffer) / (double) 1e9;
-        } else {
-            // Add base time to convert running time buffer timestamp into absolute time:
-            baseTime = gst_element_get_base_time(capdev->camera);
-            if (baseTime == 0) baseTime = capdev->lastSavedBaseTime;
-
-            capdev->current_pts = (double) (GST_BUFFER_PTS(videoBuffer) + baseTime) / (double) 1e9;
-
-            // Apply corrective offset for GStreamer clock base zero point:
-            capdev->current_pts+= gs_startupTime;
-        }
+        capdev->current_pts = PsychGSGetCaptureTimestamp(capdev, videoBuffer);
 
         deltaT = 0.0;
         if (GST_CLOCK_TIME_IS_VALID(GST_BUFFER_DURATION(videoBuffer)))
@@ -4856,6 +5159,16 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         // This will retrieve an OpenGL compatible pointer to the pixel data and assign it to our texmemptr:
         out_texture->textureMemory = (GLuint*) input_image;
 
+        // Create pool of capture buffers inside a PBO at first fetch, once the format is negotiated.
+        // Only possible with a bounded appsink queue, as the pool has a fixed number of buffers:
+        if (!capdev->uploadPoolTried) {
+            capdev->uploadPoolTried = 1;
+            capdev->uploadPool = PsychGSCreateUploadPool(win, capdev->videosink, (int) gst_app_sink_get_max_buffers(GST_APP_SINK(capdev->videosink)));
+        }
+
+        // Frame captured into the pool? Then upload asynchronously from the PBO, without a copy:
+        usedUploadPool = PsychGSUploadPoolSetupTexture(capdev->uploadPool, win, out_texture);
+
         // Special case depths == 2, aka YCBCR texture?
         if ((capdev->bitdepth <= 8) && (capdev->reqpixeldepth == 2) && (capdev->pixeldepth == 16) && (win->gfxcaps & kPsychGfxCapUYVYTexture)) {
             // GPU supports UYVY textures and we get data in that YCbCr format. Tell
@@ -5013,20 +5326,11 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         // Ready to use the texture...
     }
 
-    // Sum of pixel intensities requested? 8 bpc?
-    if (summed_intensity && (capdev->bitdepth <= 8)) {
-        pixptr = (unsigned char*) input_image;
-        count  = w * h * ((capdev->reqpixeldepth !=2) ? capdev->reqpixeldepth : 1);
-        for (i=0; i<count; i++) intensity+=(psych_uint64) pixptr[i];
-        *summed_intensity = ((double) intensity) / w / h / capdev->reqpixeldepth / 255;
-    }
-
-    // Sum of pixel intensities requested? 16 bpc?
-    if (summed_intensity && (capdev->bitdepth > 8)) {
-        pixptrs = (psych_uint16*) input_image;
+    // Sum of pixel intensities requested? 8 bpc or 16 bpc?
+    if (summed_intensity) {
         count = w * h * ((capdev->reqpixeldepth !=2) ? capdev->reqpixeldepth : 1);
-        for (i=0; i<count; i++) intensity+=(psych_uint64) pixptrs[i];
-        *summed_intensity = ((double) intensity) / w / h / capdev->reqpixeldepth / ((1 << (capdev->bitdepth)) - 1);
+        *summed_intensity = ((double) PsychSumCapturedPixels(input_image, count, capdev->bitdepth)) / w / h / capdev->reqpixeldepth /
+                            ((capdev->bitdepth > 8) ? ((1 << (capdev->bitdepth)) - 1) : 255);
     }
 
     // Raw data requested?
@@ -5041,9 +5345,13 @@ int PsychGSGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         memcpy(outrawbuffer->data, (const void *) input_image, count);
     }
 
-    // Release the capture buffer. Return it to the DMA ringbuffer pool:
+    // Release the capture buffer. Return it to the DMA ringbuffer pool, or to the PBO pool
+    // once its asynchronous texture upload is complete:
     gst_buffer_unmap(videoBuffer, &mapinfo);
-    gst_sample_unref(videoSample);
+    if (usedUploadPool)
+        PsychGSUploadPoolRetireSample(capdev->uploadPool, videoSample);
+    else
+        gst_sample_unref(videoSample);
     videoBuffer = NULL;
 
     // Update total count of dropped (or pending) frames:
@@ -5203,14 +5511,9 @@ double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, dou
             PsychErrorExitMsg(PsychError_user, "Initializing markertracker plugin failed!");
         }
 
-        // Get the sink pad from the videosink, where our to-be-processed video frames arrive on the streaming thread:
-        GstPad *pad = gst_element_get_static_pad(capdev->videosink, "sink");
-
-        // Add a pad probe callback PsychHaveVideoDataCallback(). This gets called on each received buffer
-        // from the streaming thread. If a markertracker/data processing plugin is loaded, the PsychHaveVideoDataCallback()
-        // will map the received video buffer and execute the plugin on it, otherwise the callback no-ops:
-        gst_pad_add_probe(pad, GST_PAD_PROBE_TYPE_BUFFER, PsychHaveVideoDataCallback, capdev, NULL);
-        gst_object_unref(pad);
+        // Add the pad probe callback PsychHaveVideoDataCallback(). If a markertracker/data processing plugin
+        // is loaded, the PsychHaveVideoDataCallback() will map the received video buffer and execute the plugin on it:
+        PsychGSAddVideoDataProbe(capdev);
 
         if (PsychPrefStateGet_Verbosity() > 2) {
             printf("PTB-INFO: Markertracker plugin loaded and initialized for device %i as '%s'.\n", capturehandle, pname);
@@ -5293,6 +5596,90 @@ double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, dou
         return(0);
     }
 
+    // Query and optionally (re-)allocate the capture ring for bulk frame retrieval via Screen('GetCapturedFrames'):
+    if (strcmp(pname, "CaptureRing")==0) {
+        oldvalue = (double) capdev->ringCapacity;
+        if (value != DBL_MAX) {
+            if (intval < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative number of frames for 'CaptureRing' provided!");
+            PsychGSSetupCaptureRing(capdev, intval);
+            if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: Capture ring of device %i now holds %i frames of %i bytes each.\n", capturehandle, intval, (int) capdev->ringFrameSize);
+        }
+        return(oldvalue);
+    }
+
+    // Query and optionally change the ROI of frames in the capture ring. Only moving the ROI keeps the frames in the ring,
+    // so it can follow a moving target on each frame:
+    if (strcmp(pname, "CaptureRingROI")==0) {
+        int roi[4];
+
+        PsychLockMutex(&capdev->ringMutex);
+        memcpy(roi, capdev->ringRoi, sizeof(roi));
+        PsychUnlockMutex(&capdev->ringMutex);
+
+        // Return old ROI, the full frame if none set yet:
+        if ((roi[kPsychRight] <= roi[kPsychLeft]) || (roi[kPsychBottom] <= roi[kPsychTop])) {
+            roi[kPsychLeft] = roi[kPsychTop] = 0;
+            roi[kPsychRight] = capdev->frame_width;
+            roi[kPsychBottom] = capdev->frame_height;
+        }
+        PsychCopyOutDoubleArg(2, FALSE, roi[kPsychTop]);
+        PsychCopyOutDoubleArg(3, FALSE, roi[kPsychRight]);
+        PsychCopyOutDoubleArg(4, FALSE, roi[kPsychBottom]);
+        oldvalue = roi[kPsychLeft];
+
+        if (value != DBL_MAX) {
+            int newroi[4];
+            newroi[kPsychLeft] = intval;
+            PsychCopyInIntegerArg(4, TRUE, &newroi[kPsychTop]);
+            PsychCopyInIntegerArg(5, TRUE, &newroi[kPsychRight]);
+            PsychCopyInIntegerArg(6, TRUE, &newroi[kPsychBottom]);
+
+            PsychLockMutex(&capdev->ringMutex);
+            if ((capdev->ringCapacity > 0) && (newroi[kPsychRight] - newroi[kPsychLeft] == capdev->ringRoi[kPsychRight] - capdev->ringRoi[kPsychLeft]) &&
+                (newroi[kPsychBottom] - newroi[kPsychTop] == capdev->ringRoi[kPsychBottom] - capdev->ringRoi[kPsychTop])) {
+                // Same size, just moved: Keep it inside the frame at constant size, so ring content stays valid:
+                int w = newroi[kPsychRight] - newroi[kPsychLeft];
+                int h = newroi[kPsychBottom] - newroi[kPsychTop];
+                if (newroi[kPsychLeft] > capdev->frame_width - w) newroi[kPsychLeft] = capdev->frame_width - w;
+                if (newroi[kPsychTop] > capdev->frame_height - h) newroi[kPsychTop] = capdev->frame_height - h;
+                if (newroi[kPsychLeft] < 0) newroi[kPsychLeft] = 0;
+                if (newroi[kPsychTop] < 0) newroi[kPsychTop] = 0;
+                capdev->ringRoi[kPsychLeft] = newroi[kPsychLeft];
+                capdev->ringRoi[kPsychTop] = newroi[kPsychTop];
+                capdev->ringRoi[kPsychRight] = newroi[kPsychLeft] + w;
+                capdev->ringRoi[kPsychBottom] = newroi[kPsychTop] + h;
+            }
+            else {
+                // New size: Reformat the ring:
+                memcpy(capdev->ringRoi, newroi, sizeof(newroi));
+                if (capdev->ringCapacity > 0) PsychGSUpdateCaptureRingFormat(capdev);
+            }
+            PsychUnlockMutex(&capdev->ringMutex);
+        }
+
+        return(oldvalue);
+    }
+
+    // Query and optionally change binning factor 1, 2 or 4, or grayscale conversion for frames in the capture ring:
+    if ((strcmp(pname, "CaptureRingBinning")==0) || (strcmp(pname, "CaptureRingGrayscale")==0)) {
+        int* setting = (strstr(pname, "Binning")) ? &capdev->ringBinning : &capdev->ringGrayscale;
+
+        oldvalue = (double) *setting;
+        if ((setting == &capdev->ringBinning) && (oldvalue < 1)) oldvalue = 1;
+
+        if (value != DBL_MAX) {
+            if ((setting == &capdev->ringBinning) && (intval != 1) && (intval != 2) && (intval != 4))
+                PsychErrorExitMsg(PsychError_user, "Invalid 'CaptureRingBinning' factor provided! Must be 1, 2 or 4.");
+
+            PsychLockMutex(&capdev->ringMutex);
+            *setting = (setting == &capdev->ringBinning) ? intval : ((intval > 0) ? 1 : 0);
+            if (capdev->ringCapacity > 0) PsychGSUpdateCaptureRingFormat(capdev);
+            PsychUnlockMutex(&capdev->ringMutex);
+        }
+
+        return(oldvalue);
+    }
+
     // Return current framerate:
     if (strcmp(pname, "GetFramerate")==0) {
         PsychCopyOutDoubleArg(1, FALSE, capdev->fps);
@@ -5532,5 +5919,82 @@ double PsychGSVideoCaptureSetParameter(int capturehandle, const char* pname, dou
     return(DBL_MAX);
 }
 
+/*
+ *  PsychGSGetCapturedFrames() - Bulk retrieval of the most recent frames from the capture ring.
+ *
+ *  See PsychGetCapturedFrames() for a description of the two-step query and fetch protocol.
+ *  The fetch always returns the requested number of frames: If the streaming thread overwrote
+ *  some of the frames selected by the query in the meantime, newer frames get returned instead.
+ */
+int PsychGSGetCapturedFrames(int capturehandle, int maxFrames, psych_bool onlyNew, rawcapimgdata* outrawbuffer, double* timestamps, double* framecounters, double* intensities, double* origins)
+{
+    psych_int64 first, oldest;
+    int i, n, slot;
+    unsigned char* outframe;
+
+    // Retrieve device record for handle:
+    PsychVidcapRecordType* capdev = PsychGetGSVidcapRecord(capturehandle);
+
+    // Make sure GStreamer is ready:
+    PsychGSCheckInit("videocapture");
+
+    if (capdev->ringCapacity <= 0) {
+        PsychErrorExitMsg(PsychError_user, "Capture ring not enabled for this capture device! Enable it via Screen('SetVideoCaptureParameter', capturePtr, 'CaptureRing', numFrames) first.");
+    }
+
+    PsychLockMutex(&capdev->ringMutex);
+
+    // Oldest frame still stored in the ring:
+    oldest = capdev->ringWriteCount - capdev->ringCapacity;
+    if (oldest < 0) oldest = 0;
+
+    if (outrawbuffer->data == NULL) {
+        // Query: Select up to maxFrames most recent frames, optionally only ones not yet fetched:
+        first = capdev->ringWriteCount - maxFrames;
+        if (first < oldest) first = oldest;
+        if (onlyNew && (first < capdev->ringReadCount)) first = capdev->ringReadCount;
+        n = (int) (capdev->ringWriteCount - first);
+        if (n < 0) n = 0;
+
+        capdev->ringQueryStart = first;
+
+        outrawbuffer->w = capdev->ringFormat.w;
+        outrawbuffer->h = capdev->ringFormat.h;
+        outrawbuffer->depth = capdev->ringFormat.depth;
+        outrawbuffer->bitdepth = capdev->ringFormat.bitdepth;
+    }
+    else {
+        // Fetch: Copy maxFrames frames, starting with the first one selected by the query, if still available:
+        first = capdev->ringQueryStart;
+        if (first < oldest) first = oldest;
+        n = (int) (capdev->ringWriteCount - first);
+        if (n > maxFrames) n = maxFrames;
+
+        outframe = (unsigned char*) outrawbuffer->data;
+        for (i = 0; i < n; i++) {
+            slot = (int) ((first + i) % capdev->ringCapacity);
+            memcpy(outframe, capdev->ringBuffer + (size_t) slot * capdev->ringSlotSize, capdev->ringFrameSize);
+            outframe += capdev->ringFrameSize;
+
+            if (timestamps) timestamps[i] = capdev->ringTimestamps[slot];
+            if (framecounters) framecounters[i] = capdev->ringFrameCounters[slot];
+            if (intensities) intensities[i] = capdev->ringIntensities[slot];
+            if (origins) {
+                origins[i] = capdev->ringOrigins[2 * slot];
+                origins[maxFrames + i] = capdev->ringOrigins[2 * slot + 1];
+            }
+        }
+
+        capdev->ringReadCount = first + n;
+
+        // Can't happen as frames only get added after a query, but never return uninitialized memory:
+        if (n < maxFrames) memset(outframe, 0, (size_t) (maxFrames - n) * capdev->ringFrameSize);
+    }
+
+    PsychUnlockMutex(&capdev->ringMutex);
+
+    return(n);
+}
+
 #endif
 #endif
@@ -76,6 +76,7 @@ typedef struct {
     uint64_t total_bytes;             // Total bytes per frame in Format-7 mode, as queried from camera. Needed for Basler SFF support.
     unsigned char* current_frame;     // Ptr to target buffer for most recent frame if video recorder thread is active in low-latency mode.
     unsigned char* pulled_frame;      // Ptr to fetched frame from video recorder thread (if active). This is the "front buffer" equivalent of current_frame.
+    unsigned char* spare_frame;       // Ptr to a released pulled_frame buffer, for reuse as current_frame by the video recorder thread.
     int syncmode;                     // 0 = free-running. 1 = sync-master, 2 = sync-slave, 4 = soft-sync, 8 = bus-sync, 16 = ttl-sync.
     int syncmasterhandle;             // -1 for "undefined" or the capturehandle of the sync master, if a camera is a sync slave.
     int dropframes;                   // 1 == Always deliver most recent frame in FIFO, even if dropping of frames is neccessary.
@@ -126,7 +127,7 @@ static psych_bool firsttime = TRUE;
 static dc1394_t *libdc = NULL; // Master handle to DC1394 library.
 
 // Global Bayer filter settings for helper routine which is used for movie playback:
-static dc1394bayer_method_t global_debayer_method = DC1394_BAYER_METHOD_NEAREST;
+static dc1394bayer_method_t global_debayer_method = DC1394_BAYER_METHOD_BILINEAR;
 static dc1394color_filter_t global_color_filter = DC1394_COLOR_FILTER_MIN;
 
 // Global state and functions related to special markerTrackerPlugin's:
@@ -372,7 +373,7 @@ psych_bool PsychDCOpenVideoCaptureDevice(int slotid, PsychWindowRecordType *win,
     capdev->camera = NULL;
     capdev->grabber_active = 0;
     capdev->convframe = NULL;
-    capdev->debayer_method = DC1394_BAYER_METHOD_NEAREST;
+    capdev->debayer_method = DC1394_BAYER_METHOD_BILINEAR;
     capdev->capturehandle = slotid;
     capdev->moviehandle = -1;
 
@@ -1243,12 +1244,370 @@ static psych_bool PsychDCPushFrameToMovie(PsychVidcapRecordType* capdev, psych_u
     return(TRUE);
 }
 
+// Conversion of raw Bayer sensor data and YUV422/YUV411 data into RGB8 images by our own kernels. These
+// are split into bands of rows which get processed in parallel by the shared worker thread pool, so high
+// resolution cameras at high framerates don't get bottlenecked by single-threaded conversion in libdc1394.
+// Only 8 bpc input and the most useful methods are covered, everything else is left to libdc1394:
+#define PSYCH_DCCONV_GRAINSIZE 65536
+
+typedef struct PsychDCConvJob {
+    const unsigned char* in;
+    unsigned char* out;
+    int width;
+    int height;
+    int instride;
+    int redx;           // Bayer: Column parity of red pixels.
+    int redy;           // Bayer: Row parity of red pixels.
+    psych_bool yuyv;    // YUV422: YUYV instead of UYVY byte order.
+} PsychDCConvJob;
+
+// Pixel offsets of the neighbours of a pixel, mirrored at the image borders. Mirroring keeps the
+// parity of the neighbours coordinates, so they always sample the correct color of the Bayer pattern:
+typedef struct PsychDCNeighbours {
+    int l1, r1, l2, r2;
+    int u1, d1, u2, d2;
+} PsychDCNeighbours;
+
+static inline void PsychDCVertNeighbours(PsychDCNeighbours* n, int y, int height, int stride)
+{
+    n->u1 = ((y >= 1) ? -1 : 1) * stride;
+    n->u2 = ((y >= 2) ? -2 : 2) * stride;
+    n->d1 = ((y + 1 < height) ? 1 : -1) * stride;
+    n->d2 = ((y + 2 < height) ? 2 : -2) * stride;
+}
+
+static inline void PsychDCHorzNeighbours(PsychDCNeighbours* n, int x, int width)
+{
+    n->l1 = (x >= 1) ? -1 : 1;
+    n->l2 = (x >= 2) ? -2 : 2;
+    n->r1 = (x + 1 < width) ? 1 : -1;
+    n->r2 = (x + 2 < width) ? 2 : -2;
+}
+
+static inline unsigned char PsychDCClampByte(int v)
+{
+    return((unsigned char) ((v < 0) ? 0 : ((v > 255) ? 255 : v)));
+}
+
+// Bilinear interpolation for one pixel. 'own' is the red or blue channel index of the current row:
+static inline void PsychDCBilinearPixel(const unsigned char* p, unsigned char* rgb, PsychDCNeighbours n, psych_bool nongreen, int own)
+{
+    if (nongreen) {
+        rgb[own] = p[0];
+        rgb[1] = (unsigned char) ((p[n.l1] + p[n.r1] + p[n.u1] + p[n.d1] + 2) >> 2);
+        rgb[2 - own] = (unsigned char) ((p[n.u1 + n.l1] + p[n.u1 + n.r1] + p[n.d1 + n.l1] + p[n.d1 + n.r1] + 2) >> 2);
+    }
+    else {
+        rgb[own] = (unsigned char) ((p[n.l1] + p[n.r1] + 1) >> 1);
+        rgb[1] = p[0];
+        rgb[2 - own] = (unsigned char) ((p[n.u1] + p[n.d1] + 1) >> 1);
+    }
+}
+
+static void PsychDCBilinearWorker(void* context, psych_int64 begin, psych_int64 end)
+{
+    const PsychDCConvJob* job = (const PsychDCConvJob*) context;
+    const int w = job->width;
+    PsychDCNeighbours n, inner;
+    int x, y, own, ng;
+
+    for (y = (int) begin; y < (int) end; y++) {
+        const unsigned char* in = job->in + (size_t) y * job->instride;
+        unsigned char* out = job->out + (size_t) y * w * 3;
+
+        // Red or blue row? Column parity of its red or blue pixels:
+        own = ((y & 1) == job->redy) ? 0 : 2;
+        ng = (own == 0) ? job->redx : 1 - job->redx;
+
+        PsychDCVertNeighbours(&n, y, job->height, job->instride);
+        inner = n;
+        inner.l1 = -1; inner.r1 = 1;
+
+        // Border columns, then the interior in pairs of pixels with fixed Bayer pattern positions:
+        PsychDCHorzNeighbours(&n, 0, w);
+        PsychDCBilinearPixel(in, out, n, ng == 0, own);
+        PsychDCHorzNeighbours(&n, w - 1, w);
+        PsychDCBilinearPixel(in + w - 1, out + 3 * (w - 1), n, ((w - 1) & 1) == ng, own);
+
+        for (x = 1; x + 1 < w - 1; x += 2) {
+            PsychDCBilinearPixel(in + x, out + 3 * x, inner, ng == 1, own);
+            PsychDCBilinearPixel(in + x + 1, out + 3 * x + 3, inner, ng == 0, own);
+        }
+
+        for (; x < w - 1; x++) PsychDCBilinearPixel(in + x, out + 3 * x, inner, (x & 1) == ng, own);
+    }
+}
+
+// Edge-aware debayering, first pass: Interpolate green along the direction of the smaller gradient,
+// with a correction term from the second derivative of the red or blue channel (Hamilton-Adams):
+static inline void PsychDCEdgeGreenPixel(const unsigned char* p, unsigned char* rgb, PsychDCNeighbours n, psych_bool nongreen, int own)
+{
+    int dh, dv, gh, gv, lh, lv;
+
+    if (nongreen) {
+        lh = 2 * p[0] - p[n.l2] - p[n.r2];
+        lv = 2 * p[0] - p[n.u2] - p[n.d2];
+        dh = abs(p[n.l1] - p[n.r1]) + abs(lh);
+        dv = abs(p[n.u1] - p[n.d1]) + abs(lv);
+        gh = 2 * (p[n.l1] + p[n.r1]) + lh;
+        gv = 2 * (p[n.u1] + p[n.d1]) + lv;
+
+        rgb[own] = p[0];
+        rgb[1] = PsychDCClampByte((gh + gv + (dh < dv) * (gh - gv) + (dv < dh) * (gv - gh)) / 8);
+    }
+    else {
+        rgb[1] = p[0];
+    }
+}
+
+static void PsychDCEdgeGreenWorker(void* context, psych_int64 begin, psych_int64 end)
+{
+    const PsychDCConvJob* job = (const PsychDCConvJob*) context;
+    const int w = job->width;
+    PsychDCNeighbours n, inner;
+    int x, y, own, ng;
+
+    for (y = (int) begin; y < (int) end; y++) {
+        const unsigned char* in = job->in + (size_t) y * job->instride;
+        unsigned char* out = job->out + (size_t) y * w * 3;
+
+        own = ((y & 1) == job->redy) ? 0 : 2;
+        ng = (own == 0) ? job->redx : 1 - job->redx;
+
+        PsychDCVertNeighbours(&n, y, job->height, job->instride);
+        inner = n;
+        inner.l1 = -1; inner.r1 = 1; inner.l2 = -2; inner.r2 = 2;
+
+        // Two border columns on each side, then the interior in pairs of pixels:
+        for (x = 0; x < w; x += (x == 1) ? w - 3 : 1) {
+            PsychDCHorzNeighbours(&n, x, w);
+            PsychDCEdgeGreenPixel(in + x, out + 3 * x, n, (x & 1) == ng, own);
+        }
+
+        for (x = 2; x + 1 < w - 2; x += 2) {
+            PsychDCEdgeGreenPixel(in + x, out + 3 * x, inner, ng == 0, own);
+            PsychDCEdgeGreenPixel(in + x + 1, out + 3 * x + 3, inner, ng == 1, own);
+        }
+
+        for (; x < w - 2; x++) PsychDCEdgeGreenPixel(in + x, out + 3 * x, inner, (x & 1) == ng, own);
+    }
+}
+
+// Edge-aware debayering, second pass: Interpolate the missing red and blue values from the color
+// differences to the now complete green channel, which follows edges far better than bilinear filtering.
+// 'ou' and 'od' are the offsets of the upper and lower neighbour pixel in the RGB output image:
+static inline void PsychDCEdgeColorPixel(const unsigned char* p, unsigned char* rgb, PsychDCNeighbours n, int ou, int od, psych_bool nongreen, int own)
+{
+    int g = rgb[1];
+    int d;
+
+    if (nongreen) {
+        // Diagonal neighbours carry the other chroma channel:
+        d = (p[n.u1 + n.l1] - rgb[3 * (ou + n.l1) + 1]) + (p[n.u1 + n.r1] - rgb[3 * (ou + n.r1) + 1]) +
+            (p[n.d1 + n.l1] - rgb[3 * (od + n.l1) + 1]) + (p[n.d1 + n.r1] - rgb[3 * (od + n.r1) + 1]);
+        rgb[2 - own] = PsychDCClampByte(g + (d >> 2));
+    }
+    else {
+        // Horizontal neighbours carry this rows chroma channel, vertical ones the other:
+        d = (p[n.l1] - rgb[3 * n.l1 + 1]) + (p[n.r1] - rgb[3 * n.r1 + 1]);
+        rgb[own] = PsychDCClampByte(g + (d >> 1));
+        d = (p[n.u1] - rgb[3 * ou + 1]) + (p[n.d1] - rgb[3 * od + 1]);
+        rgb[2 - own] = PsychDCClampByte(g + (d >> 1));
+    }
+}
+
+static void PsychDCEdgeColorWorker(void* context, psych_int64 begin, psych_int64 end)
+{
+    const PsychDCConvJob* job = (const PsychDCConvJob*) context;
+    const int w = job->width;
+    PsychDCNeighbours n, inner;
+    int x, y, own, ng, ou, od;
+
+    for (y = (int) begin; y < (int) end; y++) {
+        const unsigned char* in = job->in + (size_t) y * job->instride;
+        unsigned char* out = job->out + (size_t) y * w * 3;
+
+        own = ((y & 1) == job->redy) ? 0 : 2;
+        ng = (own == 0) ? job->redx : 1 - job->redx;
+
+        PsychDCVertNeighbours(&n, y, job->height, job->instride);
+        ou = n.u1 / job->instride * w;
+        od = n.d1 / job->instride * w;
+        inner = n;
+        inner.l1 = -1; inner.r1 = 1;
+
+        PsychDCHorzNeighbours(&n, 0, w);
+        PsychDCEdgeColorPixel(in, out, n, ou, od, ng == 0, own);
+        PsychDCHorzNeighbours(&n, w - 1, w);
+        PsychDCEdgeColorPixel(in + w - 1, out + 3 * (w - 1), n, ou, od, ((w - 1) & 1) == ng, own);
+
+        for (x = 1; x + 1 < w - 1; x += 2) {
+            PsychDCEdgeColorPixel(in + x, out + 3 * x, inner, ou, od, ng == 1, own);
+            PsychDCEdgeColorPixel(in + x + 1, out + 3 * x + 3, inner, ou, od, ng == 0, own);
+        }
+
+        for (; x < w - 1; x++) PsychDCEdgeColorPixel(in + x, out + 3 * x, inner, ou, od, (x & 1) == ng, own);
+    }
+}
+
+// YUV -> RGB conversion with the same integer ITU-R BT.601 coefficients as libdc1394's own conversion:
+static inline void PsychDCYUVToRGB(int y, int u, int v, unsigned char* rgb)
+{
+    rgb[0] = PsychDCClampByte(y + ((v * 1436) >> 10));
+    rgb[1] = PsychDCClampByte(y - ((u * 352 + v * 731) >> 10));
+    rgb[2] = PsychDCClampByte(y + ((u * 1814) >> 10));
+}
+
+static void PsychDCYUV422Worker(void* context, psych_int64 begin, psych_int64 end)
+{
+    const PsychDCConvJob* job = (const PsychDCConvJob*) context;
+    const int w = job->width;
+    const int yo = (job->yuyv) ? 0 : 1;
+    const int co = 1 - yo;
+    int x, y;
+
+    for (y = (int) begin; y < (int) end; y++) {
+        const unsigned char* in = job->in + (size_t) y * job->instride;
+        unsigned char* out = job->out + (size_t) y * w * 3;
+        x = 0;
+
+        #ifdef PSYCH_VIDCAP_SSE2
+        {
+            // 8 pixels per iteration: The interleaved U/V pairs are exactly the layout needed by
+            // _mm_madd_epi16() to compute all chroma terms of each pixel pair in 32 bit precision:
+            const __m128i lowmask = _mm_set1_epi16(0x00ff);
+            const __m128i bias = _mm_set1_epi16(128);
+            const __m128i kr = _mm_set1_epi32(1436 << 16);
+            const __m128i kg = _mm_set1_epi32((731 << 16) | 352);
+            const __m128i kb = _mm_set1_epi32(1814);
+            __m128i yuv, luma, uv, ro, go, bo;
+            psych_uint8 r[16], g[16], b[16];
+            int i;
+
+            for (; x + 8 <= w; x += 8) {
+                yuv = _mm_loadu_si128((const __m128i*) (in + 2 * x));
+                luma = (job->yuyv) ? _mm_and_si128(yuv, lowmask) : _mm_srli_epi16(yuv, 8);
+                uv = _mm_sub_epi16((job->yuyv) ? _mm_srli_epi16(yuv, 8) : _mm_and_si128(yuv, lowmask), bias);
+
+                ro = _mm_srai_epi32(_mm_madd_epi16(uv, kr), 10);
+                go = _mm_srai_epi32(_mm_madd_epi16(uv, kg), 10);
+                bo = _mm_srai_epi32(_mm_madd_epi16(uv, kb), 10);
+
+                // Each chroma term applies to two neighbouring pixels:
+                ro = _mm_packs_epi32(ro, ro);
+                go = _mm_packs_epi32(go, go);
+                bo = _mm_packs_epi32(bo, bo);
+                _mm_storeu_si128((__m128i*) r, _mm_packus_epi16(_mm_add_epi16(luma, _mm_unpacklo_epi16(ro, ro)), luma));
+                _mm_storeu_si128((__m128i*) g, _mm_packus_epi16(_mm_sub_epi16(luma, _mm_unpacklo_epi16(go, go)), luma));
+                _mm_storeu_si128((__m128i*) b, _mm_packus_epi16(_mm_add_epi16(luma, _mm_unpacklo_epi16(bo, bo)), luma));
+
+                for (i = 0; i < 8; i++) {
+                    out[3 * (x + i) + 0] = r[i];
+                    out[3 * (x + i) + 1] = g[i];
+                    out[3 * (x + i) + 2] = b[i];
+                }
+            }
+        }
+        #endif
+
+        for (; x + 1 < w; x += 2) {
+            const unsigned char* p = in + 2 * x;
+            PsychDCYUVToRGB(p[yo], p[co] - 128, p[co + 2] - 128, out + 3 * x);
+            PsychDCYUVToRGB(p[yo + 2], p[co] - 128, p[co + 2] - 128, out + 3 * x + 3);
+        }
+    }
+}
+
+// YUV411 in IIDC byte order U Y0 Y1 V Y2 Y3, i.e., 6 bytes for 4 pixels:
+static void PsychDCYUV411Worker(void* context, psych_int64 begin, psych_int64 end)
+{
+    const PsychDCConvJob* job = (const PsychDCConvJob*) context;
+    const int w = job->width;
+    int x, y, u, v;
+
+    for (y = (int) begin; y < (int) end; y++) {
+        const unsigned char* p = job->in + (size_t) y * job->instride;
+        unsigned char* out = job->out + (size_t) y * w * 3;
+
+        for (x = 0; x + 3 < w; x += 4, p += 6) {
+            u = p[0] - 128;
+            v = p[3] - 128;
+            PsychDCYUVToRGB(p[1], u, v, out + 3 * x);
+            PsychDCYUVToRGB(p[2], u, v, out + 3 * x + 3);
+            PsychDCYUVToRGB(p[4], u, v, out + 3 * x + 6);
+            PsychDCYUVToRGB(p[5], u, v, out + 3 * x + 9);
+        }
+    }
+}
+
+// Convert a 8 bpc raw Bayer, YUV422 or YUV411 image of size 'width' x 'height' with a row stride of
+// 'instride' bytes into the RGB8 image 'out' via our own parallel kernels. Returns FALSE if this color
+// coding, Bayer filter pattern, debayer method or image width is not covered by them, so caller must use
+// libdc1394. The YUV kernels only handle whole macropixels, i.e., widths divisible by 2 for YUV422 and by
+// 4 for YUV411, as pixels left out would show stale content of recycled target buffers:
+static psych_bool PsychDCConvertToRGB8(const unsigned char* in, int width, int height, int instride, dc1394color_coding_t coding,
+                                       dc1394color_filter_t filter, dc1394bayer_method_t method, dc1394byte_order_t yuvorder,
+                                       unsigned char* out)
+{
+    PsychDCConvJob job;
+    psych_int64 grain = PSYCH_DCCONV_GRAINSIZE / ((width > 0) ? width : 1) + 1;
+
+    if ((width < 4) || (height < 4)) return(FALSE);
+
+    job.in = in;
+    job.out = out;
+    job.width = width;
+    job.height = height;
+    job.instride = instride;
+    job.yuyv = (yuvorder == DC1394_BYTE_ORDER_YUYV) ? TRUE : FALSE;
+
+    switch (coding) {
+        case DC1394_COLOR_CODING_RAW8:
+        case DC1394_COLOR_CODING_MONO8:
+            if ((method != DC1394_BAYER_METHOD_BILINEAR) && (method != DC1394_BAYER_METHOD_EDGESENSE)) return(FALSE);
+
+            switch (filter) {
+                case DC1394_COLOR_FILTER_RGGB: job.redx = 0; job.redy = 0; break;
+                case DC1394_COLOR_FILTER_GBRG: job.redx = 0; job.redy = 1; break;
+                case DC1394_COLOR_FILTER_GRBG: job.redx = 1; job.redy = 0; break;
+                case DC1394_COLOR_FILTER_BGGR: job.redx = 1; job.redy = 1; break;
+                default: return(FALSE);
+            }
+
+            if (method == DC1394_BAYER_METHOD_BILINEAR) {
+                PsychThreadPoolParallelFor((psych_int64) height, grain, PsychDCBilinearWorker, &job);
+            }
+            else {
+                PsychThreadPoolParallelFor((psych_int64) height, grain, PsychDCEdgeGreenWorker, &job);
+                PsychThreadPoolParallelFor((psych_int64) height, grain, PsychDCEdgeColorWorker, &job);
+            }
+            break;
+
+        case DC1394_COLOR_CODING_YUV422:
+            if (width & 1) return(FALSE);
+            PsychThreadPoolParallelFor((psych_int64) height, grain, PsychDCYUV422Worker, &job);
+            break;
+
+        case DC1394_COLOR_CODING_YUV411:
+            if (width & 3) return(FALSE);
+            PsychThreadPoolParallelFor((psych_int64) height, grain, PsychDCYUV411Worker, &job);
+            break;
+
+        default:
+            return(FALSE);
+    }
+
+    return(TRUE);
+}
+
 // Helper function: Convert image from dc1394 engine into final color format. Apply YUV->RGB colorspace
-// conversion or debayering if neccessary:
-static unsigned char* PsychDCPreprocessFrame(PsychVidcapRecordType* capdev)
+// conversion or debayering if neccessary. If our own kernels can do the conversion and a 'target' buffer
+// is provided, the converted image is written directly into 'target', otherwise into a scratch buffer:
+static unsigned char* PsychDCPreprocessFrame(PsychVidcapRecordType* capdev, unsigned char* target)
 {
     dc1394error_t error;
     int capturehandle = capdev->capturehandle;
+    size_t count;
 
     // input_image points to the image buffer in our cam:
     unsigned char* input_image = (unsigned char*) (capdev->frame->image);
@@ -1290,7 +1649,27 @@ static unsigned char* PsychDCPreprocessFrame(PsychVidcapRecordType* capdev)
             if (capdev->frame->color_filter < DC1394_COLOR_FILTER_MIN || capdev->frame->color_filter > DC1394_COLOR_FILTER_MAX) {
                 capdev->frame->color_filter = capdev->color_filter_override;
             }
+        }
+
+        // Prefer our own multi-threaded conversion for the common 8 bpc cases:
+        if (!target) {
+            count = (size_t) capdev->frame->size[0] * capdev->frame->size[1] * 3;
+            if (capdev->convframe->allocated_image_bytes < count) {
+                free(capdev->convframe->image);
+                capdev->convframe->image = (unsigned char*) malloc(count);
+                capdev->convframe->allocated_image_bytes = count;
+            }
+
+            target = capdev->convframe->image;
+        }
 
+        if (PsychDCConvertToRGB8(input_image, (int) capdev->frame->size[0], (int) capdev->frame->size[1], (int) capdev->frame->stride,
+                                 capdev->colormode, capdev->frame->color_filter, capdev->debayer_method, capdev->frame->yuv_byte_order, target)) {
+            // Success: Point to converted image:
+            input_image = target;
+        }
+        else if (capdev->colormode == DC1394_COLOR_CODING_RAW8 || capdev->colormode == DC1394_COLOR_CODING_MONO8 ||
+                 capdev->colormode == DC1394_COLOR_CODING_RAW16 || capdev->colormode == DC1394_COLOR_CODING_MONO16) {
             // Trigger bayer filtering for debayering via 'method':
             if (DC1394_SUCCESS != (error = dc1394_debayer_frames(capdev->frame, capdev->convframe, capdev->debayer_method))) {
                 printf("PTB-WARNING: Debayering of raw sensor image data failed! %s\n", dc1394_error_get_string(error));
@@ -1309,6 +1688,9 @@ static unsigned char* PsychDCPreprocessFrame(PsychVidcapRecordType* capdev)
                 printf("PTB-ERROR: Bayer filtering of video frame failed.\n");
                 return(NULL);
             }
+
+            // Success: Point to decoded image buffer:
+            input_image = (unsigned char*) capdev->convframe->image;
         }
         else {
             // Input data is in YUV format. Convert into RGB8:
@@ -1318,10 +1700,10 @@ static unsigned char* PsychDCPreprocessFrame(PsychVidcapRecordType* capdev)
                 printf("PTB-ERROR: Colorspace conversion of video frame failed.\n");
                 return(NULL);
             }
-        }
 
-        // Success: Point to decoded image buffer:
-        input_image = (unsigned char*) capdev->convframe->image;
+            // Success: Point to decoded image buffer:
+            input_image = (unsigned char*) capdev->convframe->image;
+        }
     }
 
     // Is a special markertracker plugin loaded for this camera? If so, execute it on this frame:
@@ -1477,12 +1859,15 @@ static void* PsychDCRecorderThreadMain(void* capdevToCast)
     double tstart, tend;
     dc1394error_t error;
     unsigned char* input_image = NULL;
+    unsigned char* target;
 
     // Get a pointer to our associated capture device:
     PsychVidcapRecordType* capdev = (PsychVidcapRecordType*) capdevToCast;
+    unsigned int count = (capdev->width * capdev->height * ((capdev->actuallayers == 3) ? 3 : 1) * ((capdev->bitdepth > 8) ? 2 : 1));
 
     // Assign a name to ourselves, for debugging:
     PsychSetThreadName("ScreenDC1394Rec");
+    PsychAssignThreadToCoreSet("ScreenDC1394Rec", kPsychThreadClassRealtime);
 
     // We are running at elevated realtime priority. Enter the while loop
     // which waits for new video frames from libDC1394 and pushes them into
@@ -1550,8 +1935,21 @@ static void* PsychDCRecorderThreadMain(void* capdevToCast)
             capdev->current_pts = tstart;
             PsychDCUpdateCameraFrameTimestamp(capdev);
 
+            // Provide new frame to masterthread / usercode in the "current frame" buffer if low-latency mode is active
+            // and frame delivery isn't disabled. Reuse the previous buffer if it wasn't fetched by the masterthread by
+            // now, or the buffer of the last fetched frame, and let debayering or color conversion write into it directly:
+            target = NULL;
+            if (capdev->dropframes && !(capdev->recordingflags & 4)) {
+                if (!capdev->current_frame) {
+                    capdev->current_frame = (capdev->spare_frame) ? capdev->spare_frame : (unsigned char*) malloc(count);
+                    capdev->spare_frame = NULL;
+                }
+
+                target = capdev->current_frame;
+            }
+
             // Perform potential processing on image, e.g., debayering:
-            input_image = PsychDCPreprocessFrame(capdev);
+            input_image = PsychDCPreprocessFrame(capdev, target);
             if (NULL == input_image) {
                 printf("PTB-ERROR: Bayer filtering or color space conversion of video frame in video recorder thread failed. Aborting recorder thread.\n");
                 break;
@@ -1563,22 +1961,8 @@ static void* PsychDCRecorderThreadMain(void* capdevToCast)
                 if (!PsychDCPushFrameToMovie(capdev, (psych_uint16*) input_image, capdev->current_pts, FALSE)) break;
             }
 
-            // Provide new frame to masterthread / usercode, if frame delivery isn't disabled:
-            if (!(capdev->recordingflags & 4)) {
-                // Copy frame to "current frame" buffer if low-latency mode is active:
-                if (capdev->dropframes) {
-                    unsigned int count = (capdev->width * capdev->height * ((capdev->actuallayers == 3) ? 3 : 1) * ((capdev->bitdepth > 8) ? 2 : 1));
-
-                    // Release previous one, if not fetched by now by masterthread:
-                    if (capdev->current_frame) free(capdev->current_frame);
-
-                    // Allocate target buffer for most recent captured frame from video recorder thread:
-                    capdev->current_frame = (unsigned char*) malloc(count);
-
-                    // Copy image into it:
-                    memcpy(capdev->current_frame, input_image, count);
-                }
-            }
+            // Copy frame to "current frame" buffer, unless it was already converted into it:
+            if (target && (input_image != target)) memcpy(target, input_image, count);
 
             // Signal availability of new video frame: This is not only important for frame fetching on the master thread,
             // but also for slave cameras recorderThreads if multi-cam synchronization is enabled:
@@ -2218,6 +2602,9 @@ int PsychDCVideoCaptureRate(int capturehandle, double capturerate, int dropframe
             if (capdev->current_frame) free(capdev->current_frame);
             capdev->current_frame = NULL;
 
+            if (capdev->spare_frame) free(capdev->spare_frame);
+            capdev->spare_frame = NULL;
+
             // No frame ready anymore:
             capdev->frame_ready = 0;
 
@@ -2271,10 +2658,7 @@ int PsychDCGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
                                  PsychWindowRecordType *out_texture, double *presentation_timestamp, double* summed_intensity, rawcapimgdata* outrawbuffer)
 {
     int w, h;
-    psych_uint64 intensity = 0;
     unsigned int count, i;
-    unsigned char* pixptr;
-    psych_uint16* pixptrs;
     psych_bool frame_ready;
     double tstart, tend;
     dc1394error_t error;
@@ -2552,7 +2936,7 @@ int PsychDCGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
     // Synchronous frame fetch on masterthread?
     if (!(capdev->recordingflags & 16)) {
         // Yes. Do pre-processing of frame:
-        input_image = PsychDCPreprocessFrame(capdev);
+        input_image = PsychDCPreprocessFrame(capdev, NULL);
         if (NULL == input_image) PsychErrorExitMsg(PsychError_system, "Bayer filtering or color space conversion of video frame failed.");
     }
     else {
@@ -2640,20 +3024,11 @@ int PsychDCGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         // Ready to use the texture...
     }
 
-    // Sum of pixel intensities requested? 8 bpc?
-    if (summed_intensity && (capdev->bitdepth <= 8)) {
-        pixptr = (unsigned char*) input_image;
-        count = (w*h*((capdev->actuallayers == 3) ? 3 : 1));
-        for (i=0; i<count; i++) intensity+=(psych_uint64) pixptr[i];
-        *summed_intensity = ((double) intensity) / w / h / ((capdev->actuallayers == 3) ? 3 : 1) / 255;
-    }
-
-    // Sum of pixel intensities requested? 16 bpc?
-    if (summed_intensity && (capdev->bitdepth > 8)) {
-        pixptrs = (psych_uint16*) input_image;
+    // Sum of pixel intensities requested? 8 bpc or 16 bpc?
+    if (summed_intensity) {
         count = (w*h*((capdev->actuallayers == 3) ? 3 : 1));
-        for (i=0; i<count; i++) intensity+=(psych_uint64) pixptrs[i];
-        *summed_intensity = ((double) intensity) / w / h / ((capdev->actuallayers == 3) ? 3 : 1) / ((1 << (capdev->bitdepth)) - 1);
+        *summed_intensity = ((double) PsychSumCapturedPixels(input_image, count, capdev->bitdepth)) / w / h / ((capdev->actuallayers == 3) ? 3 : 1) /
+                            ((capdev->bitdepth > 8) ? ((1 << (capdev->bitdepth)) - 1) : 255);
     }
 
     // Raw data requested?
@@ -2701,7 +3076,16 @@ int PsychDCGetTextureFromCapture(PsychWindowRecordType *win, int capturehandle,
         capdev->current_dropped = 0;
     }
 
-    // Release cached frame buffer, if any:
+    // Release cached frame buffer, if any. In low-latency mode, hand it back to the video recorder thread for reuse:
+    if (capdev->pulled_frame && (capdev->recordingflags & 16) && capdev->dropframes) {
+        PsychLockMutex(&capdev->mutex);
+        if (!capdev->spare_frame) {
+            capdev->spare_frame = capdev->pulled_frame;
+            capdev->pulled_frame = NULL;
+        }
+        PsychUnlockMutex(&capdev->mutex);
+    }
+
     if (capdev->pulled_frame) free(capdev->pulled_frame);
     capdev->pulled_frame = NULL;
 
@@ -3788,6 +4172,16 @@ unsigned char* PsychDCDebayerFrame(unsigned char* inBayerImage, unsigned int wid
     dc1394video_frame_t inFrame, outFrame;
     unsigned char* outImage;
 
+    // Use our own multi-threaded debayering if possible:
+    if (bitdepth <= 8) {
+        outImage = (unsigned char*) malloc((size_t) width * height * 3);
+        if (PsychDCConvertToRGB8(inBayerImage, (int) width, (int) height, (int) width, DC1394_COLOR_CODING_RAW8, global_color_filter,
+                                 global_debayer_method, DC1394_BYTE_ORDER_UYVY, outImage))
+            return(outImage);
+
+        free(outImage);
+    }
+
     memset(&inFrame, 0, sizeof(dc1394video_frame_t));
     memset(&outFrame, 0, sizeof(dc1394video_frame_t));
 
@@ -1867,6 +1867,21 @@ void PsychCloseWindow(PsychWindowRecordType *windowRecord)
         // Make sure that OpenGL pipeline is done & idle for this window:
         PsychSetGLContext(windowRecord);
 
+        // Release pixel buffers for asynchronous texture uploads:
+        PsychReleaseTextureUploadBuffers(windowRecord);
+
+        #ifdef PTB_USE_GSTREAMER
+        // Switch movies and video capture devices which decode directly into pixel buffers of this window back to regular buffers:
+        PsychReleaseUploadPools(windowRecord);
+        #endif
+
+        // Add pending asynchronously read back movie frames to their movies, release readback buffers:
+        PsychFinishAsyncReadbacks(windowRecord, -1);
+
+        // Release streaming vertex buffer for batched 2D drawing:
+        if (windowRecord->primitiveBatchVBO) glDeleteBuffers(1, &windowRecord->primitiveBatchVBO);
+        windowRecord->primitiveBatchVBO = 0;
+
         // Execute hook chain for OpenGL related shutdown:
         PsychPipelineExecuteHook(windowRecord, kPsychCloseWindowPreGLShutdown, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
 
@@ -2299,6 +2314,7 @@ void PsychTriggerShutterGoggles(PsychWindowRecordType *windowRecord, int viewid)
 void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
 {
     PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+    PsychFlipQueueItem* item;
     int rc;
     static unsigned int recursionlevel = 0;
 
@@ -2317,6 +2333,14 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
             // If no recursion and flipper thread not in error state it might be safe to try a normal shutdown:
             if (recursionlevel == 0 && flipRequest->flipperState < 4) {
                 // Operation in progress: Try to stop it the normal way...
+
+                // Don't wait for a whole pending flip queue to play out, stop after the current frame:
+                if (flipRequest->flipQueue) {
+                    PsychLockMutex(&(flipRequest->flipQueueLock));
+                    flipRequest->flipQueueAbort = TRUE;
+                    PsychUnlockMutex(&(flipRequest->flipQueueLock));
+                }
+
                 flipRequest->opmode = 2;
                 recursionlevel++;
                 PsychFlipWindowBuffersIndirect(windowRecord);
@@ -2402,6 +2426,27 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
         // At this point, the thread and all other async flip resources have been terminated and released.
     }
 
+    // Release flip queue, if it was ever used:
+    if (flipRequest->flipQueue) {
+        // Delete the fences of all queued frames which never got presented. The flipper thread is gone,
+        // so they are ours now:
+        for (; flipRequest->flipQueueHead != flipRequest->flipQueueTail; flipRequest->flipQueueHead++) {
+            item = &(flipRequest->flipQueue[flipRequest->flipQueueHead % kPsychFlipQueueSize]);
+            if (item->fence) {
+                PsychSetGLContext(windowRecord);
+                glDeleteSync(item->fence);
+                item->fence = NULL;
+            }
+        }
+
+        if ((rc=PsychDestroyMutex(&(flipRequest->flipQueueLock)))) {
+            printf("PTB-WARNING: In PsychReleaseFlipInfoStruct: Could not destroy flipQueueLock mutex lock [%s].\n", strerror(rc));
+        }
+
+        free(flipRequest->flipQueue);
+        flipRequest->flipQueue = NULL;
+    }
+
     // Release struct:
     free(flipRequest);
     windowRecord->flipInfo = NULL;
@@ -2410,6 +2455,77 @@ void PsychReleaseFlipInfoStruct(PsychWindowRecordType *windowRecord)
     return;
 }
 
+/* PsychFlipperPresentFlipQueue() -- Present all frames of the flip queue back-to-back.
+*
+* Called by the flipper thread instead of a single PsychFlipWindowBuffers() for opmode 4 requests
+* from Screen('AsyncFlipQueue'). Takes frames from the head of windowRecord->flipInfo->flipQueue,
+* blits each frame texture into the system backbuffer and flips it at its deadline, storing the
+* flip results in the queue item. The master thread can append new frames while we present, so
+* the queue indices are only accessed under the flipQueueLock. Returns when the queue runs empty
+* or presentation got aborted, with flipQueueState set to 2 == finished.
+*
+* Like all code on the flipper thread, this must not print, allocate memory or error-abort.
+*/
+static void PsychFlipperPresentFlipQueue(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+    PsychFlipQueueItem* item;
+    int width = (int) PsychGetWidthFromRect(windowRecord->rect);
+    int height = (int) PsychGetHeightFromRect(windowRecord->rect);
+    double when;
+
+    while (TRUE) {
+        // Fetch next frame, or finish if there isn't any:
+        PsychLockMutex(&(flipRequest->flipQueueLock));
+        if ((flipRequest->flipQueueHead == flipRequest->flipQueueTail) || flipRequest->flipQueueAbort) {
+            flipRequest->flipQueueState = 2;
+            PsychUnlockMutex(&(flipRequest->flipQueueLock));
+            break;
+        }
+
+        item = &(flipRequest->flipQueue[flipRequest->flipQueueHead % kPsychFlipQueueSize]);
+        PsychUnlockMutex(&(flipRequest->flipQueueLock));
+
+        // Make the GPU wait for completion of the rendering of the frame on the master thread:
+        if (item->fence) {
+            glWaitSync(item->fence, 0, GL_TIMEOUT_IGNORED);
+            glDeleteSync(item->fence);
+            item->fence = NULL;
+        }
+
+        // Blit frame texture into the backbuffer, scaling it to the window size if needed:
+        if (flipRequest->flipQueueFBO == 0) glGenFramebuffersEXT(1, &(flipRequest->flipQueueFBO));
+        glBindFramebufferEXT(GL_READ_FRAMEBUFFER_EXT, flipRequest->flipQueueFBO);
+        glFramebufferTexture2DEXT(GL_READ_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, item->textureTarget, item->textureNumber, 0);
+        glBindFramebufferEXT(GL_DRAW_FRAMEBUFFER_EXT, 0);
+        glDrawBuffer(GL_BACK);
+        glBlitFramebufferEXT(0, 0, item->width, item->height, 0, 0, width, height, GL_COLOR_BUFFER_BIT,
+                             ((item->width == width) && (item->height == height)) ? GL_NEAREST : GL_LINEAR);
+        glFramebufferTexture2DEXT(GL_READ_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, item->textureTarget, 0, 0);
+        glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+
+        // Negative deadlines are relative to the previous flip: Aim for the middle of the refresh cycle before the target vblank:
+        when = item->flipwhen;
+        if (when < 0) when = windowRecord->time_at_last_vbl + (-when - 0.5) * windowRecord->VideoRefreshInterval;
+
+        // Flip without touching the backbuffer afterwards, as the next frame will overwrite it:
+        item->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, 0, 0, 2, when, &(item->beamPosAtFlip), &(item->miss_estimate), &(item->time_at_flipend), &(item->time_at_onset));
+
+        // Results of the most recent frame are also the results of the whole async flip operation:
+        flipRequest->vbl_timestamp = item->vbl_timestamp;
+        flipRequest->beamPosAtFlip = item->beamPosAtFlip;
+        flipRequest->miss_estimate = item->miss_estimate;
+        flipRequest->time_at_flipend = item->time_at_flipend;
+        flipRequest->time_at_onset = item->time_at_onset;
+
+        PsychLockMutex(&(flipRequest->flipQueueLock));
+        flipRequest->flipQueueHead++;
+        PsychUnlockMutex(&(flipRequest->flipQueueLock));
+    }
+
+    return;
+}
+
 /* PsychFlipperThreadMain() the "main()" routine of the asynchronous flip worker thread:
 *
 * This routine implements an infinite loop (well, infinite until cancellation at Screen('Close')
@@ -2459,6 +2575,7 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
 
     // Assign a name to ourselves, for debugging:
     PsychSetThreadName("ScreenFlipper");
+    PsychAssignThreadToCoreSet("ScreenFlipper", kPsychThreadClassRealtime);
 
     // Try to lock, block until available if not available:
     if ((rc=PsychLockMutex(&(flipRequest->performFlipLock)))) {
@@ -2584,8 +2701,14 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
 
             // Nothing more to do, the system backbuffer is bound, no FBO's are set at this point.
 
-            // Unpack struct and execute synchronous flip: Synchronous in our thread, asynchronous from Matlabs/Octaves perspective!
-            flipRequest->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, flipRequest->multiflip, flipRequest->vbl_synclevel, flipRequest->dont_clear, flipRequest->flipwhen, &(flipRequest->beamPosAtFlip), &(flipRequest->miss_estimate), &(flipRequest->time_at_flipend), &(flipRequest->time_at_onset));
+            if (flipRequest->opmode == 4) {
+                // Present all frames of the flip queue, one after the other:
+                PsychFlipperPresentFlipQueue(windowRecord);
+            }
+            else {
+                // Unpack struct and execute synchronous flip: Synchronous in our thread, asynchronous from Matlabs/Octaves perspective!
+                flipRequest->vbl_timestamp = PsychFlipWindowBuffers(windowRecord, flipRequest->multiflip, flipRequest->vbl_synclevel, flipRequest->dont_clear, flipRequest->flipwhen, &(flipRequest->beamPosAtFlip), &(flipRequest->miss_estimate), &(flipRequest->time_at_flipend), &(flipRequest->time_at_onset));
+            }
 
             // Flip finished and struct filled with return arguments.
             // Set our state to 3 aka "flip operation finished, ready for new commands":
@@ -2787,6 +2910,12 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
 
     // Exit path from thread at thread termination...
 
+    // Release our flip queue FBO, if any, while our context is still bound:
+    if (flipRequest->flipQueueFBO) {
+        glDeleteFramebuffersEXT(1, &(flipRequest->flipQueueFBO));
+        flipRequest->flipQueueFBO = 0;
+    }
+
     // Make sure our thread detaches from its private OpenGL context before it dies:
     PsychOSUnsetGLContext(windowRecord);
 
@@ -2829,7 +2958,8 @@ void* PsychFlipperThreadMain(void* windowRecordToCast)
  *    shall be returned, as well as the datastructures for thread/mutex/cond locking etc...
  *
  *    flipRequest->opmode can be one of:
- *    0 = Execute Synchronous flip, 1 = Start async flip, 2 = Finish async flip, 3 = Poll for finish of async flip.
+ *    0 = Execute Synchronous flip, 1 = Start async flip, 2 = Finish async flip, 3 = Poll for finish of async flip,
+ *    4 = Start async presentation of the flip queue, see SCREENAsyncFlipQueue.c. Finished like an async flip.
  *
  *    *   Synchronous flips are performed without changing the mutex lock flipRequest->performFlipLock. We check if
  *        there are not flip ops scheduled or executing for the window, then simply execute the flip and return its
@@ -2897,10 +3027,13 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
     }
 
     // Asynchronous flip mode, either request to trigger one or request to finalize one:
-    if ((flipRequest->opmode == 1) || ((flipRequest->opmode == 0) && (windowRecord->stereomode == kPsychFrameSequentialStereo))) {
+    if ((flipRequest->opmode == 1) || (flipRequest->opmode == 4) || ((flipRequest->opmode == 0) && (windowRecord->stereomode == kPsychFrameSequentialStereo))) {
         // Async flip start request, or a sync flip turned into an async flip due to kPsychFrameSequentialStereo:
         if (flipRequest->asyncstate != 0) PsychErrorExitMsg(PsychError_internal, "Tried to invoke asynchronous flip while flip still in progress!");
 
+        // Only opmode 4 async flips present the flip queue:
+        if (flipRequest->opmode != 4) flipRequest->flipQueueState = 0;
+
         // Current multiflip > 0 implementation is not thread-safe, so we don't support this:
         if (flipRequest->multiflip != 0) PsychErrorExitMsg(PsychError_user, "Using a non-zero 'multiflip' flag while starting an asynchronous flip! This is forbidden! Aborted.\n");
 
@@ -3098,7 +3231,7 @@ psych_bool PsychFlipWindowBuffersIndirect(PsychWindowRecordType *windowRecord)
 
         // Done, unless this wasn't a real async flip. If this was a pseudo-sync-flip,
         // we fall through to finalization stage:
-        if (flipRequest->opmode == 1) {
+        if ((flipRequest->opmode == 1) || (flipRequest->opmode == 4)) {
             // Was an async-flip begin: We´re done:
             return(TRUE);
         }
@@ -3322,6 +3455,8 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     int i;
     int numWindows=0;
     int verbosity;
+    double tTraceFlip = PsychTraceTimestamp();  // Start of flip, if event tracing is enabled.
+    double tTrace;                              // Start of individual flip phases for tracing.
 
     // Assign level of verbosity:
     verbosity = PsychPrefStateGet_Verbosity();
@@ -3384,7 +3519,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
     // and special compositing operations for specific stereo algorithms...
     // These are not thread-safe! For async flip, this gets called in async flip start
     // while still on the main thread, so this call here turns into a no-op:
+    tTrace = PsychTraceTimestamp();
     PsychPreFlipOperations(windowRecord, dont_clear);
+    PsychTraceComplete("Flip:PreFlipOperations", tTrace);
 
     // Special imaging mode active? in that case a FBO may be bound instead of the system framebuffer.
     if (windowRecord->imagingMode > 0) {
@@ -3649,7 +3786,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
                 // We'll sleep - and hope that the OS will wake us up in time, if the remaining waiting
                 // time is more than 0 milliseconds. This way, we don't burn up valuable CPU cycles by
                 // busy waiting and don't get punished by the overload detection of the OS:
+                tTrace = PsychTraceTimestamp();
                 PsychWaitUntilSeconds(flipwhen);
+                PsychTraceComplete("Flip:WaitForDeadline", tTrace);
             }
         }
         // At this point, we are less than one video refresh interval away from the deadline - the next
@@ -3712,6 +3851,7 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
 
     // Take preswap timestamp:
     PsychGetAdjustedPrecisionTimerSeconds(&time_at_swaprequest);
+    tTrace = PsychTraceTimestamp();
 
     // Execute the hookchain for non-OpenGL operations that need to happen immediately before the bufferswap, e.g.,
     // sending out control signals or commands to external hardware to somehow sync it up to imminent bufferswaps:
@@ -3812,6 +3952,7 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
 
     // Take postswap request timestamp:
     PsychGetAdjustedPrecisionTimerSeconds(&time_post_swaprequest);
+    PsychTraceComplete("Flip:SwapRequest", tTrace);
 
     // Store timestamp of swaprequest submission:
     windowRecord->time_at_swaprequest = time_at_swaprequest;
@@ -3823,6 +3964,8 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
 
     // Pause execution of application until start of VBL, if requested:
     if (sync_to_vbl) {
+        tTrace = PsychTraceTimestamp();
+
         // Init tSwapComplete to undefined:
         tSwapComplete = 0;
         swap_msc = -1;
@@ -4404,6 +4547,7 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         }
 
         // Timestamping finished, final results available!
+        PsychTraceComplete("Flip:WaitForSwapCompletion", tTrace);
 
         // Check for missed / skipped frames: We exclude the very first "Flip" after
         // creation of the onscreen window from the check, as deadline-miss is expected
@@ -4412,11 +4556,13 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
         if ((time_at_vbl > tshouldflip) && (windowRecord->time_at_last_vbl!=0) && (windowRecord->stereomode != kPsychFrameSequentialStereo)) {
             // Deadline missed!
             windowRecord->nr_missed_deadlines = windowRecord->nr_missed_deadlines + 1;
+            PsychTraceInstant("Flip:DeadlineMissed");
         }
 
         // Return some estimate of how much we've missed our deadline (positive value) or
         // how much headroom was left (negative value):
         *miss_estimate = time_at_vbl - tshouldflip;
+        PsychTraceCounter("Flip:MissEstimateMsecs", *miss_estimate * 1000.0);
 
         // Update timestamp of last vbl:
         windowRecord->time_at_last_vbl = time_at_vbl;
@@ -4480,7 +4626,9 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
 
     // The remaining code will run asynchronously on the GPU again and prepares the back-buffer
     // for drawing of next stim.
+    tTrace = PsychTraceTimestamp();
     PsychPostFlipOperations(windowRecord, dont_clear);
+    PsychTraceComplete("Flip:PostFlipOperations", tTrace);
 
     // Special imaging mode active? in that case we need to restore drawing engine state to preflip state.
     if (windowRecord->imagingMode > 0) {
@@ -4547,6 +4695,7 @@ double PsychFlipWindowBuffers(PsychWindowRecordType *windowRecord, int multiflip
 
     // We take a second timestamp here to mark the end of the Flip-routine and return it to "userspace"
     PsychGetAdjustedPrecisionTimerSeconds(time_at_flipend);
+    PsychTraceComplete("PsychFlipWindowBuffers", tTraceFlip);
 
     // Done. Return high resolution system time in seconds when VBL happened.
     return(time_at_vbl);
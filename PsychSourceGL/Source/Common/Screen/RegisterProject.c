@@ -198,6 +198,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("AsyncFlipEnd", &SCREENFlip));
     PsychErrorExit(PsychRegister("AsyncFlipCheckEnd", &SCREENFlip));
     PsychErrorExit(PsychRegister("WaitUntilAsyncFlipCertain" , &SCREENWaitUntilAsyncFlipCertain));
+    PsychErrorExit(PsychRegister("AsyncFlipQueue", &SCREENAsyncFlipQueue));
     PsychErrorExit(PsychRegister("FillRect", &SCREENFillRect));
     PsychErrorExit(PsychRegister("GetImage", &SCREENGetImage));
     PsychErrorExit(PsychRegister("PutImage", &SCREENPutImage));
@@ -224,6 +225,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("TextFont", &SCREENTextFont));
     PsychErrorExit(PsychRegister("TextBounds", &SCREENTextBounds));
     PsychErrorExit(PsychRegister("DrawText", &SCREENDrawText));
+    PsychErrorExit(PsychRegister("DrawTexts", &SCREENDrawTexts));
     PsychErrorExit(PsychRegister("TextColor", &SCREENTextColor));
     PsychErrorExit(PsychRegister("Preference", &SCREENPreference));
     PsychErrorExit(PsychRegister("MakeTexture", &SCREENMakeTexture));
@@ -251,6 +253,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("SetMovieTimeIndex", &SCREENSetMovieTimeIndex));
     PsychErrorExit(PsychRegister("GetMovieTimeIndex", &SCREENGetMovieTimeIndex));
     PsychErrorExit(PsychRegister("GetMovieImage", &SCREENGetMovieImage));
+    PsychErrorExit(PsychRegister("GetMovieStats", &SCREENGetMovieStats));
     PsychErrorExit(PsychRegister("glPushMatrix", &SCREENglPushMatrix));
     PsychErrorExit(PsychRegister("glPopMatrix", &SCREENglPopMatrix));
     PsychErrorExit(PsychRegister("glLoadIdentity", &SCREENglLoadIdentity));
@@ -272,6 +275,7 @@ PsychError PsychModuleInit(void)
     PsychErrorExit(PsychRegister("StartVideoCapture", &SCREENStartVideoCapture));
     PsychErrorExit(PsychRegister("StopVideoCapture", &SCREENStopVideoCapture));
     PsychErrorExit(PsychRegister("GetCapturedImage", &SCREENGetCapturedImage));
+    PsychErrorExit(PsychRegister("GetCapturedFrames", &SCREENGetCapturedFrames));
     PsychErrorExit(PsychRegister("SetVideoCaptureParameter", &SCREENSetVideoCaptureParameter));
     PsychErrorExit(PsychRegister("VideoCaptureDevices", &SCREENVideoCaptureDevices));
     PsychErrorExit(PsychRegister("LoadCLUT", &SCREENLoadCLUT));
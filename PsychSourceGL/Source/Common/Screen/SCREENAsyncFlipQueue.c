@@ -0,0 +1,292 @@
+/*
+  SCREENAsyncFlipQueue.c
+
+  PLATFORMS:    All
+
+  DESCRIPTION:
+
+  Queue a sequence of prerendered frames for back-to-back presentation by the
+  asynchronous flip thread of an onscreen window, and retrieve the flip timestamps
+  of all presented frames in bulk.
+
+  The queue is a ring buffer in the PsychFlipInfoStruct of the window. The master
+  thread appends frames at the tail, the flipper thread presents them from the head
+  in PsychFlipperPresentFlipQueue(), see PsychWindowSupport.c. Presentation runs as
+  an opmode 4 async flip, so it is finalized by the regular async flip machinery.
+
+*/
+
+#include "Screen.h"
+
+static char useString[] = "[ret1, ret2] = Screen('AsyncFlipQueue', windowPtr, subcommand [, textures] [, when]);";
+//                          1     2                                 1          2              3            4
+static char synopsisString[] =
+    "Present a queue of prerendered frames on onscreen window 'windowPtr' via the asynchronous flip thread.\n\n"
+    "This allows to show a sequence of prerendered stimulus images back-to-back, with one frame per video refresh "
+    "cycle if so desired, without your script having to call Screen('Flip') for each frame in time. Your script "
+    "can append new frames while the queue is being presented, and later collect the flip timestamps of all "
+    "presented frames at once.\n"
+    "Frames are textures or offscreen windows, which get blitted to the full window area by the flip thread, "
+    "scaled to the size of the window if their size differs. Textures must not be closed before they got "
+    "presented! The following subcommands are supported:\n\n"
+    "pending = Screen('AsyncFlipQueue', windowPtr, 'Append', textures [, when]);\n"
+    "Append the textures with the handles given in vector 'textures' to the queue, in the given order. 'when' "
+    "is the presentation deadline for the frames, either a scalar for all frames, or a vector with one value "
+    "per frame. A value >= 0 is an absolute target time, as for Screen('Flip'), a negative value -n asks for "
+    "presentation n video refresh cycles after the preceding frame. The default is -1, ie. one frame per "
+    "refresh cycle. Presentation starts immediately if it isn't running already. Returns the number of frames "
+    "which are queued but not yet presented.\n\n"
+    "timestamps = Screen('AsyncFlipQueue', windowPtr, 'GetTimestamps');\n"
+    "Return the results of all frames presented since the last call, as a n-by-5 matrix with one row per "
+    "frame, in presentation order. The columns are [VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos], "
+    "as returned by Screen('Flip'). The rows are removed from the queue.\n\n"
+    "[pending, presented] = Screen('AsyncFlipQueue', windowPtr, 'Status');\n"
+    "Return the number of 'pending' frames still to be presented, and the number of 'presented' frames "
+    "whose timestamps have not yet been retrieved via 'GetTimestamps'.\n\n"
+    "Screen('AsyncFlipQueue', windowPtr, 'Wait');\n"
+    "Wait until all pending frames have been presented.\n\n"
+    "Screen('AsyncFlipQueue', windowPtr, 'Abort');\n"
+    "Stop presentation after the frame currently being flipped and discard all remaining pending frames.\n\n"
+    "While frames are being presented, an async flip is active on the window, with all restrictions explained "
+    "in 'Screen AsyncFlipBegin?'. Screen('AsyncFlipEnd') and Screen('AsyncFlipCheckEnd') wait for resp. poll for "
+    "the end of presentation and return the timestamps of the last presented frame. Drawing into textures or "
+    "offscreen windows while frames are being presented requires PsychImaging('AddTask', 'General', "
+    "'UseFastOffscreenWindows'). The flip queue can not be used with the full imaging pipeline enabled, with "
+    "frame-sequential stereo or with the legacy async flip implementation, and it needs support for "
+    "framebuffer blits.\n";
+
+static char seeAlsoString[] = "AsyncFlipBegin AsyncFlipEnd AsyncFlipCheckEnd Flip";
+
+// Finalize the async flip operation of a finished or aborted flip queue presentation:
+static void PsychFinalizeFlipQueue(PsychWindowRecordType *windowRecord)
+{
+    PsychFlipInfoStruct* flipRequest = windowRecord->flipInfo;
+
+    flipRequest->opmode = 2;
+    PsychFlipWindowBuffersIndirect(windowRecord);
+    flipRequest->asyncstate = 0;
+
+    // Execute hook chain for preparation of user space drawing ops, as in Screen('AsyncFlipEnd'):
+    PsychPipelineExecuteHook(windowRecord, kPsychUserspaceBufferDrawingPrepare, NULL, NULL, FALSE, FALSE, NULL, NULL, NULL, NULL);
+
+    // Reset flipwhen to "not assigned":
+    flipRequest->flipwhen = -DBL_MAX;
+}
+
+PsychError SCREENAsyncFlipQueue(void)
+{
+    PsychWindowRecordType *windowRecord, *textureRecord;
+    PsychFlipInfoStruct* flipRequest;
+    PsychFlipQueueItem* item;
+    char *cmd;
+    double *textures, *whens, *timestamps;
+    int m, n, p, nwhen, i, count;
+    unsigned int pending, presented;
+
+    // All sub functions should have these two lines:
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(4));
+    PsychErrorExit(PsychRequireNumInputArgs(2));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    PsychAllocInWindowRecordArg(1, kPsychArgRequired, &windowRecord);
+    if (!PsychIsOnscreenWindow(windowRecord) || (windowRecord->windowType != kPsychDoubleBufferOnscreen))
+        PsychErrorExitMsg(PsychError_user, "'AsyncFlipQueue' called on something else than a double-buffered onscreen window.");
+
+    PsychAllocInCharArg(2, kPsychArgRequired, &cmd);
+
+    flipRequest = windowRecord->flipInfo;
+    if (NULL == flipRequest) PsychErrorExitMsg(PsychError_internal, "NULL-Ptr for 'flipInfo' field of onscreen window in 'AsyncFlipQueue'!");
+
+    if (PsychMatch(cmd, "Append")) {
+        // Child protection:
+        if (windowRecord->stereomode == kPsychFrameSequentialStereo)
+            PsychErrorExitMsg(PsychError_user, "'AsyncFlipQueue' can not be used with frame-sequential stereo mode.");
+
+        if (PsychPrefStateGet_ConserveVRAM() & kPsychUseOldStyleAsyncFlips)
+            PsychErrorExitMsg(PsychError_user, "'AsyncFlipQueue' can not be used while Screen('Preference', 'ConserveVRAM') setting kPsychUseOldStyleAsyncFlips is set.");
+
+        if (windowRecord->imagingMode & kPsychNeedFastBackingStore)
+            PsychErrorExitMsg(PsychError_user, "'AsyncFlipQueue' can not be used with the imaging pipeline enabled, as queued frames would bypass it.");
+
+        if (NULL == glBlitFramebufferEXT)
+            PsychErrorExitMsg(PsychError_user, "'AsyncFlipQueue' needs support for framebuffer blits (GL_EXT_framebuffer_blit), which your graphics driver lacks.");
+
+        PsychAllocInDoubleMatArg(3, kPsychArgRequired, &m, &n, &p, &textures);
+        count = m * n;
+        if ((count < 1) || (p != 1)) PsychErrorExitMsg(PsychError_user, "'textures' must be a vector of texture or offscreen window handles.");
+
+        nwhen = 0;
+        whens = NULL;
+        if (PsychAllocInDoubleMatArg(4, kPsychArgOptional, &m, &n, &p, &whens)) {
+            nwhen = m * n;
+            if ((p != 1) || ((nwhen != 1) && (nwhen != count)))
+                PsychErrorExitMsg(PsychError_user, "'when' must be a scalar or a vector with one deadline per texture.");
+        }
+
+        // First use? Allocate queue:
+        if (NULL == flipRequest->flipQueue) {
+            flipRequest->flipQueue = (PsychFlipQueueItem*) calloc(kPsychFlipQueueSize, sizeof(PsychFlipQueueItem));
+            if (NULL == flipRequest->flipQueue) PsychErrorExitMsg(PsychError_outofMemory, "Out of memory while allocating flip queue.");
+
+            if (PsychInitMutex(&(flipRequest->flipQueueLock))) {
+                free(flipRequest->flipQueue);
+                flipRequest->flipQueue = NULL;
+                PsychErrorExitMsg(PsychError_system, "Insufficient system ressources for mutex creation as part of flip queue setup!");
+            }
+        }
+
+        // A regular async flip pending? We can't mix it with the queue:
+        if ((flipRequest->asyncstate == 1) && (flipRequest->flipQueueState == 0))
+            PsychErrorExitMsg(PsychError_user, "Tried to append to the flip queue while a regular async flip is pending! Finish it first via Screen('AsyncFlipEnd').");
+
+        // Unretrieved results and pending frames must leave room for the new frames:
+        PsychLockMutex(&(flipRequest->flipQueueLock));
+        i = (int) (flipRequest->flipQueueTail - flipRequest->flipQueueDone);
+        PsychUnlockMutex(&(flipRequest->flipQueueLock));
+        if (i + count > kPsychFlipQueueSize) {
+            printf("PTB-ERROR: Flip queue can hold at most %i frames, including presented frames whose timestamps were not retrieved via 'GetTimestamps'.\n", kPsychFlipQueueSize);
+            PsychErrorExitMsg(PsychError_user, "Flip queue overflow! Retrieve timestamps or wait for presentation of pending frames before appending more.");
+        }
+
+        // Prepare all frames first, and only then hand them to the flipper thread in one go. Each
+        // texture gets converted to upright orientation, so it can be attached to a FBO for blitting:
+        for (i = 0; i < count; i++) {
+            if (!IsWindowIndex((PsychWindowIndexType) textures[i])) {
+                printf("PTB-ERROR: %i th entry in texture handle vector is not a valid handle!\n", i + 1);
+                PsychErrorExitMsg(PsychError_user, "Invalid texture handle provided to 'AsyncFlipQueue'.");
+            }
+
+            FindWindowRecord((PsychWindowIndexType) textures[i], &textureRecord);
+            if (!PsychIsTexture(textureRecord) || (PsychGetParentWindow(textureRecord) != windowRecord)) {
+                printf("PTB-ERROR: %i th entry in texture handle vector is not a texture or offscreen window of this onscreen window!\n", i + 1);
+                PsychErrorExitMsg(PsychError_user, "Invalid texture handle provided to 'AsyncFlipQueue'.");
+            }
+
+            if ((flipRequest->asyncstate == 1) && ((textureRecord->textureOrientation != 2) || (textureRecord->specialflags & kPsychPlanarTexture)) &&
+                !(windowRecord->imagingMode & kPsychNeedFastOffscreenWindows)) {
+                printf("PTB-ERROR: %i th texture needs conversion to upright orientation, which is only possible while frames are being\n", i + 1);
+                printf("PTB-ERROR: presented if you enable PsychImaging('AddTask', 'General', 'UseFastOffscreenWindows').\n");
+                PsychErrorExitMsg(PsychError_user, "Tried to append non-upright texture while flip queue is presenting.");
+            }
+
+            PsychSetGLContext(textureRecord);
+            PsychNormalizeTextureOrientation(textureRecord);
+            item = &(flipRequest->flipQueue[(flipRequest->flipQueueTail + i) % kPsychFlipQueueSize]);
+            memset(item, 0, sizeof(PsychFlipQueueItem));
+            item->textureNumber = textureRecord->textureNumber;
+            item->textureTarget = PsychGetTextureTarget(textureRecord);
+            item->width = (int) PsychGetWidthFromRect(textureRecord->rect);
+            item->height = (int) PsychGetHeightFromRect(textureRecord->rect);
+            item->flipwhen = (nwhen > 0) ? whens[(nwhen > 1) ? i : 0] : -1;
+        }
+
+        // Fence on the first new frame, so the flipper thread only presents the frames after all their rendering has completed:
+        if (GLEW_ARB_sync) {
+            item = &(flipRequest->flipQueue[flipRequest->flipQueueTail % kPsychFlipQueueSize]);
+            item->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+        }
+        else {
+            glFinish();
+        }
+
+        // Hand over the frames. If presentation is still running, the flipper thread will pick them up:
+        PsychLockMutex(&(flipRequest->flipQueueLock));
+        flipRequest->flipQueueTail += count;
+        presented = (flipRequest->flipQueueState == 1) ? 1 : 0;
+        pending = flipRequest->flipQueueTail - flipRequest->flipQueueHead;
+        PsychUnlockMutex(&(flipRequest->flipQueueLock));
+
+        if (!presented) {
+            // Presentation not running. Finalize a finished previous presentation, then start a new one:
+            if (flipRequest->asyncstate == 1) PsychFinalizeFlipQueue(windowRecord);
+
+            flipRequest->flipQueueState = 1;
+            flipRequest->flipQueueAbort = FALSE;
+            flipRequest->opmode = 4;
+            flipRequest->multiflip = 0;
+            flipRequest->vbl_synclevel = 0;
+            flipRequest->dont_clear = 2;
+            flipRequest->flipwhen = 0;
+            PsychFlipWindowBuffersIndirect(windowRecord);
+        }
+
+        PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) pending);
+        return(PsychError_none);
+    }
+
+    if (PsychMatch(cmd, "GetTimestamps")) {
+        if (NULL == flipRequest->flipQueue) {
+            PsychAllocOutDoubleMatArg(1, kPsychArgOptional, 0, 5, 1, &timestamps);
+            return(PsychError_none);
+        }
+
+        PsychLockMutex(&(flipRequest->flipQueueLock));
+        presented = flipRequest->flipQueueHead - flipRequest->flipQueueDone;
+        PsychUnlockMutex(&(flipRequest->flipQueueLock));
+
+        // Items between done and head are no longer touched by the flipper thread, so we can read them unlocked:
+        n = (int) presented;
+        PsychAllocOutDoubleMatArg(1, kPsychArgOptional, n, 5, 1, &timestamps);
+        for (i = 0; i < n; i++) {
+            item = &(flipRequest->flipQueue[(flipRequest->flipQueueDone + i) % kPsychFlipQueueSize]);
+            timestamps[i + 0 * n] = item->vbl_timestamp;
+            timestamps[i + 1 * n] = item->time_at_onset;
+            timestamps[i + 2 * n] = item->time_at_flipend;
+            timestamps[i + 3 * n] = item->miss_estimate;
+            timestamps[i + 4 * n] = (double) item->beamPosAtFlip;
+        }
+
+        PsychLockMutex(&(flipRequest->flipQueueLock));
+        flipRequest->flipQueueDone += presented;
+        PsychUnlockMutex(&(flipRequest->flipQueueLock));
+
+        return(PsychError_none);
+    }
+
+    if (PsychMatch(cmd, "Status")) {
+        pending = presented = 0;
+        if (flipRequest->flipQueue) {
+            PsychLockMutex(&(flipRequest->flipQueueLock));
+            pending = flipRequest->flipQueueTail - flipRequest->flipQueueHead;
+            presented = flipRequest->flipQueueHead - flipRequest->flipQueueDone;
+            PsychUnlockMutex(&(flipRequest->flipQueueLock));
+        }
+
+        PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) pending);
+        PsychCopyOutDoubleArg(2, kPsychArgOptional, (double) presented);
+        return(PsychError_none);
+    }
+
+    if (PsychMatch(cmd, "Wait") || PsychMatch(cmd, "Abort")) {
+        // Nothing to do if no flip queue presentation is pending:
+        if ((NULL == flipRequest->flipQueue) || (flipRequest->asyncstate != 1) || (flipRequest->flipQueueState == 0))
+            return(PsychError_none);
+
+        if (PsychMatch(cmd, "Abort")) {
+            PsychLockMutex(&(flipRequest->flipQueueLock));
+            flipRequest->flipQueueAbort = TRUE;
+            PsychUnlockMutex(&(flipRequest->flipQueueLock));
+        }
+
+        PsychFinalizeFlipQueue(windowRecord);
+
+        // Discard the frames which were not presented due to abort, and their fences:
+        for (; flipRequest->flipQueueHead != flipRequest->flipQueueTail; flipRequest->flipQueueTail--) {
+            item = &(flipRequest->flipQueue[(flipRequest->flipQueueTail - 1) % kPsychFlipQueueSize]);
+            if (item->fence) {
+                PsychSetGLContext(windowRecord);
+                glDeleteSync(item->fence);
+                item->fence = NULL;
+            }
+        }
+
+        return(PsychError_none);
+    }
+
+    PsychErrorExitMsg(PsychError_user, "Unknown subcommand specified to 'AsyncFlipQueue'.");
+    return(PsychError_none);
+}
@@ -27,16 +27,20 @@
 #include "Screen.h"
 
 // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] = "Screen('ClearTimelist');";
+static char useString[] = "oldCapacity = Screen('ClearTimelist' [, capacity]);";
 //                          
 static char synopsisString[] = 
 		"Clears the list of times held by Screen.  Time values, as returned by GetSecs, are added to the time list by " 
-		"internal debugging routines using Screen preferences. Time values are read out of Screen using GetTimeList. ";  
+		"internal debugging routines using Screen preferences. Time values are read out of Screen using GetTimeList.\n"
+		"The list is a preallocated ring buffer, so storing time values does not allocate memory and does not disturb "
+		"timing. If it overflows, the oldest time values are overwritten. 'capacity' optionally selects a new maximum "
+		"number of stored time values. The default is 65536. The previous capacity is returned in 'oldCapacity'.";
 static char seeAlsoString[] = "GetTimeList";
 	 
 
 PsychError SCREENClearTimeList(void) 
 {
+	int capacity;
 	
 	
 	//all subfunctions should have these two lines.  
@@ -44,11 +48,16 @@ PsychError SCREENClearTimeList(void)
 	if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
 	
 	//cap the numbers of inputs and outputs
-	PsychErrorExit(PsychCapNumInputArgs(0));   //The maximum number of inputs
-	PsychErrorExit(PsychCapNumOutputArgs(0));  //The maximum number of outputs
+	PsychErrorExit(PsychCapNumInputArgs(1));   //The maximum number of inputs
+	PsychErrorExit(PsychCapNumOutputArgs(1));  //The maximum number of outputs
 	
-	//return the array
-	ClearTimingArray();
+	PsychCopyOutDoubleArg(1, kPsychArgOptional, (double) GetTimeListCapacity());
+
+	//clear the array and optionally change its capacity
+	if (PsychCopyInIntegerArg(1, kPsychArgOptional, &capacity))
+		SetTimeListCapacity((unsigned int) ((capacity > 0) ? capacity : 0));
+	else
+		ClearTimingArray();
 	
 	return(PsychError_none);
 	
@@ -64,6 +64,7 @@ void (*PsychPluginSetTextVerbosity)(unsigned int verbosity) = NULL;
 void (*PsychPluginSetTextAntiAliasing)(int context, int antiAliasing) = NULL;
 void (*PsychPluginSetAffineTransformMatrix)(int context, double matrix[2][3]) = NULL;
 void (*PsychPluginGetTextCursor)(int context, double* xp, double* yp, double* height) = NULL;
+int (*PsychPluginDrawTexts)(int context, int numStrings, double* xStart, double* yStart, int* textLens, double** texts, double* colors) = NULL;
 
 // External renderplugins not yet supported on MS-Windows:
 #if PSYCH_SYSTEM != PSYCH_WINDOWS
@@ -1628,6 +1629,7 @@ psych_bool PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord)
             PsychPluginSetTextAntiAliasing = dlsym(drawtext_plugin, "PsychSetTextAntiAliasing");
             PsychPluginSetAffineTransformMatrix = dlsym(drawtext_plugin, "PsychSetAffineTransformMatrix");
             PsychPluginGetTextCursor = dlsym(drawtext_plugin, "PsychGetTextCursor");
+            PsychPluginDrawTexts = dlsym(drawtext_plugin, "PsychDrawTexts");
         #else
             PsychPluginInitText = GetProcAddress(drawtext_plugin, "PsychInitText");
             PsychPluginShutdownText = GetProcAddress(drawtext_plugin, "PsychShutdownText");
@@ -1645,6 +1647,7 @@ psych_bool PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord)
             PsychPluginSetTextAntiAliasing = GetProcAddress(drawtext_plugin, "PsychSetTextAntiAliasing");
             PsychPluginSetAffineTransformMatrix = GetProcAddress(drawtext_plugin, "PsychSetAffineTransformMatrix");
             PsychPluginGetTextCursor = GetProcAddress(drawtext_plugin, "PsychGetTextCursor");
+            PsychPluginDrawTexts = GetProcAddress(drawtext_plugin, "PsychDrawTexts");
         #endif
 
         // Assign current level of verbosity:
@@ -2084,97 +2087,126 @@ void PsychDrawCharText(PsychWindowRecordType* winRec, const char* textString, do
     return;
 }
 
-PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, double* theight, double* xAdvance, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, int swapTextDirection)
+// Assign the current text settings of window 'winRec' and the given text background color to the
+// text renderer plugin, then setup OpenGL state for drawing text via the plugin into 'winRec'.
+// Returns the plugin context id of the window. Must be followed by PsychFinishPluginTextDraw():
+static int PsychPreparePluginTextDraw(PsychWindowRecordType* winRec, PsychColorType *backgroundColor, GLenum *normalSourceBlendFactor, GLenum *normalDestinationBlendFactor)
 {
     GLdouble backgroundColorVector[4];
-    GLdouble colorVector[4];
-    GLenum normalSourceBlendFactor, normalDestinationBlendFactor;
-    float xmin, ymin, xmax, ymax, _xadvance;
-    double myyp;
-    double dummy;
-    unsigned int i;
     int ctx;
-    int rc = 0;
 
-    *xAdvance = 0;
+    // Get ctx context id for this window:
+    ctx = (int) (PsychGetParentWindow(winRec))->windowIndex;
 
-    // Invert text string (read it "backwards") if swapTextDirection is requested:
-    if (swapTextDirection) {
-        for(i = 0; i < stringLengthChars/2; i++) {
-            dummy = textUniDoubleString[i];
-            textUniDoubleString[i] = textUniDoubleString[stringLengthChars - i - 1];
-            textUniDoubleString[stringLengthChars - i - 1] = dummy;
-        }
-    }
+    // Assign current level of verbosity:
+    PsychPluginSetTextVerbosity((unsigned int) PsychPrefStateGet_Verbosity());
 
-    // Does usercode want us to use a text rendering plugin instead of our standard OS specific renderer?
-    // If so, load it if not already loaded:
-    if ((PsychPrefStateGet_TextRenderer() > 0) && PsychLoadTextRendererPlugin(winRec)) {
+    // Assign current anti-aliasing settings:
+    PsychPluginSetTextAntiAliasing(ctx, PsychPrefStateGet_TextAntiAliasing());
 
-        // Use external dynamically loaded plugin:
+    // Assign font family name of requested font:
+    PsychPluginSetTextFont(ctx, (const char*) winRec->textAttributes.textFontName);
 
-        // Get ctx context id for this window:
-        ctx = (int) (PsychGetParentWindow(winRec))->windowIndex;
+    // Assign style settings, e.g., bold, italic etc.:
+    PsychPluginSetTextStyle(ctx, winRec->textAttributes.textStyle);
 
-        // Assign current level of verbosity:
-        PsychPluginSetTextVerbosity((unsigned int) PsychPrefStateGet_Verbosity());
+    // Assign text size in pixels:
+    PsychPluginSetTextSize(ctx, (double) winRec->textAttributes.textSize);
 
-        // Assign current anti-aliasing settings:
-        PsychPluginSetTextAntiAliasing(ctx, PsychPrefStateGet_TextAntiAliasing());
+    // Retrieve true text font family name:
+    sprintf((char*) &(winRec->textAttributes.textFontName[0]), "%s", PsychPluginGetTextFont(ctx));
 
-        // Assign font family name of requested font:
-        PsychPluginSetTextFont(ctx, (const char*) winRec->textAttributes.textFontName);
+    // Assign viewport settings for rendering:
+    PsychPluginSetTextViewPort(ctx, winRec->clientrect[kPsychLeft], winRec->clientrect[kPsychTop], PsychGetWidthFromRect(winRec->clientrect), PsychGetHeightFromRect(winRec->clientrect));
 
-        // Assign style settings, e.g., bold, italic etc.:
-        PsychPluginSetTextStyle(ctx, winRec->textAttributes.textStyle);
+    // Compute and assign text background color:
+    PsychCoerceColorMode(backgroundColor);
+    PsychConvertColorToDoubleVector(backgroundColor, winRec, backgroundColorVector);
+    PsychPluginSetTextBGColor(ctx, backgroundColorVector);
 
-        // Assign text size in pixels:
-        PsychPluginSetTextSize(ctx, (double) winRec->textAttributes.textSize);
+    // Apply affine 2D transformation matrix if the plugin supports this:
+    if (PsychPluginSetAffineTransformMatrix)
+        PsychPluginSetAffineTransformMatrix(ctx, winRec->text2DMatrix);
 
-        // Retrieve true text font family name:
-        sprintf((char*) &(winRec->textAttributes.textFontName[0]), "%s", PsychPluginGetTextFont(ctx));
+    // Enable this windowRecords framebuffer as current drawingtarget:
+    PsychSetDrawingTarget(winRec);
 
-        // Assign viewport settings for rendering:
-        PsychPluginSetTextViewPort(ctx, winRec->clientrect[kPsychLeft], winRec->clientrect[kPsychTop], PsychGetWidthFromRect(winRec->clientrect), PsychGetHeightFromRect(winRec->clientrect));
+    // Save all state:
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
 
-        // Compute and assign text background color:
-        PsychCoerceColorMode(backgroundColor);
-        PsychConvertColorToDoubleVector(backgroundColor, winRec, backgroundColorVector);
-        PsychPluginSetTextBGColor(ctx, backgroundColorVector);
+    // Disable draw shader:
+    PsychSetShader(winRec, 0);
 
-        // Compute and assign text foreground color - the actual color of the glyphs:
-        PsychCoerceColorMode(textColor);
-        PsychConvertColorToDoubleVector(textColor, winRec, colorVector);
-        PsychPluginSetTextFGColor(ctx, colorVector);
+    // Override current alpha blending settings to GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA unless
+    // usercode explicitely requested to use the regular Screen('Blendfunction') settings.
+    // This is needed to perform proper text anti-aliasing via alpha-blending:
+    if (!PsychPrefStateGet_TextAlphaBlending()) {
+        PsychGetAlphaBlendingFactorsFromWindow(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
+        PsychStoreAlphaBlendingFactorsForWindow(winRec, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
 
-        // Apply affine 2D transformation matrix if the plugin supports this:
-        if (PsychPluginSetAffineTransformMatrix)
-            PsychPluginSetAffineTransformMatrix(ctx, winRec->text2DMatrix);
+    // Apply blending settings:
+    PsychUpdateAlphaBlendingFactorLazily(winRec);
 
-        // Enable this windowRecords framebuffer as current drawingtarget:
-        PsychSetDrawingTarget(winRec);
+    // Disable apple client storage - it could interfere:
+    #if PSYCH_SYSTEM == PSYCH_OSX
+        glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_FALSE);
+    #endif
 
-        // Save all state:
-        glPushAttrib(GL_ALL_ATTRIB_BITS);
+    return(ctx);
+}
 
-        // Disable draw shader:
-        PsychSetShader(winRec, 0);
+// Restore state after text drawing via the plugin, as setup by PsychPreparePluginTextDraw():
+static void PsychFinishPluginTextDraw(PsychWindowRecordType* winRec, GLenum normalSourceBlendFactor, GLenum normalDestinationBlendFactor)
+{
+    // Restore alpha-blending settings if needed:
+    if (!PsychPrefStateGet_TextAlphaBlending()) PsychStoreAlphaBlendingFactorsForWindow(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
 
-        // Override current alpha blending settings to GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA unless
-        // usercode explicitely requested to use the regular Screen('Blendfunction') settings.
-        // This is needed to perform proper text anti-aliasing via alpha-blending:
-        if (!PsychPrefStateGet_TextAlphaBlending()) {
-            PsychGetAlphaBlendingFactorsFromWindow(winRec, &normalSourceBlendFactor, &normalDestinationBlendFactor);
-            PsychStoreAlphaBlendingFactorsForWindow(winRec, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        }
+    // Restore GL state:
+    glPopAttrib();
 
-        // Apply blending settings:
-        PsychUpdateAlphaBlendingFactorLazily(winRec);
+    // Mark end of drawing op. This is needed for single buffered drawing:
+    PsychFlushGL(winRec);
+}
 
-        // Disable apple client storage - it could interfere:
-        #if PSYCH_SYSTEM == PSYCH_OSX
-            glPixelStorei(GL_UNPACK_CLIENT_STORAGE_APPLE, GL_FALSE);
-        #endif
+// Invert text string (read it "backwards"), e.g., for right-to-left scripts:
+static void PsychSwapTextDirection(unsigned int stringLengthChars, double* textUniDoubleString)
+{
+    unsigned int i;
+    double dummy;
+
+    for(i = 0; i < stringLengthChars/2; i++) {
+        dummy = textUniDoubleString[i];
+        textUniDoubleString[i] = textUniDoubleString[stringLengthChars - i - 1];
+        textUniDoubleString[stringLengthChars - i - 1] = dummy;
+    }
+}
+
+PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, double* theight, double* xAdvance, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, int swapTextDirection)
+{
+    GLdouble colorVector[4];
+    GLenum normalSourceBlendFactor, normalDestinationBlendFactor;
+    float xmin, ymin, xmax, ymax, _xadvance;
+    double myyp;
+    int ctx;
+    int rc = 0;
+
+    *xAdvance = 0;
+
+    // Invert text string (read it "backwards") if swapTextDirection is requested:
+    if (swapTextDirection) PsychSwapTextDirection(stringLengthChars, textUniDoubleString);
+
+    // Does usercode want us to use a text rendering plugin instead of our standard OS specific renderer?
+    // If so, load it if not already loaded:
+    if ((PsychPrefStateGet_TextRenderer() > 0) && PsychLoadTextRendererPlugin(winRec)) {
+
+        // Use external dynamically loaded plugin: Assign text settings and setup for drawing:
+        ctx = PsychPreparePluginTextDraw(winRec, backgroundColor, &normalSourceBlendFactor, &normalDestinationBlendFactor);
+
+        // Compute and assign text foreground color - the actual color of the glyphs:
+        PsychCoerceColorMode(textColor);
+        PsychConvertColorToDoubleVector(textColor, winRec, colorVector);
+        PsychPluginSetTextFGColor(ctx, colorVector);
 
         // Compute bounding box of drawn string:
         rc = PsychPluginMeasureText(ctx, stringLengthChars, textUniDoubleString, &xmin, &ymin, &xmax, &ymax, &_xadvance);
@@ -2198,14 +2230,8 @@ PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* bo
             rc += PsychPluginDrawText(ctx, *xp, myyp, stringLengthChars, textUniDoubleString);
         }
 
-        // Restore alpha-blending settings if needed:
-        if (!PsychPrefStateGet_TextAlphaBlending()) PsychStoreAlphaBlendingFactorsForWindow(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
-
-        // Restore GL state:
-        glPopAttrib();
-
-        // Mark end of drawing op. This is needed for single buffered drawing:
-        PsychFlushGL(winRec);
+        // Restore blending and GL state:
+        PsychFinishPluginTextDraw(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
 
         // Plugin rendering successfull?
         if (0 == rc) {
@@ -2234,6 +2260,101 @@ PsychError PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* bo
     return(PsychOSDrawUnicodeText(winRec, boundingbox, stringLengthChars, textUniDoubleString, xp, yp, yPositionIsBaseline, textColor, backgroundColor));
 }
 
+// Draw a batch of 'numStrings' text strings into window 'winRec'. String i has length textLengths[i],
+// Unicode characters textUniDoubleStrings[i] and its pen start location at (xStart[i], yStart[i]).
+// 'numColors' is 1 for a common text color textColors[0] for all strings, or 'numStrings' for one
+// color per string. The final pen location after the last string gets returned in (xp, yp).
+//
+// All strings are drawn with one setup of the text renderer, and in one go by the plugin if the
+// plugin supports batch drawing. Otherwise they are drawn one after another.
+PsychError PsychDrawUnicodeTexts(PsychWindowRecordType* winRec, int numStrings, int* textLengths, double** textUniDoubleStrings, double* xStart, double* yStart, double* xp, double* yp, unsigned int yPositionIsBaseline, int numColors, PsychColorType *textColors, PsychColorType *backgroundColor, int swapTextDirection)
+{
+    GLdouble *colorVectors;
+    GLenum normalSourceBlendFactor, normalDestinationBlendFactor;
+    float xmin = 0, ymin = 0, xmax = 0, ymax = 0, _xadvance;
+    double *myyp;
+    double theight, xAdvance;
+    int i, ctx;
+    int rc = 0;
+
+    if (numStrings < 1) return(PsychError_none);
+
+    // Invert text strings (read them "backwards") if swapTextDirection is requested:
+    if (swapTextDirection) {
+        for (i = 0; i < numStrings; i++) PsychSwapTextDirection(textLengths[i], textUniDoubleStrings[i]);
+    }
+
+    if ((PsychPrefStateGet_TextRenderer() > 0) && PsychLoadTextRendererPlugin(winRec)) {
+
+        // Use external dynamically loaded plugin: Assign text settings and setup for drawing once for all strings:
+        ctx = PsychPreparePluginTextDraw(winRec, backgroundColor, &normalSourceBlendFactor, &normalDestinationBlendFactor);
+
+        myyp = (double*) PsychMallocTemp(numStrings * sizeof(double));
+        colorVectors = (GLdouble*) PsychMallocTemp(numColors * 4 * sizeof(GLdouble));
+
+        // Compute text colors:
+        for (i = 0; i < numColors; i++) {
+            PsychCoerceColorMode(&textColors[i]);
+            PsychConvertColorToDoubleVector(&textColors[i], winRec, &colorVectors[i * 4]);
+        }
+
+        // Compute start positions: Bounding boxes are cached by the plugin for recently drawn strings.
+        for (i = 0; i < numStrings; i++) {
+            if (yPositionIsBaseline) {
+                myyp[i] = yStart[i];
+            }
+            else {
+                rc += PsychPluginMeasureText(ctx, textLengths[i], textUniDoubleStrings[i], &xmin, &ymin, &xmax, &ymax, &_xadvance);
+                myyp[i] = yStart[i] + ymax;
+            }
+        }
+
+        if (PsychPluginDrawTexts) {
+            // Draw all strings in one batch:
+            PsychPluginSetTextFGColor(ctx, &colorVectors[0]);
+            rc += PsychPluginDrawTexts(ctx, numStrings, xStart, myyp, textLengths, textUniDoubleStrings, (numColors > 1) ? colorVectors : NULL);
+        }
+        else {
+            // Plugin can only draw one string at a time:
+            for (i = 0; (i < numStrings) && (rc == 0); i++) {
+                if ((i == 0) || (numColors > 1)) PsychPluginSetTextFGColor(ctx, &colorVectors[i * 4]);
+                rc += PsychPluginDrawText(ctx, xStart[i], myyp[i], textLengths[i], textUniDoubleStrings[i]);
+            }
+        }
+
+        // Restore blending and GL state:
+        PsychFinishPluginTextDraw(winRec, normalSourceBlendFactor, normalDestinationBlendFactor);
+
+        if (0 == rc) {
+            // Update text drawing cursor to the end of the last string:
+            if (PsychPluginGetTextCursor) {
+                PsychPluginGetTextCursor(ctx, xp, yp, &theight);
+                if (!yPositionIsBaseline)
+                    *yp = *yp - ymax;
+            }
+            else {
+                PsychPluginMeasureText(ctx, textLengths[numStrings - 1], textUniDoubleStrings[numStrings - 1], &xmin, &ymin, &xmax, &ymax, &_xadvance);
+                *xp = xStart[numStrings - 1] + (xmax - xmin + 1);
+                *yp = yStart[numStrings - 1];
+            }
+
+            return(PsychError_none);
+        }
+
+        // If we reach this point then the plugin failed to render text:
+        PsychErrorExitMsg(PsychError_user, "The external text renderer plugin failed to render the text strings for some reason!");
+    }
+
+    // OS specific legacy renderer: Draw one string after the other:
+    for (i = 0; i < numStrings; i++) {
+        *xp = xStart[i];
+        *yp = yStart[i];
+        PsychDrawUnicodeText(winRec, NULL, textLengths[i], textUniDoubleStrings[i], xp, yp, &theight, &xAdvance, yPositionIsBaseline, &textColors[(numColors > 1) ? i : 0], backgroundColor, 0);
+    }
+
+    return(PsychError_none);
+}
+
 
 // Unified 'DrawText' routine, as called by Screen('DrawText', ...);
 PsychError SCREENDrawText(void)
@@ -2302,6 +2423,175 @@ drawtext_skipped:
     return(PsychError_none);
 }
 
+// 'DrawTexts' routine for drawing many text strings at once, as called by Screen('DrawTexts', ...);
+PsychError SCREENDrawTexts(void)
+{
+    // If you change useString then also change the corresponding synopsis string in ScreenSynopsis.
+    static char useString[] = "[newX, newY] = Screen('DrawTexts', windowPtr, texts, positions [,colors] [,backgroundColor] [,yPositionIsBaseline] [,swapTextDirection]);";
+    //                          1     2                           1          2      3            4         5                  6                      7
+
+    static char synopsisString[] =
+    "Draw many text strings at once, e.g., for word clouds or grids of labels. This is much faster than "
+    "drawing each string via its own call to Screen('DrawText'), as all strings are converted to Unicode in one "
+    "go and drawn with one setup of the text renderer. The standard FTGL text renderer draws them in one batch.\n"
+    "\"texts\" are the text strings, all packed into one text string, with the individual strings separated by "
+    "newline characters, e.g., texts = strjoin(mywords, char(10)); for a cell array of strings 'mywords'. A "
+    "single trailing newline character is ignored. Just as for Screen('DrawText'), \"texts\" can be a char() "
+    "string interpreted according to Screen's current character encoding setting, a uint8() string, or a double "
+    "matrix of Unicode code points. See the help of Screen('DrawText') for details.\n"
+    "\"positions\" is a 2 row matrix with one column [x ; y] per string, defining the text pen start location "
+    "of each string.\n"
+    "\"colors\" is either a single color for all strings, which becomes the new text color of the window, just as "
+    "for Screen('DrawText'), or a 3 or 4 row matrix with one [r ; g ; b] or [r ; g ; b ; a] color column per string. "
+    "Default is the current text color of the window.\n"
+    "\"backgroundColor\", \"yPositionIsBaseline\" and \"swapTextDirection\" apply to all strings, with the same "
+    "meaning as for Screen('DrawText').\n"
+    "\"newX, newY\" optionally return the final pen location after the last string.\n";
+
+    static char seeAlsoString[] = "DrawText TextBounds TextSize TextFont TextStyle TextColor TextBackgroundColor Preference";
+
+    PsychWindowRecordType       *winRec;
+    psych_bool                  doSetBackgroundColor;
+    PsychColorType              colorArg, backgroundColorArg;
+    PsychColorType              *textColors;
+    int                         yPositionIsBaseline, swapTextDirection;
+    int                         stringLengthChars, numStrings, numColors, count, i, m, n, p;
+    int                         *textLengths;
+    double*                     textUniDoubleString = NULL;
+    double                      **textUniDoubleStrings;
+    double                      *positions, *xStart, *yStart;
+    double                      *colors = NULL;
+    unsigned char               *bytecolors = NULL;
+
+    // All subfunctions should have these two lines.
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if (PsychIsGiveHelp()) { PsychGiveHelp(); return(PsychError_none); };
+
+    PsychErrorExit(PsychCapNumInputArgs(7));
+    PsychErrorExit(PsychRequireNumInputArgs(3));
+    PsychErrorExit(PsychCapNumOutputArgs(2));
+
+    //Get the window structure for the onscreen window.
+    PsychAllocInWindowRecordArg(1, TRUE, &winRec);
+
+    // Get all strings at once as one double vector of unicode characters, converted in one go.
+    // If this returns false then there ain't any work for us to do:
+    if (!PsychAllocInTextAsUnicode(2, kPsychArgRequired, &stringLengthChars, &textUniDoubleString)) goto drawtexts_skipped;
+
+    // Split at newline characters into individual strings, ignoring a trailing newline:
+    if (textUniDoubleString[stringLengthChars - 1] == 10) stringLengthChars--;
+
+    numStrings = 1;
+    for (i = 0; i < stringLengthChars; i++) {
+        if (textUniDoubleString[i] == 10) numStrings++;
+    }
+
+    textLengths = (int*) PsychMallocTemp(numStrings * sizeof(int));
+    textUniDoubleStrings = (double**) PsychMallocTemp(numStrings * sizeof(double*));
+    textLengths[0] = 0;
+    textUniDoubleStrings[0] = textUniDoubleString;
+
+    for (i = 0, count = 0; i < stringLengthChars; i++) {
+        if (textUniDoubleString[i] == 10) {
+            count++;
+            textLengths[count] = 0;
+            textUniDoubleStrings[count] = &textUniDoubleString[i + 1];
+        }
+        else {
+            textLengths[count]++;
+        }
+    }
+
+    // Get the pen start positions, one [x ; y] column per string:
+    PsychAllocInDoubleMatArg(3, kPsychArgRequired, &m, &n, &p, &positions);
+    if ((p != 1) || (m * n != 2 * numStrings) || ((m != 2) && (numStrings > 1))) {
+        printf("PTB-ERROR: DrawTexts: Got %i text strings, but 'positions' is not a 2 row matrix with %i columns.\n", numStrings, numStrings);
+        PsychErrorExitMsg(PsychError_user, "Invalid 'positions' provided. Must be a 2 row matrix with one [x ; y] column per text string.");
+    }
+
+    // Get optional colors, either one per string, or one color for all strings:
+    numColors = 1;
+    textColors = &(winRec->textAttributes.textColor);
+    if (PsychIsArgPresent(PsychArgIn, 4)) {
+        if (!PsychAllocInDoubleMatArg(4, kPsychArgAnything, &m, &n, &p, &colors))
+            PsychAllocInUnsignedByteMatArg(4, kPsychArgAnything, &m, &n, &p, &bytecolors);
+
+        if ((colors || bytecolors) && (p == 1) && (m == 3 || m == 4) && (n == numStrings) && (numStrings > 1)) {
+            // One color per string:
+            numColors = numStrings;
+            textColors = (PsychColorType*) PsychMallocTemp(numColors * sizeof(PsychColorType));
+            for (i = 0; i < numColors; i++) {
+                if (m == 4) {
+                    PsychLoadColorStruct(&textColors[i], kPsychRGBAColor,
+                                         (bytecolors) ? (double) bytecolors[i * 4 + 0] : colors[i * 4 + 0],
+                                         (bytecolors) ? (double) bytecolors[i * 4 + 1] : colors[i * 4 + 1],
+                                         (bytecolors) ? (double) bytecolors[i * 4 + 2] : colors[i * 4 + 2],
+                                         (bytecolors) ? (double) bytecolors[i * 4 + 3] : colors[i * 4 + 3]);
+                }
+                else {
+                    PsychLoadColorStruct(&textColors[i], kPsychRGBColor,
+                                         (bytecolors) ? (double) bytecolors[i * 3 + 0] : colors[i * 3 + 0],
+                                         (bytecolors) ? (double) bytecolors[i * 3 + 1] : colors[i * 3 + 1],
+                                         (bytecolors) ? (double) bytecolors[i * 3 + 2] : colors[i * 3 + 2]);
+                }
+            }
+        }
+        else {
+            // One color for all strings: Becomes the new text color of the window, as with 'DrawText':
+            PsychCopyInColorArg(4, kPsychArgRequired, &colorArg);
+            PsychSetTextColorInWindowRecord(&colorArg, winRec);
+        }
+    }
+
+    // Same for background color:
+    doSetBackgroundColor = PsychCopyInColorArg(5, kPsychArgOptional, &backgroundColorArg);
+    if (doSetBackgroundColor) {
+        PsychSetTextBackgroundColorInWindowRecord(&backgroundColorArg, winRec);
+    } else {
+        // This just to coerce background color into proper format in case it hasn't been done already:
+        PsychSetTextBackgroundColorInWindowRecord(&(winRec->textAttributes.textBackgroundColor),  winRec);
+    }
+
+    // Special handling of offset for y position correction:
+    yPositionIsBaseline = PsychPrefStateGet_TextYPositionIsBaseline();
+    PsychCopyInIntegerArg(6, kPsychArgOptional, &yPositionIsBaseline);
+
+    // Get optional text writing direction flag: Defaults to left->right aka 0:
+    swapTextDirection = 0;
+    PsychCopyInIntegerArg(7, kPsychArgOptional, &swapTextDirection);
+
+    // Gather start positions, skipping empty strings, as there is nothing to draw for them:
+    xStart = (double*) PsychMallocTemp(numStrings * sizeof(double));
+    yStart = (double*) PsychMallocTemp(numStrings * sizeof(double));
+    for (i = 0, count = 0; i < numStrings; i++) {
+        if (textLengths[i] < 1) continue;
+
+        textLengths[count] = textLengths[i];
+        textUniDoubleStrings[count] = textUniDoubleStrings[i];
+        xStart[count] = positions[i * 2];
+        yStart[count] = positions[i * 2 + 1];
+        if (numColors > 1) textColors[count] = textColors[i];
+        count++;
+    }
+
+    if (numColors > 1) numColors = count;
+    if (count < 1) goto drawtexts_skipped;
+
+    // Call Unicode text renderer: This will update the current text cursor positions as well.
+    PsychDrawUnicodeTexts(winRec, count, textLengths, textUniDoubleStrings, xStart, yStart, &(winRec->textAttributes.textPositionX), &(winRec->textAttributes.textPositionY),
+                          yPositionIsBaseline, numColors, textColors, &(winRec->textAttributes.textBackgroundColor), swapTextDirection);
+
+    // We jump directly to this position in the code if there is nothing to draw --> No op.
+drawtexts_skipped:
+
+    // Copy out new, potentially updated, "cursor position":
+    PsychCopyOutDoubleArg(1, FALSE, winRec->textAttributes.textPositionX);
+    PsychCopyOutDoubleArg(2, FALSE, winRec->textAttributes.textPositionY);
+
+    // Done.
+    return(PsychError_none);
+}
+
 PsychError SCREENTextTransform(void)
 {
     // If you change useString then also change the corresponding synopsis string in ScreenSynopsis.
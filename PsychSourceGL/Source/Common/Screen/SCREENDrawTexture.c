@@ -236,9 +236,11 @@ PsychError SCREENDrawTextures(void)
     "a 4 row by n columns matrix for 'destinationRect' to provide target rectangles for n locations, provide a n component "
     "vector of 'rotationAngles' for the n different orientations of the n drawn texture patches.\n"
     "b) n textures drawn to n different locations: Same as a) but provide a n component vector of 'texturePointers' one for "
-    "each texture to be drawn to one of n locations at n angles.\n";
+    "each texture to be drawn to one of n locations at n angles.\n\n"
+    "All items which use the same texture are drawn together in one go if they follow each other in 'texturePointers', "
+    "so for best performance with multiple textures, sort the items by texture.\n";
 
-    PsychWindowRecordType *source, *target;
+    PsychWindowRecordType *source, *target, *batchSource = NULL;
     PsychRectType sourceRect, targetRect, tempRect;
     PsychColorType color;
     double *dstRects, *srcRects, *colors, *penSizes, *globalAlphas, *filterModes, *rotationAngles;
@@ -428,8 +430,9 @@ PsychError SCREENDrawTextures(void)
     // Assign any other optional special flags:
     PsychCopyInIntegerArg(10, kPsychArgOptional, &specialFlags);
 
-    // Check if efficient batch drawing is possible at the GL level:
-    if (isclassic && (numTexs == 1) && (numFilterModes <= 1)) {
+    // Check if efficient batch drawing is possible at the GL level. With multiple textures,
+    // each run of consecutive identical textures is drawn as one batch:
+    if (isclassic && (numFilterModes <= 1)) {
         batchIt = TRUE;
     }
     else {
@@ -439,10 +442,11 @@ PsychError SCREENDrawTextures(void)
     if (PsychPrefStateGet_Verbosity() > 5)
         printf("PTB-DEBUG: DrawTextures optimized batch submit: %i\n", (int) batchIt);
 
-    if (batchIt) {
+    if (batchIt && (numTexs == 1)) {
         // Signal start of new batch with numRef drawn textures, all sourced from source and
         // drawn into windo target with filterMode:
         PsychBatchBlitTexturesToDisplay(0, numRef, source, target, NULL, NULL, 0, (int) filterMode, 1.0);
+        batchSource = source;
     }
 
     // Texture blitting loop:
@@ -464,6 +468,13 @@ PsychError SCREENDrawTextures(void)
                 printf("PTB-ERROR: %i th entry in texture handle vector is not a valid handle!\n", i + 1);
                 PsychErrorExitMsg(PsychError_user, "The second argument supplied was not a texture handle!");
             }
+
+            // Finalize the batch of the previous texture and start a new one if the texture changes:
+            if (batchIt && (source != batchSource)) {
+                if (batchSource) PsychBatchBlitTexturesToDisplay(1, numRef, batchSource, target, NULL, NULL, 0, (int) filterMode, 1.0);
+                PsychBatchBlitTexturesToDisplay(0, numRef, source, target, NULL, NULL, 0, (int) filterMode, 1.0);
+                batchSource = source;
+            }
         }
 
         // Source rectangle provided?
@@ -598,9 +609,9 @@ PsychError SCREENDrawTextures(void)
     target->auxShaderParams = NULL;
     target->auxShaderParamsCount = 0;
 
-    if (batchIt) {
+    if (batchIt && batchSource) {
         // Finalize batch drawing:
-        PsychBatchBlitTexturesToDisplay(1, numRef, source, target, NULL, NULL, 0, (int) filterMode, 1.0);
+        PsychBatchBlitTexturesToDisplay(1, numRef, batchSource, target, NULL, NULL, 0, (int) filterMode, 1.0);
     }
 
     // Mark end of drawing op. This is needed for single buffered drawing:
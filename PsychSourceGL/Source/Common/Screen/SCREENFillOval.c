@@ -54,13 +54,11 @@ PsychError SCREENFillOval(void)
 	PsychRectType			rect;
 	double					numSlices, radius, xScale, yScale, xTranslate, yTranslate, rectY, rectX;
 	PsychWindowRecordType	*windowRecord;
-	psych_bool				isArgThere, isclassic;
+	psych_bool				isArgThere, batched;
     double					*xy, *colors;
 	unsigned char			*bytecolors;
-	int						numRects, i, nc, mc, nrsize;
-	GLUquadricObj			*diskQuadric;
+	int						numRects, i, nc, mc, nrsize, ovalSlices;
 	double					perfectUpToMaxDiameter;
-	static double			perfectUpToMaxDiameterOld = 0;
 
 	//all sub functions should have these two lines
 	PsychPushHelp(useString, synopsisString,seeAlsoString);
@@ -72,7 +70,6 @@ PsychError SCREENFillOval(void)
 
 	//get the window record from the window record argument and get info from the window record
 	PsychAllocInWindowRecordArg(kPsychUseDefaultArgPosition, TRUE, &windowRecord);
-    isclassic = PsychIsGLClassic(windowRecord);
 
 	perfectUpToMaxDiameter = PsychGetWidthFromRect(windowRecord->clientrect);
 	if (PsychGetHeightFromRect(windowRecord->clientrect) < perfectUpToMaxDiameter) perfectUpToMaxDiameter = PsychGetHeightFromRect(windowRecord->clientrect);
@@ -82,29 +79,6 @@ PsychError SCREENFillOval(void)
     // distance unit on the circumference of the oval.
     numSlices = 3.14159265358979323846 * perfectUpToMaxDiameter;
 
-    if ((perfectUpToMaxDiameter != perfectUpToMaxDiameterOld) || (windowRecord->fillOvalDisplayList == 0)) {
-        perfectUpToMaxDiameterOld = perfectUpToMaxDiameter;
-
-        // Destroy old display list so it gets rebuilt with the new numSlices setting:
-        if (isclassic && (windowRecord->fillOvalDisplayList != 0)) {
-            glDeleteLists(windowRecord->fillOvalDisplayList, 1);
-            windowRecord->fillOvalDisplayList = 0;
-        }
-    }
-
-    // Already cached display list for filled ovals for this windowRecord available?
-    if (isclassic && (windowRecord->fillOvalDisplayList == 0)) {
-        // Nope. Create our prototypical filled oval:
-        // Generate a filled disk of that radius and subdivision and store it in a display list:
-        diskQuadric=gluNewQuadric();
-        windowRecord->fillOvalDisplayList = glGenLists(1);
-        glNewList(windowRecord->fillOvalDisplayList, GL_COMPILE);
-        gluDisk(diskQuadric, 0, 1, (int) numSlices, 1);
-        glEndList();
-        gluDeleteQuadric(diskQuadric);
-        // Display list ready for use in this and all future drawing calls for this windowRecord.
-    }
-
 	// Query, allocate and copy in all vectors...
 	numRects = 4;
 	nrsize = 0;
@@ -129,13 +103,19 @@ PsychError SCREENFillOval(void)
 		PsychCopyRect(rect, &xy[0]);
 	}
 
+	// Stream all ovals as one batch if possible:
+	batched = PsychBatchBegin(windowRecord, (nc>1) ? TRUE : FALSE);
+
 	// Draw all ovals (one or multiple):
 	for (i = 0; i < numRects;) {
 		// Per oval color provided? If so then set it up. If only one common color
 		// was provided then PsychPrepareRenderBatch() has already set it up.
 		if (nc>1) {
 			// Yes. Set color for this specific item:
-			PsychSetArrayColor(windowRecord, i, mc, colors, bytecolors);
+			if (batched)
+				PsychBatchSetColor(i, mc, colors, bytecolors);
+			else
+				PsychSetArrayColor(windowRecord, i, mc, colors, bytecolors);
 		}
 
 		// Compute drawing parameters for ellipse:
@@ -160,14 +140,14 @@ PsychError SCREENFillOval(void)
 				radius=rectY/2;
 			}
 
-            if (isclassic) {
-                // Draw: Set up position, scale and size via matrix transform:
-                glPushMatrix();
-                glTranslatef((float) xTranslate, (float) yTranslate, (float) 0);
-                glScalef((float) (xScale * radius), (float) (yScale * radius), (float) 1);
-                // Draw cached disk object (stored in display list):
-                glCallList(windowRecord->fillOvalDisplayList);
-                glPopMatrix();
+            if (batched) {
+                // Subdivide each oval only as finely as needed for a perfect look at its own size,
+                // ie. one subdivision per distance unit on its circumference, up to numSlices:
+                ovalSlices = (int) ceil(3.14159265358979323846 * 2 * radius);
+                if (ovalSlices > (int) numSlices) ovalSlices = (int) numSlices;
+                if (ovalSlices < 8) ovalSlices = 8;
+
+                PsychBatchAddOval(windowRecord, xTranslate, yTranslate, xScale * radius, yScale * radius, ovalSlices);
             }
             else {
                 PsychDrawDisc(windowRecord, (float) xTranslate, (float) yTranslate, (float) 0, (float) radius, (int) numSlices, (float) xScale, (float) yScale, 0, 360);
@@ -180,6 +160,9 @@ PsychError SCREENFillOval(void)
 
 		// Next oval.
 	}
+
+	// Submit all batched ovals:
+	if (batched) PsychBatchFlush(windowRecord);
 	
 	// Mark end of drawing op. This is needed for single buffered drawing:
 	PsychFlushGL(windowRecord);
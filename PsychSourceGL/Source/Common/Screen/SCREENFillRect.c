@@ -152,7 +152,15 @@ PsychError SCREENFillRect(void)
 		}
 	  } else {
 	    // Partial fill: Draw provided rects:
-		if (numRects>1) {
+		if ((numRects>1) && PsychBatchBegin(windowRecord, (nc>1) ? TRUE : FALSE)) {
+			// Multiple rects provided: Stream the whole batch into one draw call:
+			for (i=0; i<numRects; i++) {
+				if (nc>1) PsychBatchSetColor(i, mc, colors, bytecolors);
+				PsychBatchAddRect(windowRecord, xy[i*4 + 0], xy[i*4 + 1], xy[i*4 + 2], xy[i*4 + 3]);
+			}
+			PsychBatchFlush(windowRecord);
+		}
+		else if (numRects>1) {
 			// Multiple rects provided: Draw the whole batch:
 			for (i=0; i<numRects; i++) {
 				// Per rect color provided?
@@ -48,7 +48,7 @@ PsychError SCREENFrameRect(void)
 {	
 	PsychRectType					rect;
 	PsychWindowRecordType			*windowRecord;
-	psych_bool						isArgThere;
+	psych_bool						isArgThere, batched;
 	double							penSize, lf, fudge;
     double							*xy, *colors, *penSizes;
 	unsigned char					*bytecolors;
@@ -92,6 +92,9 @@ PsychError SCREENFrameRect(void)
 
 	// Pen size starts as "undefined", just to make sure it gets initially set:
 	penSize = -DBL_MAX;
+
+	// New style rendering draws each rect as four filled rects, which can be streamed as one batch:
+	batched = (lf == -1) && PsychBatchBegin(windowRecord, (nc>1) ? TRUE : FALSE);
 	
 	// Framed rect drawing loop:
 	for (i=0; i<numRects; i++) {
@@ -109,7 +112,10 @@ PsychError SCREENFrameRect(void)
 			// Per rect color provided?
 			if (nc>1) {
 				// Yes. Set color for this specific rect:
-				PsychSetArrayColor(windowRecord, i, mc, colors, bytecolors);
+				if (batched)
+					PsychBatchSetColor(i, mc, colors, bytecolors);
+				else
+					PsychSetArrayColor(windowRecord, i, mc, colors, bytecolors);
 			}
 		}
 		else {
@@ -130,7 +136,15 @@ PsychError SCREENFrameRect(void)
 		
 		if (IsPsychRectEmpty(rect)) continue;
 
-		if (lf == -1) {
+		if (batched) {
+			// New style rendering, batched:
+			fudge = penSize;
+			PsychBatchAddRect(windowRecord, rect[kPsychLeft], rect[kPsychTop], rect[kPsychRight], rect[kPsychTop] + fudge);
+			PsychBatchAddRect(windowRecord, rect[kPsychLeft], rect[kPsychBottom], rect[kPsychRight], rect[kPsychBottom] - fudge);
+			PsychBatchAddRect(windowRecord, rect[kPsychLeft], rect[kPsychTop]+fudge, rect[kPsychLeft]+fudge, rect[kPsychBottom]-fudge);
+			PsychBatchAddRect(windowRecord, rect[kPsychRight]-fudge, rect[kPsychTop]+fudge, rect[kPsychRight], rect[kPsychBottom]-fudge);
+		}
+		else if (lf == -1) {
 			// New style rendering: More robust against variations in GPU implementations:
 			fudge = penSize;
             GLRECTd(rect[kPsychLeft], rect[kPsychTop], rect[kPsychRight], rect[kPsychTop] + fudge);
@@ -170,6 +184,9 @@ PsychError SCREENFrameRect(void)
 		}
 		// Next rect...
 	}
+
+	// Submit all batched rects:
+	if (batched) PsychBatchFlush(windowRecord);
 	
 	// Need to reset line width?
 	if (penSize!=1 && lf!=-1) glLineWidth(1);
@@ -0,0 +1,102 @@
+/*
+  SCREENGetCapturedFrames.c
+
+  PLATFORMS:    All
+
+  DESCRIPTION:
+
+  Return the most recent raw video frames stored in the capture ring of a video capture device,
+  together with their capture timestamps, frame counters and average intensities, all in one call.
+
+*/
+
+#include "Screen.h"
+
+static char useString[] = "[framesOrCount, timestamps, frameCounters, intensities, roiOrigins] = Screen('GetCapturedFrames', capturePtr [, maxFrames=inf][, onlyNew=0][, targetmemptr]);";
+//                          1              2           3              4            5                                         1             2                3            4
+static char synopsisString[] =
+    "Return up to 'maxFrames' of the most recently captured video frames of capture device 'capturePtr' in one call.\n"
+    "This requires a capture ring, which stores a copy of each captured frame on the capture engines streaming thread, "
+    "irrespective of how fast your script fetches frames, e.g., for high speed cameras in eye tracking applications. Enable "
+    "it after Screen('OpenVideoCapture') via Screen('SetVideoCaptureParameter', capturePtr, 'CaptureRing', numFrames), where "
+    "'numFrames' is the number of most recent frames to keep. A setting of zero disables the ring again. Changing the setting "
+    "discards all frames in the ring. Currently only supported by the GStreamer video capture engine.\n"
+    "If 'onlyNew' is set to 1, then only frames are returned which were not already returned by a previous call.\n"
+    "'framesOrCount' is a uint8 matrix, or a uint16 matrix for high bitdepth capture, of size (depth*width) x height x count, "
+    "with the 'count' returned frames stacked along the 3rd dimension, the oldest frame first. Each frame is laid out as "
+    "for the raw image matrix returned by Screen('GetCapturedImage') with 'specialmode' 2. 'count' can be zero if no frames are available.\n"
+    "If you provide a double-encoded memory pointer in 'targetmemptr', then the frames are copied into that buffer instead, "
+    "and 'framesOrCount' returns the number of copied frames. The buffer must be big enough to hold 'maxFrames' frames, "
+    "otherwise a crash of Matlab or Octave will occur (Experts only!).\n"
+    "'timestamps' Vector with the capture timestamp of each returned frame, in the same time base as the 'capturetimestamp' "
+    "of Screen('GetCapturedImage').\n"
+    "'frameCounters' Vector with the frame counter of each returned frame, as provided by the video source, or a running count "
+    "of captured frames if the video source doesn't provide frame counters. Gaps in the sequence indicate dropped frames.\n"
+    "'intensities' Vector with the average intensity of each returned frame over all its pixels and channels, normalized to the "
+    "0.0 - 1.0 range, as computed by the streaming thread at capture time.\n"
+    "'roiOrigins' count x 2 matrix with the [left, top] corner of the region of interest of each returned frame, as set via "
+    "the 'CaptureRingROI' parameter of Screen('SetVideoCaptureParameter'). Frames in the capture ring can be restricted to a region "
+    "of interest, binned and converted to grayscale by the capture engine, see 'CaptureRingROI', 'CaptureRingBinning' and "
+    "'CaptureRingGrayscale' in Screen('SetVideoCaptureParameter').\n";
+static char seeAlsoString[] = "OpenVideoCapture CloseVideoCapture StartVideoCapture StopVideoCapture GetCapturedImage SetVideoCaptureParameter";
+
+PsychError SCREENGetCapturedFrames(void)
+{
+    int                         capturehandle = -1;
+    double                      maxFramesArg = DBL_MAX;
+    int                         maxFrames, count, onlyNew = 0;
+    double                      targetmemptr = 0;
+    double                      *timestamps, *framecounters, *intensities, *origins;
+    psych_uint8                 *targetmatrixptrbyte = NULL;
+    psych_uint16                *targetmatrixptrshort = NULL;
+    rawcapimgdata               rawCaptureBuffer = {0, 0, 0, 8, NULL};
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none);};
+
+    PsychErrorExit(PsychCapNumInputArgs(4));            // Max. 4 input args.
+    PsychErrorExit(PsychRequireNumInputArgs(1));        // Min. 1 input args required.
+    PsychErrorExit(PsychCapNumOutputArgs(5));           // Max. 5 output args.
+
+    // Get the handle:
+    PsychCopyInIntegerArg(1, TRUE, &capturehandle);
+    if (capturehandle == -1) {
+        PsychErrorExitMsg(PsychError_user, "GetCapturedFrames called without valid handle to a capture object.");
+    }
+
+    // Get optional maximum number of frames to return:
+    PsychCopyInDoubleArg(2, FALSE, &maxFramesArg);
+    if (maxFramesArg < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative 'maxFrames' provided.");
+    maxFrames = (maxFramesArg > INT_MAX) ? INT_MAX : (int) maxFramesArg;
+
+    PsychCopyInIntegerArg(3, FALSE, &onlyNew);
+
+    // Query how many frames we will get, and their format:
+    count = PsychGetCapturedFrames(capturehandle, maxFrames, (onlyNew > 0) ? TRUE : FALSE, &rawCaptureBuffer, NULL, NULL, NULL, NULL);
+
+    // Allocate output for exactly count frames, then fetch them directly into it:
+    if (PsychCopyInDoubleArg(4, FALSE, &targetmemptr)) {
+        rawCaptureBuffer.data = PsychDoubleToPtr(targetmemptr);
+        if (rawCaptureBuffer.data == NULL) PsychErrorExitMsg(PsychError_user, "Invalid NULL 'targetmemptr' provided.");
+        PsychCopyOutDoubleArg(1, FALSE, (double) count);
+    }
+    else if (rawCaptureBuffer.bitdepth <= 8) {
+        PsychAllocOutUnsignedByteMatArg(1, TRUE, rawCaptureBuffer.depth * rawCaptureBuffer.w, rawCaptureBuffer.h, count, &targetmatrixptrbyte);
+        rawCaptureBuffer.data = (void*) targetmatrixptrbyte;
+    }
+    else {
+        PsychAllocOutUnsignedInt16MatArg(1, TRUE, rawCaptureBuffer.depth * rawCaptureBuffer.w, rawCaptureBuffer.h, count, &targetmatrixptrshort);
+        rawCaptureBuffer.data = (void*) targetmatrixptrshort;
+    }
+
+    PsychAllocOutDoubleMatArg(2, FALSE, count, 1, 1, &timestamps);
+    PsychAllocOutDoubleMatArg(3, FALSE, count, 1, 1, &framecounters);
+    PsychAllocOutDoubleMatArg(4, FALSE, count, 1, 1, &intensities);
+    PsychAllocOutDoubleMatArg(5, FALSE, count, 2, 1, &origins);
+
+    if (count > 0) PsychGetCapturedFrames(capturehandle, count, (onlyNew > 0) ? TRUE : FALSE, &rawCaptureBuffer, timestamps, framecounters, intensities, origins);
+
+    // Ready!
+    return(PsychError_none);
+}
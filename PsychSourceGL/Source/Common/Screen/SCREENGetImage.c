@@ -21,8 +21,8 @@
 #include "Screen.h"
 
 // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] =  "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3])";
-//                                                        1           2       3             4                   5
+static char useString[] =  "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3] [,asyncTicket])";
+//                                                        1           2       3             4                   5               6
 
 static char synopsisString[] =
 "Slowly copy an image from a window or texture to Matlab/Octave, by default returning a uint8 array.\n\n"
@@ -79,7 +79,16 @@ static char synopsisString[] =
 "framebuffers do support 'floatprecision' readback.\n"
 "\"nrchannels\" Number of color channels to return. By default, 3 channels (RGB) are "
 "returned. Specify 1 for Red/Luminance only, 2 for Red+Green or Luminance+Alpha, 3 for "
-"RGB and 4 for RGBA. A setting of 2 is not supported on OpenGL-ES hardware. \n\n";
+"RGB and 4 for RGBA. A setting of 2 is not supported on OpenGL-ES hardware. \n\n"
+"\"asyncTicket\" If provided, the image is read back asynchronously, without stalling the graphics "
+"pipeline: If you set 'asyncTicket' to 0, the readback is only started and the function returns a "
+"positive ticket number instead of the imageArray. A later call with 'asyncTicket' set to that ticket "
+"number and the same 'windowPtr' returns the imageArray with the image as it was at the time of the "
+"first call, waiting for completion of the readback if needed. In that call all other arguments except "
+"'windowPtr' are ignored. You can start up to 16 readbacks before you need to retrieve some of their "
+"images. This is useful to grab images each frame, e.g., for quality control, by retrieving the image "
+"of the previous frame after starting readback of the current one. Asynchronous readback is not "
+"supported on OpenGL-ES hardware.\n\n";
 
 static char useString2[] = "Screen('AddFrameToMovie', windowPtr [,rect] [,bufferName] [,moviePtr=0] [,frameduration=1])";
 //                                                    1           2       3             4             5
@@ -140,10 +149,408 @@ static char synopsisString2[] =
 "of channels and bitdepth is selected in the Screen('CreateMovie') call and then kept "
 "fixed throughout the movie. OpenGL-ES hardware only supports 8 bit storage in RGB or RGBA. "
 "Not all video codecs allow for lossless encoding or encoding of all color channels.\n\n"
+"On desktop OpenGL hardware, the image data is read back asynchronously, so this function does not "
+"stall the graphics pipeline. The video frame is added to the movie by one of the following calls "
+"to 'AddFrameToMovie', once the readback is complete, or at the latest by Screen('FinalizeMovie') "
+"or when the window is closed.\n\n"
 "See Screen('CreateMovie?') for help on movie creation.\n";
 
 static char seeAlsoString[] = "PutImage CopyWindow CreateMovie FinalizeMovie";
 
+// Maximum number of asynchronous readbacks in flight at any time, and the maximum number of
+// 'AddFrameToMovie' readbacks which we let pile up before waiting for the oldest to complete:
+#define kPsychMaxAsyncReadbacks         16
+#define kPsychMaxPendingMovieReadbacks  3
+
+// Column tile size and minimum number of pixels per worker thread for readback conversion:
+#define PSYCH_READBACK_TILESIZE         64
+#define PSYCH_READBACK_GRAINSIZE        65536
+
+// State of one asynchronous readback of pixels into a pixel buffer object:
+typedef struct PsychAsyncReadback {
+    PsychWindowRecordType   *win;           // Parent onscreen window in whose context the PBO was created, or NULL.
+    psych_bool              busy;           // TRUE while the readback is pending.
+    int                     ticket;         // 'GetImage' ticket of the readback, or 0 for 'AddFrameToMovie'.
+    psych_uint64            seq;            // Submission sequence number, so movie frames are added in order.
+    int                     moviehandle;    // Movie to which the frame should be added, or -1 for 'GetImage'.
+    int                     frameduration;  // Duration of movie frame in movie frame intervals.
+    GLuint                  pbo;            // Pixel buffer object which receives the pixels.
+    size_t                  pbosize;        // Allocated size of 'pbo' in bytes.
+    GLsync                  fence;          // Fence signalling completion of the readback.
+    size_t                  width;
+    size_t                  height;
+    int                     nrchannels;
+    psych_bool              floatprecision;
+    size_t                  bytes;          // Size of the read back image in bytes.
+} PsychAsyncReadback;
+
+static PsychAsyncReadback asyncReadbacks[kPsychMaxAsyncReadbacks];
+static int asyncReadbackTicket = 0;
+static psych_uint64 asyncReadbackSeq = 0;
+
+// Conversion job for PsychConvertReadbackColumns():
+typedef struct PsychReadbackConversion {
+    const void  *in;
+    void        *out;
+    size_t      width;
+    size_t      height;
+    int         nrchannels;
+    int         stride;
+    psych_bool  isFloat;
+} PsychReadbackConversion;
+
+// Transpose and flip columns [begin, end) of the bottom-up, row-major, pixel-interleaved image read
+// back by glReadPixels() into the top-down, column-major, planar layout of a Matlab/Octave matrix.
+// The image is processed in tiles, so the strided reads from the source stay in the cpu caches,
+// while writes to the output matrix are sequential:
+static void PsychConvertReadbackColumns(void* context, psych_int64 begin, psych_int64 end)
+{
+    PsychReadbackConversion *job = (PsychReadbackConversion*) context;
+    size_t height = job->height, plane = job->width * job->height;
+    size_t stride = (size_t) job->stride, rowstride = job->width * (size_t) job->stride;
+    size_t ix, iy, x0, x1, y0, y1;
+    int c;
+
+    for (x0 = (size_t) begin; x0 < (size_t) end; x0 += PSYCH_READBACK_TILESIZE) {
+        x1 = (x0 + PSYCH_READBACK_TILESIZE < (size_t) end) ? x0 + PSYCH_READBACK_TILESIZE : (size_t) end;
+
+        for (y0 = 0; y0 < height; y0 += PSYCH_READBACK_TILESIZE) {
+            y1 = (y0 + PSYCH_READBACK_TILESIZE < height) ? y0 + PSYCH_READBACK_TILESIZE : height;
+
+            for (c = 0; c < job->nrchannels; c++) {
+                for (ix = x0; ix < x1; ix++) {
+                    if (job->isFloat) {
+                        const float *src = (const float*) job->in + (height - 1 - y0) * rowstride + ix * stride + c;
+                        double *dst = (double*) job->out + c * plane + ix * height;
+
+                        for (iy = y0; iy < y1; iy++, src -= rowstride) dst[iy] = (double) *src;
+                    }
+                    else {
+                        const psych_uint8 *src = (const psych_uint8*) job->in + (height - 1 - y0) * rowstride + ix * stride + c;
+                        psych_uint8 *dst = (psych_uint8*) job->out + c * plane + ix * height;
+
+                        for (iy = y0; iy < y1; iy++, src -= rowstride) dst[iy] = *src;
+                    }
+                }
+            }
+        }
+    }
+
+}
+
+// Convert glReadPixels() image 'in' of 'width' x 'height' pixels with 'stride' components per pixel into the
+// first 'nrchannels' planes of the Matlab/Octave matrix 'out'. uint8 data stays uint8, float data becomes double:
+static void PsychConvertReadbackToMatrix(const void *in, void *out, size_t width, size_t height, int nrchannels, int stride, psych_bool isFloat)
+{
+    PsychReadbackConversion job;
+    psych_int64 grain;
+
+    job.in = in;
+    job.out = out;
+    job.width = width;
+    job.height = height;
+    job.nrchannels = nrchannels;
+    job.stride = stride;
+    job.isFloat = isFloat;
+
+    // Work is split across worker threads in whole tiles of columns:
+    grain = (psych_int64) (PSYCH_READBACK_GRAINSIZE / height) + 1;
+    grain = ((grain + PSYCH_READBACK_TILESIZE - 1) / PSYCH_READBACK_TILESIZE) * PSYCH_READBACK_TILESIZE;
+
+    PsychThreadPoolParallelFor((psych_int64) width, grain, PsychConvertReadbackColumns, &job);
+}
+
+// Vertical flip job for PsychFlipReadbackRows():
+typedef struct PsychReadbackFlip {
+    const psych_uint8   *in;
+    psych_uint8         *out;
+    size_t              rowbytes;
+    size_t              height;
+} PsychReadbackFlip;
+
+// Copy rows [begin, end) of the bottom-up image read back by glReadPixels() into their top-down position:
+static void PsychFlipReadbackRows(void* context, psych_int64 begin, psych_int64 end)
+{
+    PsychReadbackFlip *job = (PsychReadbackFlip*) context;
+    size_t row;
+
+    for (row = (size_t) begin; row < (size_t) end; row++)
+        memcpy(job->out + (job->height - 1 - row) * job->rowbytes, job->in + row * job->rowbytes, job->rowbytes);
+}
+
+// Return readback format for 'nrchannels' color channels on desktop OpenGL:
+static GLenum PsychReadbackFormat(int nrchannels)
+{
+    switch (nrchannels) {
+        case 1:
+            return(GL_RED);
+        case 2:
+            return(GL_LUMINANCE_ALPHA);
+        case 3:
+            return(GL_RGB);
+        default:
+            return(GL_RGBA);
+    }
+}
+
+// Asynchronous readback into PBO's needs desktop OpenGL with PBO and sync object support:
+static psych_bool PsychIsAsyncReadbackSupported(PsychWindowRecordType *windowRecord)
+{
+    return(!PsychIsGLES(windowRecord) && GLEW_ARB_pixel_buffer_object && GLEW_ARB_sync);
+}
+
+// Check if an idle readback slot is available:
+static psych_bool PsychIsAsyncReadbackSlotAvailable(void)
+{
+    int i;
+
+    for (i = 0; i < kPsychMaxAsyncReadbacks; i++) {
+        if (!asyncReadbacks[i].busy) return(TRUE);
+    }
+
+    return(FALSE);
+}
+
+// Start asynchronous readback of a 'width' x 'height' pixels region at (x,y) of the current read buffer into
+// a PBO. Returns the readback slot, or NULL if all slots are busy:
+static PsychAsyncReadback* PsychEnqueueAsyncReadback(PsychWindowRecordType *windowRecord, int x, int y, size_t width, size_t height, GLenum format, GLenum type, size_t bytes)
+{
+    PsychWindowRecordType *parent = PsychGetParentWindow(windowRecord);
+    PsychAsyncReadback *slot = NULL;
+    int i;
+
+    // Prefer an idle slot with a PBO of this window, then one without PBO, then any idle one:
+    for (i = 0; i < kPsychMaxAsyncReadbacks; i++) {
+        if (asyncReadbacks[i].busy) continue;
+        if (asyncReadbacks[i].win == parent) {
+            slot = &asyncReadbacks[i];
+            break;
+        }
+
+        if (!slot || (slot->pbo && !asyncReadbacks[i].pbo)) slot = &asyncReadbacks[i];
+    }
+
+    if (!slot) return(NULL);
+
+    // Release PBO which belongs to another window:
+    if (slot->pbo && (slot->win != parent)) {
+        PsychSetGLContext(slot->win);
+        glDeleteBuffers(1, &slot->pbo);
+        slot->pbo = 0;
+        slot->pbosize = 0;
+        PsychSetGLContext(windowRecord);
+    }
+
+    slot->win = parent;
+
+    if (!slot->pbo) glGenBuffers(1, &slot->pbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+
+    // (Re-)Allocate PBO storage if too small:
+    if (slot->pbosize < bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr) bytes, NULL, GL_STREAM_READ);
+        slot->pbosize = bytes;
+    }
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, (GLsizei) width, (GLsizei) height, format, type, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // Fence the readback and kick it off now, instead of at the next flush:
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();
+
+    slot->busy = TRUE;
+    slot->ticket = 0;
+    slot->seq = ++asyncReadbackSeq;
+    slot->moviehandle = -1;
+    slot->frameduration = 1;
+    slot->width = width;
+    slot->height = height;
+    slot->bytes = bytes;
+
+    return(slot);
+}
+
+// Wait for completion of the readback of 'slot' and map its PBO. Returns the mapped pixels, or NULL on failure:
+static const void* PsychMapAsyncReadback(PsychAsyncReadback *slot)
+{
+    const void *data;
+
+    PsychSetGLContext(slot->win);
+
+    if (slot->fence) {
+        while (glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(slot->fence);
+        slot->fence = NULL;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    data = (const void*) glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if (!data) glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    return(data);
+}
+
+// Unmap PBO of 'slot' after PsychMapAsyncReadback() and mark the slot as idle:
+static void PsychReleaseAsyncReadback(PsychAsyncReadback *slot, psych_bool mapped)
+{
+    if (mapped) {
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+
+    slot->busy = FALSE;
+    slot->ticket = 0;
+    slot->moviehandle = -1;
+}
+
+// Add the video frame of completed readback 'slot' to its movie. Returns FALSE on failure:
+static psych_bool PsychCompleteMovieReadback(PsychAsyncReadback *slot)
+{
+    unsigned int twidth, theight, numChannels, bitdepth;
+    unsigned char *framepixels = NULL;
+    const void *data;
+    int moviehandle = slot->moviehandle;
+    int frameduration = slot->frameduration;
+
+    PsychReadbackFlip job;
+
+    // Movie already closed? Then just discard the frame, instead of error-exiting on the stale handle,
+    // as this can be called during window close, where an error exit would abort the teardown:
+    if (!PsychIsMovieWriterOpen(moviehandle)) {
+        if (slot->fence) {
+            PsychSetGLContext(slot->win);
+            glDeleteSync(slot->fence);
+            slot->fence = NULL;
+        }
+
+        PsychReleaseAsyncReadback(slot, FALSE);
+        if (PsychPrefStateGet_Verbosity() > 3) printf("PTB-INFO: AddFrameToMovie: Discarding pending video frame of already closed moviehandle %i.\n", moviehandle);
+        return(TRUE);
+    }
+
+    data = PsychMapAsyncReadback(slot);
+    if (data) framepixels = PsychGetVideoFrameForMoviePtr(moviehandle, &twidth, &theight, &numChannels, &bitdepth);
+    if (framepixels) {
+        // Copy the frame into the movie buffer, flipping it upright on the way, so the movie writer
+        // doesn't need an extra pass over the image to flip it:
+        job.in = (const psych_uint8*) data;
+        job.out = framepixels;
+        job.height = slot->height;
+        job.rowbytes = slot->bytes / slot->height;
+        PsychThreadPoolParallelFor((psych_int64) job.height, (psych_int64) (4 * PSYCH_READBACK_GRAINSIZE / job.rowbytes) + 1, PsychFlipReadbackRows, &job);
+    }
+
+    PsychReleaseAsyncReadback(slot, (data) ? TRUE : FALSE);
+
+    if (!framepixels) {
+        if (PsychPrefStateGet_Verbosity() > 1) printf("PTB-WARNING: AddFrameToMovie: Failed to retrieve video frame for moviehandle %i from GPU. Frame dropped.\n", moviehandle);
+        return(FALSE);
+    }
+
+    // Add upright frame to movie, with invalid -1 timestamp and a duration of frameduration ticks:
+    return((PsychAddVideoFrameToMovie(moviehandle, frameduration, FALSE, -1) == 0) ? TRUE : FALSE);
+}
+
+// Add pending video frames for movie 'moviehandle' (-1 = all movies) from readbacks of onscreen window 'parent'
+// (NULL = all windows) to their movies. Frames are added in submission order, as soon as their readback is complete,
+// or if more than 'maxPending' frames are pending. Returns FALSE if adding any frame failed:
+static psych_bool PsychDrainMovieReadbacks(PsychWindowRecordType *parent, int moviehandle, int maxPending)
+{
+    PsychAsyncReadback *oldest;
+    psych_bool rc = TRUE;
+    GLenum status;
+    int i, pending;
+
+    while (TRUE) {
+        oldest = NULL;
+        pending = 0;
+
+        for (i = 0; i < kPsychMaxAsyncReadbacks; i++) {
+            if (!asyncReadbacks[i].busy || (asyncReadbacks[i].moviehandle < 0)) continue;
+            if (parent && (asyncReadbacks[i].win != parent)) continue;
+            if ((moviehandle >= 0) && (asyncReadbacks[i].moviehandle != moviehandle)) continue;
+
+            pending++;
+            if (!oldest || (asyncReadbacks[i].seq < oldest->seq)) oldest = &asyncReadbacks[i];
+        }
+
+        if (!oldest) break;
+
+        // Only wait for the oldest frame if too many are pending, otherwise just poll:
+        if (pending <= maxPending) {
+            PsychSetGLContext(oldest->win);
+            status = glClientWaitSync(oldest->fence, 0, 0);
+            if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED)) break;
+        }
+
+        if (!PsychCompleteMovieReadback(oldest)) rc = FALSE;
+    }
+
+    return(rc);
+}
+
+// Copy out the image of the completed 'GetImage' readback with ticket 'ticket' from 'windowRecord':
+static void PsychRetrieveAsyncReadback(PsychWindowRecordType *windowRecord, int ticket)
+{
+    PsychAsyncReadback *slot = NULL;
+    psych_uint8 *returnArrayBase = NULL;
+    double *returnArrayBaseDouble = NULL;
+    const void *data;
+    int i;
+
+    for (i = 0; i < kPsychMaxAsyncReadbacks; i++) {
+        if (asyncReadbacks[i].busy && (asyncReadbacks[i].ticket == ticket)) slot = &asyncReadbacks[i];
+    }
+
+    if (!slot || (slot->win != PsychGetParentWindow(windowRecord)))
+        PsychErrorExitMsg(PsychError_user, "Invalid 'asyncTicket' provided. No pending asynchronous 'GetImage' readback with this ticket for this window.");
+
+    if (slot->floatprecision) {
+        PsychAllocOutDoubleMatArg(1, TRUE, (int) slot->height, (int) slot->width, slot->nrchannels, &returnArrayBaseDouble);
+    }
+    else {
+        PsychAllocOutUnsignedByteMatArg(1, TRUE, (int) slot->height, (int) slot->width, slot->nrchannels, &returnArrayBase);
+    }
+
+    data = PsychMapAsyncReadback(slot);
+    if (data) {
+        PsychConvertReadbackToMatrix(data, (slot->floatprecision) ? (void*) returnArrayBaseDouble : (void*) returnArrayBase,
+                                     slot->width, slot->height, slot->nrchannels, slot->nrchannels, slot->floatprecision);
+    }
+
+    PsychReleaseAsyncReadback(slot, (data) ? TRUE : FALSE);
+
+    if (!data) PsychErrorExitMsg(PsychError_system, "Failed to map pixel buffer object of asynchronous 'GetImage' readback.");
+}
+
+/* PsychFinishAsyncReadbacks()
+ *
+ * Add all pending asynchronously read back video frames of movie 'moviehandle' to the movie, or of
+ * all movies if 'moviehandle' is -1. Called before a movie gets finalized. If 'windowRecord' is
+ * non-NULL, only frames read back from that window are added, and then all other pending readbacks
+ * of the window are discarded and its pixel buffers released. Called at window close time with the
+ * windows OpenGL context bound.
+ */
+void PsychFinishAsyncReadbacks(PsychWindowRecordType *windowRecord, int moviehandle)
+{
+    PsychWindowRecordType *parent = (windowRecord) ? PsychGetParentWindow(windowRecord) : NULL;
+    int i;
+
+    PsychDrainMovieReadbacks(parent, moviehandle, 0);
+
+    if (!parent) return;
+
+    for (i = 0; i < kPsychMaxAsyncReadbacks; i++) {
+        if (asyncReadbacks[i].win != parent) continue;
+
+        if (asyncReadbacks[i].fence) glDeleteSync(asyncReadbacks[i].fence);
+        if (asyncReadbacks[i].pbo) glDeleteBuffers(1, &asyncReadbacks[i].pbo);
+        memset(&asyncReadbacks[i], 0, sizeof(PsychAsyncReadback));
+    }
+}
+
 // This also works as 'AddFrameToMovie', as almost all code is shared with 'GetImage'.
 // Only difference is where the fetched pixeldata is sent: To the movie encoder or to
 // a matlab/octave matrix.
@@ -151,7 +558,7 @@ PsychError SCREENGetImage(void)
 {
     PsychRectType   windowRect, sampleRect;
     int             nrchannels, invertedY, stride;
-    size_t          ix, iy, sampleRectWidth, sampleRectHeight, redReturnIndex, greenReturnIndex, blueReturnIndex, alphaReturnIndex;
+    size_t          sampleRectWidth, sampleRectHeight;
     int             viewid = 0;
     psych_uint8     *returnArrayBase, *redPlane;
     float           *dredPlane;
@@ -168,6 +575,10 @@ PsychError SCREENGetImage(void)
     psych_bool      isOES;
     psych_bool      readFromfinalizedFBO = FALSE;
     PsychFBO*       resolveFBO = NULL;
+    int             asyncTicket = -1;
+    psych_bool      asyncMovieFrame = FALSE;
+    GLenum          format, type;
+    PsychAsyncReadback *slot;
 
     // Called as 2nd personality "AddFrameToMovie" ?
     psych_bool isAddMovieFrame = PsychMatch(PsychGetFunctionName(), "AddFrameToMovie");
@@ -183,7 +594,7 @@ PsychError SCREENGetImage(void)
     if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
 
     //cap the numbers of inputs and outputs
-    PsychErrorExit(PsychCapNumInputArgs(5));   //The maximum number of inputs
+    PsychErrorExit(PsychCapNumInputArgs((isAddMovieFrame) ? 5 : 6));   //The maximum number of inputs
     PsychErrorExit(PsychCapNumOutputArgs(1));  //The maximum number of outputs
 
     // Get windowRecord for this window:
@@ -207,6 +618,47 @@ PsychError SCREENGetImage(void)
         PsychErrorExitMsg(PsychError_user, "Calling this function on an onscreen window with a pending asynchronous flip is not allowed!");
     }
 
+    if (!isAddMovieFrame) {
+        // Asynchronous readback requested via 'asyncTicket'? A zero ticket starts a readback, a
+        // positive ticket retrieves the image of a previously started readback:
+        if (PsychCopyInIntegerArg(6, FALSE, &asyncTicket)) {
+            if (asyncTicket < 0) PsychErrorExitMsg(PsychError_user, "Invalid negative 'asyncTicket' provided!");
+
+            if (asyncTicket > 0) {
+                PsychRetrieveAsyncReadback(windowRecord, asyncTicket);
+                return(PsychError_none);
+            }
+
+            if (!PsychIsAsyncReadbackSupported(windowRecord))
+                PsychErrorExitMsg(PsychError_user, "Asynchronous 'GetImage' readback is not supported on your system. Omit the 'asyncTicket' argument for synchronous readback.");
+
+            if (!PsychIsAsyncReadbackSlotAvailable())
+                PsychErrorExitMsg(PsychError_user, "Too many pending asynchronous 'GetImage' readbacks. Retrieve some of their images first!");
+        }
+    }
+    else {
+        // Get optional moviehandle:
+        moviehandle = 0;
+        PsychCopyInIntegerArg(4, FALSE, &moviehandle);
+        if (moviehandle < 0) PsychErrorExitMsg(PsychError_user, "Provided 'moviehandle' is negative. Must be greater or equal to zero!");
+
+        // Get optional frameduration:
+        frameduration = 1;
+        PsychCopyInIntegerArg(5, FALSE, &frameduration);
+        if (frameduration < 1) PsychErrorExitMsg(PsychError_user, "Number of requested framedurations 'frameduration' is negative. Must be greater than zero!");
+
+        // Add frames of previous asynchronous readbacks to their movies, if their readback is complete, or
+        // wait for the oldest ones if too many are pending:
+        if (!PsychDrainMovieReadbacks(NULL, -1, kPsychMaxPendingMovieReadbacks - 1))
+            PsychErrorExitMsg(PsychError_user, "AddFrameToMovie failed with error above!");
+
+        // Read back this frame asynchronously if possible:
+        if (PsychIsAsyncReadbackSupported(windowRecord)) {
+            if (!PsychIsAsyncReadbackSlotAvailable()) PsychDrainMovieReadbacks(NULL, -1, 0);
+            asyncMovieFrame = PsychIsAsyncReadbackSlotAvailable();
+        }
+    }
+
     // Set window as drawingtarget: Even important if this binding is changed later on!
     // We need to make sure all needed transitions are done - esp. in non-imaging mode,
     // so backbuffer is in a useable state:
@@ -349,7 +801,7 @@ PsychError SCREENGetImage(void)
 
                 // Is the finalizedFBO multisampled? If so, create a temporary MSAA resolve target FBO as
                 // resolveFBO, otherwise set resolveFBO == NULL:
-                resolveFBO = PsychMSAAResolveToTemp(windowRecord->fboTable[windowRecord->finalizedFBO[viewid]]);
+                resolveFBO = PsychMSAAResolveToTemp(windowRecord, windowRecord->fboTable[windowRecord->finalizedFBO[viewid]]);
                 if (!resolveFBO) {
                     // Directly bind finalizedFBO as framebuffer to read from:
                     glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, windowRecord->fboTable[windowRecord->finalizedFBO[viewid]]->fboid);
@@ -367,7 +819,7 @@ PsychError SCREENGetImage(void)
                 // Is the drawBufferFBO multisampled? If so, create a temporary MSAA resolve target FBO as
                 // resolveFBO, otherwise set resolveFBO == NULL:
                 viewid = (((windowRecord->stereomode > 0) && (windowRecord->stereodrawbuffer == 1)) ? 1 : 0);
-                resolveFBO = PsychMSAAResolveToTemp(windowRecord->fboTable[windowRecord->drawBufferFBO[viewid]]);
+                resolveFBO = PsychMSAAResolveToTemp(windowRecord, windowRecord->fboTable[windowRecord->drawBufferFBO[viewid]]);
                 if (resolveFBO) {
                     // MSAA resolved single-sample resolveFBO is now bound as framebuffer for pixel read:
                     viewid = -1;
@@ -385,7 +837,7 @@ PsychError SCREENGetImage(void)
             whichBuffer = GL_COLOR_ATTACHMENT0_EXT;
 
             // We do not support multisampled readout:
-            resolveFBO = PsychMSAAResolveToTemp(windowRecord->fboTable[windowRecord->drawBufferFBO[0]]);
+            resolveFBO = PsychMSAAResolveToTemp(windowRecord, windowRecord->fboTable[windowRecord->drawBufferFBO[0]]);
             if (resolveFBO) {
                 // MSAA resolved single-sample resolveFBO is now bound as framebuffer for pixel read:
                 viewid = -1;
@@ -479,7 +931,19 @@ PsychError SCREENGetImage(void)
         PsychCopyInIntegerArg(5, FALSE, &nrchannels);
         if (nrchannels < 1 || nrchannels > 4) PsychErrorExitMsg(PsychError_user, "Number of requested channels 'nrchannels' must be between 1 and 4!");
 
-        if (!floatprecision) {
+        if (asyncTicket == 0) {
+            // Asynchronous readback into a PBO: Start it and return a ticket for retrieval of the image later on:
+            invertedY = (int) (windowRect[kPsychBottom] - sampleRect[kPsychBottom]);
+            slot = PsychEnqueueAsyncReadback(windowRecord, (int) sampleRect[kPsychLeft], invertedY, sampleRectWidth, sampleRectHeight,
+                                             PsychReadbackFormat(nrchannels), (floatprecision) ? GL_FLOAT : GL_UNSIGNED_BYTE,
+                                             (size_t) nrchannels * ((floatprecision) ? sizeof(float) : 1) * sampleRectWidth * sampleRectHeight);
+            slot->ticket = ++asyncReadbackTicket;
+            slot->nrchannels = nrchannels;
+            slot->floatprecision = floatprecision;
+
+            PsychCopyOutDoubleArg(1, TRUE, (double) slot->ticket);
+        }
+        else if (!floatprecision) {
             // Readback of standard 8bpc uint8 pixels:
 
             // No Luminance + Alpha on OES:
@@ -503,31 +967,13 @@ PsychError SCREENGetImage(void)
             }
             else {
                 stride = nrchannels;
-                if (nrchannels==1) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RED, GL_UNSIGNED_BYTE, redPlane);
-                if (nrchannels==2) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_LUMINANCE_ALPHA, GL_UNSIGNED_BYTE, redPlane);
-                if (nrchannels==3) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGB, GL_UNSIGNED_BYTE, redPlane);
-                if (nrchannels==4) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_UNSIGNED_BYTE, redPlane);
+                glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, PsychReadbackFormat(nrchannels), GL_UNSIGNED_BYTE, redPlane);
             }
 
-            //in one pass transpose and flip what we read with glReadPixels before returning.
-            //-glReadPixels insists on filling up memory in sequence by reading the screen row-wise whearas Matlab reads up memory into columns.
-            //-the Psychtoolbox screen as setup by gluOrtho puts 0,0 at the top left of the window but glReadPixels always believes that it's at the bottom left.
-            for(ix=0; ix < sampleRectWidth; ix++){
-                for(iy=0; iy < sampleRectHeight; iy++){
-                    // Compute write-indices for returned data:
-                    redReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth, nrchannels, iy, ix, 0);
-                    greenReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 1);
-                    blueReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 2);
-                    alphaReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 3);
-
-                    // Always return RED/LUMINANCE channel:
-                    returnArrayBase[redReturnIndex] = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 0];
-                    // Other channels on demand:
-                    if (nrchannels>1) returnArrayBase[greenReturnIndex] = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 1];
-                    if (nrchannels>2) returnArrayBase[blueReturnIndex]  = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 2];
-                    if (nrchannels>3) returnArrayBase[alphaReturnIndex] = redPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 3];
-                }
-            }
+            // In one pass transpose and flip what we read with glReadPixels before returning:
+            // - glReadPixels insists on filling up memory in sequence by reading the screen row-wise whereas Matlab reads up memory into columns.
+            // - The Psychtoolbox screen as setup by gluOrtho puts 0,0 at the top left of the window but glReadPixels always believes that it's at the bottom left.
+            PsychConvertReadbackToMatrix(redPlane, returnArrayBase, sampleRectWidth, sampleRectHeight, nrchannels, stride, FALSE);
         }
         else {
             // Readback of standard 32bpc float pixels into a double matrix:
@@ -555,50 +1001,53 @@ PsychError SCREENGetImage(void)
             invertedY = (int) (windowRect[kPsychBottom]-sampleRect[kPsychBottom]);
 
             if (!isOES) {
-                if (nrchannels==1) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RED, GL_FLOAT, dredPlane);
-                if (nrchannels==2) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_LUMINANCE_ALPHA, GL_FLOAT, dredPlane);
-                if (nrchannels==3) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGB, GL_FLOAT, dredPlane);
-                if (nrchannels==4) glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_FLOAT, dredPlane);
+                glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, PsychReadbackFormat(nrchannels), GL_FLOAT, dredPlane);
             }
             else {
                 glReadPixels((int) sampleRect[kPsychLeft], invertedY, (int) sampleRectWidth, (int) sampleRectHeight, GL_RGBA, GL_FLOAT, dredPlane);
             }
 
-            //in one pass transpose and flip what we read with glReadPixels before returning.
-            //-glReadPixels insists on filling up memory in sequence by reading the screen row-wise whearas Matlab reads up memory into columns.
-            //-the Psychtoolbox screen as setup by gluOrtho puts 0,0 at the top left of the window but glReadPixels always believes that it's at the bottom left.
-            for(ix=0; ix < sampleRectWidth; ix++){
-                for(iy=0; iy < sampleRectHeight; iy++){
-                    // Compute write-indices for returned data:
-                    redReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth, nrchannels, iy, ix, 0);
-                    greenReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 1);
-                    blueReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 2);
-                    alphaReturnIndex=PsychIndexElementFrom3DArray(sampleRectHeight, sampleRectWidth,  nrchannels, iy, ix, 3);
-
-                    // Always return RED/LUMINANCE channel:
-                    returnArrayBaseDouble[redReturnIndex] = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 0];
-                    // Other channels on demand:
-                    if (nrchannels>1) returnArrayBaseDouble[greenReturnIndex] = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 1];
-                    if (nrchannels>2) returnArrayBaseDouble[blueReturnIndex]  = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 2];
-                    if (nrchannels>3) returnArrayBaseDouble[alphaReturnIndex] = dredPlane[(ix + ((sampleRectHeight-1) - iy ) * sampleRectWidth) * (size_t) stride + 3];
-                }
-            }
+            // In one pass transpose and flip what we read with glReadPixels before returning:
+            // - glReadPixels insists on filling up memory in sequence by reading the screen row-wise whereas Matlab reads up memory into columns.
+            // - The Psychtoolbox screen as setup by gluOrtho puts 0,0 at the top left of the window but glReadPixels always believes that it's at the bottom left.
+            PsychConvertReadbackToMatrix(dredPlane, returnArrayBaseDouble, sampleRectWidth, sampleRectHeight, nrchannels, stride, TRUE);
         }
     }
 
-    if (isAddMovieFrame) {
-        // Adding of image to a movie requested:
-
-        // Get optional moviehandle:
-        moviehandle = 0;
-        PsychCopyInIntegerArg(4, FALSE, &moviehandle);
-        if (moviehandle < 0) PsychErrorExitMsg(PsychError_user, "Provided 'moviehandle' is negative. Must be greater or equal to zero!");
-
-        // Get optional frameduration:
-        frameduration = 1;
-        PsychCopyInIntegerArg(5, FALSE, &frameduration);
-        if (frameduration < 1) PsychErrorExitMsg(PsychError_user, "Number of requested framedurations 'frameduration' is negative. Must be greater than zero!");
+    if (isAddMovieFrame && asyncMovieFrame) {
+        // Adding of image to a movie requested, with asynchronous readback into a PBO. The frame
+        // gets added to the movie by a later call, once the readback is complete:
+        PsychGetMovieFrameFormat(moviehandle, &twidth, &theight, &numChannels, &bitdepth);
+        invertedY = (int) (windowRect[kPsychBottom] - sampleRect[kPsychBottom]);
+        type = (bitdepth <= 8) ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT;
+
+        switch (numChannels) {
+            case 4:
+                format = GL_BGRA;
+                if (bitdepth <= 8) type = GL_UNSIGNED_INT_8_8_8_8;
+                break;
+
+            case 3:
+                format = GL_RGB;
+                break;
+
+            case 1:
+                format = GL_RED;
+                break;
+
+            default:
+                format = GL_NONE;
+                PsychErrorExitMsg(PsychError_user, "AddFrameToMovie failed due to wrong number of channels. Only 1, 3 or 4 channels are supported on OpenGL.");
+                break;
+        }
 
+        slot = PsychEnqueueAsyncReadback(windowRecord, (int) sampleRect[kPsychLeft], invertedY, (size_t) twidth, (size_t) theight, format, type,
+                                         (size_t) twidth * (size_t) theight * (size_t) numChannels * ((bitdepth <= 8) ? 1 : 2));
+        slot->moviehandle = moviehandle;
+        slot->frameduration = frameduration;
+    }
+    else if (isAddMovieFrame) {
+        // Adding of image to a movie requested, with synchronous readback:
         framepixels = PsychGetVideoFrameForMoviePtr(moviehandle, &twidth, &theight, &numChannels, &bitdepth);
         if (framepixels) {
             glPixelStorei(GL_PACK_ALIGNMENT,1);
@@ -660,9 +1109,8 @@ PsychError SCREENGetImage(void)
         PsychSetDrawingTarget(NULL);
     }
 
-    // Delete temporary MSAA resolve FBO, if any:
-    if (resolveFBO)
-        PsychDeleteFBO(resolveFBO);
+    // Release temporary MSAA resolve FBO, if any:
+    PsychReleaseMSAAResolveTemp(windowRecord, resolveFBO);
 
     return(PsychError_none);
 }
@@ -0,0 +1,65 @@
+/*
+  SCREENGetMovieStats.c
+
+  PLATFORMS:    All
+
+  DESCRIPTION:
+
+  Return performance statistics of a movie object, e.g., of its optional decoded-frame cache,
+  or the decode timing statistics for the shared decode scheduler.
+
+*/
+
+#include "Screen.h"
+
+static char useString[] = "stats = Screen('GetMovieStats', moviePtr);";
+//                         1                               1
+static char synopsisString[] =
+    "Return a struct 'stats' with performance statistics of movie 'moviePtr'.\n"
+    "The struct contains the following fields:\n"
+    "'FrameCacheMB' Memory limit of the decoded-frame cache in Megabytes, as set via the 'FrameCacheMB' keyword "
+    "of the 'movieOptions' parameter of Screen('OpenMovie'), zero if the movie has no decoded-frame cache.\n"
+    "'CachedFrames' Number of decoded video frames stored in the cache so far.\n"
+    "'CachedMB' Amount of memory used by the cached frames in Megabytes.\n"
+    "'CacheFull' 1 if the cache reached its memory limit, so not all frames of the movie could be cached.\n"
+    "'CacheHits' Number of frames fetched via Screen('GetMovieImage') which were served from the cache.\n"
+    "'CacheMisses' Number of frames which had to be fetched via the regular playback pipeline, because they "
+    "were not (yet) cached.\n"
+    "'DroppedFrames' Number of frames dropped during the current or last playback, as also returned by Screen('PlayMovie').\n"
+    "'DecoderThreads' Number of video decoder threads assigned to the movie by the shared decode scheduler, if the movie "
+    "was opened with a 'maxNumberThreads' setting of -2, otherwise -1.\n"
+    "'DecodedFrames' Number of video frames decoded during playback of the movie.\n"
+    "'LateFrames' Number of decoded video frames which were only ready after their due presentation time.\n"
+    "'MeanDecodeLead' Average time in seconds between the completion of decoding of a video frame and its due "
+    "presentation time during playback. Small or negative values mean that the decoder barely keeps up.\n"
+    "'MinDecodeLead' Smallest such time in seconds, negative if there were late frames.\n"
+    "'SeekIndexFrames' Number of video frames in the seek table of the movie, as requested via the 'SeekIndex' keyword "
+    "of the 'movieOptions' parameter of Screen('OpenMovie'). Zero if there is no seek table, or it is not yet complete.\n"
+    "'SeekIndexKeyFrames' Number of keyframes in the seek table.\n"
+    "'StepSeeks' Number of seeks which were done by stepping forward to the target frame, instead of seeking, "
+    "thanks to the seek table.\n";
+static char seeAlsoString[] = "OpenMovie CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";
+
+PsychError SCREENGetMovieStats(void)
+{
+    int moviehandle = -1;
+
+    // All sub functions should have these two lines
+    PsychPushHelp(useString, synopsisString, seeAlsoString);
+    if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none);};
+
+    PsychErrorExit(PsychCapNumInputArgs(1));            // Max. 1 input args.
+    PsychErrorExit(PsychRequireNumInputArgs(1));        // Min. 1 input args required.
+    PsychErrorExit(PsychCapNumOutputArgs(1));           // One output arg.
+
+    // Get the movie handle:
+    PsychCopyInIntegerArg(1, TRUE, &moviehandle);
+    if (moviehandle == -1) {
+        PsychErrorExitMsg(PsychError_user, "GetMovieStats called without valid handle to a movie object.");
+    }
+
+    // Return struct with statistics:
+    PsychGetMovieStats(moviehandle, 1);
+
+    return(PsychError_none);
+}
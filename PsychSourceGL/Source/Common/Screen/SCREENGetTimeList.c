@@ -25,19 +25,26 @@
 #include "Screen.h"
 
 // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] = "timeList= Screen('GetTimelist');";
+static char useString[] = "[timeList, labels, threadIds] = Screen('GetTimelist');";
 //                          
 static char synopsisString[] = 
 	"Return a vector of doubles holding times as reported by GetSecs.  When debugging is enabled for particular  "
 	"Screen subfunctions using a Screen preference setting, diagnostics may store time values in an array held by Screen."
-	" GetTimelist returns that array. The array is cleared by using the Screen 'ClearTimeList' command.";
+	" GetTimelist returns that array. The array is cleared by using the Screen 'ClearTimeList' command.\n"
+	"The array is a ring buffer of fixed capacity, so if more time values were stored than fit into it, only the most "
+	"recent values are returned, oldest first.\n"
+	"'labels' optionally returns a cell array with a label string for each time value, naming the event which was "
+	"timestamped, or an empty string for unlabeled values. 'threadIds' optionally returns a vector with the operating "
+	"system thread id of the thread which stored each time value.";
 static char seeAlsoString[] = "ClearTimeList";
 	 
 
 PsychError SCREENGetTimeList(void) 
 {
-	unsigned int	numTimeValues;
+	unsigned int	numTimeValues, i;
 	double			*timeValueArray;
+	PsychGenericScriptType	*labelCell;
+	const char		*label;
 	
 	
 	//all subfunctions should have these two lines.  
@@ -46,12 +53,23 @@ PsychError SCREENGetTimeList(void)
 	
 	//cap the numbers of inputs and outputs
 	PsychErrorExit(PsychCapNumInputArgs(0));   //The maximum number of inputs
-	PsychErrorExit(PsychCapNumOutputArgs(1));  //The maximum number of outputs
+	PsychErrorExit(PsychCapNumOutputArgs(3));  //The maximum number of outputs
 	
 	//return the array
 	numTimeValues=GetNumTimeValues();
 	PsychAllocOutDoubleMatArg(1, kPsychArgOptional, 1, numTimeValues, 1, &timeValueArray);
 	CopyTimeArray(timeValueArray,numTimeValues);
+
+	//optionally return the labels and ids of recording threads
+	if (PsychAllocOutCellVector(2, kPsychArgOptional, numTimeValues, &labelCell)) {
+		for (i = 0; i < numTimeValues; i++) {
+			label = GetTimeArrayLabel(i, numTimeValues);
+			PsychSetCellVectorStringElement(i, (label) ? label : "", labelCell);
+		}
+	}
+
+	if (PsychAllocOutDoubleMatArg(3, kPsychArgOptional, 1, numTimeValues, 1, &timeValueArray))
+		CopyTimeArrayThreadIds(timeValueArray, numTimeValues);
 	
 	return(PsychError_none);
 	
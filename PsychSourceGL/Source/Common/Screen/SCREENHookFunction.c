@@ -119,6 +119,24 @@ static char synopsisString[] =
     "Screen('HookFunction', windowPtr, 'DumpAll'); \n"
     "Print out all chains for the given onscreen window 'windowPtr' to the Matlab console in a human readable format - Useful for debugging."
     "\n\n"
+    "stats = Screen('HookFunction', windowPtr, 'Timing', hookname [, reset=0]); \n"
+    "Return execution time statistics for all slots of chain 'hookname' of window 'windowPtr', as a struct array with one element per slot. "
+    "This helps to find out which slot of a processing chain is the one that eats up the time budget of your frames. "
+    "'Id' is the name of the slot. 'Count' is the number of executions so far, 'CPULast', 'CPUAverage' and 'CPUMax' are the cpu wall "
+    "time in seconds taken by the last execution, as moving average over roughly the last 20 executions, and the maximum. 'GPUCount', "
+    "'GPULast', 'GPUAverage' and 'GPUMax' are the same for the time the gpu took for the rendering commands of the slot, measured via "
+    "OpenGL timer queries for image processing slots of onscreen windows, if the graphics driver supports GL_ARB_timer_query. Gpu times "
+    "become available with a delay of typically one or two frames, and are only collected when available, so they don't stall the "
+    "pipeline, but may occasionally skip an execution. If 'reset' is set to 1, all statistics of the chain are reset to zero after query. "
+    "'Dump' and 'DumpAll' also print average and maximum execution times of each slot."
+    "\n\n"
+    "Screen('HookFunction', windowPtr, 'ShaderChanged' [, hookname]); \n"
+    "Tell Screen that you relinked GLSL shaders of slots in chain 'hookname', or in all chains if 'hookname' is omitted. Runs of "
+    "simple shader slots get fused into single shader passes for efficiency, unless disabled via the ConserveVRAM setting "
+    "kPsychDontFuseShaderPasses. Changed uniform values of the slot shaders are picked up automatically at each execution. Relinked "
+    "shaders are detected after each 'Query' or 'Edit' of a slot in the chain, which is what most code does to get at the shader of "
+    "a slot. Usercode which keeps a shader handle around and relinks the shader later on should call this subcommand after the change."
+    "\n\n"
     "oldImagingMode = Screen('HookFunction', proxyPtr, 'ImagingMode' [, imagingMode]); \n"
     "Change or query imagingMode flags of provided proxy window 'proxyPtr' to 'imagingMode'. Proxy windows are used to define "
     "image processing operations, mostly for Screen('TransformTexture'). Returns old imaging mode."
@@ -205,6 +223,10 @@ PsychError SCREENHookFunction(void)
     int                         n, m, p;
     double                      *dblmat;
     int                         verbosity = PsychPrefStateGet_Verbosity();
+    PtrPsychHookFunction        hookfunc;
+    PsychGenericScriptType      *s;
+    const char                  *timingFieldNames[] = { "Id", "Count", "CPULast", "CPUAverage", "CPUMax", "GPUCount", "GPULast", "GPUAverage", "GPUMax" };
+    const int                   timingFieldCount = 9;
 
     blitterString = NULL;
 
@@ -239,12 +261,14 @@ PsychError SCREENHookFunction(void)
     if (strcmp(cmdString, "SetOneshotFlipFlags")==0) cmd=16;
     if (strcmp(cmdString, "SetOneshotFlipResults")==0) cmd=17;
     if (strcmp(cmdString, "SetWindowBackendOverrides")==0) cmd=18;
+    if (strcmp(cmdString, "Timing")==0) cmd=19;
+    if (strcmp(cmdString, "ShaderChanged")==0) cmd=20;
 
     if (cmd == 0) PsychErrorExitMsg(PsychError_user, "Unknown subcommand specified to 'HookFunction'.");
     if (whereloc < 0) PsychErrorExitMsg(PsychError_user, "Unknown/Invalid/Unparseable insert location specified to 'HookFunction' 'InsertAtXXX'.");
 
     // Need hook name?
-    if (cmd!=9 && cmd!=8 && cmd!=11 && cmd!=14 && cmd!=15 && cmd!=16 && cmd!=17 && cmd!=18) {
+    if (cmd!=9 && cmd!=8 && cmd!=11 && cmd!=14 && cmd!=15 && cmd!=16 && cmd!=17 && cmd!=18 && cmd!=20) {
         // Get it:
         PsychAllocInCharArg(3, kPsychArgRequired, &hookString);
     }
@@ -527,6 +551,44 @@ PsychError SCREENHookFunction(void)
                 }
             }
         break;
+
+        case 19: // Timing statistics of all slots in a specific hook-chain:
+            slotid = PsychGetHookByName(hookString);
+            if (slotid == -1) PsychErrorExitMsg(PsychError_user, "In 'Timing' Unknown (non-existent) hook name provided.");
+
+            for (n = 0, hookfunc = windowRecord->HookChain[slotid]; hookfunc; hookfunc = hookfunc->next) n++;
+            if (n > 0) {
+                PsychAllocOutStructArray(1, FALSE, n, timingFieldCount, timingFieldNames, &s);
+                for (m = 0, hookfunc = windowRecord->HookChain[slotid]; hookfunc; hookfunc = hookfunc->next, m++) {
+                    PsychSetStructArrayStringElement("Id", m, hookfunc->idString, s);
+                    PsychSetStructArrayDoubleElement("Count", m, hookfunc->cpuCount, s);
+                    PsychSetStructArrayDoubleElement("CPULast", m, hookfunc->cpuTimeLast, s);
+                    PsychSetStructArrayDoubleElement("CPUAverage", m, hookfunc->cpuTimeAvg, s);
+                    PsychSetStructArrayDoubleElement("CPUMax", m, hookfunc->cpuTimeMax, s);
+                    PsychSetStructArrayDoubleElement("GPUCount", m, hookfunc->gpuCount, s);
+                    PsychSetStructArrayDoubleElement("GPULast", m, hookfunc->gpuTimeLast, s);
+                    PsychSetStructArrayDoubleElement("GPUAverage", m, hookfunc->gpuTimeAvg, s);
+                    PsychSetStructArrayDoubleElement("GPUMax", m, hookfunc->gpuTimeMax, s);
+                }
+            }
+            else {
+                PsychAllocOutDoubleMatArg(1, FALSE, 0, 0, 0, &dblmat);
+            }
+
+            flag1 = 0;
+            PsychCopyInIntegerArg(4, FALSE, &flag1);
+            if (flag1) PsychPipelineResetHookTiming(windowRecord, hookString);
+        break;
+
+        case 20: // Shaders of slots in a specific hook-chain, or in all hook-chains, changed by usercode:
+            slotid = -1;
+            if (PsychAllocInCharArg(3, FALSE, &hookString)) {
+                slotid = PsychGetHookByName(hookString);
+                if (slotid == -1) PsychErrorExitMsg(PsychError_user, "In 'ShaderChanged' Unknown (non-existent) hook name provided.");
+            }
+
+            PsychPipelineInvalidateFusedShaderPasses(windowRecord, slotid);
+        break;
     }
 
     // Done.
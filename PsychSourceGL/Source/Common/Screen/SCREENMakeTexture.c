@@ -63,6 +63,11 @@ static char synopsisString[] =
 "A 'specialFlags' == 8 will prevent automatic mipmap-generation for GL_TEXTURE_2D textures.\n"
 "A 'specialFlags' == 32 setting will prevent automatic closing of the texture if Screen('Close'); is called. Only "
 "Screen('Close', textureIndex); would close the texture.\n"
+"A 'specialFlags' == 64 setting requests asynchronous texture upload: The image gets converted directly into a pixel buffer "
+"object, from which the graphics card uploads it in the background via DMA, so MakeTexture returns without waiting for the "
+"upload. This allows to create large textures during an ongoing animation with less risk of skipped frames. The texture "
+"can be drawn immediately, as the GPU will only draw it after completion of the upload. Screen('PreloadTextures') allows "
+"to query or wait for completion of the upload. This is silently ignored if the graphics card does not support it.\n"
 "'floatprecision' defines the precision with which the texture should be stored and processed. Default value is zero, "
 "which asks to store textures with 8 bit per color component precision, a suitable format for standard images read via "
 "imread(). A non-zero value will store the textures color component values as floating point precision numbers, useful "
@@ -105,10 +110,9 @@ PsychError SCREENMakeTexture(void)
     unsigned char               *byteMatrix;
     double                      *doubleMatrix;
     GLuint                      *texturePointer;
-    GLubyte                     *texturePointer_b;
-    GLfloat                     *texturePointer_f;
-    double                      *rp, *gp, *bp, *ap;
-    GLubyte                     *rpb, *gpb, *bpb, *apb;
+    GLubyte                     *rpb;
+    static const int            bgraOrder[4] = { 2, 1, 0, 3 };
+    static const int            argbOrder[4] = { 3, 0, 1, 2 };
     int                         usepoweroftwo, usefloatformat, assume_texorientation, textureShader;
     double                      optimized_orientation;
     psych_bool                  bigendian;
@@ -123,7 +127,7 @@ PsychError SCREENMakeTexture(void)
     ix = 0; rpb = NULL;
 
     if(PsychPrefStateGet_DebugMakeTexture())    //MARK #1
-        StoreNowTime();
+        StoreNowTimeLabeled("MakeTexture:Start");
 
     //all subfunctions should have these two lines.
     PsychPushHelp(useString, synopsisString, seeAlsoString);
@@ -296,7 +300,7 @@ PsychError SCREENMakeTexture(void)
     // We allocate our own intermediate conversion buffer unless this is
     // creation of a single-layer luminance8 integer texture from a single
     // layer uint8 input matrix and client storage is disabled. In that case, we can use a zero-copy path:
-    if ((isImageMatrixBytes && (numMatrixPlanes == 1) && (!usefloatformat) && !(PsychPrefStateGet_ConserveVRAM() & kPsychDontCacheTextures)) ||
+    if ((isImageMatrixBytes && (numMatrixPlanes == 1) && (!usefloatformat) && !(PsychPrefStateGet_ConserveVRAM() & kPsychDontCacheTextures) && !(usepoweroftwo & 64)) ||
         (isImageMatrixBytes && planar_storage)) {
         // Zero copy path:
         texturePointer = NULL;
@@ -305,11 +309,27 @@ PsychError SCREENMakeTexture(void)
         usefloatformat = 0;
     }
     else {
-        // Allocate memory:
-        if(PsychPrefStateGet_DebugMakeTexture()) StoreNowTime();
-        textureRecord->textureMemory = malloc(textureRecord->textureMemorySizeBytes);
-        if(PsychPrefStateGet_DebugMakeTexture()) StoreNowTime();
-        texturePointer = textureRecord->textureMemory;
+        // Asynchronous upload requested? Then convert directly into a mapped pixel buffer object, from which
+        // the texture gets filled via DMA, without stalling us. Not possible with client storage textures:
+        texturePointer = NULL;
+        if ((usepoweroftwo & 64) && !(PsychPrefStateGet_ConserveVRAM() & kPsychDontCacheTextures)) {
+            texturePointer = (GLuint*) PsychMapTextureUploadBuffer(windowRecord, textureRecord, textureRecord->textureMemorySizeBytes);
+            if (texturePointer) {
+                // The mapped PBO memory is only referenced by texturePointer, never by textureMemory, so
+                // no free() path can ever see it, even if we error-exit before the upload. PsychCreateTexture()
+                // sources the upload from the PBO assigned to textureRecord instead:
+                textureRecord->textureMemory = NULL;
+                textureRecord->textureMemorySizeBytes = 0;
+            }
+        }
+
+        if (!texturePointer) {
+            // Allocate memory:
+            if(PsychPrefStateGet_DebugMakeTexture()) StoreNowTimeLabeled("MakeTexture:MallocStart");
+            textureRecord->textureMemory = malloc(textureRecord->textureMemorySizeBytes);
+            if(PsychPrefStateGet_DebugMakeTexture()) StoreNowTimeLabeled("MakeTexture:MallocEnd");
+            texturePointer = textureRecord->textureMemory;
+        }
     }
 
     // Does script explicitely request usage of a GL_TEXTURE_2D texture?
@@ -354,10 +374,7 @@ PsychError SCREENMakeTexture(void)
 
                 // Perform copy with double -> float cast:
                 iters = (size_t) xSize * (size_t) ySize * (size_t) numMatrixPlanes;
-                texturePointer_f = (GLfloat*) texturePointer;
-                for(ix = 0; ix < iters; ix++) {
-                    *(texturePointer_f++) = (GLfloat) *(doubleMatrix++);
-                }
+                PsychConvertPlanarToInterleavedTexture(texturePointer, doubleMatrix, TRUE, TRUE, 1, iters, 0.0, 1.0, NULL);
                 iters = (size_t) xSize * (size_t) ySize;
             }
             else {
@@ -367,10 +384,7 @@ PsychError SCREENMakeTexture(void)
                 textureRecord->textureinternalformat = GL_LUMINANCE8;
 
                 iters = (size_t) xSize * (size_t) ySize * (size_t) numMatrixPlanes;
-                texturePointer_b = (GLubyte*) texturePointer;
-                for(ix = 0; ix < iters; ix++) {
-                    *(texturePointer_b++) = (GLubyte) (offsetd + scaled * *(doubleMatrix++));
-                }
+                PsychConvertPlanarToInterleavedTexture(texturePointer, doubleMatrix, TRUE, FALSE, 1, iters, offsetd, scaled, NULL);
                 iters = (size_t) xSize * (size_t) ySize;
             }
         }
@@ -382,12 +396,11 @@ PsychError SCREENMakeTexture(void)
 
         // Our input buffer is always of GL_FLOAT precision:
         textureRecord->textureexternaltype = GL_FLOAT;
-        texturePointer_f=(GLfloat*) texturePointer;
+
+        // Convert and interleave all planes with double -> float cast:
+        PsychConvertPlanarToInterleavedTexture(texturePointer, doubleMatrix, TRUE, TRUE, numMatrixPlanes, iters, 0.0, 1.0, NULL);
 
         if (numMatrixPlanes==1) {
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(doubleMatrix++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 16 : 32;
 
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_LUMINANCE_FLOAT16_APPLE : GL_LUMINANCE_FLOAT32_APPLE;
@@ -398,13 +411,6 @@ PsychError SCREENMakeTexture(void)
         }
 
         if (numMatrixPlanes==2) {
-            rp=(double*) ((size_t) doubleMatrix);
-            ap=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(rp++);
-                *(texturePointer_f++)= (GLfloat) *(ap++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 32 : 64;
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_LUMINANCE_ALPHA_FLOAT16_APPLE : GL_LUMINANCE_ALPHA_FLOAT32_APPLE;
             textureRecord->textureexternalformat = GL_LUMINANCE_ALPHA;
@@ -414,15 +420,6 @@ PsychError SCREENMakeTexture(void)
         }
 
         if (numMatrixPlanes==3) {
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(rp++);
-                *(texturePointer_f++)= (GLfloat) *(gp++);
-                *(texturePointer_f++)= (GLfloat) *(bp++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 48 : 96;
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_RGB_FLOAT16_APPLE : GL_RGB_FLOAT32_APPLE;
             textureRecord->textureexternalformat = GL_RGB;
@@ -432,17 +429,6 @@ PsychError SCREENMakeTexture(void)
         }
 
         if (numMatrixPlanes==4) {
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-            ap=(double*) ((size_t) bp + (size_t) iters * sizeof(double));
-
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_f++)= (GLfloat) *(rp++);
-                *(texturePointer_f++)= (GLfloat) *(gp++);
-                *(texturePointer_f++)= (GLfloat) *(bp++);
-                *(texturePointer_f++)= (GLfloat) *(ap++);
-            }
             textureRecord->depth=(usefloatformat==1) ? 64 : 128;
             textureRecord->textureinternalformat = (usefloatformat==1) ? GL_RGBA_FLOAT16_APPLE : GL_RGBA_FLOAT32_APPLE;
             textureRecord->textureexternalformat = GL_RGBA;
@@ -456,28 +442,11 @@ PsychError SCREENMakeTexture(void)
         // Standard LDR texture 8 bpc conversion routines -- Fast path.
         iters = (size_t) xSize * (size_t) ySize;
 
-        // Improved implementation: Takes 13 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==1){
-            texturePointer_b=(GLubyte*) texturePointer;
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(doubleMatrix++));
-            }
-            textureRecord->depth=8;
-        }
-
-        // Improved version: Takes 3 ms on a 800x800 texture...
-        // NB: Implementing memcpy manually by a for-loop takes 10 ms! This is a huge difference.
-        // -> That's because memcpy on MacOS-X is implemented with hand-coded, highly tuned Assembler code for PowerPC.
-        // -> It's always wise to use system-routines if available, instead of coding it by yourself!
+        // Single layer uint8 input needs no conversion:
         if (isImageMatrixBytes && numMatrixPlanes==1) {
             if (texturePointer) {
                 // Need to do a copy. Use optimized memcpy():
                 memcpy((void*) texturePointer, (void*) byteMatrix, iters);
-
-                //texturePointer_b=(GLubyte*) texturePointer;
-                //for(ix=0;ix<iters;ix++){
-                //    *(texturePointer_b++) = *(byteMatrix++);
-                //}
             }
             else {
                 // Zero-Copy path. Just pass a pointer to our input matrix:
@@ -487,119 +456,17 @@ PsychError SCREENMakeTexture(void)
                 // input buffer:
                 textureRecord->textureMemorySizeBytes = 0;
             }
-
-            textureRecord->depth=8;
         }
-
-        // New version: Takes 33 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==2){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rp=(double*) ((size_t) doubleMatrix);
-            ap=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(ap++));
-            }
-            textureRecord->depth=16;
-        }
-
-        // New version: Takes 20 ms on a 800x800 texture...
-        if (isImageMatrixBytes && numMatrixPlanes==2){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rpb=(GLubyte*) ((size_t) byteMatrix);
-            apb=(GLubyte*) ((size_t) rpb + (size_t) iters);
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= *(rpb++);
-                *(texturePointer_b++)= *(apb++);
-            }
-            textureRecord->depth=16;
-        }
-
-        // Improved version: Takes 43 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==3){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(gp++));
-                *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(bp++));
-            }
-            textureRecord->depth=24;
-        }
-
-        // Improved version: Takes 25 ms on a 800x800 texture...
-        if (isImageMatrixBytes && numMatrixPlanes==3){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rpb=(GLubyte*) ((size_t) byteMatrix);
-            gpb=(GLubyte*) ((size_t) rpb + (size_t) iters);
-            bpb=(GLubyte*) ((size_t) gpb + (size_t) iters);
-            for(ix=0;ix<iters;ix++){
-                *(texturePointer_b++)= *(rpb++);
-                *(texturePointer_b++)= *(gpb++);
-                *(texturePointer_b++)= *(bpb++);
-            }
-            textureRecord->depth=24;
-        }
-
-        // Improved version: Takes 55 ms on a 800x800 texture...
-        if (isImageMatrixDoubles && numMatrixPlanes==4){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rp=(double*) ((size_t) doubleMatrix);
-            gp=(double*) ((size_t) rp + (size_t) iters * sizeof(double));
-            bp=(double*) ((size_t) gp + (size_t) iters * sizeof(double));
-            ap=(double*) ((size_t) bp + (size_t) iters * sizeof(double));
-            if (bigendian) {
-                // Code for big-endian machines like PowerPC:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(ap++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(gp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(bp++));
-                }
-            }
-            else {
-                // Code for little-endian machines like Intel Pentium:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(bp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(gp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(rp++));
-                    *(texturePointer_b++)= (GLubyte) (offsetd + scaled * *(ap++));
-                }
-            }
-
-            textureRecord->depth=32;
+        else {
+            // Interleave the planes, with conversion for double input. RGBA textures are
+            // stored as BGRA on little-endian machines like Intel, ARGB on big-endian
+            // machines like PowerPC:
+            PsychConvertPlanarToInterleavedTexture(texturePointer, (isImageMatrixDoubles) ? (void*) doubleMatrix : (void*) byteMatrix,
+                                                   isImageMatrixDoubles, FALSE, numMatrixPlanes, iters, offsetd, scaled,
+                                                   (numMatrixPlanes == 4) ? ((bigendian) ? argbOrder : bgraOrder) : NULL);
         }
 
-        // Improved version: Takes 33 ms on a 800x800 texture...
-        if (isImageMatrixBytes && numMatrixPlanes==4){
-            texturePointer_b=(GLubyte*) texturePointer;
-            rpb=(GLubyte*) ((size_t) byteMatrix);
-            gpb=(GLubyte*) ((size_t) rpb + (size_t) iters);
-            bpb=(GLubyte*) ((size_t) gpb + (size_t) iters);
-            apb=(GLubyte*) ((size_t) bpb + (size_t) iters);
-            if (bigendian) {
-                // Code for big-endian machines like PowerPC:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= *(apb++);
-                    *(texturePointer_b++)= *(rpb++);
-                    *(texturePointer_b++)= *(gpb++);
-                    *(texturePointer_b++)= *(bpb++);
-                }
-            }
-            else {
-                // Code for little-endian machines like Intel Pentium:
-                for(ix=0;ix<iters;ix++){
-                    *(texturePointer_b++)= *(bpb++);
-                    *(texturePointer_b++)= *(gpb++);
-                    *(texturePointer_b++)= *(rpb++);
-                    *(texturePointer_b++)= *(apb++);
-                }
-            }
-
-            textureRecord->depth=32;
-        }
+        textureRecord->depth = 8 * numMatrixPlanes;
     } // End of 8 bpc texture conversion code (fast-path for LDR textures)
 
     // Override for missing floating point texture support?
@@ -621,16 +488,13 @@ PsychError SCREENMakeTexture(void)
         }
 
         // Check value range of pixels. This will not work for out of [-1; 1] range values.
-        texturePointer_f=(GLfloat*) texturePointer;
         iters = iters * (size_t) numMatrixPlanes;
-        for (ix=0; ix<iters; ix++, texturePointer_f++) {
-            if(fabs((double) *texturePointer_f) > 1.0) {
-                // Game over!
-                printf("PTB-ERROR:MakeTexture: Code requested 16 bpc floating point texture, but this is unsupported by this graphics card.\n");
-                printf("PTB-ERROR:MakeTexture: Tried to use 16 bit snorm texture instead, but failed because some pixels are outside the\n");
-                printf("PTB-ERROR:MakeTexture: representable range -1.0 to 1.0 for this texture type. Change your code or update your graphics hardware.\n");
-                PsychErrorExitMsg(PsychError_user, "Creation of 15 bit linear precision signed normalized texture failed due to out of [-1 ; +1] range pixel values!");
-            }
+        if (!PsychCheckFloatTextureRange((GLfloat*) texturePointer, iters)) {
+            // Game over!
+            printf("PTB-ERROR:MakeTexture: Code requested 16 bpc floating point texture, but this is unsupported by this graphics card.\n");
+            printf("PTB-ERROR:MakeTexture: Tried to use 16 bit snorm texture instead, but failed because some pixels are outside the\n");
+            printf("PTB-ERROR:MakeTexture: representable range -1.0 to 1.0 for this texture type. Change your code or update your graphics hardware.\n");
+            PsychErrorExitMsg(PsychError_user, "Creation of 15 bit linear precision signed normalized texture failed due to out of [-1 ; +1] range pixel values!");
         }
     }
 
@@ -640,9 +504,8 @@ PsychError SCREENMakeTexture(void)
     // Therefore, if FLOAT16 texture creation is requested, we loop over the whole input buffer and
     // set all values with magnitude smaller than 1e-9 to zero. Better safe than sorry...
     if ((usefloatformat==1) && (windowRecord->gfxcaps & kPsychGfxCapFPTex16)) {
-        texturePointer_f=(GLfloat*) texturePointer;
         iters = iters * (size_t) numMatrixPlanes;
-        for(ix=0; ix<iters; ix++, texturePointer_f++) if(fabs((double) *texturePointer_f) < 1e-9) { *texturePointer_f = 0.0; }
+        PsychFlushTinyFloatTextureValues((GLfloat*) texturePointer, iters);
     }
 
     // On OpenGL-ES, 32 bpc floating point textures are selected via the GL_FLOAT type specifier, and
@@ -732,7 +595,7 @@ PsychError SCREENMakeTexture(void)
     if (usepoweroftwo & 32) textureRecord->specialflags |= kPsychDontDeleteOnClose;
 
     if (PsychPrefStateGet_DebugMakeTexture())     //MARK #4
-        StoreNowTime();
+        StoreNowTimeLabeled("MakeTexture:End");
 
     return(PsychError_none);
 }
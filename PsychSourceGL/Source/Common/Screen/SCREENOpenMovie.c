@@ -119,7 +119,13 @@ static char synopsisString[] =
         "and can provide a significant performance boost on multi-core computers. Specify a discrete non-zero number of threads "
         "if you want to benefit from multi-core decoding but want to prevent movie playback from using up all available computation "
         "power, e.g., because you want to run some other timing-sensitive tasks in parallel and want to make sure to leave some processor "
-        "cores dedicated to them.\n"
+        "cores dedicated to them. A setting of -2 enables the shared decode scheduler, which is useful if you play many movies "
+        "at the same time, e.g., for a video wall: All movies opened with this setting share a budget of one decoder thread per "
+        "processor core, instead of each movie trying to use all cores. The budget is split among all open movies with this "
+        "setting, in proportion to their decoding load in pixels per second, and movies which had late frames get a larger share. "
+        "The share of a movie is reassigned whenever its playback is started via Screen('PlayMovie'), limited to the threads "
+        "left over by the other movies, but at least one thread per movie. Screen('GetMovieStats') "
+        "reports the assigned number of threads and the decode timing of each movie.\n"
         "'movieOptions' Optional text string which encodes additional options for playback of the movie. Parameters are "
         "keyword=value pairs, separated by three colons ::: if there are multiple parameters. Currently supported keywords:\n"
         "AudioSink=GStreamerSinkSpec -- GStreamerSinkSpec is a GStreamer gst-launch line style specification for a audio sink "
@@ -131,9 +137,26 @@ static char synopsisString[] =
         "Linux pulseaudiosink plugin to send sound data to the output named 'MyCardsOutput1' via the PulseAudio sound server commonly "
         "used on Linux desktop systems.\n"
         "If you set a Screen() verbosity level of 4 or higher, Screen() will print out the actually used audio output at the end "
-        "of movie playback on operating systems which support this. This can help debugging issues with audio routing if you don't hear sound.\n";
-
-static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex";
+        "of movie playback on operating systems which support this. This can help debugging issues with audio routing if you don't hear sound.\n"
+        "FrameCacheMB=x -- Decode the video frames of the movie in the background into a RAM cache of at most x Megabytes. "
+        "Frames fetched via Screen('GetMovieImage') or selected via Screen('SetMovieTimeIndex') while the movie is not playing, "
+        "ie. while the playback rate is zero, are then served from the cache without any seeking or decoding, if they are already "
+        "cached. This allows fast random access to arbitrary frames, e.g., for showing frames in shuffled order, or for scrubbing "
+        "back and forth. Frames are cached in the format selected by 'pixelFormat', so the YUV formats 6 or 7 allow to cache "
+        "more frames in the same amount of memory. Decoding stops when the memory limit is reached, and the remaining frames "
+        "are fetched as usual. Use Screen('GetMovieStats') to query the state of the cache and its hit and miss counts.\n"
+        "SeekIndex=x -- Build a seek table of the movie, which stores the exact presentation timestamp of each video frame and "
+        "if it is a keyframe. The table is built by parsing, but not decoding, the movie, which is fast. A setting of 1 builds "
+        "the table in the background, a setting of 2 builds it immediately, so Screen('OpenMovie') only returns when the table "
+        "is complete, and then also returns the exact 'count' of frames. Once the table is complete, Screen('SetMovieTimeIndex') "
+        "with 'indexIsFrames' = 1 seeks exactly to the given frame, also for movie formats which don't support frame based seeking, "
+        "and seeks forward to a frame in the same group of pictures while the movie is not playing step forward from the current "
+        "frame, instead of decoding again from the preceding keyframe. This speeds up scrubbing through long-GOP H.264 or H.265 "
+        "movies. Requires GStreamer 1.10 or later.\n"
+        "SeekIndexFile=filename -- Load the seek table requested via SeekIndex from the given sidecar file, if it exists and matches "
+        "the movie, instead of building it. Otherwise save the newly built table to that file, for faster opening next time.\n";
+
+static char seeAlsoString[] = "CloseMovie PlayMovie GetMovieImage GetMovieTimeIndex SetMovieTimeIndex GetMovieStats";
 
 PsychAsyncMovieInfo asyncmovieinfo;
 
@@ -201,7 +224,7 @@ PsychError SCREENOpenMovie(void)
 
     // Get the (optional) maxNumberThreads:
     PsychCopyInIntegerArg(7, FALSE, &maxNumberThreads);
-    if (maxNumberThreads < -1) PsychErrorExitMsg(PsychError_user, "OpenMovie called with invalid 'maxNumberThreads' setting! Only values of -1 or greater are allowed.");
+    if (maxNumberThreads < -2) PsychErrorExitMsg(PsychError_user, "OpenMovie called with invalid 'maxNumberThreads' setting! Only values of -2 or greater are allowed.");
 
     // Get the (optional) movie options string: As PsychAllocInCharArg() no-ops if
     // the optional string isn't provided, we need to point movieOptions to an empty
@@ -354,6 +377,9 @@ PsychError SCREENFinalizeMovie(void)
     // Get the moviehandle:
     PsychCopyInIntegerArg(1, kPsychArgRequired, &moviehandle);
 
+    // Add all pending asynchronously read back video frames to the movie:
+    PsychFinishAsyncReadbacks(NULL, moviehandle);
+
     // Finalize the movie:
     if (!PsychFinalizeNewMovieFile(moviehandle)) {
         PsychErrorExitMsg(PsychError_user, "FinalizeMovie failed for reason mentioned above.");
@@ -391,6 +417,10 @@ PsychError SCREENCreateMovie(void)
         "Keywords unknown to a certain implementation or codec will be silently ignored:\n"
         "EncodingQuality=x Set encoding quality to value x, in the range 0.0 for lowest movie quality to "
         "1.0 for highest quality. Default is 0.5 = normal quality. 1.0 often provides near-lossless encoding.\n"
+"MaxQueuedFrames=n Limit the number of video frames which are queued up for encoding to n frames. If the "
+"encoder can't keep up, 'AddFrameToMovie' will wait for it, instead of queuing up ever more frames and memory. "
+"By default, the queue is unlimited. 'FinalizeMovie' reports how often and how long it had to wait at "
+"Screen('Preference', 'Verbosity') levels of 3 or higher, and the peak length of the queue at levels of 4 or higher.\n"
         "'numChannels' Optional number of image channels to encode: Can be 1, 3 or 4 on OpenGL graphics hardware, "
         "and 3 or 4 on OpenGL-ES hardware. 1 = Red/Grayscale channel only, 3 = RGB, 4 = RGBA. Please note that not "
         "all video codecs can encode pure 1 channel data or RGBA data, ie. an alpha channel. If an unsuitable codec "
@@ -355,8 +355,8 @@ PsychError SCREENOpenOffscreenWindow(void)
             }
         }
 
-        // Allocate framebuffer object for this Offscreen window:
-        if (!PsychCreateFBO(&(windowRecord->fboTable[0]), fboInternalFormat, needzbuffer, (int) PsychGetWidthFromRect(rect), (int) PsychGetHeightFromRect(rect), multiSample, specialFlags)) {
+        // Allocate framebuffer object for this Offscreen window, reusing a pooled one of a closed Offscreen window if possible:
+        if (!PsychCreatePooledFBO(targetWindow, &(windowRecord->fboTable[0]), fboInternalFormat, needzbuffer, (int) PsychGetWidthFromRect(rect), (int) PsychGetHeightFromRect(rect), multiSample, specialFlags)) {
             // Failed!
             PsychErrorExitMsg(PsychError_user, "Creation of Offscreen window in imagingmode failed for some reason :(");
         }
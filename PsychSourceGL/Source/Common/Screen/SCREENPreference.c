@@ -109,7 +109,7 @@ static char synopsisString[] =
     "\noldStyleFlag = Screen('Preference', 'DefaultFontStyle', [styleFlag]);"
     "\noldfontName = Screen('Preference', 'DefaultFontName', [fontName]);"
     "\noldEnableFlag = Screen('Preference', 'DefaultTextYPositionIsBaseline', [enableFlag]);"
-    "\noldEnableFlag = Screen('Preference', 'TextAntiAliasing', [enableFlag=-1 (System setting), 0 = Disable, 1 = Enable, 2 = EnableHighQuality]);"
+    "\noldEnableFlag = Screen('Preference', 'TextAntiAliasing', [enableFlag=-1 (System setting), 0 = Disable, 1 = Enable, 2 = EnableHighQuality, 3 = Signed distance field rendering (FTGL text renderer plugin only)]);"
     "\noldEnableFlag = Screen('Preference', 'TextRenderer', [enableFlag=0 (Legacy OS-specific), 1 = HighQ OS-specific (Default), 2 = Linux renderer plugin]);"
     "\noldLocaleNameString = Screen('Preference', 'TextEncodingLocale', [newLocalenNameString]);"
     "\noldEnableFlag = Screen('Preference', 'SkipSyncTests', [enableFlag]);"
@@ -26,8 +26,8 @@
 #include "Screen.h"
 
 // If you change the useString then also change the corresponding synopsis string in ScreenSynopsis.c
-static char useString[] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids]);";
-//                                                                                1          2
+static char useString[] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids][, waitForUpload=1]);";
+//                                                                                1          2          3
 static char synopsisString[] = 
 "Try to preload textures into VRAM to facilitate fast drawing. This method tries "
 "to upload textures into the local (and fast) VRAM of your graphics hardware before "
@@ -39,7 +39,11 @@ static char synopsisString[] =
 "The return value 'resident' tells you, if all requested textures could be preloaded. A value of 1 "
 "means full success. The 'texidresident' vector tells you for each texture, if that "
 "specific texture could be preloaded. Preloading requested textures can fail if your gfx-hardware "
-"has an insufficient amount of free VRAM memory. ";
+"has an insufficient amount of free VRAM memory. "
+"This also waits for completion of all pending asynchronous texture uploads, as requested via the 'specialFlags' "
+"setting 64 of Screen('MakeTexture'). If the optional \"waitForUpload\" flag is set to 0, nothing is preloaded "
+"or waited for. Instead 'texidresident' tells for each texture if its asynchronous upload is already complete, "
+"and 'resident' is 1 if all uploads are complete. ";
 
 static char seeAlsoString[] = "MakeTexture DrawTexture GetMovieImage";	 
 
@@ -55,6 +59,9 @@ PsychError SCREENPreloadTextures(void)
         GLuint*                                 texids;
         GLboolean*                              texresident;
         psych_bool                                 failed = false;
+        int                                     waitForUpload = 1;
+        int                                     m;
+        PsychNativeBooleanType*                 uploaded;
         GLclampf                                maxprio = 1.0f;
         GLenum                                  target;
 
@@ -63,7 +70,7 @@ PsychError SCREENPreloadTextures(void)
 	if(PsychIsGiveHelp()){PsychGiveHelp();return(PsychError_none);};
 	
 	//check for superfluous arguments
-	PsychErrorExit(PsychCapNumInputArgs(2));        //The maximum number of inputs
+	PsychErrorExit(PsychCapNumInputArgs(3));        //The maximum number of inputs
 	PsychErrorExit(PsychRequireNumInputArgs(1));    //The minimum number of inputs
 	PsychErrorExit(PsychCapNumOutputArgs(2));       //The maximum number of outputs
 	
@@ -74,6 +81,53 @@ PsychError SCREENPreloadTextures(void)
 	isArgThere = PsychIsArgPresent(PsychArgIn, 2);
         PsychAllocInIntegerListArg(2, FALSE, &n, &texhandles);
         if (n < 1) isArgThere=FALSE;
+
+        // Get optional waitForUpload flag:
+        PsychCopyInIntegerArg(3, FALSE, &waitForUpload);
+
+        if (!waitForUpload) {
+            // Only query completion state of asynchronous texture uploads, without any preloading or waiting:
+            PsychCreateVolatileWindowRecordPointerList(&numWindows, &windowRecordArray);
+            residency = (psych_bool*) PsychMallocTemp(sizeof(psych_bool) * ((isArgThere) ? n : numWindows));
+
+            m = 0;
+            for (i = 0; i < ((isArgThere) ? n : numWindows); i++) {
+                texwin = NULL;
+                if (isArgThere) {
+                    if (IsWindowIndex(texhandles[i])) FindWindowRecord(texhandles[i], &texwin);
+                }
+                else {
+                    texwin = windowRecordArray[i];
+                }
+
+                if (!texwin || texwin->windowType != kPsychTexture) {
+                    if (isArgThere) {
+                        printf("PTB-ERROR! Screen('PreloadTextures'): Entry %i of texture handle vector (handle %i) is not a texture handle!\n",
+                               i, texhandles[i]);
+                        failed = true;
+                    }
+                    continue;
+                }
+
+                residency[m++] = PsychQueryTextureUploadComplete(texwin, FALSE);
+            }
+
+            PsychDestroyVolatileWindowRecordPointerList(windowRecordArray);
+
+            if (failed) {
+                PsychErrorExitMsg(PsychError_user, "At least one texture handle in texids-vector was invalid! Aborted.");
+            }
+
+            success = NULL;
+            PsychAllocOutDoubleArg(1, FALSE, &success);
+            *success = 1;
+            for (i = 0; i < m; i++) if (!residency[i]) *success = 0;
+
+            PsychAllocOutBooleanMatArg(2, FALSE, m, 1, 1, &uploaded);
+            for (i = 0; i < m; i++) uploaded[i] = (PsychNativeBooleanType) residency[i];
+
+            return(PsychError_none);
+        }
         
         // Enable this windowRecords framebuffer as current drawingtarget:
         PsychSetDrawingTarget(windowRecord);
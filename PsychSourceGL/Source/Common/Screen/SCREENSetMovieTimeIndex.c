@@ -32,7 +32,9 @@ static char synopsisString[] =	"Set current time index for movie object with han
 								"as a frameindex in frames since start of movie, starting with frame 0 as the "
 								"first frame in the movie.\n\n"
 								"Specifying a new timeindex in seconds is usually faster than specifying a "
-								"timeindex in frames.\n\n"
+								"timeindex in frames, unless the movie was opened with a seek table, see "
+								"the 'SeekIndex' option of Screen('OpenMovie'). A seek table also makes "
+								"frame indices exact, instead of being derived from the nominal framerate.\n\n"
 								"The function optionally returns the old position in seconds in the return "
 								"argument 'oldtimeindex'.\n";
 
@@ -112,8 +112,12 @@ static char synopsisString[] =  "Set video capture parameter 'parameterName' on
                                 "mislabeled as mono data.\n"
                                 "'DebayerMethod' Select method of bayer filtering for conversion of raw sensor data to RGB images. "
                                 "Different methods represent different tradeoffs between quality and computation time. Method 0 "
-                                "(the Default) is the fastest and lowest quality method, whereas higher numbers select higher "
-                                "quality and more cpu load. Currently values 0 to 7 may be valid for your system. This can be "
+                                "is the fastest and lowest quality method, whereas higher numbers select higher "
+                                "quality and more cpu load. Currently values 0 to 7 may be valid for your system. Method 2 "
+                                "(bilinear, the Default) and method 5 (edge-aware) are executed multi-threaded by Psychtoolbox's "
+                                "own implementation for 8 bpc raw sensor data, as is YUV422 and YUV411 to RGB conversion, so they "
+                                "are also suitable for high resolution cameras at high framerates. With 'recordingflags' 16, "
+                                "conversion is performed by the background video processing thread. This can be "
                                 "also used with a 'capturePtr' of -1 to set the method used during movie playback.\n"
                                 "'OverrideBayerPattern' If you choose color image output from raw sensor input, via one of the "
                                 "'DataConversionMode' settings, then a bayer filter operation must be performed to convert raw "
@@ -192,9 +196,20 @@ static char synopsisString[] =  "Set video capture parameter 'parameterName' on
                                 "hang of Psychtoolbox!\n"
                                 "'LoadMarkerTrackingPlugin=' Specify the name of a special markertracker plugin to load and use during video capture. The name "
                                 "must be the path and filename of a shared library which implements this plugin. EXPERIMENTAL and subject to change without notice!\n"
-                                "'SendCommandToMarkerTrackingPlugin=' Send an ASCII string containing commands to a loaded markertracker plugin. EXPERIMENTAL!\n";
+                                "'SendCommandToMarkerTrackingPlugin=' Send an ASCII string containing commands to a loaded markertracker plugin. EXPERIMENTAL!\n"
+                                "'CaptureRing' Get/Set number of most recent frames to keep in the capture ring for bulk retrieval via "
+                                "Screen('GetCapturedFrames'). Zero disables the ring, which is the default. GStreamer engine only.\n"
+                                "'CaptureRingROI' Get/Set the region of interest of frames stored in the capture ring: Only the ROI gets cropped out of "
+                                "each captured frame by the capture engine, e.g., [oldLeft, oldTop, oldRight, oldBottom] = Screen('...', camera, "
+                                "'CaptureRingROI' [, left, top, right, bottom]); An empty ROI selects the full frame, which is the default. Moving the ROI "
+                                "to a new position without changing its size is cheap and takes effect with the next captured frame, so you can update "
+                                "it on each frame to follow a moving target. Changing its size discards all frames in the ring.\n"
+                                "'CaptureRingBinning' Get/Set binning factor 1, 2 or 4 for frames in the capture ring: Each block of 2x2 or 4x4 pixels of "
+                                "the ROI gets averaged into one pixel. Changing it discards all frames in the ring.\n"
+                                "'CaptureRingGrayscale' Get/Set if color frames in the capture ring should be converted to grayscale. YUV video formats "
+                                "always store only their luminance channel in the ring. Changing it discards all frames in the ring.\n";
 
-static char seeAlsoString[] = "OpenVideoCapture CloseVideoCapture StartVideoCapture StopVideoCapture GetCapturedImage";
+static char seeAlsoString[] = "OpenVideoCapture CloseVideoCapture StartVideoCapture StopVideoCapture GetCapturedImage GetCapturedFrames";
 	 
 PsychError SCREENSetVideoCaptureParameter(void) 
 {
@@ -207,7 +222,7 @@ PsychError SCREENSetVideoCaptureParameter(void)
     PsychPushHelp(useString, synopsisString, seeAlsoString);
     if(PsychIsGiveHelp()) {PsychGiveHelp(); return(PsychError_none);};
 
-    PsychErrorExit(PsychCapNumInputArgs(5));            // Max. 5 input args.
+    PsychErrorExit(PsychCapNumInputArgs(6));            // Max. 6 input args.
     PsychErrorExit(PsychRequireNumInputArgs(2));        // Min. 2 input args required.
     PsychErrorExit(PsychCapNumOutputArgs(5));           // Up to 5 output args.
     
@@ -119,6 +119,13 @@ void PsychGLColor4f(PsychWindowRecordType *windowRecord, float r, float g, float
 void PsychGLTexCoord4f(PsychWindowRecordType *windowRecord, float s, float t, float u, float v);
 void PsychGLRectd(PsychWindowRecordType *windowRecord, double x1, double y1, double x2, double y2);
 void PsychDrawDisc(PsychWindowRecordType *windowRecord, float xc, float yc, float innerRadius, float outerRadius, int numSlices, float xScale, float yScale, float startAngle, float arcAngle);
+char* PsychStreamVertexData(PsychWindowRecordType *windowRecord, const void* data, size_t size);
+void PsychStreamVertexDataDone(void);
+psych_bool PsychBatchBegin(PsychWindowRecordType *windowRecord, psych_bool perVertexColors);
+void PsychBatchFlush(PsychWindowRecordType *windowRecord);
+void PsychBatchSetColor(int i, int mc, double* colors, unsigned char *bytecolors);
+void PsychBatchAddRect(PsychWindowRecordType *windowRecord, double x1, double y1, double x2, double y2);
+void PsychBatchAddOval(PsychWindowRecordType *windowRecord, double xc, double yc, double xRadius, double yRadius, int numSlices);
 
 #define GLBEGIN(p) PsychGLBegin(windowRecord, (p))
 #define GLEND() PsychGLEnd(windowRecord)
@@ -127,6 +134,14 @@ void PsychDrawDisc(PsychWindowRecordType *windowRecord, float xc, float yc, floa
 #define GLRECTd(x1, y1, x2, y2) PsychGLRectd(windowRecord, (x1), (y1), (x2), (y2))
 #define GLTEXCOORD2f(s,t) PsychGLTexCoord4f(windowRecord, (s), (t), 0.0, 1.0)
 
+// Helper routine for asynchronous readback by 'GetImage' and 'AddFrameToMovie': Defined in SCREENGetImage.c
+void PsychFinishAsyncReadbacks(PsychWindowRecordType *windowRecord, int moviehandle);
+
+// Helper routine for PBO upload buffer pools of movie playback and video capture: Defined in PsychUploadBufferPoolGStreamer.c
+#ifdef PTB_USE_GSTREAMER
+void PsychReleaseUploadPools(PsychWindowRecordType *windowRecord);
+#endif
+
 // Helper routines for vertically compressed stereo displays: Defined in SCREENSelectStereoDrawBuffer.c
 int PsychSwitchCompressedStereoDrawBuffer(PsychWindowRecordType *windowRecord, int newbuffer);
 void PsychComposeCompressedStereoBuffer(PsychWindowRecordType *windowRecord);
@@ -136,6 +151,7 @@ void            PsychCleanupTextRenderer(PsychWindowRecordType* windowRecord);
 psych_bool      PsychLoadTextRendererPlugin(PsychWindowRecordType* windowRecord);
 void            PsychDrawCharText(PsychWindowRecordType* winRec, const char* textString, double* xp, double* yp, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, PsychRectType* boundingbox);
 PsychError      PsychDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, double* theight, double* xAdvance, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor, int swapTextDirection);
+PsychError      PsychDrawUnicodeTexts(PsychWindowRecordType* winRec, int numStrings, int* textLengths, double** textUniDoubleStrings, double* xStart, double* yStart, double* xp, double* yp, unsigned int yPositionIsBaseline, int numColors, PsychColorType *textColors, PsychColorType *backgroundColor, int swapTextDirection);
 PsychError      PsychOSDrawUnicodeText(PsychWindowRecordType* winRec, PsychRectType* boundingbox, unsigned int stringLengthChars, double* textUniDoubleString, double* xp, double* yp, unsigned int yPositionIsBaseline, PsychColorType *textColor, PsychColorType *backgroundColor);
 psych_bool      PsychAllocInTextAsUnicode(int position, PsychArgRequirementType isRequired, int *textLength, double **unicodeText);
 psych_bool      PsychSetUnicodeTextConversionLocale(char* mnewlocale);
@@ -182,6 +198,7 @@ PsychError SCREENTextFont(void);
 PsychError SCREENTextBounds(void);
 PsychError SCREENTextTransform(void);
 PsychError SCREENDrawText(void);
+PsychError SCREENDrawTexts(void);
 PsychError SCREENTextColor(void);
 PsychError SCREENPreference(void);
 PsychError SCREENDrawTexture(void);
@@ -208,6 +225,7 @@ PsychError SCREENPlayMovie(void);
 PsychError SCREENSetMovieTimeIndex(void);
 PsychError SCREENGetMovieTimeIndex(void);
 PsychError SCREENGetMovieImage(void);
+PsychError SCREENGetMovieStats(void);
 PsychError SCREENglPushMatrix(void);
 PsychError SCREENglPopMatrix(void);
 PsychError SCREENglLoadIdentity(void);
@@ -227,6 +245,7 @@ PsychError SCREENCloseVideoCapture(void);
 PsychError SCREENStartVideoCapture(void);
 PsychError SCREENStopVideoCapture(void);
 PsychError SCREENGetCapturedImage(void);
+PsychError SCREENGetCapturedFrames(void);
 PsychError SCREENSetVideoCaptureParameter(void);
 PsychError SCREENBeginOpenGL(void);
 PsychError SCREENEndOpenGL(void);
@@ -244,6 +263,7 @@ PsychError SCREENGetMouseHelper(void);
 PsychError SCREENResolution(void);
 PsychError SCREENResolutions(void);
 PsychError SCREENWaitUntilAsyncFlipCertain(void);
+PsychError SCREENAsyncFlipQueue(void);
 PsychError SCREENCreateMovie(void);
 PsychError SCREENFinalizeMovie(void);
 PsychError SCREENAddAudioBufferToMovie(void);
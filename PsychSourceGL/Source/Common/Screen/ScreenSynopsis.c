@@ -112,20 +112,21 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[oldFontName,oldFontNumber,oldTextStyle]=Screen('TextFont', windowPtr [,fontNameOrNumber][,textStyle]);";
     synopsis[i++] = "[normBoundsRect, offsetBoundsRect, textHeight, xAdvance] = Screen('TextBounds', windowPtr, text [,x] [,y] [,yPositionIsBaseline] [,swapTextDirection]);";
     synopsis[i++] = "[newX, newY, textHeight]=Screen('DrawText', windowPtr, text [,x] [,y] [,color] [,backgroundColor] [,yPositionIsBaseline] [,swapTextDirection]);";
+    synopsis[i++] = "[newX, newY]=Screen('DrawTexts', windowPtr, texts, positions [,colors] [,backgroundColor] [,yPositionIsBaseline] [,swapTextDirection]);";
     synopsis[i++] = "oldTextColor=Screen('TextColor', windowPtr [,colorVector]);";
     synopsis[i++] = "oldTextBackgroundColor=Screen('TextBackgroundColor', windowPtr [,colorVector]);";
     synopsis[i++] = "oldMatrix = Screen('TextTransform', windowPtr [, newMatrix]);";
 
     // Copy an image, very quickly, between textures and onscreen windows
     synopsis[i++] = "\n% Copy an image, very quickly, between textures, offscreen windows and onscreen windows.";
-    synopsis[i++] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids]);";
+    synopsis[i++] = "[resident [texidresident]] = Screen('PreloadTextures', windowPtr [, texids][, waitForUpload=1]);";
     synopsis[i++] = "Screen('DrawTexture', windowPointer, texturePointer [,sourceRect] [,destinationRect] [,rotationAngle] [, filterMode] [, globalAlpha] [, modulateColor] [, textureShader] [, specialFlags] [, auxParameters]);";
     synopsis[i++] = "Screen('DrawTextures', windowPointer, texturePointer(s) [, sourceRect(s)] [, destinationRect(s)] [, rotationAngle(s)] [, filterMode(s)] [, globalAlpha(s)] [, modulateColor(s)] [, textureShader] [, specialFlags] [, auxParameters]);";
     synopsis[i++] = "Screen('CopyWindow', srcWindowPtr, dstWindowPtr, [srcRect], [dstRect], [copyMode])";
 
     // Copy an image, slowly, between matrices and windows
     synopsis[i++] = "\n% Copy an image, slowly, between matrices and windows :";
-    synopsis[i++] = "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3])";
+    synopsis[i++] = "imageArray=Screen('GetImage', windowPtr [,rect] [,bufferName] [,floatprecision=0] [,nrchannels=3] [,asyncTicket])";
     synopsis[i++] = "Screen('PutImage', windowPtr, imageArray [,rect]);";
 
     // Synchronize with the window's screen (on-screen only):
@@ -135,6 +136,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos] = Screen('AsyncFlipEnd', windowPtr);";
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime FlipTimestamp Missed Beampos] = Screen('AsyncFlipCheckEnd', windowPtr);";
     synopsis[i++] = "[VBLTimestamp StimulusOnsetTime swapCertainTime] = Screen('WaitUntilAsyncFlipCertain', windowPtr);";
+    synopsis[i++] = "[ret1, ret2] = Screen('AsyncFlipQueue', windowPtr, subcommand [, textures] [, when]);";
     synopsis[i++] = "[info] = Screen('GetFlipInfo', windowPtr [, infoType=0] [, auxArg1]);";
     synopsis[i++] = "[telapsed] = Screen('DrawingFinished', windowPtr [, dontclear] [, sync]);";
     synopsis[i++] = "framesSinceLastWait = Screen('WaitBlanking', windowPtr [, waitFrames]);";
@@ -206,6 +208,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] =  "[droppedframes] = Screen('PlayMovie', moviePtr, rate, [loop], [soundvolume]);";
     synopsis[i++] =  "timeindex = Screen('GetMovieTimeIndex', moviePtr);";
     synopsis[i++] =  "[oldtimeindex] = Screen('SetMovieTimeIndex', moviePtr, timeindex [, indexIsFrames=0]);";
+    synopsis[i++] =  "stats = Screen('GetMovieStats', moviePtr);";
     synopsis[i++] =  "moviePtr = Screen('CreateMovie', windowPtr, movieFile [, width][, height][, frameRate=30][, movieOptions][, numChannels=4][, bitdepth=8]);";
     synopsis[i++] =  "Screen('FinalizeMovie', moviePtr);";
     synopsis[i++] =  "Screen('AddFrameToMovie', windowPtr [,rect] [,bufferName] [,moviePtr=0] [,frameduration=1]);";
@@ -219,6 +222,7 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "[fps starttime] = Screen('StartVideoCapture', capturePtr [, captureRateFPS] [, dropframes=0] [, startAt]);";
     synopsis[i++] = "droppedframes = Screen('StopVideoCapture', capturePtr [, discardFrames=1]);";
     synopsis[i++] = "[ texturePtr [capturetimestamp] [droppedcount] [average_intensityOrRawImageMatrix]]=Screen('GetCapturedImage', windowPtr, capturePtr [, waitForImage=1] [,oldTexture] [,specialmode] [,targetmemptr]);";
+    synopsis[i++] = "[framesOrCount, timestamps, frameCounters, intensities, roiOrigins] = Screen('GetCapturedFrames', capturePtr [, maxFrames=inf][, onlyNew=0][, targetmemptr]);";
     synopsis[i++] = "oldvalue = Screen('SetVideoCaptureParameter', capturePtr, 'parameterName' [, value]);";
 
     // Low level OpenGL calls - directly translated to C via very thin wrapper functions:
@@ -253,6 +253,9 @@ typedef struct {
 // Skip wait until scanout out-of-vblank before issuing swaprequest:
 #define kPsychSkipOutOfVblankWait (1 << 29)
 
+// Don't fuse runs of simple shader slots in imaging pipeline hook-chains into one pass:
+#define kPsychDontFuseShaderPasses (1 << 30)
+
 //function protoptypes
 
 //Accessors for PsychDepthType
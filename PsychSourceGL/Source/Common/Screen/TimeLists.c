@@ -17,7 +17,10 @@
 	DESCRIPTION:
 
 		For purposes of instrumenting Screen, maintain times samples in an abstract list type.  Internally we use a 
-		linked list.  To external functions reading out values, the list appears to be an array.
+		preallocated ring buffer of 64 bit integer nanosecond timestamps, each optionally tagged with an event label 
+		and the id of the recording thread.  Appending a sample is O(1), lock-free and does not allocate memory, so 
+		time logging can stay enabled without perturbing timing.  If the ring is full, the oldest samples get 
+		overwritten.  To external functions reading out values, the list appears to be an array, oldest sample first.
 		
 		It is easy to time  Screen subfuntions from MATLAB by surrounding them with calls to GetSecs().  
 
@@ -36,106 +39,125 @@
 		
 		The close routine which you register with ScriptingGlue, that routine which is executed before the mex file 
 		is flushed, must call ClearTimingArray() to free storage allocated by TimeLists.
-	
-	TO DO:
-	
-		No provision is made for multiple simultaneous lists of times.  However, it seems better to only maintain one list of 
-		times, and to have a second, parallel list of strings labeling the events which occured at particular times. 
-		
+
+		No provision is made for multiple simultaneous lists of times.  Instead there is one list of times, and each
+		sample can carry a label string identifying the event which occured at that time, see StoreNowTimeLabeled().
 */
 
 #include "Psych.h"
 
+#if PSYCH_SYSTEM == PSYCH_WINDOWS
+#define PsychTimeListFetchAndIncrement(p) ((psych_uint64) InterlockedIncrement64((volatile LONGLONG*) (p)) - 1)
+#else
+#define PsychTimeListFetchAndIncrement(p) __sync_fetch_and_add((p), 1)
+#endif
 
+#define kPsychDefaultTimeListCapacity 65536
 
 typedef struct _timeArrayElement_{
-	double							timeValue;
-	struct _timeArrayElement_		*next;
+    psych_int64     timeNanoseconds;    // GetSecs() time of sample in nanoseconds.
+    const char*     label;              // Persistent label string, or NULL.
+    psych_uint64    threadId;           // OS thread id of recording thread.
 } timeArrayElement;
 
 
-static timeArrayElement		*timeListHead=NULL;
-static timeArrayElement		*timeListTail=NULL;
-static unsigned int			numElements=0;
+static timeArrayElement         *timeList = NULL;
+static unsigned int             timeListCapacity = kPsychDefaultTimeListCapacity;
+static volatile psych_uint64    timeListWriteCount = 0;
 
 
-void StoreNowTime(void)
+void StoreNowTimeLabeled(const char* label)
 {
-	double				now;
-	timeArrayElement	*newElement;
-	
-	PsychGetAdjustedPrecisionTimerSeconds(&now);
-	newElement=(timeArrayElement *)malloc(sizeof(timeArrayElement));
-	newElement->timeValue=now;
-	newElement->next=NULL;
-	if(timeListTail != NULL)
-		timeListTail->next=newElement;
-	timeListTail=newElement;
-	if(timeListHead==NULL)
-		timeListHead=newElement;
-	++numElements;
+    double              now;
+    psych_uint64        slot;
+    timeArrayElement    *element;
+
+    PsychGetAdjustedPrecisionTimerSeconds(&now);
+
+    // Preallocate the ring on first use. This happens on the main thread,
+    // as all time logging is enabled via Screen preference settings:
+    if (timeList == NULL) {
+        timeList = (timeArrayElement*) calloc(timeListCapacity, sizeof(timeArrayElement));
+        if (timeList == NULL) return;
+    }
+
+    // Claim a slot atomically, so concurrent threads never collide:
+    slot = PsychTimeListFetchAndIncrement(&timeListWriteCount);
+    element = &timeList[slot % timeListCapacity];
+    element->timeNanoseconds = (psych_int64) (now * 1e9 + 0.5);
+    element->label = label;
+    element->threadId = PsychTraceGetOSThreadId();
 }
 
-void ClearTimingArray(void)
+void StoreNowTime(void)
 {
-	timeArrayElement	*thisElement, *tempElement;
-	
-	
-	thisElement=timeListHead;
-	while(thisElement!=NULL){
-		if(thisElement->next==NULL){
-			//end of list.  free this element.
-			free(thisElement);
-			thisElement=NULL;
-			timeListHead=NULL;
-			timeListTail=NULL;
-			numElements=0;
-		}else{
-			//step ahead and free the element behind
-			tempElement=thisElement;
-			thisElement=thisElement->next;
-			free(tempElement);
-		}
-	}	
+    StoreNowTimeLabeled(NULL);
 }
 
-unsigned int GetNumTimeValues(void)
+void ClearTimingArray(void)
 {
-	return(numElements);
+    free(timeList);
+    timeList = NULL;
+    timeListWriteCount = 0;
 }
 
-unsigned int GetTimeArraySizeBytes(void)
+void SetTimeListCapacity(unsigned int capacity)
 {
-	return(numElements * sizeof(double));
-}
+    if (capacity < 1)
+        PsychErrorExitMsg(PsychError_user, "Invalid time list capacity. Must be at least 1 sample.");
 
+    ClearTimingArray();
+    timeListCapacity = capacity;
+}
 
-void CopyTimeArray(double *destination, unsigned int numElements)
+unsigned int GetTimeListCapacity(void)
 {
-	timeArrayElement	*thisElement;
-	unsigned int		i;
-
-	thisElement=timeListHead;
-	for(i=0;i<numElements;i++){
-		if(thisElement==NULL)
-			PsychErrorExitMsg(PsychError_internal, "Attempted to copy out more values than are stored in list");
-		else{
-			destination[i]=thisElement->timeValue;
-			thisElement=thisElement->next;
-		}
-	}
+    return(timeListCapacity);
 }
 
+unsigned int GetNumTimeValues(void)
+{
+    psych_uint64 count = timeListWriteCount;
 
+    return((unsigned int) ((count < timeListCapacity) ? count : timeListCapacity));
+}
 
+unsigned int GetTimeArraySizeBytes(void)
+{
+    return(GetNumTimeValues() * sizeof(double));
+}
 
+// Return ring index of the oldest of the numElements most recent samples:
+static psych_uint64 GetOldestTimeListIndex(unsigned int numElements)
+{
+    if (numElements > GetNumTimeValues())
+        PsychErrorExitMsg(PsychError_internal, "Attempted to copy out more values than are stored in list");
 
+    return(timeListWriteCount - numElements);
+}
 
+void CopyTimeArray(double *destination, unsigned int numElements)
+{
+    psych_uint64    i, first = GetOldestTimeListIndex(numElements);
 
+    for (i = 0; i < numElements; i++)
+        destination[i] = (double) timeList[(first + i) % timeListCapacity].timeNanoseconds / 1e9;
+}
 
+void CopyTimeArrayThreadIds(double *destination, unsigned int numElements)
+{
+    psych_uint64    i, first = GetOldestTimeListIndex(numElements);
 
+    for (i = 0; i < numElements; i++)
+        destination[i] = (double) timeList[(first + i) % timeListCapacity].threadId;
+}
 
+const char* GetTimeArrayLabel(unsigned int index, unsigned int numElements)
+{
+    psych_uint64    first = GetOldestTimeListIndex(numElements);
 
+    if (index >= numElements)
+        PsychErrorExitMsg(PsychError_internal, "Time list label index out of range");
 
-
-
+    return(timeList[(first + index) % timeListCapacity].label);
+}
@@ -17,7 +17,7 @@
 	DESCRIPTION:
 
 		For purposes of instrumenting Screen, maintain times samples in an abstract list type.  Internally we use a 
-		linked list.  To external functions reading out values, it appears to be an array.
+		preallocated ring buffer.  To external functions reading out values, it appears to be an array.
 */
 
 //begin include once 
@@ -26,10 +26,15 @@
 
 
 void StoreNowTime(void);
+void StoreNowTimeLabeled(const char* label);
 void ClearTimingArray(void);
+void SetTimeListCapacity(unsigned int capacity);
+unsigned int GetTimeListCapacity(void);
 unsigned int GetNumTimeValues(void);
 unsigned int GetTimeArraySizeBytes(void);
 void CopyTimeArray(double *destination, unsigned int numElements);
+void CopyTimeArrayThreadIds(double *destination, unsigned int numElements);
+const char* GetTimeArrayLabel(unsigned int index, unsigned int numElements);
 
 //end include once
 #endif
@@ -294,6 +294,9 @@ void PsychCreateWindowRecord(PsychWindowRecordType **winRec)
     (*winRec)->fillOvalDisplayList = 0;
     (*winRec)->frameOvalDisplayList = 0;
 
+    // No streaming vertex buffer for batched 2D drawing yet:
+    (*winRec)->primitiveBatchVBO = 0;
+
     // No special flags set by default:
     (*winRec)->specialflags = 0;
     // No capabilities setup yet:
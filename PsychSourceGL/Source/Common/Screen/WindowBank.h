@@ -181,8 +181,44 @@ typedef struct PsychHookFunction {
     void*                   cprocfunc;
     unsigned int            shaderid;
     unsigned int            luttexid1;
+
+    // Execution time statistics of this slot, see PsychPipelineExecuteHookSlot():
+    GLuint                  timerQuery[2][2];       // Double-buffered GL_TIMESTAMP queries at begin and end of execution, or zero.
+    psych_bool              timerQueryPending[2];   // TRUE if result of timerQuery[i] not yet collected.
+    unsigned int            cpuCount;               // Number of executions with measured cpu time.
+    double                  cpuTimeLast;            // Cpu wall time of last execution in seconds.
+    double                  cpuTimeAvg;             // Moving average of cpu wall time in seconds.
+    double                  cpuTimeMax;             // Maximum cpu wall time in seconds.
+    unsigned int            gpuCount;               // Number of executions with measured gpu time.
+    double                  gpuTimeLast;            // Gpu execution time of most recently collected execution in seconds.
+    double                  gpuTimeAvg;             // Moving average of gpu execution time in seconds.
+    double                  gpuTimeMax;             // Maximum gpu execution time in seconds.
 } PsychHookFunction;
 
+// Uniform of an original shader slot program, mirrored into a fused shader program:
+typedef struct PsychFusedUniform {
+    GLuint                  srcprogram;     // Original GLSL program of the shader slot.
+    GLint                   srcloc;         // Location of uniform in srcprogram.
+    GLint                   dstloc;         // Location of corresponding uniform in fused program.
+    GLenum                  type;           // GL type of the uniform, e.g., GL_FLOAT_VEC4.
+    psych_bool              cached;         // TRUE if fvalue or ivalue hold the value last assigned to dstloc.
+    GLfloat                 fvalue[16];     // Last assigned value of float type uniforms.
+    GLint                   ivalue[4];      // Last assigned value of int and bool type uniforms.
+} PsychFusedUniform;
+
+// Definition of a run of shader slots of a hook chain, fused into one shader pass:
+typedef struct PsychFusedShaderPass*    PtrPsychFusedShaderPass;
+typedef struct PsychFusedShaderPass {
+    PtrPsychFusedShaderPass next;
+    PtrPsychHookFunction    first;          // First shader slot of the fused run.
+    PtrPsychHookFunction    last;           // Last shader slot of the fused run.
+    int                     stages;         // Number of shader slots in the run.
+    unsigned int*           signatures;     // Signature of each slots shader program at fusion time.
+    PsychFusedUniform*      uniforms;       // Uniforms to copy from slot programs to fused program on changes.
+    int                     uniformCount;
+    PsychHookFunction       slot;           // Synthetic shader slot which executes the fused program.
+} PsychFusedShaderPass;
+
 // Definition of an OpenGL Framebuffer object (FBO) for internal use.
 typedef struct PsychFBO {
     GLuint                  fboid;          // Handle to FBO.
@@ -196,8 +232,42 @@ typedef struct PsychFBO {
     GLenum                  textarget;      // Type of texture target for texture coltexid (GL_TEXTURE_RECTANGLE_EXT or GL_TEXTURE_2D etc.)
 } PsychFBO;
 
+// Maximum number of idle FBOs kept for reuse in the FBO pool of an onscreen window:
+#define kPsychFBOPoolSize 8
+
+// Number of pixel buffer objects in the ring used for asynchronous texture uploads:
+#define kPsychTextureUploadRingSize 4
+
+// One pixel buffer object of an onscreen windows ring for asynchronous texture uploads:
+typedef struct PsychTextureUploadSlot {
+    GLuint                  pbo;            // Handle of PBO, zero if not yet created.
+    size_t                  size;           // Size of PBO in bytes.
+    void*                   mapped;         // Pointer to mapped PBO memory, or NULL if not mapped.
+    psych_bool              persistent;     // TRUE if PBO is persistently mapped.
+    GLsync                  fence;          // Fence which signals completion of the last upload from this PBO, or NULL.
+} PsychTextureUploadSlot;
+
 // Typedefs for WindowRecord in WindowBank.h
 
+// Maximum number of frames in the flip queue of a window for Screen('AsyncFlipQueue'):
+#define kPsychFlipQueueSize 1024
+
+// One prerendered frame in the flip queue, with its presentation deadline and the results of its flip:
+typedef struct PsychFlipQueueItem {
+    GLuint                  textureNumber;      // OpenGL texture with the upright frame image.
+    GLenum                  textureTarget;      // Texture target of textureNumber.
+    int                     width;              // Width of texture in pixels.
+    int                     height;             // Height of texture in pixels.
+    GLsync                  fence;              // Fence to wait for before presenting, or NULL.
+    double                  flipwhen;           // >= 0 = Absolute presentation deadline, < 0 = -n refresh cycles after previous frame.
+    // Results of the flip of this frame, see PsychFlipInfoStruct:
+    int                     beamPosAtFlip;
+    double                  miss_estimate;
+    double                  time_at_flipend;
+    double                  time_at_onset;
+    double                  vbl_timestamp;
+} PsychFlipQueueItem;
+
 // This support structure for async flips is supported on all non-Windows platforms, aka all Unix platforms:
 // It gets attached to the asyncFlipInfo* of a windowRecord whenever async flips are used.
 typedef struct PsychFlipInfoStruct {
@@ -219,6 +289,17 @@ typedef struct PsychFlipInfoStruct {
     psych_thread            flipperThread;      // Thread handle for background flipping thread.
     psych_mutex             performFlipLock;    // Primary lock.
     psych_condition         flipperGoGoGo;      // Signalling condition variable to trigger execution of a flip request by the flipper thread.
+
+    // Flip queue for Screen('AsyncFlipQueue'): Ring of kPsychFlipQueueSize items, indexed by free running
+    // counters modulo kPsychFlipQueueSize, with flipQueueDone <= flipQueueHead <= flipQueueTail:
+    PsychFlipQueueItem*     flipQueue;          // Ring buffer, or NULL if flip queue never used.
+    unsigned int            flipQueueDone;      // Index of oldest presented frame whose results are not yet retrieved.
+    unsigned int            flipQueueHead;      // Index of next frame to present.
+    unsigned int            flipQueueTail;      // Index of next free slot for appending a frame.
+    int                     flipQueueState;     // 0 = Idle, 1 = Presenting, 2 = Finished presenting.
+    psych_bool              flipQueueAbort;     // TRUE = Stop presentation after current frame.
+    psych_mutex             flipQueueLock;      // Protects the flipQueue indices, state and abort flag.
+    GLuint                  flipQueueFBO;       // FBO of flipper thread for blitting queued frames.
 } PsychFlipInfoStruct;
 
 
@@ -365,6 +446,10 @@ typedef struct _PsychWindowRecordType_{
     GLint                       textureI420PlanarShader; // Optional GLSL program handle for shader to convert a YUV-I420 planar texture into a standard RGBA8 texture.
     GLint                       textureI800PlanarShader; // Optional GLSL program handle for shader to convert a Y8-I800 planar texture into a standard RGBA8 texture.
     GLint                       multiSampleFetchShader;  // Optional GLSL program handler for shader to fetch from multisample texture.
+    GLuint                      textureUploadPBO;       // PBO from which the next texture upload is sourced, zero for upload from textureMemory.
+    int                         textureUploadSlot;      // Slot of the parent windows textureUploadRing which contains textureUploadPBO, -1 for a persistently mapped PBO of some other owner.
+    size_t                      textureUploadOffset;    // Offset of the image data in textureUploadPBO, if textureUploadSlot == -1.
+    GLsync                      textureUploadFence;     // Fence which signals completion of an asynchronous upload, or NULL if none pending.
 
     psych_bool                  needsViewportSetup;     // Set on userspace OpenGL contexts of onscreen windows to signal need for glViewport setup and other one-time
                                                         // stuff on first Screen('BeginOpenGL'). Also (ab)used for textures and offscreen windows to track "dirty" state.
@@ -433,6 +518,9 @@ typedef struct _PsychWindowRecordType_{
     int                         imagingMode;                                // Master mode switch for imaging and callback hook pipeline.
     PtrPsychHookFunction        HookChain[MAX_SCREEN_HOOKS];                // Array of pointers to the hook-chains for different hooks.
     psych_bool                  HookChainEnabled[MAX_SCREEN_HOOKS];         // Array of Booleans to en-/disable single chains temporarily.
+    PtrPsychFusedShaderPass     HookChainFusion[MAX_SCREEN_HOOKS];          // Fused shader passes of each hook-chain, see PsychPipelineGetFusedShaderPasses().
+    psych_bool                  HookChainFusionValid[MAX_SCREEN_HOOKS];     // TRUE if HookChainFusion[] is up to date with the hook-chain.
+    psych_bool                  HookChainFusionDirty[MAX_SCREEN_HOOKS];     // TRUE if shaders of fused slots may have changed since last execution.
 
     // Indices into our FBO table: The special value -1 means: Don't use.
     int                         drawBufferFBO[2];                   // Storage for drawing FBOs: These are the targets of all drawing operations before
@@ -460,6 +548,17 @@ typedef struct _PsychWindowRecordType_{
     GLuint                      fillOvalDisplayList;
     GLuint                      frameOvalDisplayList;
 
+    // Ring of pixel buffer objects for asynchronous texture uploads, used only when this structure holds an onscreen window:
+    PsychTextureUploadSlot      textureUploadRing[kPsychTextureUploadRingSize];
+    int                         textureUploadRingNext;
+
+    // Pool of idle FBOs for reuse by offscreen windows and temporary buffers, used only when this structure holds an onscreen window:
+    PsychFBO*                   fboPool[kPsychFBOPoolSize];     // Oldest first.
+    int                         fboPoolCount;
+
+    // Streaming vertex buffer for batched drawing of 2D primitives, used only when this structure holds an onscreen window:
+    GLuint                      primitiveBatchVBO;
+
     // Pointer to double-array of auxiliary parameters for bound shaders - or NULL by default.
     double*                     auxShaderParams;
     int                         auxShaderParamsCount;
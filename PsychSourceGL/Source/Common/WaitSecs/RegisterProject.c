@@ -28,11 +28,11 @@ PsychError PsychModuleInit(void)
 
     // Register the project function which is called when the module
     // is invoked with no named subfunction:
-    PsychErrorExit(PsychRegister(NULL,  &WAITSECSWaitSecs));
+    PsychErrorExit(PsychRegisterBlocking(NULL,  &WAITSECSWaitSecs));
 
     // Wait until specific deadline:
-    PsychErrorExit(PsychRegister("UntilTime", &WAITSECSWaitUntilSecs));
-    PsychErrorExit(PsychRegister("YieldSecs", &WAITSECSYieldSecs));
+    PsychErrorExit(PsychRegisterBlocking("UntilTime", &WAITSECSWaitUntilSecs));
+    PsychErrorExit(PsychRegisterBlocking("YieldSecs", &WAITSECSYieldSecs));
 
     // Report the version
     PsychErrorExit(PsychRegister("Version", &MODULEVersion));
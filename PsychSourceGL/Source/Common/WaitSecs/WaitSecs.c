@@ -56,6 +56,9 @@ const char** InitializeSynopsis(void)
     synopsis[i++] = "\nThe optional 'realWakeupTimeSecs' is the real system time when WaitSecs finished waiting,";
     synopsis[i++] = "just as if you'd call realWakeupTimeSecs = GetSecs; after calling WaitSecs. This for your";
     synopsis[i++] = "convenience and to reduce call overhead and drift a bit for this common combo of commands.";
+    synopsis[i++] = "\nUnder Python, all waits release the global interpreter lock, so other Python threads keep";
+    synopsis[i++] = "running while waiting. Busy threads may delay the return of WaitSecs by up to the interpreter";
+    synopsis[i++] = "thread switch interval, see sys.setswitchinterval().";
     synopsis[i++] = NULL;
 
     return(synopsisSYNOPSIS);
@@ -87,7 +90,9 @@ PsychError WAITSECSWaitSecs(void)
     }
 
     // Wait for requested interval:
+    PsychEnterBlockingSection();
     PsychWaitIntervalSeconds(waitPeriodSecs);
+    PsychLeaveBlockingSection();
 
     // Return current system time at end of sleep:
     PsychGetAdjustedPrecisionTimerSeconds(&now);
@@ -130,7 +135,9 @@ PsychError WAITSECSWaitUntilSecs(void)
     PsychErrorExit(PsychCapNumInputArgs(1));
     
     PsychCopyInDoubleArg(1,TRUE,&waitUntilSecs);
+    PsychEnterBlockingSection();
     PsychWaitUntilSeconds(waitUntilSecs);
+    PsychLeaveBlockingSection();
 
     // Return current system time at end of sleep:
     PsychGetAdjustedPrecisionTimerSeconds(&now);
@@ -166,7 +173,9 @@ PsychError WAITSECSYieldSecs(void)
     PsychErrorExit(PsychCapNumInputArgs(1));
     
     PsychCopyInDoubleArg(1,TRUE,&waitPeriodSecs);
+    PsychEnterBlockingSection();
     PsychYieldIntervalSeconds(waitPeriodSecs);
+    PsychLeaveBlockingSection();
 
     // Return current system time at end of sleep:
     PsychGetAdjustedPrecisionTimerSeconds(&now);
@@ -28,6 +28,11 @@
 
 
 
+// For the cpu affinity macros and sched_setaffinity() in sched.h:
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "Psych.h"
 #include <time.h>
 #include <errno.h>
@@ -612,7 +617,7 @@ void PsychSetThreadName(const char *name)
     pthread_setname_np(pthread_self(), name);
     #  endif
 
-    (void)name;
+    PsychTraceSetThreadName(name);
 }
 
 /* Initialize condition variable:
@@ -715,6 +720,68 @@ psych_uint64 PsychAutoLockThreadToCores(psych_uint64* curCpuMask)
     return(INT64_MAX);
 }
 
+/* Restrict the calling thread to the cores in the bitmask 'coreMask', where bit
+ * i set means core i is allowed. Returns the previous mask in 'oldCoreMask' if
+ * that is non-NULL. Returns zero on success, an errno code on failure.
+ */
+int PsychSetThreadCoreMask(psych_uint64 coreMask, psych_uint64* oldCoreMask)
+{
+    cpu_set_t cpuset;
+    int i;
+
+    if (oldCoreMask) {
+        *oldCoreMask = 0;
+        CPU_ZERO(&cpuset);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == 0) {
+            for (i = 0; i < 64; i++)
+                if (CPU_ISSET(i, &cpuset)) *oldCoreMask |= ((psych_uint64) 1) << i;
+        }
+    }
+
+    CPU_ZERO(&cpuset);
+    for (i = 0; i < 64; i++)
+        if (coreMask & (((psych_uint64) 1) << i)) CPU_SET(i, &cpuset);
+
+    return(pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset));
+}
+
+/* Return number of online processor cores: */
+int PsychGetNumProcessorCores(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return((n > 0) ? (int) n : 1);
+}
+
+/* Return consumed cpu time in seconds of the thread with kernel thread id 'osThreadId'
+ * of our process, as returned by PsychTraceGetOSThreadId(), or -1 if the thread does not
+ * exist anymore:
+ */
+double PsychGetThreadCPUTime(psych_uint64 osThreadId)
+{
+    char path[64];
+    unsigned long long runtimeNsecs;
+    struct timespec ts;
+    FILE* fd;
+    int rc;
+
+    // Calling thread can ask the kernel directly:
+    if (osThreadId == PsychTraceGetOSThreadId()) {
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return((double) ts.tv_sec + (double) ts.tv_nsec / 1e9);
+    }
+
+    // Other threads: First field of schedstat is the time spent on a cpu in nanoseconds:
+    snprintf(path, sizeof(path), "/proc/self/task/%llu/schedstat", (unsigned long long) osThreadId);
+    if (!(fd = fopen(path, "r")))
+        return(-1);
+
+    rc = fscanf(fd, "%llu", &runtimeNsecs);
+    fclose(fd);
+
+    return((rc == 1) ? (double) runtimeNsecs / 1e9 : -1);
+}
+
 /* Report official support status for this operating system release.
  * The string "Supported" means supported.
  * Other strings describe lack of support.
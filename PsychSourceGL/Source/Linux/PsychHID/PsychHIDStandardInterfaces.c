@@ -1019,6 +1019,7 @@ void* KbQueueWorkerThreadMain(void* dummy)
 
     // Assign a name to ourselves, for debugging:
     PsychSetThreadName("PsychHIDKbQueue");
+    PsychAssignThreadToCoreSet("PsychHIDKbQueue", kPsychThreadClassRealtime);
 
     // Try to raise our priority: We ask to switch ourselves (NULL) to priority class 2 aka
     // rt_fifo realtime scheduling, with a tweakPriority of +1, ie., raise the relative
@@ -1607,7 +1608,9 @@ void PsychHIDOSKbTriggerWait(int deviceIndex, int numScankeys, int* scanKeys)
     // Scan for trigger key:
     while (1) {
         // Wait until something changes in a keyboard queue:
+        PsychEnterBlockingSection();
         PsychWaitCondition(&KbQueueCondition, &KbQueueMutex);
+        PsychLeaveBlockingSection();
 
         // Check if our queue had one of the dedicated trigger keys pressed:
         for (i = 0; i < numScankeys; i++) {
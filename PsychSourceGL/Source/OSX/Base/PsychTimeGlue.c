@@ -30,6 +30,8 @@
 #include <mach/mach_time.h>
 #include <sys/sysctl.h>
 #include <sched.h>
+// For proc_pidinfo() thread cpu time queries:
+#include <libproc.h>
 
 #include <mach/mach_init.h>
 #include <mach/task_policy.h>
@@ -415,6 +417,7 @@ void PsychSetThreadName(const char *name)
 {
     // OSX interface only allows assigning name to current thread, different to Linux:
     pthread_setname_np(name);
+    PsychTraceSetThreadName(name);
 }
 
 /* Initialize condition variable:
@@ -520,6 +523,39 @@ psych_uint64 PsychAutoLockThreadToCores(psych_uint64* curCpuMask)
     return(INT64_MAX);
 }
 
+/* Restrict the calling thread to the cores in the bitmask 'coreMask':
+ * Unsupported, as OSX does not allow to bind threads to cores. Returns ENOTSUP.
+ */
+int PsychSetThreadCoreMask(psych_uint64 coreMask, psych_uint64* oldCoreMask)
+{
+    (void) coreMask;
+    if (oldCoreMask) *oldCoreMask = 0;
+
+    return(ENOTSUP);
+}
+
+/* Return number of online processor cores: */
+int PsychGetNumProcessorCores(void)
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return((n > 0) ? (int) n : 1);
+}
+
+/* Return consumed cpu time in seconds of the thread with system thread id 'osThreadId'
+ * of our process, as returned by PsychTraceGetOSThreadId(), or -1 if the thread does not
+ * exist anymore:
+ */
+double PsychGetThreadCPUTime(psych_uint64 osThreadId)
+{
+    struct proc_threadinfo info;
+
+    if (proc_pidinfo(getpid(), PROC_PIDTHREADID64INFO, osThreadId, &info, sizeof(info)) != sizeof(info))
+        return(-1);
+
+    return((double) (info.pth_user_time + info.pth_system_time) / 1e9);
+}
+
 /* Query / derive / return OSX minor version from Darwin kernel major version.
  * This is a makeshift replacement for Gestalt(), which was sadly deprecated by
  * the iPhone company. It only gives us the x in OSX 10.x.y, but that's usually
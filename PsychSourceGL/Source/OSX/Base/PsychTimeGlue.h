@@ -88,6 +88,9 @@ int PsychTimedWaitCondition(psych_condition* condition, psych_mutex* mutex, doub
 #define PsychIsMSVista() 0
 int PsychIsCurrentThreadEqualToPsychThread(psych_thread threadhandle);
 psych_uint64 PsychAutoLockThreadToCores(psych_uint64* curCpuMask);
+int PsychSetThreadCoreMask(psych_uint64 coreMask, psych_uint64* oldCoreMask);
+int PsychGetNumProcessorCores(void);
+double PsychGetThreadCPUTime(psych_uint64 osThreadId);
 int PsychGetOSXMinorVersion(void);
 const char* PsychSupportStatus(void);
 
@@ -840,6 +840,7 @@ static void *KbQueueWorkerThreadMain(void *inarg) {
 
     // Assign a name to ourselves, for debugging:
     PsychSetThreadName("PsychHIDKbQueue");
+    PsychAssignThreadToCoreSet("PsychHIDKbQueue", kPsychThreadClassRealtime);
 
     // Switch ourselves (NULL) to RT scheduling: We promise to use / require at most (0+1) == 1 msec every
     // 10 msecs and allow for wakeup delay/jitter of up to 2 msecs -- perfectly reasonable, given that we
@@ -554,6 +554,61 @@ psych_uint64 PsychAutoLockThreadToCores(psych_uint64* curCpuMask)
     return((psych_uint64) oldCpuMask);
 }
 
+/* Restrict the calling thread to the cores in the bitmask 'coreMask', where bit
+ * i set means core i is allowed. Returns the previous mask in 'oldCoreMask' if
+ * that is non-NULL. Returns zero on success, GetLastError() code on failure.
+ *
+ * Note that the timing code may temporarily lock threads to a single core via
+ * PsychAutoLockThreadToCores() to work around broken timer hardware.
+ */
+int PsychSetThreadCoreMask(psych_uint64 coreMask, psych_uint64* oldCoreMask)
+{
+    DWORD_PTR oldMask;
+
+    if ((oldMask = SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) coreMask)) == 0)
+        return((int) GetLastError());
+
+    if (oldCoreMask) *oldCoreMask = (psych_uint64) oldMask;
+
+    return(0);
+}
+
+/* Return number of processor cores: */
+int PsychGetNumProcessorCores(void)
+{
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+
+    return((int) info.dwNumberOfProcessors);
+}
+
+/* Return consumed cpu time in seconds of the thread with thread id 'osThreadId'
+ * of our process, as returned by PsychTraceGetOSThreadId(), or -1 if the thread does not
+ * exist anymore:
+ */
+double PsychGetThreadCPUTime(psych_uint64 osThreadId)
+{
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    HANDLE thread;
+    DWORD exitCode;
+    double cpuTime = -1;
+
+    if ((thread = OpenThread(THREAD_QUERY_INFORMATION, FALSE, (DWORD) osThreadId)) == NULL)
+        return(-1);
+
+    if (GetExitCodeThread(thread, &exitCode) && (exitCode == STILL_ACTIVE) &&
+        GetThreadTimes(thread, &creationTime, &exitTime, &kernelTime, &userTime)) {
+        // Times are in units of 100 nsecs:
+        cpuTime = ((double) (((psych_uint64) kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime) +
+                   (double) (((psych_uint64) userTime.dwHighDateTime << 32) | userTime.dwLowDateTime)) / 1e7;
+    }
+
+    CloseHandle(thread);
+
+    return(cpuTime);
+}
+
 void PsychGetPrecisionTimerSeconds(double *secs)
 {
     double                      ss, ticks, diff;
@@ -1497,8 +1552,8 @@ int PsychSetThreadPriority(psych_thread* threadhandle, int basePriority, int twe
 /* Assign a name to a thread, for debugging: */
 void PsychSetThreadName(const char *name)
 {
-    // No-op for now.
-    (void) name;
+    // No-op for now, except for remembering it for trace exports:
+    PsychTraceSetThreadName(name);
     return;
 }
 
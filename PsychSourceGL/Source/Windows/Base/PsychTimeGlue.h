@@ -71,6 +71,9 @@ int PsychOSIsMSWin8(void);
 int PsychOSIsMSWin10(void);
 int PsychIsCurrentThreadEqualToPsychThread(psych_thread threadhandle);
 psych_uint64 PsychAutoLockThreadToCores(psych_uint64* curCpuMask);
+int PsychSetThreadCoreMask(psych_uint64 coreMask, psych_uint64* oldCoreMask);
+int PsychGetNumProcessorCores(void);
+double PsychGetThreadCPUTime(psych_uint64 osThreadId);
 const char* PsychSupportStatus(void);
 
 //end include once
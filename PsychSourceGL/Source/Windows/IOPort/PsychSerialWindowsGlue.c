@@ -72,6 +72,8 @@ void* PsychSerialWindowsGlueReaderThreadMain(void* deviceToCast)
         if (verbosity > 0) fprintf(stderr, "PTB-ERROR: In IOPort:PsychSerialWindowsGlueReaderThreadMain(): Failed to switch to realtime priority [%i]!\n", rc);
     }
 
+    PsychAssignThreadToCoreSet("IOPortSerialRd", kPsychThreadClassRealtime);
+
     // Perform initial check for device errors, clear error state:
     errmsg[0] = 0;
     if ((rc=PsychIOOSCheckError(device, &errmsg[0]))>0) {
@@ -188,6 +190,7 @@ void* PsychSerialWindowsGlueReaderThreadMain(void* deviceToCast)
 
             // Increment serial bytes received counter:
             device->asyncReadBytesCount += (naccumread > 0) ? naccumread : 0;
+            PsychTraceCounter("IOPort:BytesReceived", (double) device->asyncReadBytesCount);
         }
         else {
             // Standard non-linebuffered readop:
@@ -234,6 +237,7 @@ void* PsychSerialWindowsGlueReaderThreadMain(void* deviceToCast)
 
             // Increment serial bytes received counter:
             device->asyncReadBytesCount += (nread > 0) ? nread : 0;
+            PsychTraceCounter("IOPort:BytesReceived", (double) device->asyncReadBytesCount);
 
             // Filtermode for filtering out CR and LF characters active (e.g., for UBW32-Bitwhacker with StickOS)?
             if ((device->readFilterFlags & kPsychIOPortCRLFFiltering) &&
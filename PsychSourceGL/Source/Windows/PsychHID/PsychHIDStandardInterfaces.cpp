@@ -1298,7 +1298,9 @@ void PsychHIDOSKbTriggerWait(int deviceIndex, int numScankeys, int* scanKeys)
     // Scan for trigger key:
     while (1) {
         // Wait until something changes in a keyboard queue:
+        PsychEnterBlockingSection();
         PsychWaitCondition(&KbQueueCondition, &KbQueueMutex);
+        PsychLeaveBlockingSection();
 
         // Check if our queue had one of the dedicated trigger keys pressed:
         for (i = 0; i < numScankeys; i++) {
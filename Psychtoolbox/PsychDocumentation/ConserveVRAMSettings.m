@@ -327,6 +327,21 @@
 % drivers and advice the user to use this flag in such situations.
 %
 %
+% 2^30 == kPsychDontFuseShaderPasses
+% Don't fuse runs of simple per-pixel shader slots in the processing chains of
+% the imaging pipeline into single shader passes. By default, Psychtoolbox
+% detects chains of shader slots which only read the input image at the
+% current pixel location, e.g., color correction followed by gamma correction,
+% and executes them as one generated shader in one pass, saving the time and
+% memory bandwidth for writing and reading back intermediate images. As
+% intermediate results are then not rounded to the precision of the bounce
+% buffers anymore, results may differ in the least significant bits. Set this
+% flag to disable the optimization, e.g., for debugging of your own shaders.
+% If your code relinks a slot shader via a handle it kept around, instead of
+% getting it via Screen('HookFunction', ..., 'Query'), call
+% Screen('HookFunction', window, 'ShaderChanged') after the change.
+%
+%
 % --> It's always better to update your graphics drivers with fixed
 % versions or buy proper hardware than using these workarounds. They are
 % meant as a last ressort, e.g., if you need to get something going quickly
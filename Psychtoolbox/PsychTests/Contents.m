@@ -21,6 +21,7 @@
 %   DatapixxGPUDitherpatternTest    - Low level diagnostic of GPU dithering bugs via Datapixx et al.
 %   DeinterlacerTest                - Simple correctness test for GLSL video image deinterlacer. INCOMPLETE.
 %   DrawingIntoTexturesTest         - Tests if using a texture as an offscreen window, i.e., for drawing, works.
+%   DrawTexturesBenchmark           - Benchmark Screen('DrawTextures') with thousands of sprites per frame.
 %   DrawTextFontSwitchSpeedTest - Test speed of text drawing when switching between different font type/style/size settings.
 %   DriftTexturePrecisionTest       - Test subpixel accuracy of texture interpolators: What is the smallest
 %                                     fraction of a pixel that one can scroll, using built-in bilinear interpolation?
@@ -51,6 +52,7 @@
 %   LabLuvTest                      - Test routines that convert to CIELAB and CIELUV.
 %   LoadGenerator                   - Create cpu load by spinning in an infinite loop. Used in conjunction with FlipTimingWithRTBoxPhotoDiodeTest.
 %   LosslessMovieWritingTest        - Test lossless encoding and decoding of video in movie files.
+%   MakeTextureBenchmark            - Benchmark MakeTexture pixel conversion for all channel counts and input formats.
 %   MakeTextureTimingTest           - Time memory allocation by MakeTexture
 %   MakeTextureTimingTest2          - Time texture creation -> upload -> destruction for given texture by MakeTexture et al.
 %   MatlabTimingTest                - Test for MATLAB timing glitch caused by sigsetjmp().
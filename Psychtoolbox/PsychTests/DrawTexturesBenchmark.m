@@ -0,0 +1,119 @@
+function results = DrawTexturesBenchmark(screenid, counts, nFrames)
+% results = DrawTexturesBenchmark([screenid=max][,counts=[1000 2000 5000 10000 20000 50000]][,nFrames=100]);
+%
+% Benchmark Screen('DrawTextures') for drawing many small sprites per frame.
+%
+% For each number of sprites in 'counts', 'nFrames' frames are drawn with
+% random positions, rotation angles, global alpha values and modulate
+% colors for each sprite, in three configurations:
+%
+% 1. One texture drawn as all sprites.
+% 2. Four different textures, sorted by texture, so each texture gets
+%    drawn as one run of sprites.
+% 3. One procedural Gabor patch with individual parameters per sprite,
+%    passed via 'auxParameters', as used for dense Gabor displays.
+%
+% The average cpu time per 'DrawTextures' call and the average duration of
+% a frame, including the time the gpu needs to finish drawing, are printed
+% as a table, and returned in the matrix 'results' in msecs, one row per
+% sprite count, with the cpu times of the three configurations in the
+% first three columns and the frame durations in the last three columns.
+%
+% see also: DrawingSpeedTest, PsychTests
+
+% History:
+% 10/16/26 Written.
+
+AssertOpenGL;
+
+if nargin < 1 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+if nargin < 2 || isempty(counts)
+    counts = [1000 2000 5000 10000 20000 50000];
+end
+
+if nargin < 3 || isempty(nFrames)
+    nFrames = 100;
+end
+
+configs = { 'one texture', 'four textures', 'procedural gabor' };
+results = zeros(length(counts), 6);
+spriteSize = 32;
+
+try
+    w = Screen('OpenWindow', screenid, 128);
+    [width, height] = Screen('WindowSize', w);
+    Screen('BlendFunction', w, 'GL_SRC_ALPHA', 'GL_ONE_MINUS_SRC_ALPHA');
+
+    texs = zeros(1, 4);
+    for i = 1:4
+        texs(i) = Screen('MakeTexture', w, uint8(rand(spriteSize, spriteSize, 3) * 255));
+    end
+    gabortex = CreateProceduralGabor(w, spriteSize, spriteSize);
+
+    for c = 1:length(counts)
+        n = counts(c);
+        for config = 1:3
+            switch config
+                case 1
+                    tex = texs(1);
+                case 2
+                    tex = sort(texs(ceil(rand(1, n) * 4)));
+                case 3
+                    tex = gabortex;
+            end
+
+            cputime = 0;
+            tstart = 0;
+            for frame = 0:nFrames
+                x = rand(1, n) * (width - spriteSize);
+                y = rand(1, n) * (height - spriteSize);
+                dstRects = [x; y; x + spriteSize; y + spriteSize];
+                angles = rand(1, n) * 360;
+
+                t = GetSecs;
+                if config < 3
+                    Screen('DrawTextures', w, tex, [], dstRects, angles, [], rand(1, n), rand(3, n) * 255);
+                else
+                    auxParameters = [rand(1, n) * 180; repmat([0.05; 5; 50], 1, n)];
+                    Screen('DrawTextures', w, tex, [], dstRects, angles, [], [], [], [], kPsychDontDoRotation, auxParameters);
+                end
+                t = GetSecs - t;
+
+                Screen('Flip', w, 0, 0, 2);
+
+                % First frame is for warmup, so one-time setup overhead doesn't spoil the numbers:
+                if frame == 0
+                    Screen('DrawingFinished', w, 0, 1);
+                    tstart = GetSecs;
+                else
+                    cputime = cputime + t;
+                end
+            end
+            Screen('DrawingFinished', w, 0, 1);
+
+            results(c, config) = cputime / nFrames * 1000;
+            results(c, config + 3) = (GetSecs - tstart) / nFrames * 1000;
+        end
+    end
+
+    Screen('CloseAll');
+catch
+    Screen('CloseAll');
+    psychrethrow(psychlasterror);
+end
+
+fprintf('\nAverage DrawTextures cpu time / frame duration in msecs over %i frames:\n\n', nFrames);
+fprintf('%-10s', 'Sprites');
+fprintf('%26s', configs{:});
+fprintf('\n');
+for c = 1:length(counts)
+    fprintf('%-10i', counts(c));
+    fprintf('%15.3f /%9.3f', [results(c, 1:3); results(c, 4:6)]);
+    fprintf('\n');
+end
+fprintf('\n');
+
+return;
@@ -0,0 +1,98 @@
+function results = MakeTextureBenchmark(screenid, width, height, nSamples)
+% results = MakeTextureBenchmark([screenid=max][,width=2048][,height=2048][,nSamples=20]);
+%
+% Benchmark the pixel format conversion of Screen('MakeTexture') for all
+% combinations of 1 to 4 color channels (1=Luminance, 2=Luminance+Alpha,
+% 3=RGB, 4=RGBA) and the input -> texture formats uint8 -> 8 bit integer,
+% double -> 8 bit integer and double -> 32 bpc float.
+%
+% For each combination, a random 'width' x 'height' image is converted
+% 'nSamples' times into a texture, which is then immediately destroyed
+% again. The average time per texture is printed as a table and returned
+% in the 4-by-3 matrix 'results' in msecs, one row per channel count, one
+% column per format.
+%
+% Large images get converted in parallel by the worker thread pool of
+% Screen. The number of worker threads can be selected via the environment
+% variable PSYCH_WORKER_THREADS before Screen is loaded, e.g., a setting of
+% 1 allows to compare against single-threaded conversion. See
+% Screen('ThreadControl?') for more info.
+%
+% see also: MakeTextureTimingTest2, PsychTests
+
+% History:
+% 10/16/26 Written.
+
+AssertOpenGL;
+
+if nargin < 1 || isempty(screenid)
+    screenid = max(Screen('Screens'));
+end
+
+if nargin < 2 || isempty(width)
+    width = 2048;
+end
+
+if nargin < 3 || isempty(height)
+    height = 2048;
+end
+
+if nargin < 4 || isempty(nSamples)
+    nSamples = 20;
+end
+
+formats = { 'uint8 -> uint8', 'double -> uint8', 'double -> float32' };
+results = zeros(4, 3);
+
+try
+    w = Screen('OpenWindow', screenid, 0);
+
+    for channels = 1:4
+        for format = 1:3
+            img = uint8(rand(height, width, channels) * 255);
+            if format > 1
+                img = double(img);
+            end
+
+            precision = 0;
+            if format == 3
+                img = img / 255;
+                precision = 2;
+            end
+
+            % Preheat: Screen() may need to allocate internal buffers, create
+            % shaders or start its worker threads - we don't want this one-time
+            % setup overhead to spoil the numbers:
+            tex = Screen('MakeTexture', w, img, [], [], precision);
+            Screen('Close', tex);
+            Screen('DrawingFinished', w, 2, 1);
+
+            tstart = GetSecs;
+            for i = 1:nSamples
+                tex = Screen('MakeTexture', w, img, [], [], precision);
+                Screen('Close', tex);
+            end
+            Screen('DrawingFinished', w, 2, 1);
+
+            results(channels, format) = (GetSecs - tstart) / nSamples * 1000;
+        end
+    end
+
+    Screen('CloseAll');
+catch
+    Screen('CloseAll');
+    psychrethrow(psychlasterror);
+end
+
+fprintf('\nAverage MakeTexture time in msecs for %i x %i pixels over %i samples:\n\n', width, height, nSamples);
+fprintf('%-10s', 'Channels');
+fprintf('%20s', formats{:});
+fprintf('\n');
+for channels = 1:4
+    fprintf('%-10i', channels);
+    fprintf('%20.3f', results(channels, :));
+    fprintf('\n');
+end
+fprintf('\n');
+
+return;